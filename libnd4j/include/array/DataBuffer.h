@@ -45,6 +45,8 @@ class ND4J_EXPORT DataBuffer {
         memory::Workspace* _workspace = nullptr;
         bool _isOwnerPrimary;
         bool _isOwnerSpecial;
+        // size primary buffer was taken from PooledAllocator with, 0 if it isn't pooled. _lenInBytes can change while buffer is owned (i.e. setSpecialBuffer)
+        size_t _pooledPrimaryBytes = 0;
         std::atomic<int> _deviceId;
 
     #ifdef __CUDABLAS__
@@ -63,8 +65,15 @@ class ND4J_EXPORT DataBuffer {
         void setAllocFlags(const bool isOwnerPrimary, const bool isOwnerSpecial = false);
         void allocateBuffers(const bool allocBoth = false);
         void setSpecial(void* special, const bool isOwnerSpecial);
+
+        // sets access flag of calling thread, see wasAccessed()
+        static void markAccessed();
         void copyBufferFromHost(const void* hostBuffer, size_t sizeToCopyinBytes = 0, const Nd4jLong offsetThis = 0, const Nd4jLong offsetHostBuffer = 0);
 
+        // zeroed host memory, taken from PooledAllocator if it's enabled and there's no workspace
+        int8_t* allocateHostBytes(const size_t numBytes, size_t &pooledBytes);
+        void releaseHostBytes(void* buffer, const size_t pooledBytes);
+
 
     public:
 
@@ -118,6 +127,10 @@ class ND4J_EXPORT DataBuffer {
         template <typename T> FORCEINLINE T* primaryAsT();
         template <typename T> FORCEINLINE T* specialAsT();
 
+        // these methods only check if buffers are set, so unlike primary() and special() they don't count as access
+        FORCEINLINE bool hasPrimary() const;
+        FORCEINLINE bool hasSpecial() const;
+
         void syncToPrimary(const LaunchContext* context, const bool forceSync = false);
         void syncToSpecial(const bool forceSync = false);
 
@@ -134,19 +147,36 @@ class ND4J_EXPORT DataBuffer {
          * This method deletes buffers, if we're owners
          */
         void close();
+
+        /**
+         * These methods track access to buffers memory (primary, special or copying) made by calling thread,
+         * so it's known if i.e. shape function depends on values of input arrays, and not only on their shapes
+         */
+        static void resetAccessed();
+        static bool wasAccessed();
 };
 ///// IMLEMENTATION OF INLINE METHODS /////
 
 ////////////////////////////////////////////////////////////////////////
     template <typename T>
     T* DataBuffer::primaryAsT() {
-        return reinterpret_cast<T*>(_primaryBuffer);
+        return reinterpret_cast<T*>(primary());
     }
 
 ////////////////////////////////////////////////////////////////////////
     template <typename T>
     T* DataBuffer::specialAsT() {
-        return reinterpret_cast<T*>(_specialBuffer);
+        return reinterpret_cast<T*>(special());
+    }
+
+////////////////////////////////////////////////////////////////////////
+    bool DataBuffer::hasPrimary() const {
+        return _primaryBuffer != nullptr;
+    }
+
+////////////////////////////////////////////////////////////////////////
+    bool DataBuffer::hasSpecial() const {
+        return _specialBuffer != nullptr;
     }
 
 }
@@ -1632,9 +1632,9 @@ bool NDArray::nonNull() const {
         return true;
 
     if(!Environment::getInstance().isCPU())
-        return getDataBuffer()->special() != nullptr && specialShapeInfo() != nullptr;
+        return getDataBuffer()->hasSpecial() && specialShapeInfo() != nullptr;
 
-    return getDataBuffer()->primary() != nullptr && shapeInfo() != nullptr;
+    return getDataBuffer()->hasPrimary() && shapeInfo() != nullptr;
 }
 
 //////////////////////////////////////////////////////////////////////////
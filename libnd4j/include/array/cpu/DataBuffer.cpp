@@ -23,24 +23,28 @@
 
 #include <array/DataBuffer.h>
 #include <array/DataTypeUtils.h>
+#include <execution/Threads.h>
+#include <execution/ThreadPool.h>
+#include <system/Environment.h>
 
 namespace sd {
     void DataBuffer::expand(const uint64_t size) {
         if (size > _lenInBytes) {
             // allocate new buffer
-            int8_t *newBuffer = nullptr;
-            ALLOCATE(newBuffer, _workspace, size, int8_t);
+            size_t pooledBytes = 0;
+            int8_t *newBuffer = allocateHostBytes(size, pooledBytes);
 
             // copy data from existing buffer
             std::memcpy(newBuffer, _primaryBuffer, _lenInBytes);
 
             if (_isOwnerPrimary) {
-                RELEASE(reinterpret_cast<int8_t *>(_primaryBuffer), _workspace);
+                releaseHostBytes(_primaryBuffer, _pooledPrimaryBytes);
             }
 
             _primaryBuffer = newBuffer;
             _lenInBytes = size;
             _isOwnerPrimary = true;
+            _pooledPrimaryBytes = pooledBytes;
         }
     }
 
@@ -57,6 +61,19 @@ void DataBuffer::copyCounters(const DataBuffer& other) {
 void DataBuffer::allocateBuffers(const bool allocBoth) {    // always allocate primary buffer only (cpu case)
 
     allocatePrimary();
+
+    // pages are placed on the node of the thread that touches them first, so we touch them with the same split parallel loops use later
+    if (_workspace == nullptr && _isOwnerPrimary && Environment::getInstance().isNumaAware() && (Nd4jLong) getLenInBytes() >= Environment::getInstance().numaFirstTouchThreshold()) {
+        if (samediff::ThreadPool::getInstance().numberOfNodes() > 1) {
+            auto buffer = reinterpret_cast<int8_t *>(_primaryBuffer);
+
+            auto func = PRAGMA_THREADS_FOR {
+                std::memset(buffer + start, 0, stop - start);
+            };
+
+            samediff::Threads::parallel_tad(func, 0, getLenInBytes(), 1, Environment::getInstance().maxThreads());
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -67,6 +84,8 @@ void DataBuffer::copyBufferFrom(const DataBuffer& other, size_t sizeToCopyinByte
     if(sizeToCopyinBytes == 0)
         return;
 
+    markAccessed();
+
     if(other._primaryBuffer != nullptr)
         std::memcpy(static_cast<int8_t*>(_primaryBuffer) + offsetThis * DataTypeUtils::sizeOfElement(_dataType), static_cast<const int8_t*>(other._primaryBuffer) + offsetOther * DataTypeUtils::sizeOfElement(other._dataType), sizeToCopyinBytes);
 }
@@ -125,6 +144,8 @@ void DataBuffer::memcpy(const DataBuffer &dst, const DataBuffer &src) {
     if (src._lenInBytes > dst._lenInBytes)
         throw std::runtime_error("DataBuffer::memcpy: Source data buffer is larger than destination");
 
+    markAccessed();
+
     std::memcpy(dst._primaryBuffer, src._primaryBuffer, src._lenInBytes);
     dst.readPrimary();
 }
@@ -40,16 +40,17 @@ namespace sd {
             // copy data from existing buffer
             if (_primaryBuffer != nullptr) {
                 // there's non-zero chance that primary buffer doesn't exist yet
-                ALLOCATE(newBuffer, _workspace, size, int8_t);
+                size_t pooledBytes = 0;
+                newBuffer = allocateHostBytes(size, pooledBytes);
                 std::memcpy(newBuffer, _primaryBuffer, _lenInBytes);
 
                 if (_isOwnerPrimary) {
-                    auto ipb = reinterpret_cast<int8_t *>(_primaryBuffer);
-                    RELEASE(ipb, _workspace);
+                    releaseHostBytes(_primaryBuffer, _pooledPrimaryBytes);
                 }
 
                 _primaryBuffer = newBuffer;
                 _isOwnerPrimary = true;
+                _pooledPrimaryBytes = pooledBytes;
             }
 
             cudaMemcpy(newSpecialBuffer, _specialBuffer, _lenInBytes, cudaMemcpyDeviceToDevice);
@@ -170,6 +171,8 @@ void DataBuffer::copyBufferFrom(const DataBuffer& other, size_t sizeToCopyinByte
     if(other._primaryBuffer == nullptr && other._specialBuffer == nullptr)
         return;
 
+    markAccessed();
+
     if(sizeToCopyinBytes == 0)
         sizeToCopyinBytes = other.getLenInBytes();
     if(sizeToCopyinBytes == 0)
@@ -247,6 +250,7 @@ void DataBuffer::memcpy(const DataBuffer &dst, const DataBuffer &src) {
     if (src._lenInBytes > dst._lenInBytes)
         throw std::runtime_error("DataBuffer::memcpy: Source data buffer is larger than destination");
 
+    markAccessed();
 
     int res = 0;
     if (src.isSpecialActual()) {
@@ -26,11 +26,17 @@
 #include <array/DataTypeUtils.h>
 #include <execution/AffinityManager.h>
 #include <memory/MemoryCounter.h>
+#include <memory/MemoryTracker.h>
+#include <memory/PooledAllocator.h>
+#include <system/Environment.h>
 #include <exceptions/allocation_exception.h>
 
 namespace sd {
     ///// IMLEMENTATION OF COMMON METHODS /////
 
+    // set whenever calling thread gets access to memory of any buffer
+    static thread_local bool accessed = false;
+
 
 ////////////////////////////////////////////////////////////////////////
 // default constructor
@@ -157,12 +163,14 @@ namespace sd {
         _workspace      = other._workspace;
         _isOwnerPrimary = other._isOwnerPrimary;
         _isOwnerSpecial = other._isOwnerSpecial;
+        _pooledPrimaryBytes = other._pooledPrimaryBytes;
         _deviceId.store(other._deviceId);
 
         copyCounters(other);
 
         other._primaryBuffer = other._specialBuffer = nullptr;
         other.setAllocFlags(false, false);
+        other._pooledPrimaryBytes = 0;
         other._lenInBytes = 0;
     }
 
@@ -201,11 +209,13 @@ namespace sd {
         _workspace      = other._workspace;
         _isOwnerPrimary = other._isOwnerPrimary;
         _isOwnerSpecial = other._isOwnerSpecial;
+        _pooledPrimaryBytes = other._pooledPrimaryBytes;
 
         copyCounters(other);
 
         other._primaryBuffer = other._specialBuffer = nullptr;
         other.setAllocFlags(false, false);
+        other._pooledPrimaryBytes = 0;
         other._lenInBytes = 0;
 
         return *this;
@@ -213,14 +223,31 @@ namespace sd {
 
 ////////////////////////////////////////////////////////////////////////
     void* DataBuffer::primary() {
+        accessed = true;
         return _primaryBuffer;
     }
 
 ////////////////////////////////////////////////////////////////////////
     void* DataBuffer::special() {
+        accessed = true;
         return _specialBuffer;
     }
 
+////////////////////////////////////////////////////////////////////////
+    void DataBuffer::markAccessed() {
+        accessed = true;
+    }
+
+////////////////////////////////////////////////////////////////////////
+    void DataBuffer::resetAccessed() {
+        accessed = false;
+    }
+
+////////////////////////////////////////////////////////////////////////
+    bool DataBuffer::wasAccessed() {
+        return accessed;
+    }
+
 ////////////////////////////////////////////////////////////////////////
     DataType DataBuffer::getDataType() {
         return _dataType;
@@ -250,7 +277,7 @@ namespace sd {
                 }
             }
 
-            ALLOCATE(_primaryBuffer, _workspace, getLenInBytes(), int8_t);
+            _primaryBuffer = allocateHostBytes(getLenInBytes(), _pooledPrimaryBytes);
             _isOwnerPrimary = true;
 
             // count in towards current deviceId if we're not in workspace mode
@@ -263,6 +290,39 @@ namespace sd {
         }
     }
 
+////////////////////////////////////////////////////////////////////////
+    int8_t* DataBuffer::allocateHostBytes(const size_t numBytes, size_t &pooledBytes) {
+
+        int8_t* buffer = nullptr;
+        pooledBytes = numBytes > 0 && _workspace == nullptr && Environment::getInstance().isPooledAllocation() ? numBytes : 0;
+
+        if (pooledBytes > 0) {
+            buffer = reinterpret_cast<int8_t*>(sd::memory::PooledAllocator::getInstance().allocate(numBytes));
+            std::memset(buffer, 0, numBytes);
+#if	!defined(_RELEASE)
+            sd::memory::MemoryTracker::getInstance().countIn(sd::memory::MemoryType::HOST, buffer, numBytes);
+#endif
+        } else {
+            ALLOCATE(buffer, _workspace, numBytes, int8_t);
+        }
+
+        return buffer;
+    }
+
+////////////////////////////////////////////////////////////////////////
+    void DataBuffer::releaseHostBytes(void* buffer, const size_t pooledBytes) {
+
+        if (pooledBytes > 0) {
+#if	!defined(_RELEASE)
+            sd::memory::MemoryTracker::getInstance().countOut(buffer);
+#endif
+            sd::memory::PooledAllocator::getInstance().release(buffer, pooledBytes);
+        } else {
+            auto p = reinterpret_cast<int8_t*>(buffer);
+            RELEASE(p, _workspace);
+        }
+    }
+
 ////////////////////////////////////////////////////////////////////////
     void DataBuffer::setAllocFlags(const bool isOwnerPrimary, const bool isOwnerSpecial) {
         _isOwnerPrimary = isOwnerPrimary;
@@ -272,11 +332,11 @@ namespace sd {
 ////////////////////////////////////////////////////////////////////////
     void DataBuffer::deletePrimary() {
 
-        if(_isOwnerPrimary && _primaryBuffer != nullptr && getLenInBytes() != 0) {
-            auto p = reinterpret_cast<int8_t*>(_primaryBuffer);
-            RELEASE(p, _workspace);
+        if(_isOwnerPrimary && _primaryBuffer != nullptr && (getLenInBytes() != 0 || _pooledPrimaryBytes != 0)) {
+            releaseHostBytes(_primaryBuffer, _pooledPrimaryBytes);
             _primaryBuffer = nullptr;
             _isOwnerPrimary = false;
+            _pooledPrimaryBytes = 0;
 
 
             // count out towards DataBuffer device, only if we're not in workspace
@@ -310,6 +370,7 @@ namespace sd {
 
         _primaryBuffer = buffer;
         _isOwnerPrimary = false;
+        _pooledPrimaryBytes = 0;
         _lenInBytes = length * DataTypeUtils::sizeOf(_dataType);
     }
 
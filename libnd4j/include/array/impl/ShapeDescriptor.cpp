@@ -469,8 +469,8 @@ namespace std {
         res ^= k.dataType() + 0x9e3779b9 + (res << 6) + (res >> 2);
         res ^= std::hash<int>()(k.rank()) + 0x9e3779b9 + (res << 6) + (res >> 2);
         res ^= std::hash<Nd4jLong>()(k.ews()) + 0x9e3779b9 + (res << 6) + (res >> 2);
-        auto shapes = const_cast<sd::ShapeDescriptor&>(k).shape();
-        auto strides = const_cast<sd::ShapeDescriptor&>(k).strides();
+        auto &shapes = const_cast<sd::ShapeDescriptor&>(k).shape();
+        auto &strides = const_cast<sd::ShapeDescriptor&>(k).strides();
         for (auto s: shapes) {
             res ^= std::hash<Nd4jLong>()(s) + 0x9e3779b9 + (res << 6) + (res >> 2);
         }
@@ -0,0 +1,67 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SAMEDIFF_NUMATOPOLOGY_H
+#define SAMEDIFF_NUMATOPOLOGY_H
+
+#include <system/dll.h>
+#include <vector>
+#include <string>
+#include <thread>
+
+namespace samediff {
+    /**
+     * This class describes NUMA layout of the host: which CPUs belong to which memory node.
+     * On Linux topology is read from sysfs, and only CPUs from affinity mask of the process are taken into account.
+     * Everywhere else (or if sysfs isn't available) host is treated as a single node.
+     */
+    class ND4J_EXPORT NumaTopology {
+    private:
+        // CPUs per node, nodes without CPUs are skipped
+        std::vector<std::vector<int>> _cpus;
+
+        NumaTopology();
+    public:
+        static NumaTopology& getInstance();
+
+        int numberOfNodes() const;
+
+        /**
+         * This method returns list of CPUs that belong to the given node
+         */
+        const std::vector<int>& cpusOfNode(int node) const;
+
+        /**
+         * This method returns node the given CPU belongs to, or 0 if CPU is unknown
+         */
+        int nodeOfCpu(int cpu) const;
+
+        /**
+         * This method restricts given thread to CPUs of the given node
+         * @return true if affinity was set, false otherwise
+         */
+        bool bindToNode(std::thread &thread, int node) const;
+
+        /**
+         * This method parses sysfs cpulist format, i.e. "0-3,8,10-11"
+         */
+        static std::vector<int> parseCpuList(const std::string &list);
+    };
+}
+
+#endif //SAMEDIFF_NUMATOPOLOGY_H
@@ -0,0 +1,35 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_SCHEDULE_H
+#define SD_SCHEDULE_H
+
+namespace samediff {
+    /**
+     * Defines how loop iterations are distributed among threads:
+     * STATIC - one contiguous span per thread
+     * DYNAMIC - small chunks picked up by threads as they go, executed on work-stealing TaskScheduler.
+     *           functions used with this schedule can be invoked multiple times per thread_id, so they must not reset per-thread state
+     */
+    enum Schedule {
+        SCHEDULE_STATIC = 0,
+        SCHEDULE_DYNAMIC = 1,
+    };
+}
+
+#endif //SD_SCHEDULE_H
@@ -0,0 +1,110 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SAMEDIFF_TASKSCHEDULER_H
+#define SAMEDIFF_TASKSCHEDULER_H
+
+#include <system/dll.h>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <functional>
+#include <exception>
+
+namespace samediff {
+    /**
+     * This class tracks completion of tasks submitted to TaskScheduler
+     */
+    class ND4J_EXPORT TaskGroup {
+    private:
+        std::atomic<int64_t> _pending;
+        std::mutex _lock;
+        std::exception_ptr _exception;
+
+        friend class TaskScheduler;
+    public:
+        TaskGroup();
+        ~TaskGroup() = default;
+
+        bool finished() const;
+    };
+
+    /**
+     * Work-stealing scheduler: every participating thread owns a deque, pushes/pops its own tasks at the back,
+     * and steals from the front of other deques when it runs out of work. Threads without own deque use shared injection deque.
+     *
+     * Scheduler has no threads of its own, so it never oversubscribes cores on top of ThreadPool: tasks are executed by
+     * threads waiting for their groups, and by ThreadPool threads lent to the group via help().
+     * Thread waiting for a TaskGroup doesn't block, but executes pending tasks instead,
+     * so nested parallel regions never deadlock, and run serially only if no threads are available to help.
+     */
+    class ND4J_EXPORT TaskScheduler {
+    private:
+        struct Task {
+            std::function<void()> function;
+            TaskGroup *group;
+        };
+
+        struct WorkerQueue {
+            std::mutex lock;
+            std::deque<Task> tasks;
+
+            // mirrors tasks.size(), so thieves can skip empty queues without locking
+            std::atomic<int64_t> size{0};
+        };
+
+        // last queue is injection queue for threads that didn't get own queue
+        std::vector<WorkerQueue*> _queues;
+        std::atomic<int> _assigned;
+
+        TaskScheduler();
+        ~TaskScheduler() = default;
+
+        int currentQueue();
+        bool pop(int queue, Task &task);
+        bool steal(int self, Task &task);
+        void execute(Task &task);
+    public:
+        static TaskScheduler& getInstance();
+
+        /**
+         * This method schedules task for execution
+         * @param group
+         * @param function
+         */
+        void submit(TaskGroup &group, const std::function<void()> &function);
+
+        /**
+         * This method executes pending tasks until all tasks of the group are finished.
+         * Exceptions thrown by tasks are kept in the group, so ThreadPool threads can use it safely
+         * @param group
+         */
+        void help(TaskGroup &group);
+
+        /**
+         * This method executes pending tasks until all tasks of the group are finished.
+         * First exception thrown by group tasks is rethrown here
+         * @param group
+         */
+        void wait(TaskGroup &group);
+    };
+}
+
+#endif //SAMEDIFF_TASKSCHEDULER_H
@@ -44,6 +44,10 @@ namespace samediff {
         std::mutex _lock;
         std::atomic<int> _available;
         std::queue<Ticket*> _tickets;
+
+        // NUMA node of each thread, used only if pool was created in NUMA-aware mode
+        std::vector<int> _nodes;
+        int _numberOfNodes = 1;
     protected:
         ThreadPool();
         ~ThreadPool();
@@ -64,6 +68,17 @@ namespace samediff {
         void release(int num_threads = 1);
 
         void release(Ticket *ticket);
+
+        /**
+         * This method returns number of NUMA nodes threads are spread over, 1 if pool isn't NUMA-aware
+         */
+        int numberOfNodes() const;
+
+        /**
+         * This method returns NUMA node that ticket slot is going to be executed on, for a ticket with given number of threads
+         * Slots are mapped to nodes proportionally, so contiguous chunks of a range land on the same nodes as they were first touched on
+         */
+        static int nodeForSlot(int slot, int numThreads, int numberOfNodes);
     };
 }
 
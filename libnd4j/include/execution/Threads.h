@@ -27,6 +27,7 @@
 #include <system/op_boilerplate.h>
 #include <system/Environment.h>
 #include <system/op_enums.h>
+#include <execution/Schedule.h>
 
 namespace samediff {
     class ND4J_EXPORT ThreadsHelper {
@@ -123,6 +124,26 @@ namespace samediff {
          */
         static int parallel_tad(FUNC_1D function, int64_t start, int64_t stop, int64_t increment = 1, uint32_t numThreads = sd::Environment::getInstance().maxMasterThreads());
 
+        /**
+         * These functions execute 1 dimensional loop with given schedule.
+         * SCHEDULE_DYNAMIC is meant for loops with unbalanced iterations: work is split into small chunks, and idle threads
+         * pick them up from work-stealing TaskScheduler. Nested calls are supported, waiting thread executes pending chunks.
+         * If dynamic scheduling is disabled via Environment, static split is used instead.
+         *
+         * PLEASE NOTE: with SCHEDULE_DYNAMIC function can be called multiple times with the same thread_id,
+         * but never concurrently, so per-thread accumulators are fine as long as they aren't reset within function.
+         *
+         * @param function
+         * @param start
+         * @param stop
+         * @param increment
+         * @param numThreads
+         * @param schedule
+         * @return
+         */
+        static int parallel_for(FUNC_1D function, int64_t start, int64_t stop, int64_t increment, uint32_t numThreads, Schedule schedule);
+        static int parallel_tad(FUNC_1D function, int64_t start, int64_t stop, int64_t increment, uint32_t numThreads, Schedule schedule);
+
         /**
          * This method will execute function splitting 2 nested loops space with multiple threads
          *
@@ -0,0 +1,134 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <execution/NumaTopology.h>
+#include <helpers/logger.h>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cctype>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace samediff {
+    NumaTopology::NumaTopology() {
+#if defined(__linux__)
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        bool hasMask = sched_getaffinity(0, sizeof(cpu_set_t), &allowed) == 0;
+
+        std::vector<int> nodes;
+        auto dir = opendir("/sys/devices/system/node");
+        if (dir != nullptr) {
+            struct dirent *entry;
+            while ((entry = readdir(dir)) != nullptr) {
+                std::string name(entry->d_name);
+                if (name.size() > 4 && name.compare(0, 4, "node") == 0 && std::all_of(name.begin() + 4, name.end(), ::isdigit))
+                    nodes.emplace_back(std::atoi(name.c_str() + 4));
+            }
+
+            closedir(dir);
+        }
+
+        std::sort(nodes.begin(), nodes.end());
+        for (auto node : nodes) {
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            std::string list;
+            if (!file.good() || !std::getline(file, list))
+                continue;
+
+            std::vector<int> cpus;
+            for (auto cpu : parseCpuList(list))
+                if (!hasMask || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)))
+                    cpus.emplace_back(cpu);
+
+            // memory-only nodes and nodes we're not allowed to run on are useless for us
+            if (!cpus.empty())
+                _cpus.emplace_back(cpus);
+        }
+#endif
+
+        if (_cpus.empty()) {
+            std::vector<int> cpus(std::max<unsigned int>(1, std::thread::hardware_concurrency()));
+            for (int e = 0; e < cpus.size(); e++)
+                cpus[e] = e;
+
+            _cpus.emplace_back(cpus);
+        }
+
+        nd4j_debug("NumaTopology: %i node(s) detected\n", (int) _cpus.size());
+    }
+
+    NumaTopology& NumaTopology::getInstance() {
+        static NumaTopology instance;
+        return instance;
+    }
+
+    int NumaTopology::numberOfNodes() const {
+        return (int) _cpus.size();
+    }
+
+    const std::vector<int>& NumaTopology::cpusOfNode(int node) const {
+        return _cpus[node % _cpus.size()];
+    }
+
+    int NumaTopology::nodeOfCpu(int cpu) const {
+        for (int e = 0; e < _cpus.size(); e++)
+            if (std::find(_cpus[e].begin(), _cpus[e].end(), cpu) != _cpus[e].end())
+                return e;
+
+        return 0;
+    }
+
+    bool NumaTopology::bindToNode(std::thread &thread, int node) const {
+#if defined(__linux__)
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        for (auto cpu : cpusOfNode(node))
+            if (cpu < CPU_SETSIZE)
+                CPU_SET(cpu, &cpuset);
+
+        return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuset) == 0;
+#else
+        return false;
+#endif
+    }
+
+    std::vector<int> NumaTopology::parseCpuList(const std::string &list) {
+        std::vector<int> result;
+        std::stringstream stream(list);
+        std::string token;
+        while (std::getline(stream, token, ',')) {
+            if (token.empty() || !::isdigit(token[0]))
+                continue;
+
+            auto dash = token.find('-');
+            int first = std::atoi(token.c_str());
+            int last = dash == std::string::npos ? first : std::atoi(token.c_str() + dash + 1);
+            for (int cpu = first; cpu <= last; cpu++)
+                result.emplace_back(cpu);
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,138 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <execution/TaskScheduler.h>
+#include <system/Environment.h>
+
+namespace samediff {
+    // index of the queue owned by current thread, -1 until thread uses scheduler for the first time
+    static thread_local int workerQueue = -1;
+
+    TaskGroup::TaskGroup() : _pending(0) {
+        //
+    }
+
+    bool TaskGroup::finished() const {
+        return _pending.load() == 0;
+    }
+
+    TaskScheduler::TaskScheduler() : _assigned(0) {
+        // one queue per possible ThreadPool thread, plus caller, plus injection queue
+        auto numQueues = sd::Environment::getInstance().maxThreads() + 2;
+        for (int e = 0; e < numQueues; e++)
+            _queues.emplace_back(new WorkerQueue());
+    }
+
+    TaskScheduler& TaskScheduler::getInstance() {
+        // never destroyed, since threads of ThreadPool might outlive static destructors
+        static auto instance = new TaskScheduler();
+        return *instance;
+    }
+
+    int TaskScheduler::currentQueue() {
+        const int injection = static_cast<int>(_queues.size()) - 1;
+
+        // queues are assigned to threads on their first use, threads that came late share injection queue
+        if (workerQueue < 0) {
+            auto id = _assigned++;
+            workerQueue = id < injection ? id : injection;
+        }
+
+        return workerQueue;
+    }
+
+    bool TaskScheduler::pop(int queue, Task &task) {
+        auto q = _queues[queue];
+        if (q->size.load() == 0)
+            return false;
+
+        std::lock_guard<std::mutex> lock(q->lock);
+        if (q->tasks.empty())
+            return false;
+
+        task = std::move(q->tasks.back());
+        q->tasks.pop_back();
+        q->size--;
+        return true;
+    }
+
+    bool TaskScheduler::steal(int self, Task &task) {
+        const int numQueues = static_cast<int>(_queues.size());
+        for (int e = 1; e <= numQueues; e++) {
+            auto q = _queues[(self + e) % numQueues];
+
+            // cheap check without lock first
+            if (q->size.load() == 0)
+                continue;
+
+            std::lock_guard<std::mutex> lock(q->lock);
+            if (q->tasks.empty())
+                continue;
+
+            task = std::move(q->tasks.front());
+            q->tasks.pop_front();
+            q->size--;
+            return true;
+        }
+
+        return false;
+    }
+
+    void TaskScheduler::execute(Task &task) {
+        auto group = task.group;
+        try {
+            task.function();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(group->_lock);
+            if (!group->_exception)
+                group->_exception = std::current_exception();
+        }
+
+        group->_pending--;
+    }
+
+    void TaskScheduler::submit(TaskGroup &group, const std::function<void()> &function) {
+        group._pending++;
+
+        auto q = _queues[currentQueue()];
+        {
+            std::lock_guard<std::mutex> lock(q->lock);
+            q->tasks.emplace_back(Task{function, &group});
+            q->size++;
+        }
+    }
+
+    void TaskScheduler::help(TaskGroup &group) {
+        const auto self = currentQueue();
+
+        Task task;
+        while (!group.finished()) {
+            if (pop(self, task) || steal(self, task))
+                execute(task);
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    void TaskScheduler::wait(TaskGroup &group) {
+        help(group);
+
+        if (group._exception)
+            std::rethrow_exception(group._exception);
+    }
+}
@@ -21,6 +21,7 @@
 //
 
 #include <execution/ThreadPool.h>
+#include <execution/NumaTopology.h>
 #include <stdexcept>
 #include <helpers/logger.h>
 
@@ -78,13 +79,22 @@ namespace samediff {
     }
 
     ThreadPool::ThreadPool() {
-        // TODO: number of threads must reflect number of cores for UMA system. In case of NUMA it should be per-device pool
         // FIXME: on mobile phones this feature must NOT be used
         _available = sd::Environment::getInstance().maxThreads();
 
         _queues.resize(_available.load());
         _threads.resize(_available.load());
         _interfaces.resize(_available.load());
+        _nodes.resize(_available.load(), 0);
+
+        // in NUMA-aware mode we have one group of threads per node, sized proportionally to number of CPUs on the node
+        auto &topology = NumaTopology::getInstance();
+        std::vector<int> cpuNodes;
+        if (sd::Environment::getInstance().isNumaAware() && topology.numberOfNodes() > 1) {
+            _numberOfNodes = topology.numberOfNodes();
+            for (int n = 0; n < _numberOfNodes; n++)
+                cpuNodes.insert(cpuNodes.end(), topology.cpusOfNode(n).size(), n);
+        }
 
         // creating threads here
         for (int e = 0; e < _available.load(); e++) {
@@ -94,28 +104,24 @@ namespace samediff {
             _tickets.push(new Ticket());
             // _threads[e] = new std::thread(executionLoop_, e, _queues[e]);
 
-            // TODO: add other platforms here as well
-            // now we must set affinity, and it's going to be platform-specific thing
-#ifdef LINUX_BUILD
-            cpu_set_t cpuset;
-            CPU_ZERO(&cpuset);
-            CPU_SET(e, &cpuset);
-            int rc = pthread_setaffinity_np(_threads[e]->native_handle(), sizeof(cpu_set_t), &cpuset);
-            if (rc != 0)
-                throw std::runtime_error("Failed to set pthread affinity");
-#endif
+            // threads are bound to the whole node rather than to a single core, so OS can still balance them within the node
+            if (_numberOfNodes > 1) {
+                _nodes[e] = cpuNodes[(int64_t) e * cpuNodes.size() / _available.load()];
+                if (!topology.bindToNode(_threads[e], _nodes[e]))
+                    nd4j_debug("ThreadPool: failed to bind thread %i to NUMA node %i\n", e, _nodes[e]);
+            }
             /*
 #if defined(_WIN32) || defined(_WIN64)
             // we can't set affinity to more than 64 cores
             if (e <= 64) {
                 auto mask = (static_cast<DWORD_PTR>(1) << e);
-                auto result = SetThreadAffinityMask(_threads[e]->native_handle(), mask);
+                auto result = SetThreadAffinityMask(_threads[e].native_handle(), mask);
                 if (!result)
                     throw std::runtime_error("Failed to set pthread affinity");
             }
 
             // that's fine. no need for time_critical here
-            SetThreadPriority(_threads[e]->native_handle(), THREAD_PRIORITY_HIGHEST);
+            SetThreadPriority(_threads[e].native_handle(), THREAD_PRIORITY_HIGHEST);
 #endif
              */
         }
@@ -170,10 +176,31 @@ namespace samediff {
                 t->acquiredThreads(numThreads);
 
                 // filling ticket with executable interfaces
-                for (int e = 0, i = 0; e < _queues.size() && i < numThreads; e++) {
-                    if (_interfaces[e]->available()) {
-                        t->attach(i++, _interfaces[e]);
-                        _interfaces[e]->markUnavailable();
+                if (_numberOfNodes > 1) {
+                    // each slot prefers thread from its own node, and takes any available thread otherwise
+                    for (int i = 0; i < numThreads; i++) {
+                        auto node = nodeForSlot(i, numThreads, _numberOfNodes);
+                        int picked = -1;
+                        for (int e = 0; e < _queues.size(); e++) {
+                            if (_interfaces[e]->available() && (picked < 0 || _nodes[e] == node)) {
+                                picked = e;
+                                if (_nodes[e] == node)
+                                    break;
+                            }
+                        }
+
+                        if (picked < 0)
+                            break;
+
+                        t->attach(i, _interfaces[picked]);
+                        _interfaces[picked]->markUnavailable();
+                    }
+                } else {
+                    for (int e = 0, i = 0; e < _queues.size() && i < numThreads; e++) {
+                        if (_interfaces[e]->available()) {
+                            t->attach(i++, _interfaces[e]);
+                            _interfaces[e]->markUnavailable();
+                        }
                     }
                 }
             }
@@ -193,4 +220,15 @@ namespace samediff {
         std::unique_lock<std::mutex> lock(_lock);
         _tickets.push(ticket);
     }
+
+    int ThreadPool::numberOfNodes() const {
+        return _numberOfNodes;
+    }
+
+    int ThreadPool::nodeForSlot(int slot, int numThreads, int numberOfNodes) {
+        if (numberOfNodes <= 1 || numThreads <= 1)
+            return 0;
+
+        return (int) ((int64_t) slot * numberOfNodes / numThreads);
+    }
 }
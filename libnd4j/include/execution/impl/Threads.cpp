@@ -21,6 +21,7 @@
 //
 #include <execution/Threads.h>
 #include <execution/ThreadPool.h>
+#include <execution/TaskScheduler.h>
 #include <vector>
 #include <thread>
 #include <helpers/logger.h>
@@ -409,6 +410,106 @@ namespace samediff {
         return parallel_tad(function, start, stop, increment, numThreads);
     }
 
+    // every lane grabs chunks from shared counter until there's nothing left, so fast lanes take over work of slow ones
+    static int parallelDynamic_(FUNC_1D &function, int64_t start, int64_t stop, int64_t increment, uint32_t numThreads) {
+        auto &scheduler = TaskScheduler::getInstance();
+
+        const int64_t iterations = (stop - start + increment - 1) / increment;
+        const int64_t numLanes = sd::math::nd4j_min<int64_t>(iterations, sd::math::nd4j_min<int64_t>(numThreads, sd::Environment::getInstance().maxThreads()));
+        if (numLanes <= 1) {
+            function(0, start, stop, increment);
+            return 1;
+        }
+
+        // a few chunks per lane is enough to even out imbalance, while keeping scheduling overhead low
+        const int64_t numChunks = sd::math::nd4j_min<int64_t>(iterations, numLanes * 8);
+        const int64_t chunk = (iterations + numChunks - 1) / numChunks;
+
+        std::atomic<int64_t> next(0);
+        auto lane = [&] (uint64_t laneId) -> void {
+            try {
+                int64_t c;
+                while ((c = next++) * chunk < iterations) {
+                    auto s = start + c * chunk * increment;
+                    auto e = sd::math::nd4j_min<int64_t>(stop, s + chunk * increment);
+                    function(laneId, s, e, increment);
+                }
+            } catch (...) {
+                // there's no point in processing the rest of the range
+                next.store(numChunks);
+                throw;
+            }
+        };
+
+        TaskGroup group;
+        for (int64_t e = 1; e < numLanes; e++)
+            scheduler.submit(group, [&lane, e] () { lane(e); });
+
+        // lanes are executed by ThreadPool threads, so there are never more threads than pool has.
+        // if pool is busy, i.e. within nested call, current thread executes all lanes
+        const int numHelpers = static_cast<int>(numLanes - 1);
+        auto ticket = ThreadPool::getInstance().tryAcquire(numHelpers);
+        if (ticket != nullptr) {
+            for (int e = 0; e < numHelpers; e++)
+                ticket->enqueue(e, numHelpers, [&scheduler, &group] (uint64_t, uint64_t) { scheduler.help(group); });
+        }
+
+        // current thread is lane 0. queued tasks refer to this frame, so we must wait for them even if lane 0 fails
+        std::exception_ptr exception;
+        try {
+            lane(0);
+        } catch (...) {
+            exception = std::current_exception();
+        }
+
+        try {
+            scheduler.wait(group);
+        } catch (...) {
+            if (!exception)
+                exception = std::current_exception();
+        }
+
+        if (ticket != nullptr)
+            ticket->waitAndRelease();
+
+        if (exception)
+            std::rethrow_exception(exception);
+
+        return numLanes;
+    }
+
+    int Threads::parallel_tad(FUNC_1D function, int64_t start, int64_t stop, int64_t increment, uint32_t numThreads, Schedule schedule) {
+        if (schedule == SCHEDULE_STATIC || !sd::Environment::getInstance().dynamicSchedulingAllowed())
+            return parallel_tad(function, start, stop, increment, numThreads);
+
+        if (start > stop)
+            throw std::runtime_error("Threads::parallel_tad got start > stop");
+
+        if (start == stop || numThreads <= 1) {
+            function(0, start, stop, increment);
+            return 1;
+        }
+
+        return parallelDynamic_(function, start, stop, increment, numThreads);
+    }
+
+    int Threads::parallel_for(FUNC_1D function, int64_t start, int64_t stop, int64_t increment, uint32_t numThreads, Schedule schedule) {
+        if (schedule == SCHEDULE_STATIC || !sd::Environment::getInstance().dynamicSchedulingAllowed())
+            return parallel_for(function, start, stop, increment, numThreads);
+
+        if (start > stop)
+            throw std::runtime_error("Threads::parallel_for got start > stop");
+
+        auto delta = (stop - start);
+        if (delta == 0 || numThreads == 1) {
+            function(0, start, stop, increment);
+            return 1;
+        }
+
+        numThreads = ThreadsHelper::numberOfThreads(numThreads, delta / increment);
+        return parallel_tad(function, start, stop, increment, numThreads, schedule);
+    }
+
     int Threads::parallel_for(FUNC_2D function, int64_t startX, int64_t stopX, int64_t incX, int64_t startY, int64_t stopY, int64_t incY, uint64_t numThreads, bool debug) {
         if (startX > stopX)
             throw std::runtime_error("Threads::parallel_for got startX > stopX");
@@ -28,6 +28,8 @@
 #include <graph/generated/array_generated.h>
 #include <graph/generated/node_generated.h>
 #include <array/NDArray.h>
+#include <helpers/MappedFile.h>
+#include <memory>
 
 namespace sd {
     namespace graph {
@@ -37,7 +39,12 @@ namespace sd {
 
             static std::pair<Nd4jLong, Nd4jLong> fromLongPair(LongPair* pair);
 
-            static NDArray* fromFlatArray(const sd::graph::FlatArray* flatArray);
+            /**
+             * This method restores NDArray from FlatArray.
+             * If FlatArray lives within given mapped file, and its buffer has native byte order and proper alignment,
+             * NDArray is a view of the file, and it keeps the file mapped. Otherwise buffer is copied
+             */
+            static NDArray* fromFlatArray(const sd::graph::FlatArray* flatArray, const std::shared_ptr<MappedFile> &mappedFile = nullptr);
 
             static flatbuffers::Offset<FlatArray> toFlatArray(flatbuffers::FlatBufferBuilder &builder, NDArray &array);
         };
@@ -80,6 +80,11 @@ namespace sd {
             void incrementNumberOfCycles(Nd4jLong frameId);
             Nd4jLong getNumberOfCycles(Nd4jLong frameId);
 
+            /**
+             * This method brings all node states back to defaults and forgets frames, so FlowPath can be reused for the next run
+             */
+            void reset();
+
             GraphProfile* profile();
         };
     }
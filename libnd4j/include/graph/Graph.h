@@ -38,6 +38,8 @@
 #include <graph/generated/config_generated.h>
 #include <graph/ExecutorConfiguration.h>
 #include <ops/declarable/OpDescriptor.h>
+#include <helpers/MappedFile.h>
+#include <memory>
 
 namespace sd {
     namespace graph {
@@ -85,6 +87,13 @@ namespace sd {
         public:
             Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr);
 
+#ifndef __JAVACPP_HACK__
+            /**
+             * If flatGraph lives within mapped file, arrays that don't need conversion are views of that file
+             */
+            Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace, const std::shared_ptr<MappedFile> &mappedFile);
+#endif
+
             ~Graph();
 
             // this method applies toposort to nodes
@@ -122,6 +131,13 @@ namespace sd {
              */
             void addNode(sd::graph::Node *node);
 
+            /**
+             * This method removes given node from built graph and deletes it. Graph rewrites (i.e. op fusion) use it
+             *
+             * @param nodeId
+             */
+            void removeNode(int nodeId);
+
             /**
              * This method returns layered representation of the graph
              *
@@ -73,6 +73,12 @@ namespace sd {
 
         static Graph *importFromFlatBuffers(const char *filename);
 
+        /**
+         * This method maps given FlatBuffers file into memory instead of reading it. Arrays that don't need byte order conversion
+         * are views of mapped file then, so file stays mapped until all of them are released
+         */
+        static Graph *importFromMappedFlatBuffers(const char *filename);
+
         static Graph *importFromFlatPointer(Nd4jPointer ptr);
     };
 
@@ -25,8 +25,11 @@
 #include <unordered_map>
 #include <map>
 #include <graph/Graph.h>
+#include <graph/GraphSession.h>
 #include <helpers/SimpleReadWriteLock.h>
 #include <exceptions/unknown_graph_exception.h>
+#include <mutex>
+#include <vector>
 
 namespace sd {
     namespace graph {
@@ -36,6 +39,14 @@ namespace sd {
 
             MAP_IMPL<Nd4jLong, SimpleReadWriteLock> _locks;
 
+            // idle execution sessions of each graph, reused between requests
+            MAP_IMPL<Nd4jLong, std::vector<GraphSession*>> _sessions;
+            std::mutex _sessionsLock;
+
+            GraphSession* acquireSession(Nd4jLong graphId);
+            void releaseSession(Nd4jLong graphId, GraphSession *session);
+            void dropSessions(Nd4jLong graphId);
+
             GraphHolder() = default;
             ~GraphHolder() = default;
         public:
@@ -57,8 +68,17 @@ namespace sd {
 
             bool hasGraphAny(Nd4jLong graphId);
 
+            /**
+             * This method executes request against stored graph.
+             * Requests are executed within pooled sessions, so concurrent requests to the same graph don't clone it
+             */
             flatbuffers::Offset<FlatResult> execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
 
+            /**
+             * This method returns number of idle sessions pooled for given graph
+             */
+            int numberOfSessions(Nd4jLong graphId);
+
             void replaceGraph(Nd4jLong graphId, Graph *graph);
 
             /////////////////////////////
@@ -0,0 +1,67 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_GRAPHSESSION_H
+#define LIBND4J_GRAPHSESSION_H
+
+#include <graph/Graph.h>
+#include <graph/FlowPath.h>
+#include <graph/VariableProxy.h>
+#include <graph/generated/request_generated.h>
+#include <graph/generated/result_generated.h>
+#include <system/dll.h>
+
+namespace sd {
+    namespace graph {
+        /**
+         * This class holds per-request execution state of a Graph stored in GraphHolder:
+         * its own copy of nodes, VariableProxy on top of original VariableSpace, and FlowPath.
+         *
+         * All node outputs are shadowed in the proxy, so original Graph is never modified, and session can be reused for any number of requests.
+         * PLEASE NOTE: session can be used by one thread at a time
+         */
+        class ND4J_EXPORT GraphSession {
+        private:
+            Graph *_original;
+            Graph *_graph;
+            VariableProxy *_proxy;
+            FlowPath _flowPath;
+
+        public:
+            explicit GraphSession(Graph *original);
+            ~GraphSession();
+
+            GraphSession(const GraphSession &other) = delete;
+            GraphSession &operator=(const GraphSession &other) = delete;
+
+            Graph* graph();
+
+            /**
+             * This method returns Graph this session was created for
+             */
+            Graph* original();
+
+            /**
+             * This method executes request and packs its results into given builder
+             */
+            flatbuffers::Offset<FlatResult> execute(flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
+        };
+    }
+}
+
+#endif //LIBND4J_GRAPHSESSION_H
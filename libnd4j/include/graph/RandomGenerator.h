@@ -32,6 +32,7 @@
 #include <array/DataTypeUtils.h>
 #include <helpers/logger.h>
 #include <stdexcept>
+#include <type_traits>
 #include <math/templatemath.h>
 
 #ifdef __CUDACC__
@@ -123,6 +124,16 @@ namespace sd {
             FORCEINLINE _CUDA_HD int relativeInt(Nd4jLong index);
             FORCEINLINE _CUDA_HD Nd4jLong relativeLong(Nd4jLong index);
 
+            /**
+             * Batched versions of xoroshiro32 and relativeT: z[e] gets exactly the same value as call for index + e would return,
+             * so results don't depend on how indices are split between threads or blocks.
+             * Values are mixed in 32-bit lanes, which vectorizes well. relativeBlock is meant for floating point T
+             */
+            FORCEINLINE _CUDA_H void xoroshiro32Block(uint64_t index, Nd4jLong length, uint32_t *z);
+
+            template <typename T>
+            FORCEINLINE _CUDA_H void relativeBlock(Nd4jLong index, Nd4jLong length, T *z, T from, T to);
+
             FORCEINLINE _CUDA_HD void rewindH(uint64_t steps);
 
             /**
@@ -289,6 +300,50 @@ namespace sd {
             return upper + lower;
         }
 
+        FORCEINLINE void RandomGenerator::xoroshiro32Block(uint64_t index, Nd4jLong length, uint32_t *z) {
+            // only lower halves of states contribute to xoroshiro32 result, so 32-bit arithmetic gives the same values
+            const auto s0 = static_cast<uint32_t>(_rootState._ulong);
+            const auto s1 = static_cast<uint32_t>(_nodeState._ulong);
+            const auto first = static_cast<uint32_t>(index + 2);
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong e = 0; e < length; e++) {
+                const uint32_t i = first + static_cast<uint32_t>(e);
+                const uint32_t r0 = s0 | (i * (s1 + 24243287u));
+                const uint32_t r1 = s1 ^ (i * (r0 + 723829u));
+                const uint32_t v = (r0 ^ r1) * 0x9E3779BBu;
+
+                z[e] = ((v << 5) | (v >> 27)) * 5u;
+            }
+        }
+
+        template <typename T>
+        FORCEINLINE void RandomGenerator::relativeBlock(Nd4jLong index, Nd4jLong length, T *z, T from, T to) {
+#ifdef __DOUBLE_RNG__
+            // doubles are made of two 32-bit values there
+            if (std::is_same<T, double>::value) {
+                for (Nd4jLong e = 0; e < length; e++)
+                    z[e] = relativeT<T>(index + e, from, to);
+
+                return;
+            }
+#endif
+            uint32_t bits[256];
+
+            for (Nd4jLong b = 0; b < length; b += 256) {
+                const auto blockLength = sd::math::nd4j_min<Nd4jLong>(256, length - b);
+                xoroshiro32Block(index + b, blockLength, bits);
+
+                // same conversion as relativeT<float>, then relativeT<T>(index, from, to)
+                for (Nd4jLong e = 0; e < blockLength; e++) {
+                    u32 u;
+                    u._u32 = 0x3f800000 | (bits[e] >> 9);
+                    auto t = static_cast<T>(u._f32 - 1.0f);
+                    z[b + e] = from + T(t * (to - from));
+                }
+            }
+        }
+
         _CUDA_HD FORCEINLINE void RandomGenerator::rewindH(uint64_t steps) {
           // we only update node state, if any
           auto s0 = _nodeState._du32._v0;
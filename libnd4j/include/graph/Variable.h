@@ -27,6 +27,8 @@
 #include <array/NDArray.h>
 #include <array/NDArrayList.h>
 #include <graph/VariableType.h>
+#include <helpers/MappedFile.h>
+#include <memory>
 #include <graph/generated/array_generated.h>
 #include <graph/generated/node_generated.h>
 #include <graph/generated/graph_generated.h>
@@ -72,6 +74,9 @@ namespace sd {
             bool _placeholder = false;
             bool _removable = true;
 
+            // array of this variable is a view of MemoryPlanner arena
+            bool _planned = false;
+
             // for now we're setting default to numeric
             // in future we'll be fetching it right from the array, 
             //InputType _variableType = InputType_UNDEFINED;
@@ -87,7 +92,7 @@ namespace sd {
             Variable(sd::NDArray *array = nullptr, const char *name = nullptr);
 
 #ifndef __JAVACPP_HACK__
-            Variable(const sd::graph::FlatVariable *flatVariable);
+            Variable(const sd::graph::FlatVariable *flatVariable, const std::shared_ptr<MappedFile> &mappedFile = nullptr);
 #endif
 
             ~Variable();
@@ -109,6 +114,7 @@ namespace sd {
             bool isReadOnly();
             bool isEmpty();
             bool isRemovable();
+            bool isPlanned();
 
             bool isPlaceholder();
 
@@ -125,6 +131,7 @@ namespace sd {
             void markExternal(bool reallyExternal);
             void markReadOnly(bool reallyReadOnly);
             void markRemovable(bool reallyRemovable);
+            void markPlanned(bool reallyPlanned);
 
             int id();
             int index();
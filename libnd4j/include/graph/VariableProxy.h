@@ -65,6 +65,17 @@ namespace sd {
 
             virtual void replaceVariable(Variable *variable);
 
+            /**
+             * This method returns local Variable for given id:index, creating empty one if it doesn't exist yet.
+             * Writes to this Variable never reach backing VariableSpace
+             */
+            Variable* shadowVariable(int id, int idx);
+
+            /**
+             * This method returns Variables stored locally, i.e. everything that isn't taken from backing VariableSpace
+             */
+            std::vector<Variable*>* localVariables();
+
             virtual void dropVariable(std::pair<int,int> &pair);
             virtual void dropVariable(int id, int idx);
 
@@ -0,0 +1,57 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_DATAFLOWEXECUTOR_H
+#define LIBND4J_DATAFLOWEXECUTOR_H
+
+#include <system/pointercast.h>
+#include <graph/Node.h>
+#include <graph/Graph.h>
+#include <graph/VariableSpace.h>
+
+namespace sd {
+    namespace graph {
+        /**
+         * This class executes Graph as dataflow: every node keeps number of its unfinished dependencies,
+         * and node becomes ready for execution once all of them are finished.
+         * Ready nodes are picked by a number of inter-op workers, so independent branches of the graph are executed concurrently.
+         *
+         * Node activity (Switch/Merge branches) is tracked via FlowPath exactly like in layer-by-layer execution.
+         * Loop frames and scopes rely on rewinds of layer-by-layer execution, so graphs with them aren't supported here.
+         */
+        class ND4J_EXPORT DataflowExecutor {
+        public:
+            /**
+             * This method returns TRUE if given Graph can be executed by DataflowExecutor,
+             * and has at least 2 nodes that could be executed concurrently
+             */
+            static bool isApplicable(Graph *graph);
+
+            /**
+             * This method executes given Graph with up to numThreads concurrent nodes.
+             * Threads of each node are limited to maxMasterThreads / numThreads
+             */
+            static Nd4jStatus execute(Graph *graph, VariableSpace *variableSpace, int numThreads);
+
+        protected:
+            static Nd4jStatus processNode(Graph *graph, Node *node, VariableSpace *variableSpace);
+        };
+    }
+}
+
+#endif //LIBND4J_DATAFLOWEXECUTOR_H
@@ -0,0 +1,47 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_ELEMENTWISEFUSION_H
+#define LIBND4J_ELEMENTWISEFUSION_H
+
+#include <graph/Graph.h>
+#include <graph/Node.h>
+
+namespace sd {
+    namespace graph {
+        /**
+         * This class replaces chains of legacy elementwise ops (transform strict/same, scalar, pairwise) with single
+         * sd::ops::FusedElementwiseOp node, so chain is executed in one pass over memory.
+         *
+         * Node P is chained with node N if P output is the first input of N, N is the only consumer of P output,
+         * and P isn't graph output. Last node of the chain keeps its id, so graph outputs are kept intact.
+         */
+        class ND4J_EXPORT ElementwiseFusion {
+        protected:
+            static bool isFusable(Node *node);
+
+        public:
+            /**
+             * This method rewrites given built Graph in place, and returns number of removed nodes
+             */
+            static int apply(Graph *graph);
+        };
+    }
+}
+
+#endif //LIBND4J_ELEMENTWISEFUSION_H
@@ -0,0 +1,128 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_MEMORYPLANNER_H
+#define LIBND4J_MEMORYPLANNER_H
+
+#include <system/pointercast.h>
+#include <graph/Graph.h>
+#include <graph/Variable.h>
+#include <graph/VariableSpace.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sd {
+    namespace graph {
+        /**
+         * Single intermediate array of the plan: producer output, its lifetime in execution order, and its place in arena
+         */
+        struct ND4J_EXPORT PlannedTensor {
+            int id;
+            int idx;
+
+            // positions of producer and last consumer within execution order, both inclusive
+            int first;
+            int last;
+
+            Nd4jLong size;
+            Nd4jLong offset;
+
+            std::vector<Nd4jLong> shapeInfo;
+        };
+
+        /**
+         * This class holds offsets of graph intermediates within single arena.
+         * Arrays with overlapping lifetimes never overlap in arena, so arena is usually much smaller than sum of arrays
+         */
+        class ND4J_EXPORT MemoryPlan {
+        protected:
+            std::vector<PlannedTensor> _tensors;
+            Nd4jLong _arenaSize = 0;
+            Nd4jLong _totalSize = 0;
+
+        public:
+            explicit MemoryPlan(std::vector<PlannedTensor> &tensors);
+            ~MemoryPlan() = default;
+
+            /**
+             * This method allocates arena and puts its views into output variables which have no arrays yet.
+             * Returns variables which got planned arrays
+             */
+            std::vector<Variable*> bind(VariableSpace *variableSpace);
+
+            const std::vector<PlannedTensor>& tensors() const;
+
+            /**
+             * Size of arena in bytes
+             */
+            Nd4jLong arenaSize() const;
+
+            /**
+             * Sum of sizes of planned arrays in bytes, i.e. what dynamic allocation would take
+             */
+            Nd4jLong totalSize() const;
+        };
+
+        /**
+         * This class builds and caches memory plans of graphs executed layer-by-layer.
+         *
+         * Output shapes are taken from the first run for given input shapes, so data-dependent shapes are known as well.
+         * Plans are cached per graph structure and input shapes. If some output doesn't match its planned shape later,
+         * it's allocated dynamically, and plan is rebuilt after that run.
+         */
+        class ND4J_EXPORT MemoryPlanner {
+        protected:
+            std::map<std::string, std::shared_ptr<MemoryPlan>> _plans;
+            std::mutex _lock;
+
+            MemoryPlanner() = default;
+            ~MemoryPlanner() = default;
+
+        public:
+            static MemoryPlanner& getInstance();
+
+            /**
+             * This method returns TRUE if intermediates of given Graph can be planned:
+             * there are no scopes, logic ops or embedded graphs
+             */
+            static bool isApplicable(Graph *graph);
+
+            /**
+             * This method returns key of plan for given Graph and input arrays, or empty string if some input isn't available
+             */
+            static std::string signature(Graph *graph, VariableSpace *variableSpace);
+
+            /**
+             * This method builds plan out of arrays produced by the finished run, nullptr is returned if there's nothing to plan
+             */
+            static std::shared_ptr<MemoryPlan> build(Graph *graph, VariableSpace *variableSpace);
+
+            std::shared_ptr<MemoryPlan> plan(const std::string &signature);
+            void storePlan(const std::string &signature, std::shared_ptr<MemoryPlan> plan);
+            void forgetPlan(const std::string &signature);
+
+            int numberOfPlans();
+            void purge();
+        };
+    }
+}
+
+#endif //LIBND4J_MEMORYPLANNER_H
@@ -0,0 +1,235 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/execution/DataflowExecutor.h>
+#include <graph/execution/LogicExecutor.h>
+#include <graph/GraphExecutioner.h>
+#include <graph/FlowPath.h>
+#include <graph/Status.h>
+#include <execution/Threads.h>
+#include <system/Environment.h>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+
+namespace sd {
+    namespace graph {
+
+        // nodes in the order layer-by-layer execution would run them
+        static std::vector<Node*> nodesInOrder(Graph *graph) {
+            std::vector<Node*> nodes;
+            auto onion = graph->getOnion();
+            for (int l = 0; l < (int) onion->size(); l++) {
+                if (onion->count(l) == 0)
+                    continue;
+
+                for (auto node : *onion->at(l))
+                    nodes.emplace_back(node);
+            }
+
+            return nodes;
+        }
+
+        bool DataflowExecutor::isApplicable(Graph *graph) {
+            if (!graph->scopes()->empty())
+                return false;
+
+            bool wide = false;
+            auto onion = graph->getOnion();
+            for (auto &layer : *onion) {
+                for (auto node : *layer.second) {
+                    if (node->opType() == OpType_LOGIC && node->opNum() != sd::logic::Switch && node->opNum() != sd::logic::Merge)
+                        return false;
+                }
+
+                wide |= layer.second->size() > 1;
+            }
+
+            return wide;
+        }
+
+        Nd4jStatus DataflowExecutor::processNode(Graph *graph, Node *node, VariableSpace *variableSpace) {
+            auto flowPath = variableSpace->flowPath();
+
+            // same activity rules as layer-by-layer execution
+            if (node->opType() == OpType_LOGIC && node->opNum() == sd::logic::Merge) {
+                // Merge node can be skipped only both inputs are inactive
+                if (!flowPath->isNodeActive(node->input()->at(0).first) && !flowPath->isNodeActive(node->input()->at(1).first))
+                    return Status::OK();
+            } else {
+                for (int e = 0; e < (int) node->input()->size(); e++) {
+                    auto inputId = node->input()->at(e);
+
+                    // not a node. skipping checks
+                    if (graph->getMapped()->count(inputId.first) == 0)
+                        continue;
+
+                    Node *prevNode = graph->getMapped()->at(inputId.first);
+                    if (!flowPath->isNodeActive(inputId.first) || (prevNode->isDivergencePoint() && flowPath->branch(inputId.first) != inputId.second)) {
+                        nd4j_debug("Skipping Node_%i due to inactive input [%i]\n", node->id(), inputId.first);
+                        flowPath->markNodeActive(node->id(), false);
+                        return Status::OK();
+                    }
+                }
+            }
+
+            flowPath->markNodeActive(node->id(), true);
+
+            if (node->opType() == OpType_LOGIC) {
+                auto status = LogicExecutor::processNode(graph, node);
+                if (status != Status::OK())
+                    return status;
+            } else {
+                auto timeStart = std::chrono::system_clock::now();
+
+                auto status = GraphExecutioner::executeFlatNode(graph, node, variableSpace);
+
+                auto timeEnd = std::chrono::system_clock::now();
+                flowPath->setOuterTime(node->id(), std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count());
+
+                if (status != Status::OK())
+                    return status;
+            }
+
+            flowPath->markExecuted(node->id(), true);
+            return Status::OK();
+        }
+
+        Nd4jStatus DataflowExecutor::execute(Graph *graph, VariableSpace *variableSpace, int numThreads) {
+            auto flowPath = variableSpace->flowPath();
+            auto nodes = nodesInOrder(graph);
+            const int numNodes = nodes.size();
+
+            MAP_IMPL<int, int> positions;
+            for (int e = 0; e < numNodes; e++)
+                positions[nodes[e]->id()] = e;
+
+            std::vector<int> pending(numNodes, 0);
+            std::vector<std::vector<int>> consumers(numNodes);
+            auto addDependency = [&](int from, int to) {
+                consumers[from].emplace_back(to);
+                pending[to]++;
+            };
+
+            // every node depends on nodes it takes inputs from
+            MAP_IMPL<int, std::vector<int>> users;
+            for (int e = 0; e < numNodes; e++) {
+                for (auto &input : *nodes[e]->input()) {
+                    // FlowPath states are created here, so workers never modify FlowPath maps
+                    flowPath->isNodeActive(input.first);
+
+                    auto &u = users[input.first];
+                    if (u.empty() || u.back() != e)
+                        u.emplace_back(e);
+
+                    auto p = positions.find(input.first);
+                    if (p != positions.end())
+                        addDependency(p->second, e);
+                }
+
+                flowPath->isNodeActive(nodes[e]->id());
+            }
+
+            // in-place node overwrites its input, so it must keep its original order against other users of that input
+            for (auto &u : users) {
+                for (auto n : u.second) {
+                    if (!nodes[n]->isInplace())
+                        continue;
+
+                    for (auto c : u.second) {
+                        if (c < n)
+                            addDependency(c, n);
+                        else if (c > n)
+                            addDependency(n, c);
+                    }
+                }
+            }
+
+            // ready nodes are picked in layer-by-layer order, so with single worker execution order is the same
+            std::priority_queue<int, std::vector<int>, std::greater<int>> ready;
+            for (int e = 0; e < numNodes; e++)
+                if (pending[e] == 0)
+                    ready.push(e);
+
+            std::mutex lock;
+            std::condition_variable cv;
+            int remaining = numNodes;
+            Nd4jStatus status = Status::OK();
+            std::exception_ptr error = nullptr;
+
+            numThreads = sd::math::nd4j_max<int>(1, sd::math::nd4j_min<int>(numThreads, numNodes));
+            const int intraOpThreads = sd::math::nd4j_max<int>(1, sd::Environment::getInstance().maxMasterThreads() / numThreads);
+
+            auto worker = [&](uint64_t thread_id, uint64_t numberOfThreads) -> void {
+                sd::Environment::getInstance().setThreadMaxMasterThreads(intraOpThreads);
+
+                while (true) {
+                    int current = 0;
+                    {
+                        std::unique_lock<std::mutex> guard(lock);
+                        cv.wait(guard, [&] { return !ready.empty() || remaining == 0 || status != Status::OK(); });
+                        if (remaining == 0 || status != Status::OK())
+                            break;
+
+                        current = ready.top();
+                        ready.pop();
+                    }
+
+                    Nd4jStatus result;
+                    std::exception_ptr exception = nullptr;
+                    try {
+                        result = processNode(graph, nodes[current], variableSpace);
+                    } catch (...) {
+                        exception = std::current_exception();
+                        result = ND4J_STATUS_KERNEL_FAILURE;
+                    }
+
+                    std::lock_guard<std::mutex> guard(lock);
+                    if (result != Status::OK()) {
+                        if (status == Status::OK()) {
+                            status = result;
+                            error = exception;
+                        }
+
+                        cv.notify_all();
+                        break;
+                    }
+
+                    remaining--;
+                    for (auto c : consumers[current])
+                        if (--pending[c] == 0)
+                            ready.push(c);
+
+                    cv.notify_all();
+                }
+
+                sd::Environment::getInstance().setThreadMaxMasterThreads(0);
+            };
+
+            samediff::Threads::parallel_do(worker, numThreads);
+
+            if (error != nullptr)
+                std::rethrow_exception(error);
+
+            return status;
+        }
+    }
+}
@@ -0,0 +1,153 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/execution/ElementwiseFusion.h>
+#include <ops/declarable/FusedElementwiseOp.h>
+#include <map>
+#include <set>
+
+namespace sd {
+    namespace graph {
+
+        static FusedStep::Kind stepKind(OpType opType) {
+            switch (opType) {
+                case OpType_TRANSFORM_STRICT:
+                    return FusedStep::TRANSFORM_STRICT;
+                case OpType_TRANSFORM_SAME:
+                    return FusedStep::TRANSFORM_SAME;
+                case OpType_SCALAR:
+                    return FusedStep::SCALAR;
+                default:
+                    return FusedStep::PAIRWISE;
+            }
+        }
+
+        bool ElementwiseFusion::isFusable(Node *node) {
+            auto opType = node->opType();
+            if (opType != OpType_TRANSFORM_STRICT && opType != OpType_TRANSFORM_SAME && opType != OpType_SCALAR && opType != OpType_PAIRWISE)
+                return false;
+
+            if (!node->hasCustomOp() || node->isScoped() || node->hasExternalOutputs() || node->getContextPrototype() == nullptr)
+                return false;
+
+            // extra params of transforms aren't passed through fused op, scalar might be given as T argument
+            auto tArgs = node->getContextPrototype()->getTArguments()->size();
+            auto width = node->input()->size();
+            if (opType == OpType_SCALAR)
+                return width == 1 && tArgs <= 1;
+            else if (opType == OpType_PAIRWISE)
+                return width == 2 && tArgs == 0;
+            else
+                return width == 1 && tArgs == 0;
+        }
+
+        int ElementwiseFusion::apply(Graph *graph) {
+            if (!graph->scopes()->empty())
+                return 0;
+
+            // nodes in execution order, and number of consumers of every output
+            std::vector<Node*> nodes;
+            std::map<std::pair<int, int>, int> consumers;
+            auto onion = graph->getOnion();
+            for (int l = 0; l < (int) onion->size(); l++) {
+                if (onion->count(l) == 0)
+                    continue;
+
+                for (auto node : *onion->at(l)) {
+                    nodes.emplace_back(node);
+
+                    for (auto &in : *node->input())
+                        consumers[std::pair<int, int>(in.first, in.second)]++;
+                }
+            }
+
+            auto mapped = graph->getMapped();
+            auto outputs = graph->output();
+            std::set<int> absorbed;
+
+            // going backwards, so every chain is found starting from its last node
+            for (int e = (int) nodes.size() - 1; e >= 0; e--) {
+                auto tail = nodes[e];
+                if (absorbed.count(tail->id()) > 0 || !isFusable(tail))
+                    continue;
+
+                std::vector<Node*> chain({tail});
+                while (true) {
+                    auto &in = chain.front()->input()->at(0);
+                    if (in.second != 0 || mapped->count(in.first) == 0)
+                        break;
+
+                    auto prev = mapped->at(in.first);
+                    if (absorbed.count(prev->id()) > 0 || !isFusable(prev) || consumers[in] != 1)
+                        break;
+
+                    if (std::find(outputs->begin(), outputs->end(), prev->id()) != outputs->end())
+                        break;
+
+                    chain.insert(chain.begin(), prev);
+                }
+
+                if (chain.size() < 2)
+                    continue;
+
+                std::vector<FusedStep> program;
+                std::vector<std::pair<int, int>> inputs({chain.front()->input()->at(0)});
+                std::vector<double> scalars;
+                for (auto node : chain) {
+                    FusedStep step;
+                    step.kind = stepKind(node->opType());
+                    step.opNum = (int) node->opNum();
+                    program.emplace_back(step);
+
+                    if (step.kind == FusedStep::PAIRWISE)
+                        inputs.emplace_back(node->input()->at(1));
+                    else if (step.kind == FusedStep::SCALAR) {
+                        auto tArgs = node->getContextPrototype()->getTArguments();
+                        scalars.emplace_back(tArgs->empty() ? node->scalar() : tArgs->at(0));
+                    }
+                }
+
+                auto op = sd::ops::FusedElementwiseOp::build(program);
+
+                // tail node takes whole chain, legacy op it owned isn't needed anymore
+                if (tail->isDeductable())
+                    Node::deleteOpByType(tail->opType(), tail->getCustomOp());
+
+                tail->setOpType(OpType_CUSTOM);
+                tail->setDeductable(false);
+                tail->setCustomOp(op);
+                tail->markInplace(false);
+
+                *tail->input() = inputs;
+
+                auto prototype = tail->getContextPrototype();
+                *prototype->inputs() = inputs;
+                *prototype->getTArguments() = scalars;
+                prototype->setOpDescriptor(op->getOpDescriptor());
+
+                for (int c = 0; c < (int) chain.size() - 1; c++)
+                    absorbed.insert(chain[c]->id());
+            }
+
+            for (auto id : absorbed)
+                graph->removeNode(id);
+
+            return (int) absorbed.size();
+        }
+    }
+}
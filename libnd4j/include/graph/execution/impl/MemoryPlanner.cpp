@@ -0,0 +1,302 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/execution/MemoryPlanner.h>
+#include <array/DataBuffer.h>
+#include <array/DataTypeUtils.h>
+#include <array/NDArray.h>
+#include <array/ShapeDescriptor.h>
+#include <helpers/ShapeUtils.h>
+#include <algorithm>
+#include <set>
+
+namespace sd {
+    namespace graph {
+
+        // arena offsets are aligned, so every planned array starts at properly aligned address
+        static const Nd4jLong PLANNER_ALIGNMENT = 64;
+
+        // max number of cached plans, cache is flushed once it's exceeded
+        static const int PLANNER_CACHE_LIMIT = 256;
+
+        // nodes in the order layer-by-layer execution runs them
+        static std::vector<Node*> plannedOrder(Graph *graph) {
+            std::vector<Node*> nodes;
+            auto onion = graph->getOnion();
+            for (int l = 0; l < (int) onion->size(); l++) {
+                if (onion->count(l) == 0)
+                    continue;
+
+                for (auto node : *onion->at(l))
+                    nodes.emplace_back(node);
+            }
+
+            return nodes;
+        }
+
+        static bool isInplaceNode(Node *node) {
+            return node->isInplace() || (node->getContextPrototype() != nullptr && node->getContextPrototype()->isInplace());
+        }
+
+        MemoryPlan::MemoryPlan(std::vector<PlannedTensor> &tensors) {
+            _tensors = tensors;
+
+            // greedy by size: biggest arrays are placed first, every array takes smallest gap
+            // between arrays with overlapping lifetimes it fits into, or goes after all of them
+            std::vector<int> order(_tensors.size());
+            for (int e = 0; e < (int) order.size(); e++)
+                order[e] = e;
+
+            std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+                return _tensors[a].size > _tensors[b].size;
+            });
+
+            std::vector<int> placed;
+            for (auto t : order) {
+                auto &tensor = _tensors[t];
+
+                std::vector<int> overlapping;
+                for (auto p : placed)
+                    if (_tensors[p].first <= tensor.last && tensor.first <= _tensors[p].last)
+                        overlapping.emplace_back(p);
+
+                std::sort(overlapping.begin(), overlapping.end(), [&](int a, int b) {
+                    return _tensors[a].offset < _tensors[b].offset;
+                });
+
+                Nd4jLong prevEnd = 0;
+                Nd4jLong bestOffset = -1;
+                Nd4jLong bestGap = DataTypeUtils::max<Nd4jLong>();
+                for (auto p : overlapping) {
+                    auto gap = _tensors[p].offset - prevEnd;
+                    if (gap >= tensor.size && gap < bestGap) {
+                        bestGap = gap;
+                        bestOffset = prevEnd;
+                    }
+
+                    prevEnd = sd::math::nd4j_max<Nd4jLong>(prevEnd, _tensors[p].offset + _tensors[p].size);
+                }
+
+                tensor.offset = bestOffset >= 0 ? bestOffset : prevEnd;
+                _arenaSize = sd::math::nd4j_max<Nd4jLong>(_arenaSize, tensor.offset + tensor.size);
+                _totalSize += tensor.size;
+
+                placed.emplace_back(t);
+            }
+        }
+
+        std::vector<Variable*> MemoryPlan::bind(VariableSpace *variableSpace) {
+            std::vector<Variable*> bound;
+            std::shared_ptr<DataBuffer> arena;
+
+            for (auto &tensor : _tensors) {
+                std::pair<int, int> pair(tensor.id, tensor.idx);
+
+                Variable *var = nullptr;
+                if (variableSpace->hasVariable(pair)) {
+                    var = variableSpace->getVariable(pair);
+
+                    // arrays left from previous runs are reused as is
+                    if (var->variableType() != VariableType::NDARRAY || var->hasNDArray())
+                        continue;
+                }
+
+                if (arena == nullptr)
+                    arena = std::make_shared<DataBuffer>(_arenaSize, sd::DataType::INT8, variableSpace->launchContext()->getWorkspace());
+
+                ShapeDescriptor descriptor(tensor.shapeInfo.data());
+                auto array = new NDArray(arena, descriptor, variableSpace->launchContext(), tensor.offset / DataTypeUtils::sizeOf(descriptor.dataType()));
+
+                if (var == nullptr) {
+                    var = new Variable(array, nullptr, tensor.id, tensor.idx);
+                    variableSpace->putVariable(pair, var);
+                } else {
+                    var->setNDArray(array);
+                }
+
+                var->markRemovable(true);
+                var->markPlanned(true);
+                bound.emplace_back(var);
+            }
+
+            return bound;
+        }
+
+        const std::vector<PlannedTensor>& MemoryPlan::tensors() const {
+            return _tensors;
+        }
+
+        Nd4jLong MemoryPlan::arenaSize() const {
+            return _arenaSize;
+        }
+
+        Nd4jLong MemoryPlan::totalSize() const {
+            return _totalSize;
+        }
+
+        MemoryPlanner& MemoryPlanner::getInstance() {
+            static MemoryPlanner instance;
+            return instance;
+        }
+
+        bool MemoryPlanner::isApplicable(Graph *graph) {
+            if (!graph->scopes()->empty())
+                return false;
+
+            for (auto node : plannedOrder(graph)) {
+                if (node->opType() == OpType_LOGIC || node->hasGraphEmbedded() || !node->hasCustomOp())
+                    return false;
+            }
+
+            return true;
+        }
+
+        std::string MemoryPlanner::signature(Graph *graph, VariableSpace *variableSpace) {
+            std::string signature;
+
+            for (auto node : plannedOrder(graph)) {
+                signature += std::to_string(node->id()) + ":" + std::to_string((int) node->opType()) + ":" + std::to_string(node->opNum());
+                if (isInplaceNode(node))
+                    signature += "i";
+
+                signature += "(";
+                for (auto &in : *node->input()) {
+                    signature += std::to_string(in.first) + ":" + std::to_string(in.second);
+
+                    // input shapes define all shapes within graph
+                    if (graph->getMapped()->count(in.first) == 0) {
+                        std::pair<int, int> pair(in.first, in.second);
+                        if (!variableSpace->hasVariable(pair))
+                            return std::string();
+
+                        auto var = variableSpace->getVariable(pair);
+                        if (var->variableType() != VariableType::NDARRAY || !var->hasNDArray())
+                            return std::string();
+
+                        signature += ShapeUtils::shapeInfoAsString(var->getNDArray()->shapeInfo());
+                    }
+
+                    signature += ";";
+                }
+                signature += ")";
+            }
+
+            signature += "->";
+            for (auto id : *graph->output())
+                signature += std::to_string(id) + ";";
+
+            return signature;
+        }
+
+        std::shared_ptr<MemoryPlan> MemoryPlanner::build(Graph *graph, VariableSpace *variableSpace) {
+            auto nodes = plannedOrder(graph);
+
+            // last consumer of each output, and outputs that might be aliased by inplace consumers
+            std::map<std::pair<int, int>, int> lastUse;
+            std::set<std::pair<int, int>> aliased;
+            for (int p = 0; p < (int) nodes.size(); p++) {
+                for (auto &in : *nodes[p]->input()) {
+                    std::pair<int, int> pair(in.first, in.second);
+                    lastUse[pair] = p;
+
+                    if (isInplaceNode(nodes[p]))
+                        aliased.insert(pair);
+                }
+            }
+
+            auto outputs = graph->output();
+            std::vector<PlannedTensor> tensors;
+            for (int p = 0; p < (int) nodes.size(); p++) {
+                auto node = nodes[p];
+
+                // graph outputs must survive execution, and inplace outputs are views of inputs
+                if (isInplaceNode(node) || std::find(outputs->begin(), outputs->end(), node->id()) != outputs->end())
+                    continue;
+
+                for (int idx = 0; variableSpace->hasVariable(node->id(), idx); idx++) {
+                    std::pair<int, int> pair(node->id(), idx);
+                    if (aliased.count(pair) > 0)
+                        continue;
+
+                    auto var = variableSpace->getVariable(pair);
+                    if (var->variableType() != VariableType::NDARRAY || !var->hasNDArray())
+                        continue;
+
+                    auto array = var->getNDArray();
+                    if (array->isEmpty() || array->isS() || array->ews() != 1 || (array->isView() && !var->isPlanned()))
+                        continue;
+
+                    auto bytes = array->lengthOf() * array->sizeOfT();
+                    if (bytes <= 0)
+                        continue;
+
+                    PlannedTensor tensor;
+                    tensor.id = pair.first;
+                    tensor.idx = pair.second;
+                    tensor.first = p;
+                    tensor.last = lastUse.count(pair) > 0 ? lastUse[pair] : p;
+                    tensor.size = (bytes + PLANNER_ALIGNMENT - 1) / PLANNER_ALIGNMENT * PLANNER_ALIGNMENT;
+                    tensor.offset = 0;
+                    tensor.shapeInfo = std::vector<Nd4jLong>(array->shapeInfo(), array->shapeInfo() + shape::shapeInfoLength(array->rankOf()));
+
+                    tensors.emplace_back(tensor);
+                }
+            }
+
+            // single array doesn't benefit from arena
+            if (tensors.size() < 2)
+                return nullptr;
+
+            return std::make_shared<MemoryPlan>(tensors);
+        }
+
+        std::shared_ptr<MemoryPlan> MemoryPlanner::plan(const std::string &signature) {
+            std::lock_guard<std::mutex> lock(_lock);
+
+            auto it = _plans.find(signature);
+            return it != _plans.end() ? it->second : nullptr;
+        }
+
+        void MemoryPlanner::storePlan(const std::string &signature, std::shared_ptr<MemoryPlan> plan) {
+            if (plan == nullptr)
+                return;
+
+            std::lock_guard<std::mutex> lock(_lock);
+
+            if ((int) _plans.size() >= PLANNER_CACHE_LIMIT && _plans.count(signature) == 0)
+                _plans.clear();
+
+            _plans[signature] = plan;
+        }
+
+        void MemoryPlanner::forgetPlan(const std::string &signature) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _plans.erase(signature);
+        }
+
+        int MemoryPlanner::numberOfPlans() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return (int) _plans.size();
+        }
+
+        void MemoryPlanner::purge() {
+            std::lock_guard<std::mutex> lock(_lock);
+            _plans.clear();
+        }
+    }
+}
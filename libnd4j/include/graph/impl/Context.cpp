@@ -303,6 +303,7 @@ namespace sd {
 
                             var->setNDArray(array);
                             var->markRemovable(removable);
+                            var->markPlanned(false);
                         }
                     } else {
                         var->setNDArray(array);
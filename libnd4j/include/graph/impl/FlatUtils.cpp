@@ -26,6 +26,8 @@
 #include <array/DataTypeUtils.h>
 #include <array/ByteOrderUtils.h>
 #include <array/NDArrayFactory.h>
+#include <array/ShapeDescriptor.h>
+#include <helpers/BitwiseUtils.h>
 
 
 namespace sd {
@@ -38,7 +40,7 @@ namespace sd {
             return std::pair<Nd4jLong, Nd4jLong>(pair->first(), pair->second());
         }
 
-        NDArray* FlatUtils::fromFlatArray(const sd::graph::FlatArray *flatArray) {
+        NDArray* FlatUtils::fromFlatArray(const sd::graph::FlatArray *flatArray, const std::shared_ptr<MappedFile> &mappedFile) {
             auto rank = static_cast<int>(flatArray->shape()->Get(0));
             auto newShape = new Nd4jLong[shape::shapeInfoLength(rank)];
             memcpy(newShape, flatArray->shape()->data(), shape::shapeInfoByteLength(rank));
@@ -94,9 +96,23 @@ namespace sd {
             }
 
 
-            auto newBuffer = new int8_t[length * DataTypeUtils::sizeOf(dtype)];
+            auto data = flatArray->buffer()->data();
+            auto byteOrder = ByteOrderUtils::fromFlatByteOrder(flatArray->byteOrder());
+            auto lenInBytes = length * DataTypeUtils::sizeOf(dtype);
 
-            BUILD_SINGLE_SELECTOR(dtype, DataTypeConversions, ::convertType(newBuffer, (void *)flatArray->buffer()->data(), dtype, ByteOrderUtils::fromFlatByteOrder(flatArray->byteOrder()),  length), LIBND4J_TYPES);
+            // zero-copy: buffer within mapped file is used as is, and the file stays mapped while buffer is alive
+            if (mappedFile != nullptr && byteOrder == BitwiseUtils::asByteOrder() && mappedFile->contains(data, lenInBytes) && reinterpret_cast<uintptr_t>(data) % DataTypeUtils::sizeOf(dtype) == 0) {
+                std::shared_ptr<DataBuffer> buffer(new DataBuffer(const_cast<int8_t *>(data), lenInBytes, dtype, false), [mappedFile] (DataBuffer *b) { delete b; });
+
+                auto array = new NDArray(buffer, ShapeDescriptor(newShape), sd::LaunchContext::defaultContext());
+
+                delete[] newShape;
+                return array;
+            }
+
+            auto newBuffer = new int8_t[lenInBytes];
+
+            BUILD_SINGLE_SELECTOR(dtype, DataTypeConversions, ::convertType(newBuffer, (void *) data, dtype, byteOrder, length), LIBND4J_TYPES);
 
             auto array = new NDArray(newBuffer, newShape, sd::LaunchContext::defaultContext(), true);
 
@@ -146,6 +146,13 @@ namespace sd {
             _states[nodeId].markExecuted(wasExecuted);
         }
 
+        void FlowPath::reset() {
+            for (auto &v: _states)
+                v.second = NodeState(v.first);
+
+            _frames.clear();
+        }
+
         GraphProfile* FlowPath::profile() {
             return &_profile;
         }
@@ -274,6 +274,26 @@ namespace sd {
             _mapped->insert(pair);
         }
 
+        void Graph::removeNode(int nodeId) {
+            if (_mapped->count(nodeId) == 0)
+                return;
+
+            auto node = _mapped->at(nodeId);
+
+            for (auto &v: *_onion) {
+                auto it = std::find(v.second->begin(), v.second->end(), node);
+                if (it != v.second->end())
+                    v.second->erase(it);
+            }
+
+            auto it = std::find(_nodes->begin(), _nodes->end(), nodeId);
+            if (it != _nodes->end())
+                _nodes->erase(it);
+
+            _mapped->erase(nodeId);
+            delete node;
+        }
+
         void Graph::expandOnion(int newLayer) {
             if (_onion->count(newLayer) > 0)
                 return;
@@ -867,7 +887,11 @@ namespace sd {
             }
         }
 
-        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace) {
+        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace) : Graph(flatGraph, variableSpace, nullptr) {
+            //
+        }
+
+        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace, const std::shared_ptr<MappedFile> &mappedFile) {
             this->_onion = new MAP_IMPL<int, std::vector<Node *> *>();
             this->_mapped = new MAP_IMPL<int, Node *> ();
             this->_nodes = new std::vector<int>();
@@ -894,7 +918,7 @@ namespace sd {
                 for (unsigned int e = 0; e < flatGraph->variables()->size(); e++) {
                     auto flatVar = flatGraph->variables()->Get(e);
 
-                    auto var = new Variable(flatVar);
+                    auto var = new Variable(flatVar, mappedFile);
                     std::pair<int, int> pair(flatVar->id()->first(), flatVar->id()->second());
                     _variableSpace->putVariable(pair, var);
 
@@ -46,6 +46,9 @@
 #include <chrono>
 #include <ctime>
 #include <graph/execution/LogicExecutor.h>
+#include <graph/execution/DataflowExecutor.h>
+#include <graph/execution/MemoryPlanner.h>
+#include <graph/execution/ElementwiseFusion.h>
 #include <array/DataTypeUtils.h>
 #include <helpers/BitwiseUtils.h>
 #include <graph/generated/array_generated.h>
@@ -220,6 +223,12 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     Nd4jLong tb0 = Environment::getInstance().isProfiling() ? GraphProfile::currentTime() : 0L;
     graph->buildGraph();
 
+#ifndef __CUDABLAS__
+    // chains of legacy elementwise ops are replaced with fused ops before anything else looks at graph structure
+    if (Environment::getInstance().isElementwiseFusion())
+        ElementwiseFusion::apply(graph);
+#endif
+
     auto footprintForward = sd::memory::MemoryRegistrator::getInstance().getGraphMemoryFootprint(graph->hashCode());
     if (footprintForward > 0) {
         if (__variableSpace->launchContext()->getWorkspace() != nullptr) {
@@ -237,6 +246,41 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
     bool pe = graph->getExecutorConfiguration()->_executionMode == ExecutionMode_AUTO;
 
+#ifndef __CUDABLAS__
+    // independent nodes can be executed concurrently, unless we're profiling per-node times
+    auto interOpThreads = Environment::getInstance().interOpThreads();
+    if (interOpThreads > 1 && !Environment::getInstance().isProfiling() && DataflowExecutor::isApplicable(graph)) {
+        auto status = DataflowExecutor::execute(graph, __variableSpace, interOpThreads);
+        if (status != Status::OK())
+            return status;
+
+        // saving memory footprint for current run
+        if (__variableSpace->launchContext()->getWorkspace() != nullptr) {
+            auto m = __variableSpace->launchContext()->getWorkspace()->getAllocatedSize();
+            sd::memory::MemoryRegistrator::getInstance().setGraphMemoryFootprintIfGreater(graph->hashCode(), m);
+        }
+
+        if (tempFlow) {
+            delete flowPath;
+            __variableSpace->setFlowPath(nullptr);
+        }
+
+        return Status::OK();
+    }
+
+    // intermediate arrays are placed into single arena if we already have plan for these input shapes
+    std::string planSignature;
+    std::shared_ptr<MemoryPlan> memoryPlan;
+    std::vector<Variable*> plannedVariables;
+    if (Environment::getInstance().isMemoryPlanning() && MemoryPlanner::isApplicable(graph)) {
+        planSignature = MemoryPlanner::signature(graph, __variableSpace);
+        if (!planSignature.empty()) {
+            memoryPlan = MemoryPlanner::getInstance().plan(planSignature);
+            if (memoryPlan != nullptr)
+                plannedVariables = memoryPlan->bind(__variableSpace);
+        }
+    }
+#endif
 
     // basically if at some point code diverges, code branch might be _DISABLED_, and all nodes within that branch will be disabled as well
 
@@ -482,6 +526,18 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
         }
     }
 
+#ifndef __CUDABLAS__
+    // plan is built out of the first run, and rebuilt if some planned output got another shape
+    if (!planSignature.empty()) {
+        bool stale = memoryPlan == nullptr;
+        for (auto v : plannedVariables)
+            stale |= !v->isPlanned();
+
+        if (stale)
+            MemoryPlanner::getInstance().storePlan(planSignature, MemoryPlanner::build(graph, __variableSpace));
+    }
+#endif
+
     // optionally saving execution time
     if (Environment::getInstance().isProfiling()) {
         flowPath->profile()->nodeById(lastId)->setTotalTime(GraphProfile::relativeTime(nodeTime));
@@ -836,15 +892,26 @@ uint8_t* readFlatBuffers(const char * filename) {
     uint8_t * data = new uint8_t[fileLen];
 
     FILE *in = fopen(filename, "rb");
-    int cnt = 0;
-    int b = 0;
+    if (in == nullptr) {
+        delete[] data;
+        throw std::runtime_error("Can't open file");
+    }
+
+    long cnt = 0;
     while (cnt < fileLen) {
-        b = fread(data + cnt, 1, 1, in);
+        auto b = fread(data + cnt, 1, fileLen - cnt, in);
+        if (b == 0)
+            break;
 
         cnt += b;
     }
     fclose(in);
 
+    if (cnt < fileLen) {
+        delete[] data;
+        throw std::runtime_error("Failed to read file");
+    }
+
     return data;
 }
 
@@ -898,6 +965,13 @@ flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuff
             return restoredGraph;
         }
 
+        Graph* GraphExecutioner::importFromMappedFlatBuffers(const char *filename) {
+            auto mappedFile = std::make_shared<MappedFile>(filename);
+            auto fg = GetFlatGraph(mappedFile->data());
+
+            return new Graph(fg, nullptr, mappedFile);
+        }
+
         Graph *GraphExecutioner::importFromFlatPointer(Nd4jPointer ptr) {
             auto fg = GetFlatGraph(reinterpret_cast<uint8_t *>(ptr));
             auto restoredGraph = new Graph(fg);
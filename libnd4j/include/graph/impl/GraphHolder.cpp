@@ -65,27 +65,38 @@ namespace sd {
         }
 
         void GraphHolder::forgetGraph(Nd4jLong graphId) {
-            if (this->hasGraph(graphId))
-                _graphF.erase(graphId);
+            if (!this->hasGraph(graphId))
+                return;
+
+            // sessions can't be dropped while requests are executed within them
+            this->lockWrite(graphId);
+
+            dropSessions(graphId);
+            _graphF.erase(graphId);
+
+            this->unlockWrite(graphId);
         }
 
         void GraphHolder::dropGraph(Nd4jLong graphId) {
-            if (this->hasGraph(graphId)) {
-                auto g = _graphF[graphId];
-                forgetGraph(graphId);
-                delete g;
-            }
+            if (!this->hasGraph(graphId))
+                return;
+
+            this->lockWrite(graphId);
+
+            auto g = _graphF[graphId];
+            dropSessions(graphId);
+            _graphF.erase(graphId);
+
+            this->unlockWrite(graphId);
+
+            delete g;
         }
 
         void GraphHolder::dropGraphAny(Nd4jLong graphId) {
             if (!hasGraphAny(graphId))
                 return;
 
-            this->lockWrite(graphId);
-
             this->dropGraph(graphId);
-
-            this->unlockWrite(graphId);
         }
 
         bool GraphHolder::hasGraphAny(Nd4jLong graphId) {
@@ -104,11 +115,59 @@ namespace sd {
 
             this->lockWrite(graphId);
 
+            // sessions refer to the previous graph
+            dropSessions(graphId);
             _graphF[graphId] = graph;
 
             this->unlockWrite(graphId);
         }
 
+        GraphSession* GraphHolder::acquireSession(Nd4jLong graphId) {
+            std::lock_guard<std::mutex> lock(_sessionsLock);
+
+            auto &pool = _sessions[graphId];
+            if (!pool.empty()) {
+                auto session = pool.back();
+                pool.pop_back();
+                return session;
+            }
+
+            // new session is created only if all existing ones are busy
+            return new GraphSession(_graphF[graphId]);
+        }
+
+        void GraphHolder::releaseSession(Nd4jLong graphId, GraphSession *session) {
+            std::lock_guard<std::mutex> lock(_sessionsLock);
+
+            // graph was forgotten or replaced while session was in use, so session isn't valid anymore
+            if (!hasGraph(graphId) || _graphF[graphId] != session->original()) {
+                delete session;
+                return;
+            }
+
+            _sessions[graphId].emplace_back(session);
+        }
+
+        void GraphHolder::dropSessions(Nd4jLong graphId) {
+            std::lock_guard<std::mutex> lock(_sessionsLock);
+
+            auto it = _sessions.find(graphId);
+            if (it == _sessions.end())
+                return;
+
+            for (auto session: it->second)
+                delete session;
+
+            _sessions.erase(it);
+        }
+
+        int GraphHolder::numberOfSessions(Nd4jLong graphId) {
+            std::lock_guard<std::mutex> lock(_sessionsLock);
+
+            auto it = _sessions.find(graphId);
+            return it == _sessions.end() ? 0 : (int) it->second.size();
+        }
+
 
 
 
@@ -118,9 +177,19 @@ namespace sd {
 
             lockRead(graphId);
 
-            auto graph = cloneGraph(graphId);
-            auto res = GraphExecutioner::execute(graph, builder, request);
-            delete graph;
+            auto session = acquireSession(graphId);
+
+            flatbuffers::Offset<FlatResult> res;
+            try {
+                res = session->execute(builder, request);
+            } catch (...) {
+                // session state is undefined after failure, so it's not returned to the pool
+                delete session;
+                unlockRead(graphId);
+                throw;
+            }
+
+            releaseSession(graphId, session);
 
             unlockRead(graphId);
 
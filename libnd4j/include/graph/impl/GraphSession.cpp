@@ -0,0 +1,123 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/GraphSession.h>
+#include <graph/GraphExecutioner.h>
+#include <system/Environment.h>
+#include <exceptions/graph_execution_exception.h>
+#include <exceptions/no_results_exception.h>
+
+namespace sd {
+    namespace graph {
+        GraphSession::GraphSession(Graph *original) {
+            _original = original;
+            _graph = original->cloneWithProxy();
+            _proxy = dynamic_cast<VariableProxy*>(_graph->getVariableSpace());
+            _proxy->setFlowPath(&_flowPath);
+
+            // every variable produced by nodes gets local copy, so outputs never land in original VariableSpace
+            auto handles = original->getVariableSpace()->handles();
+            for (auto v: *handles)
+                if (_graph->getMapped()->count(v->id()) > 0)
+                    _proxy->shadowVariable(v->id(), v->index());
+
+            for (auto &v: *_graph->getMapped())
+                _proxy->shadowVariable(v.first, 0);
+        }
+
+        GraphSession::~GraphSession() {
+            _proxy->setFlowPath(nullptr);
+            delete _graph;
+        }
+
+        Graph* GraphSession::graph() {
+            return _graph;
+        }
+
+        Graph* GraphSession::original() {
+            return _original;
+        }
+
+        flatbuffers::Offset<FlatResult> GraphSession::execute(flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
+            _flowPath.reset();
+
+            // outputs of previous request may have different shapes (i.e. another batch size), so they are released here and allocated again
+            auto mapped = _graph->getMapped();
+            for (auto v: *_proxy->localVariables()) {
+                if (v->isPlaceholder() || mapped->count(v->id()) == 0)
+                    continue;
+
+                if (v->hasNDArray() && v->isRemovable()) {
+                    delete v->getNDArray();
+                    v->setNDArray(nullptr);
+                }
+            }
+
+            // request variables replace arrays of session-local variables, previous arrays are released
+            if (request != nullptr && request->variables() != nullptr) {
+                auto vars = request->variables();
+                for (int e = 0; e < (int) vars->size(); e++) {
+                    Variable fv(vars->Get(e));
+
+                    int id = fv.id();
+                    int idx = fv.index();
+                    if (fv.getName() != nullptr && !fv.getName()->empty() && _proxy->hasVariable(fv.getName())) {
+                        auto origVar = _proxy->getVariable(fv.getName());
+                        id = origVar->id();
+                        idx = origVar->index();
+                    }
+
+                    auto local = _proxy->shadowVariable(id, idx);
+                    if (local->hasNDArray() && local->isRemovable())
+                        delete local->getNDArray();
+
+                    local->setNDArray(fv.getNDArray());
+                    local->markRemovable(true);
+                    local->markReadOnly(false);
+
+                    // array belongs to session variable now
+                    fv.setNDArray(nullptr);
+                }
+            }
+
+            if (Environment::getInstance().isDebugAndVerbose())
+                _graph->printOut();
+
+            auto status = GraphExecutioner::execute(_graph);
+            if (status != sd::Status::OK())
+                throw graph_execution_exception(request != nullptr ? request->id() : 0);
+
+            auto outputs = _graph->fetchOutputs();
+
+            if (outputs->size() == 0) {
+                delete outputs;
+                throw no_results_exception(request != nullptr ? request->id() : 0);
+            }
+
+            ExecutionResult result;
+            for (auto v: *outputs)
+                result.emplace_back(v);
+
+            auto t = result.asFlatResult(builder);
+
+            delete outputs;
+
+            return t;
+        }
+    }
+}
@@ -141,6 +141,10 @@ namespace sd {
             this->_removable = reallyRemovable;
         }
 
+        void sd::graph::Variable::markPlanned(bool reallyPlanned) {
+            this->_planned = reallyPlanned;
+        }
+
         void sd::graph::Variable::markReadOnly(bool reallyReadOnly) {
             this->_readOnly = reallyReadOnly;
         }
@@ -176,6 +180,10 @@ namespace sd {
             return _removable;
         }
 
+        bool Variable::isPlanned() {
+            return _planned;
+        }
+
 
         void sd::graph::Variable::setNDArrayList(sd::NDArrayList * list) {
             this->_variableType = VariableType::ARRAY_LIST;
@@ -194,7 +202,7 @@ namespace sd {
         }
 
 
-        sd::graph::Variable::Variable(const sd::graph::FlatVariable *flatVariable) {
+        sd::graph::Variable::Variable(const sd::graph::FlatVariable *flatVariable, const std::shared_ptr<MappedFile> &mappedFile) {
             auto vid = flatVariable->id();
             this->_id = vid->first();
             this->_index = vid->second();
@@ -213,7 +221,7 @@ namespace sd {
                         // ?????
                         if (flatVariable->ndarray() != nullptr) {
                             auto ar = flatVariable->ndarray();
-                            _ndarray = sd::graph::FlatUtils::fromFlatArray(ar);
+                            _ndarray = sd::graph::FlatUtils::fromFlatArray(ar, mappedFile);
                         }
 
                         _variableType = VariableType::NDARRAY;
@@ -225,9 +233,9 @@ namespace sd {
 
                         auto ar = flatVariable->ndarray();
                         if (ar->dtype() == DType_UTF8) {
-                            _ndarray = sd::graph::FlatUtils::fromFlatArray(ar);
+                            _ndarray = sd::graph::FlatUtils::fromFlatArray(ar, mappedFile);
                         } else {
-                            _ndarray = sd::graph::FlatUtils::fromFlatArray(ar);
+                            _ndarray = sd::graph::FlatUtils::fromFlatArray(ar, mappedFile);
                         }
 
                         _variableType = VariableType::NDARRAY;
@@ -238,7 +246,7 @@ namespace sd {
                         // ?????
                         if (flatVariable->ndarray() != nullptr) {
                             auto ar = flatVariable->ndarray();
-                            _ndarray = sd::graph::FlatUtils::fromFlatArray(ar);
+                            _ndarray = sd::graph::FlatUtils::fromFlatArray(ar, mappedFile);
                             // _ndarray->triggerAllocationFlag(true);
                         }
 
@@ -251,7 +259,7 @@ namespace sd {
 
                         if (flatVariable->ndarray() != nullptr) {
                             auto ar = flatVariable->ndarray();
-                            _ndarray = sd::graph::FlatUtils::fromFlatArray(ar);
+                            _ndarray = sd::graph::FlatUtils::fromFlatArray(ar, mappedFile);
                             // _ndarray->triggerAllocationFlag(true);
 
                             _variableType = VariableType::NDARRAY;
@@ -174,6 +174,29 @@ namespace sd {
         }
 
         
+        Variable* VariableProxy::shadowVariable(int id, int idx) {
+            if (_current->hasVariable(id, idx))
+                return _current->getVariable(id, idx);
+
+            const char *name = nullptr;
+            if (_backed->hasVariable(id, idx)) {
+                auto origVar = _backed->getVariable(id, idx);
+                if (origVar->getName() != nullptr && !origVar->getName()->empty())
+                    name = origVar->getName()->c_str();
+            }
+
+            auto var = new Variable(nullptr, name, id, idx);
+            std::pair<int, int> pair(id, idx);
+            _current->putVariable(pair, var);
+
+            return var;
+        }
+
+        std::vector<Variable*>* VariableProxy::localVariables() {
+            return _current->handles();
+        }
+
+        
         Variable* VariableProxy::putVariable(std::pair<int,int>& pair, NDArray *array) {
             return _current->putVariable(pair, array);
         }
@@ -92,10 +92,12 @@ namespace sd {
         }
 
         bool sd::graph::VariableSpace::hasVariable(std::string *symbol) {
+            std::lock_guard<std::mutex> lock(_varmap);
             return _symbolic.count(*symbol) == 1;
         }
 
         sd::graph::Variable * sd::graph::VariableSpace::getVariable(std::string *symbol) {
+            std::lock_guard<std::mutex> lock(_varmap);
             return _symbolic.at(*symbol);
         }
 
@@ -136,18 +138,21 @@ namespace sd {
         sd::graph::Variable * sd::graph::VariableSpace::getVariable(std::pair<int, int>& pair) {
             if (pair.first < 0)
                 return getVariable(pair.first);
-            else
-                return _paired.at(pair);
+
+            std::lock_guard<std::mutex> lock(_varmap);
+            return _paired.at(pair);
 
             nd4j_printf("Unknown variable requested: [%i,%i]\n", pair.first, pair.second);
             throw std::runtime_error("Unknown variable requested");
         }
 
         bool sd::graph::VariableSpace::hasVariable(int id) {
+            std::lock_guard<std::mutex> lock(_varmap);
             return _variables.count(id) == 1 || _temporary.count(id) == 1;
         }
 
         bool sd::graph::VariableSpace::hasVariable(std::pair<int,int>& id) {
+            std::lock_guard<std::mutex> lock(_varmap);
             return _paired.count(id) > 0;
         }
 
@@ -237,12 +242,12 @@ namespace sd {
             if (pair.second == 0 && !this->hasVariable(pair.first)) {
                 this->putVariable(pair.first, variable);
             } else {
+                _varmap.lock();
+
                 if (variable->getName() != nullptr && variable->getName()->length() != 0) {
                     _symbolic[*(variable->getName())] = variable;
                 }
 
-                _varmap.lock();
-
                 _handles->push_back(variable);
 
                 _varmap.unlock();
@@ -250,13 +255,16 @@ namespace sd {
         }
 
         void VariableSpace::trackList(sd::NDArrayList* list) {
+            std::lock_guard<std::mutex> lock(_varmap);
             _lists.emplace_back(list);
         }
 
         void sd::graph::VariableSpace::putVariable(int id, Variable *variable) {
             // we don't want to add variables more then once
+            _varmap.lock();
             if (_variables.count(id) > 0 || _temporary.count(id) > 0) {
                 auto local = id < 0 ? _variables.at(id) : _temporary.at(id);
+                _varmap.unlock();
 
                 if (!local->hasNDArray() && variable->hasNDArray()) {
                     local->setNDArray(variable->getNDArray());
@@ -269,8 +277,6 @@ namespace sd {
                 return;
             }
 
-            _varmap.lock();
-
             _handles->emplace_back(variable);
 
             if (_auto_counter >= id)
@@ -328,6 +334,7 @@ namespace sd {
         }
 
         sd::graph::Variable * sd::graph::VariableSpace::getVariable(int id) {
+            std::lock_guard<std::mutex> lock(_varmap);
             if (id < 0) {
                 return _variables.at(id);
             } else {
@@ -52,6 +52,10 @@ namespace sd {
             // time spent for output shape creation
             Nd4jLong _shapeTime = 0L;
 
+            // lookups of op shape function cache, and how many of them skipped shape function
+            Nd4jLong _shapeCacheLookups = 0L;
+            Nd4jLong _shapeCacheHits = 0L;
+
             // time spent for output arrays creation
             Nd4jLong _arrayTime = 0L;
 
@@ -82,6 +86,7 @@ namespace sd {
             void setExecutionTime(Nd4jLong time);
             void setTotalTime(Nd4jLong time);
             void setShapeFunctionTime(Nd4jLong time);
+            void addShapeCacheLookup(bool hit);
             void setArrayTime(Nd4jLong time);
             void setInputTime(Nd4jLong time);
 
@@ -100,6 +105,14 @@ namespace sd {
 
             Nd4jLong getExecutionTime() const;
 
+            Nd4jLong getShapeCacheLookups() const;
+            Nd4jLong getShapeCacheHits() const;
+
+            /**
+             * Fraction of shape cache lookups that skipped shape function, 0 if there were no lookups
+             */
+            double getShapeCacheHitRate() const;
+
             std::string& name();
 
             void merge(NodeProfile *other);
@@ -38,6 +38,8 @@ namespace sd {
             nd4j_printf("      Memory: ACT: %lld; TMP: %lld; OBJ: %lld; TTL: %lld;\n", _memoryActivations / _merges, _memoryTemporary / _merges, _memoryObjects / _merges, _memoryTotal / _merges);
             nd4j_printf("      Time: PREP: %lld ns; EXEC: %lld ns; TTL: %lld ns;\n", _preparationTime / _merges, _executionTime / _merges, _totalTime / _merges);
             nd4j_printf("      PREP: INPUT: %lld ns; SHAPE: %lld ns; ARRAY: %lld ns;\n", _inputTime / _merges, _shapeTime / _merges, _arrayTime / _merges);
+            if (_shapeCacheLookups > 0)
+                nd4j_printf("      SHAPE CACHE: %lld hits of %lld lookups (%.1f%%);\n", _shapeCacheHits, _shapeCacheLookups, getShapeCacheHitRate() * 100.0);
 
             std::string inputs;
             std::string outputs;
@@ -62,6 +64,24 @@ namespace sd {
             _shapeTime = time;
         }
 
+        void NodeProfile::addShapeCacheLookup(bool hit) {
+            _shapeCacheLookups++;
+            if (hit)
+                _shapeCacheHits++;
+        }
+
+        Nd4jLong NodeProfile::getShapeCacheLookups() const {
+            return _shapeCacheLookups;
+        }
+
+        Nd4jLong NodeProfile::getShapeCacheHits() const {
+            return _shapeCacheHits;
+        }
+
+        double NodeProfile::getShapeCacheHitRate() const {
+            return _shapeCacheLookups > 0 ? (double) _shapeCacheHits / (double) _shapeCacheLookups : 0.0;
+        }
+
         void NodeProfile::setArrayTime(Nd4jLong time) {
             _arrayTime = time;
         }
@@ -137,6 +157,8 @@ namespace sd {
             _executionTime += other->_executionTime;
             _totalTime += other->_totalTime;
             _shapeTime += other->_shapeTime;
+            _shapeCacheLookups += other->_shapeCacheLookups;
+            _shapeCacheHits += other->_shapeCacheHits;
             _arrayTime += other->_arrayTime;
             _inputTime += other->_inputTime;
 
@@ -159,6 +181,8 @@ namespace sd {
             _executionTime = other->_executionTime;
             _totalTime = other->_totalTime;
             _shapeTime = other->_shapeTime;
+            _shapeCacheLookups = other->_shapeCacheLookups;
+            _shapeCacheHits = other->_shapeCacheHits;
             _arrayTime = other->_arrayTime;
             _inputTime = other->_inputTime;
 
@@ -58,8 +58,6 @@ namespace sd {
 
         void benchmarkDeclarableOp(sd::ops::DeclarableOp &op, std::string testName, Context &context);
 
-        void benchmarkGEMM(char orderA, std::initializer_list<Nd4jLong> shapeA, char orderB, std::initializer_list<Nd4jLong> shapeB, char orderC, std::initializer_list<Nd4jLong> shapeC);
-
         std::string printHeader();
     public:
         BenchmarkHelper(unsigned int warmUpIterations = 10, unsigned int runIterations = 100);
@@ -68,6 +66,12 @@ namespace sd {
         std::string runOperationSuit(std::vector<OpBenchmark*> &benchmarks, bool postHeaders, const char *msg = nullptr);
         std::string runOperationSuit(OpBenchmark* benchmark);
 
+        /**
+         * This method benchmarks A x B = C via MmulHelper for each of given data types, and reports median time and GFLOP/s per data type
+         */
+        std::string benchmarkGEMM(char orderA, std::initializer_list<Nd4jLong> shapeA, char orderB, std::initializer_list<Nd4jLong> shapeB, char orderC, std::initializer_list<Nd4jLong> shapeC,
+                                  std::initializer_list<sd::DataType> dataTypes = {sd::DataType::FLOAT32, sd::DataType::DOUBLE, sd::DataType::HALF, sd::DataType::BFLOAT16, sd::DataType::INT8, sd::DataType::INT32});
+
         std::string runOperationSuit(ScalarBenchmark *op, const std::function<void (ResultSet &, ResultSet &)>& func, const char *message = nullptr);
         std::string runOperationSuit(TransformBenchmark *op, const std::function<void (ResultSet &, ResultSet &)>& func, const char *message = nullptr);
         std::string runOperationSuit(ReductionBenchmark *op, const std::function<void (ResultSet &, ResultSet &)>& func, const char *message = nullptr);
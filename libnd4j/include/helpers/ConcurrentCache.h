@@ -0,0 +1,395 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_HELPERS_CONCURRENTCACHE_H
+#define SD_HELPERS_CONCURRENTCACHE_H
+
+#include <system/pointercast.h>
+#include <atomic>
+#include <unordered_map>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <thread>
+
+namespace sd {
+
+/**
+ * Read-mostly concurrent cache, used by constant helpers.
+ *
+ * Entries are spread over a fixed number of shards. Each shard publishes an immutable snapshot of its table,
+ * so lookups of entries within snapshot never take a lock: reader registers itself in current epoch of the shard,
+ * loads snapshot and copies value out.
+ * Inserts go to per-shard delta table under shard mutex, and lookups that miss snapshot check delta under the same mutex.
+ * Delta is merged into new snapshot once it grows to a fraction of snapshot, so every insert copies O(1) entries on average:
+ * writer publishes merged snapshot, flips epoch and waits for readers of previous epoch before releasing replaced snapshot.
+ *
+ * Optional entries/bytes limits are enforced per shard (limit / numberOfShards) with CLOCK eviction:
+ * every hit sets reference bit, and eviction hand skips (and clears) referenced entries once.
+ * Evicted entries are removed from snapshot with the next merge, lock-free readers might still get them until then.
+ *
+ * PLEASE NOTE: Value must be safe to evict, i.e. all resources it holds must be ref-counted
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class ConcurrentCache {
+ public:
+  struct Entry {
+    const K key;
+    V value;
+    Nd4jLong bytes;
+    mutable std::atomic<bool> referenced;
+
+    Entry(const K &k, const V &v, Nd4jLong b) : key(k), value(v), bytes(b), referenced(true) { }
+  };
+
+ private:
+
+  // Hash is used for tables as well, so keys without std::hash specialization (i.e. vectors) are fine
+  typedef std::unordered_map<K, std::shared_ptr<Entry>, Hash> Table;
+
+  // delta is merged into snapshot once it has that many entries, or 1/DELTA_FRACTION of snapshot size
+  static const size_t MIN_DELTA = 16;
+  static const size_t DELTA_FRACTION = 4;
+
+  struct Shard {
+    std::mutex mutex;
+    std::atomic<const Table*> table;
+    std::atomic<int> epoch;
+    std::atomic<Nd4jLong> readers[2];
+
+    // entries inserted or evicted since last merge, nullptr value marks evicted key. guarded by mutex
+    Table delta;
+    std::atomic<Nd4jLong> pending;
+
+    // CLOCK ring, guarded by mutex
+    std::vector<K> ring;
+    size_t hand = 0;
+
+    std::atomic<Nd4jLong> entries;
+    std::atomic<Nd4jLong> bytes;
+
+    std::atomic<Nd4jLong> hits;
+    std::atomic<Nd4jLong> misses;
+    std::atomic<Nd4jLong> evictions;
+
+    Shard() : table(new Table()), epoch(0), pending(0), entries(0), bytes(0), hits(0), misses(0), evictions(0) {
+      readers[0] = 0;
+      readers[1] = 0;
+    }
+
+    ~Shard() {
+      delete table.load();
+    }
+  };
+
+  Shard *_shards;
+  int _numShards;
+
+  inline Shard &shardFor(size_t hash) {
+    hash ^= (hash >> 17);
+    return _shards[hash % _numShards];
+  }
+
+  // must be called with shard mutex held, returns live entry for the key or nullptr
+  std::shared_ptr<Entry> lookupLocked(Shard &shard, const K &key) {
+    auto dit = shard.delta.find(key);
+    if (dit != shard.delta.end())
+      return dit->second;
+
+    auto current = shard.table.load();
+    auto it = current->find(key);
+    return it != current->end() ? it->second : nullptr;
+  }
+
+  // lookup of entries which aren't merged into snapshot yet
+  std::shared_ptr<Entry> lookupDelta(Shard &shard, const K &key) {
+    if (shard.pending.load() == 0)
+      return nullptr;
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return lookupLocked(shard, key);
+  }
+
+  std::shared_ptr<Entry> insertEntry(const K &key, size_t hash, const V &value, Nd4jLong bytes, Nd4jLong maxEntries, Nd4jLong maxBytes) {
+    auto &shard = shardFor(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto existing = lookupLocked(shard, key);
+    if (existing != nullptr)
+      return existing;
+
+    auto entry = std::make_shared<Entry>(key, value, bytes);
+    shard.delta[key] = entry;
+    shard.ring.emplace_back(key);
+
+    auto shardBytes = shard.bytes.load() + bytes;
+    auto shardEntries = shard.entries.load() + 1;
+    auto entriesLimit = maxEntries > 0 ? (maxEntries + _numShards - 1) / _numShards : 0;
+    auto bytesLimit = maxBytes > 0 ? (maxBytes + _numShards - 1) / _numShards : 0;
+    evict(shard, entriesLimit, bytesLimit, shardEntries, shardBytes);
+
+    shard.entries.store(shardEntries);
+    shard.bytes.store(shardBytes);
+
+    auto current = shard.table.load();
+    if (shard.delta.size() >= MIN_DELTA && shard.delta.size() >= current->size() / DELTA_FRACTION)
+      merge(shard);
+    else
+      shard.pending.store(shard.delta.size());
+
+    return entry;
+  }
+
+  inline int enterRead(Shard &shard) {
+    while (true) {
+      auto e = shard.epoch.load();
+      shard.readers[e]++;
+
+      // epoch was flipped in between, so writer might not wait for us
+      if (shard.epoch.load() == e)
+        return e;
+
+      shard.readers[e]--;
+    }
+  }
+
+  // must be called with shard mutex held
+  void merge(Shard &shard) {
+    auto table = new Table(*shard.table.load());
+    for (const auto &p : shard.delta) {
+      if (p.second == nullptr)
+        table->erase(p.first);
+      else
+        (*table)[p.first] = p.second;
+    }
+
+    shard.delta.clear();
+    shard.pending.store(0);
+    publish(shard, table);
+  }
+
+  // must be called with shard mutex held
+  void publish(Shard &shard, const Table *table) {
+    auto replaced = shard.table.exchange(table);
+
+    // readers that might still hold replaced snapshot are registered in previous epoch only
+    auto e = shard.epoch.load();
+    shard.epoch.store(e ^ 1);
+    while (shard.readers[e].load() > 0)
+      std::this_thread::yield();
+
+    delete replaced;
+  }
+
+  // must be called with shard mutex held, evicted keys are marked in delta
+  void evict(Shard &shard, Nd4jLong maxEntries, Nd4jLong maxBytes, Nd4jLong &entries, Nd4jLong &bytes) {
+    // every entry gets at most one second chance, so 2 full turns are always enough
+    auto budget = 2 * shard.ring.size();
+    while (!shard.ring.empty() && budget-- > 0) {
+      bool overflow = (maxEntries > 0 && entries > maxEntries) || (maxBytes > 0 && bytes > maxBytes);
+      if (!overflow || entries <= 1)
+        break;
+
+      if (shard.hand >= shard.ring.size())
+        shard.hand = 0;
+
+      auto entry = lookupLocked(shard, shard.ring[shard.hand]);
+      if (entry == nullptr) {
+        shard.ring.erase(shard.ring.begin() + shard.hand);
+        continue;
+      }
+
+      // most recent entry is the one we've just added, it's never a victim
+      if (entry->referenced.exchange(false) || shard.hand == shard.ring.size() - 1) {
+        shard.hand++;
+        continue;
+      }
+
+      bytes -= entry->bytes;
+      entries--;
+      shard.delta[entry->key] = nullptr;
+      shard.ring.erase(shard.ring.begin() + shard.hand);
+      shard.evictions++;
+    }
+  }
+
+ public:
+  explicit ConcurrentCache(int numShards = 32) {
+    _numShards = numShards > 0 ? numShards : 1;
+    _shards = new Shard[_numShards];
+  }
+
+  ~ConcurrentCache() {
+    delete[] _shards;
+  }
+
+  ConcurrentCache(const ConcurrentCache &other) = delete;
+  ConcurrentCache &operator=(const ConcurrentCache &other) = delete;
+
+  /**
+   * This method looks up key without taking any locks
+   * @return true if value was found, false otherwise
+   */
+  bool get(const K &key, V &value) {
+    auto &shard = shardFor(Hash()(key));
+    auto e = enterRead(shard);
+
+    // value is copied while we're still registered as reader, since entry might be evicted right after
+    auto table = shard.table.load();
+    auto it = table->find(key);
+    bool found = it != table->end();
+    if (found) {
+      it->second->referenced.store(true, std::memory_order_relaxed);
+      value = it->second->value;
+    }
+
+    shard.readers[e]--;
+
+    if (!found) {
+      auto entry = lookupDelta(shard, key);
+      found = entry != nullptr;
+      if (found) {
+        entry->referenced.store(true, std::memory_order_relaxed);
+        value = entry->value;
+      }
+    }
+
+    if (found)
+      shard.hits.fetch_add(1, std::memory_order_relaxed);
+    else
+      shard.misses.fetch_add(1, std::memory_order_relaxed);
+
+    return found;
+  }
+
+  /**
+   * This method looks up key without taking any locks
+   * @param hash - precomputed std::hash of the key
+   * @return pointer to cached entry, or nullptr. Pointer stays valid until entry is evicted, so it's safe to keep it only if cache is used without limits
+   */
+  Entry *find(const K &key, size_t hash) {
+    auto &shard = shardFor(hash);
+    auto e = enterRead(shard);
+
+    Entry *entry = nullptr;
+    auto table = shard.table.load();
+    auto it = table->find(key);
+    if (it != table->end()) {
+      entry = it->second.get();
+      entry->referenced.store(true, std::memory_order_relaxed);
+    }
+
+    shard.readers[e]--;
+
+    if (entry == nullptr) {
+      entry = lookupDelta(shard, key).get();
+      if (entry != nullptr)
+        entry->referenced.store(true, std::memory_order_relaxed);
+    }
+
+    if (entry != nullptr)
+      shard.hits.fetch_add(1, std::memory_order_relaxed);
+    else
+      shard.misses.fetch_add(1, std::memory_order_relaxed);
+
+    return entry;
+  }
+
+  /**
+   * This method inserts value if key is absent, and evicts old entries if limits are exceeded
+   * @param maxEntries - total entries limit, 0 means no limit
+   * @param maxBytes - total bytes limit, 0 means no limit
+   * @return value stored in cache for this key, which might be a value inserted concurrently by another thread
+   */
+  V put(const K &key, const V &value, Nd4jLong bytes, Nd4jLong maxEntries = 0, Nd4jLong maxBytes = 0) {
+    return insertEntry(key, Hash()(key), value, bytes, maxEntries, maxBytes)->value;
+  }
+
+  /**
+   * This method inserts value if key is absent, without any eviction
+   * @param hash - precomputed std::hash of the key
+   * @return pointer to cached entry for this key, which might be an entry inserted concurrently by another thread
+   */
+  Entry *insert(const K &key, size_t hash, const V &value, Nd4jLong bytes) {
+    return insertEntry(key, hash, value, bytes, 0, 0).get();
+  }
+
+  /**
+   * This method removes all entries from cache. Counters are preserved.
+   */
+  void clear() {
+    for (int e = 0; e < _numShards; e++) {
+      auto &shard = _shards[e];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      shard.delta.clear();
+      shard.pending.store(0);
+      shard.ring.clear();
+      shard.hand = 0;
+      shard.entries.store(0);
+      shard.bytes.store(0);
+
+      publish(shard, new Table());
+    }
+  }
+
+  Nd4jLong size() const {
+    Nd4jLong r = 0;
+    for (int e = 0; e < _numShards; e++)
+      r += _shards[e].entries.load();
+
+    return r;
+  }
+
+  Nd4jLong bytes() const {
+    Nd4jLong r = 0;
+    for (int e = 0; e < _numShards; e++)
+      r += _shards[e].bytes.load();
+
+    return r;
+  }
+
+  Nd4jLong hits() const {
+    Nd4jLong r = 0;
+    for (int e = 0; e < _numShards; e++)
+      r += _shards[e].hits.load(std::memory_order_relaxed);
+
+    return r;
+  }
+
+  Nd4jLong misses() const {
+    Nd4jLong r = 0;
+    for (int e = 0; e < _numShards; e++)
+      r += _shards[e].misses.load(std::memory_order_relaxed);
+
+    return r;
+  }
+
+  Nd4jLong evictions() const {
+    Nd4jLong r = 0;
+    for (int e = 0; e < _numShards; e++)
+      r += _shards[e].evictions.load();
+
+    return r;
+  }
+};
+
+}
+
+#endif //SD_HELPERS_CONCURRENTCACHE_H
@@ -26,22 +26,31 @@
 #include <system/dll.h>
 #include <system/pointercast.h>
 #include <map>
-#include <mutex>
+#include <memory>
 #include <vector>
 #include <array/ShapeDescriptor.h>
 #include <array/ConstantShapeBuffer.h>
 #include <memory/Workspace.h>
 #include <system/op_boilerplate.h>
+#include <helpers/ConcurrentCache.h>
 
 namespace sd {
 
     class ND4J_EXPORT ConstantShapeHelper {
     private:
-        std::mutex _mutex;
-        std::vector<MAP_IMPL<ShapeDescriptor, ConstantShapeBuffer>> _cache;
+        typedef ConcurrentCache<ShapeDescriptor, ConstantShapeBuffer> ShapeCache;
 
+        // one interning table per device. shapeInfo pointers are handed out as raw pointers, so entries are never evicted
+        std::vector<std::unique_ptr<ShapeCache>> _cache;
 
         ConstantShapeHelper();
+
+        /**
+         * These methods work with per-thread front cache: small direct-mapped table in front of shared one,
+         * hits there don't touch any shared state at all
+         */
+        static ShapeCache::Entry* frontLookup(const ShapeDescriptor &descriptor, size_t hash, int deviceId);
+        static void frontStore(size_t hash, int deviceId, ShapeCache::Entry *entry);
     public:
         ~ConstantShapeHelper() = default;
 
@@ -79,7 +88,7 @@ namespace sd {
             if (deviceId > _cache.size())
                 throw std::runtime_error("deviceId > number of actual devices");
 
-            return _cache[deviceId].size();
+            return _cache[deviceId]->size();
         }
 
         /**
@@ -90,7 +99,27 @@ namespace sd {
             int total = 0;
 
             for (int e = 0; e < _cache.size(); e++)
-                total += _cache[e].size();
+                total += _cache[e]->size();
+
+            return total;
+        }
+
+        /**
+         * These methods return shared table statistics, summed over all devices. Front cache hits aren't counted here
+         * @return
+         */
+        FORCEINLINE Nd4jLong cacheHits() {
+            Nd4jLong total = 0;
+            for (const auto &c : _cache)
+                total += c->hits();
+
+            return total;
+        }
+
+        FORCEINLINE Nd4jLong cacheMisses() {
+            Nd4jLong total = 0;
+            for (const auto &c : _cache)
+                total += c->misses();
 
             return total;
         }
@@ -29,16 +29,19 @@
 #include <system/pointercast.h>
 #include <map>
 #include <vector>
-#include <mutex>
+#include <memory>
 #include <array/ShapeDescriptor.h>
 #include <array/TadDescriptor.h>
 #include <array/TadPack.h>
+#include <helpers/ConcurrentCache.h>
 
 namespace sd {
     class ND4J_EXPORT ConstantTadHelper {
     private:
-        std::mutex _mutex;
-        std::vector<MAP_IMPL<TadDescriptor, TadPack>> _cache;
+        // one cache per device. lookups are lock-free, see ConcurrentCache
+        std::vector<std::unique_ptr<ConcurrentCache<TadDescriptor, TadPack>>> _cache;
+
+        TadPack buildTadPack(TadDescriptor &descriptor);
 
         ConstantTadHelper();
     public:
@@ -68,7 +71,7 @@ namespace sd {
             if (deviceId > _cache.size())
                 throw std::runtime_error("deviceId > number of actual devices");
 
-            return _cache[deviceId].size();
+            return _cache[deviceId]->size();
         }
 
         /**
@@ -79,10 +82,54 @@ namespace sd {
             int total = 0;
 
             for (int e = 0; e < _cache.size(); e++)
-                total += _cache[e].size();
+                total += _cache[e]->size();
+
+            return total;
+        }
+
+        /**
+         * These methods return cache statistics, summed over all devices
+         * @return
+         */
+        FORCEINLINE Nd4jLong cacheHits() {
+            Nd4jLong total = 0;
+            for (const auto &c : _cache)
+                total += c->hits();
+
+            return total;
+        }
+
+        FORCEINLINE Nd4jLong cacheMisses() {
+            Nd4jLong total = 0;
+            for (const auto &c : _cache)
+                total += c->misses();
 
             return total;
         }
+
+        FORCEINLINE Nd4jLong cacheEvictions() {
+            Nd4jLong total = 0;
+            for (const auto &c : _cache)
+                total += c->evictions();
+
+            return total;
+        }
+
+        FORCEINLINE Nd4jLong cachedBytes() {
+            Nd4jLong total = 0;
+            for (const auto &c : _cache)
+                total += c->bytes();
+
+            return total;
+        }
+
+        /**
+         * This method drops all cached TAD packs. Packs already handed out stay valid, since buffers are ref-counted
+         */
+        FORCEINLINE void clearCache() {
+            for (const auto &c : _cache)
+                c->clear();
+        }
     };
 }
 
@@ -0,0 +1,61 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_FLOATCONVERSIONS_H
+#define LIBND4J_FLOATCONVERSIONS_H
+
+#include <system/pointercast.h>
+#include <system/dll.h>
+#include <array/DataType.h>
+#include <types/float16.h>
+#include <types/bfloat16.h>
+
+namespace sd {
+    /**
+     * This class converts contiguous buffers between FLOAT32, DOUBLE, HALF and BFLOAT16 with vectorized kernels:
+     * F16C for half (if CPU supports it), bit tricks for bfloat16, plain casts for double. Pairs without float32
+     * on either side are converted via float32 in cache-sized blocks.
+     *
+     * Results match per-element static_cast through float, except for NaN payloads of half conversions
+     */
+    class ND4J_EXPORT FloatConversions {
+    public:
+        /**
+         * This method returns TRUE if conversion between given types is handled here
+         */
+        static bool isSupported(sd::DataType xType, sd::DataType zType);
+
+        /**
+         * This method converts length elements, split between threads if parallel is TRUE.
+         * Returns FALSE and converts nothing if pair of types isn't supported
+         */
+        static bool convert(sd::DataType xType, const void *x, sd::DataType zType, void *z, Nd4jLong length, bool parallel = true);
+
+        /**
+         * Single-threaded kernels
+         */
+        static void convert(const float16 *x, float *z, Nd4jLong length);
+        static void convert(const float *x, float16 *z, Nd4jLong length);
+        static void convert(const bfloat16 *x, float *z, Nd4jLong length);
+        static void convert(const float *x, bfloat16 *z, Nd4jLong length);
+        static void convert(const double *x, float *z, Nd4jLong length);
+        static void convert(const float *x, double *z, Nd4jLong length);
+    };
+}
+
+#endif //LIBND4J_FLOATCONVERSIONS_H
@@ -0,0 +1,196 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_FUSEDLOOPS_H
+#define LIBND4J_FUSEDLOOPS_H
+
+#include <system/pointercast.h>
+#include <system/openmp_pragmas.h>
+#include <helpers/shape.h>
+#include <helpers/LoopKind.h>
+#include <execution/Threads.h>
+#include <vector>
+
+namespace sd {
+
+    /**
+     * Steps of compile-time fused chains. Every step gets value produced by previous step and logical (c-order) index of element.
+     * OpType is any simdOps op of matching arity, i.e. simdOps::Tanh<X> for Transform, simdOps::Multiply<X,X,X> for others
+     */
+    namespace fused {
+
+        // z = op(z)
+        template <typename X, typename OpType>
+        class Transform {
+        private:
+            X *_params;
+
+        public:
+            explicit Transform(X *params = nullptr) : _params(params) { }
+
+            FORCEINLINE X operator()(X value, Nd4jLong i) const {
+                return OpType::op(value, _params);
+            }
+        };
+
+        // z = op(z, scalar)
+        template <typename X, typename OpType>
+        class Scalar {
+        private:
+            X _scalar;
+            X *_params;
+
+        public:
+            explicit Scalar(X scalar, X *params = nullptr) : _scalar(scalar), _params(params) { }
+
+            FORCEINLINE X operator()(X value, Nd4jLong i) const {
+                return OpType::op(value, _scalar, _params);
+            }
+        };
+
+        // z = op(z, y), y has the same shape as z
+        template <typename X, typename OpType>
+        class Pairwise {
+        private:
+            const X *_y;
+            const Nd4jLong *_yShapeInfo;
+            bool _linear;
+            X *_params;
+
+        public:
+            Pairwise(const X *y, const Nd4jLong *yShapeInfo, X *params = nullptr) : _y(y), _yShapeInfo(yShapeInfo), _params(params) {
+                _linear = shape::order(yShapeInfo) == 'c' && shape::elementWiseStride(yShapeInfo) == 1;
+            }
+
+            FORCEINLINE X operator()(X value, Nd4jLong i) const {
+                return OpType::op(value, _y[_linear ? i : shape::getIndexOffset(i, _yShapeInfo)], _params);
+            }
+        };
+
+        // z = op(z, y), y is vector applied along given axis of z, i.e. bias or gain
+        template <typename X, typename OpType>
+        class Broadcast {
+        private:
+            const X *_y;
+            Nd4jLong _yEws;
+            Nd4jLong _length;
+            Nd4jLong _inner = 1;
+            X *_params;
+
+        public:
+            Broadcast(const X *y, const Nd4jLong *yShapeInfo, const Nd4jLong *zShapeInfo, int axis, X *params = nullptr) : _y(y), _params(params) {
+                _yEws = shape::elementWiseStride(yShapeInfo);
+                _length = shape::sizeAt(zShapeInfo, axis);
+                for (int e = axis + 1; e < shape::rank(zShapeInfo); e++)
+                    _inner *= shape::sizeAt(zShapeInfo, e);
+            }
+
+            FORCEINLINE X operator()(X value, Nd4jLong i) const {
+                return OpType::op(value, _y[((i / _inner) % _length) * _yEws], _params);
+            }
+        };
+
+        template <typename X>
+        FORCEINLINE X applySteps(X value, Nd4jLong i) {
+            return value;
+        }
+
+        template <typename X, typename Step, typename... Steps>
+        FORCEINLINE X applySteps(X value, Nd4jLong i, const Step &step, const Steps&... steps) {
+            return applySteps<X>(step(value, i), i, steps...);
+        }
+    }
+
+    /**
+     * Single step of runtime fused program, i.e. one legacy op node of the graph
+     */
+    class ND4J_EXPORT FusedStep {
+    public:
+        enum Kind { TRANSFORM_STRICT, TRANSFORM_SAME, SCALAR, PAIRWISE };
+
+        Kind kind;
+        int opNum;
+
+        // SCALAR only
+        double scalar = 0.0;
+
+        // PAIRWISE only, y has the same shape as z, or it's a scalar
+        const void *y = nullptr;
+        const Nd4jLong *yShapeInfo = nullptr;
+    };
+
+    /**
+     * This class applies chains of elementwise ops in a single pass over memory
+     */
+    template <typename X>
+    class ND4J_EXPORT FusedLoops {
+    public:
+        /**
+         * Compile-time chain: intermediate values never leave registers, i.e.
+         * FusedLoops<float>::exec(x, xShape, z, zShape, fused::Broadcast<float, simdOps::Multiply<float, float, float>>(g, gShape, zShape, 1), fused::Transform<float, simdOps::Tanh<float>>());
+         */
+        template <typename... Steps>
+        static void exec(const X *x, const Nd4jLong *xShapeInfo, X *z, const Nd4jLong *zShapeInfo, const Steps&... steps);
+
+        /**
+         * Runtime chain of legacy ops: every step is applied to a cache-resident block of elements before moving to the next block.
+         * X is float type here
+         */
+        static void execProgram(const std::vector<FusedStep> &program, const void *vx, const Nd4jLong *xShapeInfo, void *vz, const Nd4jLong *zShapeInfo);
+
+    protected:
+        template <typename OpType>
+        static void transformBlock(X *buffer, Nd4jLong length);
+
+        template <typename OpType>
+        static void scalarBlock(X *buffer, X scalar, Nd4jLong length);
+
+        template <typename OpType>
+        static void pairwiseBlock(X *buffer, const X *y, Nd4jLong length);
+    };
+
+    template <typename X>
+    template <typename... Steps>
+    void FusedLoops<X>::exec(const X *x, const Nd4jLong *xShapeInfo, X *z, const Nd4jLong *zShapeInfo, const Steps&... steps) {
+        const Nd4jLong length = shape::length(zShapeInfo);
+        const auto kind = LoopKind::deduceKindOfLoopXZ(xShapeInfo, zShapeInfo);
+
+        // steps use logical index, so memory order must match it for linear loops
+        const bool cOrder = shape::order(xShapeInfo) == 'c' && shape::order(zShapeInfo) == 'c';
+        const Nd4jLong xEws = shape::elementWiseStride(xShapeInfo);
+        const Nd4jLong zEws = shape::elementWiseStride(zShapeInfo);
+
+        auto func = PRAGMA_THREADS_FOR {
+            if (kind == LoopKind::EWS1 && cOrder) {
+                PRAGMA_OMP_SIMD
+                for (auto i = start; i < stop; i++)
+                    z[i] = fused::applySteps<X>(x[i], i, steps...);
+            } else if (kind == LoopKind::EWSNONZERO && cOrder) {
+                for (auto i = start; i < stop; i++)
+                    z[i * zEws] = fused::applySteps<X>(x[i * xEws], i, steps...);
+            } else {
+                for (auto i = start; i < stop; i++)
+                    z[shape::getIndexOffset(i, zShapeInfo)] = fused::applySteps<X>(x[shape::getIndexOffset(i, xShapeInfo)], i, steps...);
+            }
+        };
+
+        samediff::Threads::parallel_for(func, 0, length);
+    }
+}
+
+#endif //LIBND4J_FUSEDLOOPS_H
@@ -34,6 +34,7 @@
 #include <helpers/ConstantTadHelper.h>
 #include <system/openmp_pragmas.h>
 #include <execution/Threads.h>
+#include <system/CpuDispatch.h>
 
 namespace sd {
 
@@ -94,6 +95,20 @@ namespace sd {
     };
 
 
+    template <typename X, typename Z, typename E, typename OpType>
+    struct TransformEwsKernel {
+        static FORCEINLINE void run(const X* x, Nd4jLong xEws, Z* z, Nd4jLong zEws, E* extraParams, int64_t start, int64_t stop) {
+            if (xEws == 1 && zEws == 1) {
+                for (auto i = start; i < stop; i++)
+                    z[i] = OpType::op(x[i], extraParams);
+            }
+            else {
+                for (auto i = start; i < stop; i++)
+                    z[i * zEws] = OpType::op(x[i * xEws], extraParams);
+            }
+        }
+    };
+
     template <typename X, typename Z, typename E>
     class ND4J_LOCAL TransformLoops {
 
@@ -755,25 +770,15 @@ ND4J_LOCAL void sd::ReductionLoops<X, Z, E>::loopReduce(sd::memory::Workspace* w
         switch (kindOfLoop) {
 
             //*********************************************//
-        case LoopKind::EWS1: {
-            auto span = samediff::Span::build(threadId, numThreads, 0, len, 1);
-            int64_t start = span.startX(), stop = span.stopX();
-
-            for (auto i = start; i < stop; i++)
-                z[i] = OpType::op(x[i], extraParams);
-        }
-        break;
-
-        //*********************************************//
+        case LoopKind::EWS1:
         case LoopKind::EWSNONZERO: {
-            const uint xEws = shape::elementWiseStride(xShapeInfo);
-            const uint zEws = shape::elementWiseStride(zShapeInfo);
+            const Nd4jLong xEws = shape::elementWiseStride(xShapeInfo);
+            const Nd4jLong zEws = shape::elementWiseStride(zShapeInfo);
 
             auto span = samediff::Span::build(threadId, numThreads, 0, len, 1);
             int64_t start = span.startX(), stop = span.stopX();
 
-            for (auto i = start; i < stop; i++)
-                z[i * zEws] = OpType::op(x[i * xEws], extraParams);
+            sd::cpuDispatch<TransformEwsKernel<X, Z, E, OpType>>(x, xEws, z, zEws, extraParams, start, stop);
         }
         break;
 
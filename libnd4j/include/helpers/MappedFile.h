@@ -0,0 +1,63 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_MAPPEDFILE_H
+#define LIBND4J_MAPPEDFILE_H
+
+#include <system/pointercast.h>
+#include <system/dll.h>
+#include <cstdint>
+
+namespace sd {
+    /**
+     * This class maps whole file into memory, and unmaps it once destroyed.
+     *
+     * Mapping is private and copy-on-write: pages are shared with page cache (and other processes mapping the same file)
+     * until they're written to, and writes never reach the file
+     */
+    class ND4J_EXPORT MappedFile {
+    private:
+        uint8_t *_data = nullptr;
+        Nd4jLong _length = 0;
+
+#if defined(_WIN32) || defined(_WIN64)
+        void *_file = nullptr;
+        void *_mapping = nullptr;
+#endif
+
+    public:
+        /**
+         * @throws std::runtime_error if file can't be opened or mapped
+         */
+        explicit MappedFile(const char *fileName);
+        ~MappedFile();
+
+        MappedFile(const MappedFile &other) = delete;
+        MappedFile& operator=(const MappedFile &other) = delete;
+
+        uint8_t* data() const;
+        Nd4jLong length() const;
+
+        /**
+         * This method returns TRUE if numBytes bytes starting at ptr are all within mapped file
+         */
+        bool contains(const void *ptr, Nd4jLong numBytes) const;
+    };
+}
+
+#endif //LIBND4J_MAPPEDFILE_H
@@ -0,0 +1,231 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_OPENHASHTABLE_H
+#define LIBND4J_OPENHASHTABLE_H
+
+#include <system/pointercast.h>
+#include <system/openmp_pragmas.h>
+#include <helpers/PrefixScan.h>
+#include <execution/Threads.h>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sd {
+
+    /**
+     * Open-addressing hash table with linear probing, mapping keys to Nd4jLong values.
+     * Keys, values and occupancy flags are kept in flat arrays, so there are no allocations per element.
+     * Keys are compared with their operator==, so every NaN is distinct key
+     */
+    template <typename K>
+    class OpenHashTable {
+    protected:
+        std::vector<K> _keys;
+        std::vector<Nd4jLong> _values;
+        std::vector<int8_t> _used;
+        Nd4jLong _mask;
+        Nd4jLong _size = 0;
+
+        static FORCEINLINE uint64_t bits(const K &key, std::true_type) {
+            return static_cast<uint64_t>(key);
+        }
+
+        static FORCEINLINE uint64_t bits(const K &key, std::false_type) {
+            // equal keys must have equal hashes, and -0 == 0 for float and double
+            double value = static_cast<double>(key);
+            if (value == 0.0)
+                value = 0.0;
+
+            uint64_t result;
+            std::memcpy(&result, &value, sizeof(result));
+            return result;
+        }
+
+        static FORCEINLINE uint64_t hash(const K &key) {
+            // splitmix64 finalizer, sequential ids are spread over the whole table
+            uint64_t h = bits(key, std::integral_constant<bool, std::is_integral<K>::value>());
+            h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+            return h ^ (h >> 31);
+        }
+
+        void rehash(Nd4jLong capacity) {
+            std::vector<K> keys(capacity);
+            std::vector<Nd4jLong> values(capacity);
+            std::vector<int8_t> used(capacity, 0);
+
+            const Nd4jLong mask = capacity - 1;
+            for (Nd4jLong e = 0; e < (Nd4jLong) _used.size(); e++) {
+                if (!_used[e])
+                    continue;
+
+                auto slot = static_cast<Nd4jLong>(hash(_keys[e]) & mask);
+                while (used[slot])
+                    slot = (slot + 1) & mask;
+
+                keys[slot] = _keys[e];
+                values[slot] = _values[e];
+                used[slot] = 1;
+            }
+
+            _keys.swap(keys);
+            _values.swap(values);
+            _used.swap(used);
+            _mask = mask;
+        }
+
+    public:
+        /**
+         * expected is number of distinct keys table is sized for, table grows if there are more
+         */
+        explicit OpenHashTable(Nd4jLong expected = 16) {
+            Nd4jLong capacity = 16;
+            while (capacity < 2 * expected)
+                capacity <<= 1;
+
+            _keys.resize(capacity);
+            _values.resize(capacity);
+            _used.resize(capacity, 0);
+            _mask = capacity - 1;
+        }
+
+        /**
+         * Inserts key with given value if it's absent. Returns value stored for the key, and TRUE if it was inserted
+         */
+        FORCEINLINE std::pair<Nd4jLong, bool> emplace(const K &key, Nd4jLong value) {
+            auto slot = static_cast<Nd4jLong>(hash(key) & _mask);
+            while (_used[slot]) {
+                if (_keys[slot] == key)
+                    return std::pair<Nd4jLong, bool>(_values[slot], false);
+
+                slot = (slot + 1) & _mask;
+            }
+
+            _keys[slot] = key;
+            _values[slot] = value;
+            _used[slot] = 1;
+
+            // load factor is kept at 1/2 at most, so probe sequences stay short
+            if (++_size * 2 > _mask + 1)
+                rehash(2 * (_mask + 1));
+
+            return std::pair<Nd4jLong, bool>(value, true);
+        }
+
+        /**
+         * Returns value stored for the key, or -1 if there's no such key
+         */
+        FORCEINLINE Nd4jLong get(const K &key) const {
+            auto slot = static_cast<Nd4jLong>(hash(key) & _mask);
+            while (_used[slot]) {
+                if (_keys[slot] == key)
+                    return _values[slot];
+
+                slot = (slot + 1) & _mask;
+            }
+
+            return -1;
+        }
+
+        Nd4jLong size() const {
+            return _size;
+        }
+    };
+
+    /**
+     * Groups elements with equal keys, i.e. for unique values or segment ids. Every thread groups its own range of elements
+     * within private table, and these tables are merged afterwards, so distinct keys are ordered by their first appearance.
+     *
+     * key(e) returns key of e-th element, groups gets index of element's key within distinct for every element,
+     * counts gets number of elements with every distinct key
+     */
+    template <typename K, typename KeyGetter>
+    void groupByKey(Nd4jLong length, const KeyGetter &key, std::vector<K> &distinct, Nd4jLong *groups, std::vector<Nd4jLong> &counts) {
+        distinct.clear();
+        counts.clear();
+
+        const Nd4jLong numChunks = PrefixScan::numberOfChunks(length);
+        const Nd4jLong chunk = (length + numChunks - 1) / numChunks;
+
+        std::vector<std::vector<K>> localKeys(numChunks);
+        std::vector<std::vector<Nd4jLong>> localCounts(numChunks);
+
+        auto buildChunks = PRAGMA_THREADS_FOR {
+            for (auto c = start; c < stop; c++) {
+                const auto last = sd::math::nd4j_min<Nd4jLong>((c + 1) * chunk, length);
+                OpenHashTable<K> table;
+                auto &keys = localKeys[c];
+                auto &cnts = localCounts[c];
+
+                for (auto e = c * chunk; e < last; e++) {
+                    const K k = key(e);
+                    const auto r = table.emplace(k, (Nd4jLong) keys.size());
+                    if (r.second) {
+                        keys.emplace_back(k);
+                        cnts.emplace_back(0);
+                    }
+
+                    cnts[r.first]++;
+                    groups[e] = r.first;
+                }
+            }
+        };
+
+        samediff::Threads::parallel_for(buildChunks, 0, numChunks, 1, numChunks);
+
+        // chunks are merged in order, so global order of first appearance is kept
+        Nd4jLong maxLocal = 0;
+        for (const auto &keys : localKeys)
+            maxLocal = sd::math::nd4j_max<Nd4jLong>(maxLocal, keys.size());
+
+        OpenHashTable<K> table(maxLocal);
+        std::vector<std::vector<Nd4jLong>> remap(numChunks);
+        for (Nd4jLong c = 0; c < numChunks; c++) {
+            remap[c].resize(localKeys[c].size());
+            for (Nd4jLong l = 0; l < (Nd4jLong) localKeys[c].size(); l++) {
+                const auto r = table.emplace(localKeys[c][l], (Nd4jLong) distinct.size());
+                if (r.second) {
+                    distinct.emplace_back(localKeys[c][l]);
+                    counts.emplace_back(0);
+                }
+
+                counts[r.first] += localCounts[c][l];
+                remap[c][l] = r.first;
+            }
+        }
+
+        // first chunk has the same local and global ids
+        if (numChunks < 2)
+            return;
+
+        auto remapChunks = PRAGMA_THREADS_FOR {
+            for (auto c = start; c < stop; c++) {
+                const auto last = sd::math::nd4j_min<Nd4jLong>((c + 1) * chunk, length);
+                for (auto e = c * chunk; e < last; e++)
+                    groups[e] = remap[c][groups[e]];
+            }
+        };
+
+        samediff::Threads::parallel_for(remapChunks, 1, numChunks, 1, numChunks - 1);
+    }
+}
+
+#endif //LIBND4J_OPENHASHTABLE_H
@@ -0,0 +1,53 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_PACKEDGEMM_H
+#define LIBND4J_PACKEDGEMM_H
+
+#include <system/dll.h>
+#include <system/pointercast.h>
+#include <array/DataType.h>
+
+namespace sd {
+    /**
+     * Native cache-blocked GEMM for data types BLAS doesn't cover.
+     *
+     * Both operands are packed into MR/NR-wide panels (converted to accumulation type on the way, or into
+     * pairs/quads of values for AVX512-BF16/VNNI kernels), and C is computed tile by tile with register-blocked micro-kernels.
+     * Half precision types are accumulated in float, integer types up to 32 bits in int32.
+     */
+    class ND4J_EXPORT PackedGemm {
+    public:
+        /**
+         * This method checks if engine has kernels for given data type
+         */
+        static bool isSupported(sd::DataType dataType);
+
+        /**
+         * C = alpha * A x B + beta * C, where A is [M, K], B is [K, N] and C is [M, N]. All arrays have the same data type.
+         * Strides are given in elements, so any ordering or transposed views are accepted as is
+         * @param numThreads - max number of threads to use, 0 means Environment::maxThreads()
+         */
+        static void gemm(sd::DataType dataType, Nd4jLong M, Nd4jLong N, Nd4jLong K, double alpha,
+                         const void *A, Nd4jLong aStrideM, Nd4jLong aStrideK,
+                         const void *B, Nd4jLong bStrideK, Nd4jLong bStrideN,
+                         double beta, void *C, Nd4jLong cStrideM, Nd4jLong cStrideN, int numThreads = 0);
+    };
+}
+
+#endif //LIBND4J_PACKEDGEMM_H
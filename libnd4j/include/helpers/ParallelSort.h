@@ -0,0 +1,379 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_PARALLELSORT_H
+#define LIBND4J_PARALLELSORT_H
+
+#include <system/pointercast.h>
+#include <system/openmp_pragmas.h>
+#include <system/Environment.h>
+#include <math/templatemath.h>
+#include <execution/Threads.h>
+#include <types/float16.h>
+#include <types/bfloat16.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sd {
+
+    /**
+     * Order-preserving mapping of keys to unsigned integers for radix sort: a < b if and only if encode(a) < encode(b).
+     * Types without specialization are sorted with merge sort
+     */
+    template <typename T, typename Enable = void>
+    struct RadixKey {
+        static const bool enabled = false;
+    };
+
+    template <typename T>
+    struct RadixKey<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> {
+        static const bool enabled = true;
+        static const int bytes = sizeof(T);
+        typedef typename std::conditional<sizeof(T) <= 4, uint32_t, uint64_t>::type Type;
+        typedef typename std::make_unsigned<T>::type Unsigned;
+
+        // signed values get their sign bit flipped, so negative values go first
+        static FORCEINLINE Type sign() { return std::is_signed<T>::value ? static_cast<Type>(1) << (8 * sizeof(T) - 1) : 0; }
+        static FORCEINLINE Type encode(T value) { return static_cast<Type>(static_cast<Unsigned>(value)) ^ sign(); }
+        static FORCEINLINE T decode(Type key) { return static_cast<T>(static_cast<Unsigned>(key ^ sign())); }
+    };
+
+    template <>
+    struct RadixKey<bool> {
+        static const bool enabled = true;
+        static const int bytes = 1;
+        typedef uint32_t Type;
+
+        static FORCEINLINE Type encode(bool value) { return value ? 1 : 0; }
+        static FORCEINLINE bool decode(Type key) { return (key & 1) != 0; }
+    };
+
+    // negative floats get all bits flipped, positive ones get sign bit set
+    template <>
+    struct RadixKey<float> {
+        static const bool enabled = true;
+        static const int bytes = 4;
+        typedef uint32_t Type;
+
+        static FORCEINLINE Type encode(float value) {
+            Type bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return (bits & 0x80000000U) ? ~bits : bits | 0x80000000U;
+        }
+
+        static FORCEINLINE float decode(Type key) {
+            Type bits = (key & 0x80000000U) ? key & 0x7fffffffU : ~key;
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    };
+
+    template <>
+    struct RadixKey<double> {
+        static const bool enabled = true;
+        static const int bytes = 8;
+        typedef uint64_t Type;
+
+        static FORCEINLINE Type encode(double value) {
+            Type bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return (bits & 0x8000000000000000ULL) ? ~bits : bits | 0x8000000000000000ULL;
+        }
+
+        static FORCEINLINE double decode(Type key) {
+            Type bits = (key & 0x8000000000000000ULL) ? key & 0x7fffffffffffffffULL : ~key;
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    };
+
+    // half types are widened to float, which is exact
+    template <>
+    struct RadixKey<float16> {
+        static const bool enabled = true;
+        static const int bytes = 4;
+        typedef uint32_t Type;
+
+        static FORCEINLINE Type encode(float16 value) { return RadixKey<float>::encode(static_cast<float>(value)); }
+        static FORCEINLINE float16 decode(Type key) { return static_cast<float16>(RadixKey<float>::decode(key)); }
+    };
+
+    template <>
+    struct RadixKey<bfloat16> {
+        static const bool enabled = true;
+        static const int bytes = 4;
+        typedef uint32_t Type;
+
+        static FORCEINLINE Type encode(bfloat16 value) { return RadixKey<float>::encode(static_cast<float>(value)); }
+        static FORCEINLINE bfloat16 decode(Type key) { return static_cast<bfloat16>(RadixKey<float>::decode(key)); }
+    };
+
+    /**
+     * Stable parallel sorts of contiguous buffers: LSD radix sort for arithmetic keys, merge sort for everything else
+     */
+    class ND4J_EXPORT ParallelSort {
+    public:
+        /**
+         * Sorts keys, equal keys keep their relative order
+         */
+        template <typename T>
+        static void sort(T *keys, Nd4jLong length, bool descending, int numThreads = sd::Environment::getInstance().maxMasterThreads());
+
+        /**
+         * Sorts keys, and moves values along with them. Equal keys keep relative order of their values
+         */
+        template <typename K, typename V>
+        static void sortByKey(K *keys, V *values, Nd4jLong length, bool descending, int numThreads = sd::Environment::getInstance().maxMasterThreads());
+
+        /**
+         * Stable merge sort with custom strict weak ordering: chunks are sorted by their threads, then merged pairwise
+         */
+        template <typename T, typename Comparator>
+        static void mergeSort(T *data, Nd4jLong length, const Comparator &less, int numThreads = sd::Environment::getInstance().maxMasterThreads());
+
+        /**
+         * Number of threads worth splitting sort of given length between, at most numThreads
+         */
+        static FORCEINLINE int numberOfChunks(Nd4jLong length, int numThreads) {
+            // smaller chunks don't pay off extra passes and synchronization
+            const Nd4jLong minChunk = 32768;
+            return static_cast<int>(sd::math::nd4j_max<Nd4jLong>(1, sd::math::nd4j_min<Nd4jLong>(numThreads, length / minChunk)));
+        }
+
+    protected:
+        template <typename U, typename V>
+        static void radixSort(U *keys, V *values, Nd4jLong length, int bytes, int numThreads);
+
+        template <typename K, typename V>
+        static void sortByKey_(K *keys, V *values, Nd4jLong length, bool descending, int numThreads, std::true_type);
+
+        template <typename K, typename V>
+        static void sortByKey_(K *keys, V *values, Nd4jLong length, bool descending, int numThreads, std::false_type);
+    };
+
+    template <typename U, typename V>
+    void ParallelSort::radixSort(U *keys, V *values, Nd4jLong length, int bytes, int numThreads) {
+        const int numChunks = numberOfChunks(length, numThreads);
+        const Nd4jLong chunk = (length + numChunks - 1) / numChunks;
+
+        // keys and values can be bool, and std::vector<bool> packs them into bits, so threads scattering
+        // their chunks into neighbouring positions would race on the same words. Plain arrays don't have that problem
+        std::unique_ptr<U[]> keysBuffer(new U[length]);
+        std::unique_ptr<V[]> valuesBuffer(values != nullptr ? new V[length] : nullptr);
+        std::vector<Nd4jLong> histogram(numChunks * 256);
+
+        U *srcKeys = keys, *dstKeys = keysBuffer.get();
+        V *srcValues = values, *dstValues = valuesBuffer.get();
+
+        for (int pass = 0; pass < bytes; pass++) {
+            const int shift = 8 * pass;
+
+            auto count = PRAGMA_THREADS_FOR {
+                for (auto c = start; c < stop; c++) {
+                    auto h = histogram.data() + c * 256;
+                    std::fill(h, h + 256, 0);
+
+                    const auto last = sd::math::nd4j_min<Nd4jLong>((c + 1) * chunk, length);
+                    for (auto e = c * chunk; e < last; e++)
+                        h[(srcKeys[e] >> shift) & 0xff]++;
+                }
+            };
+
+            samediff::Threads::parallel_for(count, 0, numChunks, 1, numChunks);
+
+            // digit shared by all keys doesn't change order, i.e. upper bytes of small values
+            bool trivial = false;
+            for (int d = 0; d < 256 && !trivial; d++) {
+                Nd4jLong total = 0;
+                for (int c = 0; c < numChunks; c++)
+                    total += histogram[c * 256 + d];
+
+                trivial = total == length;
+            }
+
+            if (trivial)
+                continue;
+
+            // every chunk writes its keys of every digit right after keys of the same digit from previous chunks
+            Nd4jLong position = 0;
+            for (int d = 0; d < 256; d++) {
+                for (int c = 0; c < numChunks; c++) {
+                    const auto cnt = histogram[c * 256 + d];
+                    histogram[c * 256 + d] = position;
+                    position += cnt;
+                }
+            }
+
+            auto scatter = PRAGMA_THREADS_FOR {
+                for (auto c = start; c < stop; c++) {
+                    auto h = histogram.data() + c * 256;
+
+                    const auto last = sd::math::nd4j_min<Nd4jLong>((c + 1) * chunk, length);
+                    for (auto e = c * chunk; e < last; e++) {
+                        const auto p = h[(srcKeys[e] >> shift) & 0xff]++;
+                        dstKeys[p] = srcKeys[e];
+                        if (srcValues != nullptr)
+                            dstValues[p] = srcValues[e];
+                    }
+                }
+            };
+
+            samediff::Threads::parallel_for(scatter, 0, numChunks, 1, numChunks);
+
+            std::swap(srcKeys, dstKeys);
+            std::swap(srcValues, dstValues);
+        }
+
+        if (srcKeys != keys) {
+            auto copy = PRAGMA_THREADS_FOR {
+                for (auto e = start; e < stop; e++) {
+                    keys[e] = srcKeys[e];
+                    if (values != nullptr)
+                        values[e] = srcValues[e];
+                }
+            };
+
+            samediff::Threads::parallel_for(copy, 0, length, 1, numChunks);
+        }
+    }
+
+    template <typename T, typename Comparator>
+    void ParallelSort::mergeSort(T *data, Nd4jLong length, const Comparator &less, int numThreads) {
+        // number of chunks is power of 2, so every merge round halves it
+        int numChunks = 1;
+        while (numChunks * 2 <= numberOfChunks(length, numThreads))
+            numChunks *= 2;
+
+        if (numChunks == 1) {
+            std::stable_sort(data, data + length, less);
+            return;
+        }
+
+        const Nd4jLong chunk = (length + numChunks - 1) / numChunks;
+
+        auto sortChunks = PRAGMA_THREADS_FOR {
+            for (auto c = start; c < stop; c++) {
+                const auto first = sd::math::nd4j_min<Nd4jLong>(c * chunk, length);
+                const auto last = sd::math::nd4j_min<Nd4jLong>((c + 1) * chunk, length);
+                std::stable_sort(data + first, data + last, less);
+            }
+        };
+
+        samediff::Threads::parallel_for(sortChunks, 0, numChunks, 1, numChunks);
+
+        std::unique_ptr<T[]> buffer(new T[length]);
+        T *src = data, *dst = buffer.get();
+
+        for (Nd4jLong width = chunk; width < length; width *= 2) {
+            const Nd4jLong numPairs = (length + 2 * width - 1) / (2 * width);
+
+            // std::merge takes equal elements from the first range first, so merge is stable
+            auto mergePairs = PRAGMA_THREADS_FOR {
+                for (auto p = start; p < stop; p++) {
+                    const auto first = p * 2 * width;
+                    const auto middle = sd::math::nd4j_min<Nd4jLong>(first + width, length);
+                    const auto last = sd::math::nd4j_min<Nd4jLong>(first + 2 * width, length);
+                    std::merge(src + first, src + middle, src + middle, src + last, dst + first, less);
+                }
+            };
+
+            samediff::Threads::parallel_for(mergePairs, 0, numPairs, 1, numPairs);
+            std::swap(src, dst);
+        }
+
+        if (src != data)
+            std::copy(src, src + length, data);
+    }
+
+    template <typename K, typename V>
+    void ParallelSort::sortByKey_(K *keys, V *values, Nd4jLong length, bool descending, int numThreads, std::true_type) {
+        typedef typename RadixKey<K>::Type U;
+        std::unique_ptr<U[]> encoded(new U[length]);
+
+        // descending order is ascending order of inverted keys
+        const U mask = descending ? ~static_cast<U>(0) : static_cast<U>(0);
+
+        auto encode = PRAGMA_THREADS_FOR {
+            for (auto e = start; e < stop; e++)
+                encoded[e] = RadixKey<K>::encode(keys[e]) ^ mask;
+        };
+
+        samediff::Threads::parallel_for(encode, 0, length, 1, numThreads);
+
+        radixSort<U, V>(encoded.get(), values, length, RadixKey<K>::bytes, numThreads);
+
+        auto decode = PRAGMA_THREADS_FOR {
+            for (auto e = start; e < stop; e++)
+                keys[e] = RadixKey<K>::decode(encoded[e] ^ mask);
+        };
+
+        samediff::Threads::parallel_for(decode, 0, length, 1, numThreads);
+    }
+
+    template <typename K, typename V>
+    void ParallelSort::sortByKey_(K *keys, V *values, Nd4jLong length, bool descending, int numThreads, std::false_type) {
+        // permutation is sorted, and then applied to keys and values
+        std::vector<Nd4jLong> order(length);
+        for (Nd4jLong e = 0; e < length; e++)
+            order[e] = e;
+
+        if (descending)
+            mergeSort(order.data(), length, [keys](Nd4jLong a, Nd4jLong b) -> bool { return keys[b] < keys[a]; }, numThreads);
+        else
+            mergeSort(order.data(), length, [keys](Nd4jLong a, Nd4jLong b) -> bool { return keys[a] < keys[b]; }, numThreads);
+
+        std::vector<K> sortedKeys(length);
+        for (Nd4jLong e = 0; e < length; e++)
+            sortedKeys[e] = keys[order[e]];
+
+        std::copy(sortedKeys.begin(), sortedKeys.end(), keys);
+
+        if (values != nullptr) {
+            std::vector<V> sortedValues(length);
+            for (Nd4jLong e = 0; e < length; e++)
+                sortedValues[e] = values[order[e]];
+
+            std::copy(sortedValues.begin(), sortedValues.end(), values);
+        }
+    }
+
+    template <typename K, typename V>
+    void ParallelSort::sortByKey(K *keys, V *values, Nd4jLong length, bool descending, int numThreads) {
+        if (length < 2)
+            return;
+
+        // passes over 256 digits don't pay off for short vectors, i.e. rows of many small TADs
+        if (length < 256)
+            sortByKey_<K, V>(keys, values, length, descending, 1, std::false_type());
+        else
+            sortByKey_<K, V>(keys, values, length, descending, numThreads, std::integral_constant<bool, RadixKey<K>::enabled>());
+    }
+
+    template <typename T>
+    void ParallelSort::sort(T *keys, Nd4jLong length, bool descending, int numThreads) {
+        sortByKey<T, int8_t>(keys, nullptr, length, descending, numThreads);
+    }
+}
+
+#endif //LIBND4J_PARALLELSORT_H
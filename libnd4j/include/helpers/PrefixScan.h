@@ -0,0 +1,227 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_PREFIXSCAN_H
+#define LIBND4J_PREFIXSCAN_H
+
+#include <system/pointercast.h>
+#include <system/openmp_pragmas.h>
+#include <system/Environment.h>
+#include <math/templatemath.h>
+#include <execution/Threads.h>
+#include <memory>
+#include <vector>
+
+namespace sd {
+
+    /**
+     * Parallel prefix scan over strided vectors, and stream compaction built on top of it.
+     *
+     * Long vectors are scanned as reduce-then-scan: every thread reduces its own chunk, chunk totals are
+     * scanned serially, and then every chunk is scanned again starting from carry of previous chunks.
+     * OpType is associative simdOps op with (X, X, X) signature, i.e. simdOps::Add<T, T, T>
+     */
+    class ND4J_EXPORT PrefixScan {
+    public:
+        /**
+         * Inclusive or exclusive scan of x into z, which might be the same buffer.
+         * Strides are in elements, reverse scan goes from the last element to the first one.
+         * If parallel is false, scan is done by calling thread, i.e. when caller already splits work by TADs
+         */
+        template <typename T, typename OpType>
+        static void exec(const T *x, Nd4jLong xStride, T *z, Nd4jLong zStride, Nd4jLong length, T identity, bool exclusive, bool reverse, bool parallel = true);
+
+        /**
+         * Stable stream compaction: write(position, index) is called for every index within [0, length) which is selected,
+         * position is number of selected indices preceding it. Returns number of selected indices.
+         * selected(index) is evaluated twice for long ranges, so it should be cheap and free of side effects
+         */
+        template <typename Predicate, typename Writer>
+        static Nd4jLong compact(Nd4jLong length, const Predicate &selected, const Writer &write);
+
+        /**
+         * Number of chunks long range is split into for reduce-then-scan, 1 means serial scan
+         */
+        static FORCEINLINE Nd4jLong numberOfChunks(Nd4jLong length) {
+            // shorter ranges don't pay off two passes over memory
+            const Nd4jLong minChunk = 16384;
+            const Nd4jLong threads = sd::Environment::getInstance().maxMasterThreads();
+
+            return sd::math::nd4j_max<Nd4jLong>(1, sd::math::nd4j_min<Nd4jLong>(threads, length / minChunk));
+        }
+
+    protected:
+        template <typename T, typename OpType>
+        static T reduce(const T *x, Nd4jLong xStride, Nd4jLong length, T carry);
+
+        template <typename T, typename OpType>
+        static void scan(const T *x, Nd4jLong xStride, T *z, Nd4jLong zStride, Nd4jLong length, T carry, bool exclusive);
+    };
+
+    template <typename T, typename OpType>
+    T PrefixScan::reduce(const T *x, Nd4jLong xStride, Nd4jLong length, T carry) {
+        if (xStride == 1) {
+            for (Nd4jLong e = 0; e < length; e++)
+                carry = OpType::op(carry, x[e]);
+        } else {
+            for (Nd4jLong e = 0; e < length; e++)
+                carry = OpType::op(carry, x[e * xStride]);
+        }
+
+        return carry;
+    }
+
+    template <typename T, typename OpType>
+    void PrefixScan::scan(const T *x, Nd4jLong xStride, T *z, Nd4jLong zStride, Nd4jLong length, T carry, bool exclusive) {
+        // x is read before z is written, so in-place scan is fine
+        if (xStride == 1 && zStride == 1) {
+            if (exclusive) {
+                for (Nd4jLong e = 0; e < length; e++) {
+                    const T v = x[e];
+                    z[e] = carry;
+                    carry = OpType::op(carry, v);
+                }
+            } else {
+                for (Nd4jLong e = 0; e < length; e++) {
+                    carry = OpType::op(carry, x[e]);
+                    z[e] = carry;
+                }
+            }
+        } else {
+            if (exclusive) {
+                for (Nd4jLong e = 0; e < length; e++) {
+                    const T v = x[e * xStride];
+                    z[e * zStride] = carry;
+                    carry = OpType::op(carry, v);
+                }
+            } else {
+                for (Nd4jLong e = 0; e < length; e++) {
+                    carry = OpType::op(carry, x[e * xStride]);
+                    z[e * zStride] = carry;
+                }
+            }
+        }
+    }
+
+    template <typename T, typename OpType>
+    void PrefixScan::exec(const T *x, Nd4jLong xStride, T *z, Nd4jLong zStride, Nd4jLong length, T identity, bool exclusive, bool reverse, bool parallel) {
+        if (length <= 0)
+            return;
+
+        // reverse scan is forward scan starting from the last element with negated strides
+        if (reverse) {
+            x += (length - 1) * xStride;
+            z += (length - 1) * zStride;
+            xStride = -xStride;
+            zStride = -zStride;
+        }
+
+        const Nd4jLong numChunks = parallel ? numberOfChunks(length) : 1;
+        if (numChunks == 1) {
+            scan<T, OpType>(x, xStride, z, zStride, length, identity, exclusive);
+            return;
+        }
+
+        const Nd4jLong chunk = (length + numChunks - 1) / numChunks;
+        // not std::vector, since vector<bool> can't be written concurrently
+        std::unique_ptr<T[]> carries(new T[numChunks]);
+
+        auto reduceChunks = PRAGMA_THREADS_FOR {
+            for (auto c = start; c < stop; c++) {
+                const auto first = c * chunk;
+                const auto chunkLength = sd::math::nd4j_min<Nd4jLong>(chunk, length - first);
+                carries[c] = chunkLength > 0 ? reduce<T, OpType>(x + first * xStride, xStride, chunkLength, identity) : identity;
+            }
+        };
+
+        samediff::Threads::parallel_for(reduceChunks, 0, numChunks, 1, numChunks);
+
+        // chunk totals become carries into chunks, there's only as many of them as threads
+        T carry = identity;
+        for (Nd4jLong c = 0; c < numChunks; c++) {
+            const T total = carries[c];
+            carries[c] = carry;
+            carry = OpType::op(carry, total);
+        }
+
+        auto scanChunks = PRAGMA_THREADS_FOR {
+            for (auto c = start; c < stop; c++) {
+                const auto first = c * chunk;
+                const auto chunkLength = sd::math::nd4j_min<Nd4jLong>(chunk, length - first);
+                if (chunkLength > 0)
+                    scan<T, OpType>(x + first * xStride, xStride, z + first * zStride, zStride, chunkLength, carries[c], exclusive);
+            }
+        };
+
+        samediff::Threads::parallel_for(scanChunks, 0, numChunks, 1, numChunks);
+    }
+
+    template <typename Predicate, typename Writer>
+    Nd4jLong PrefixScan::compact(Nd4jLong length, const Predicate &selected, const Writer &write) {
+        const Nd4jLong numChunks = numberOfChunks(length);
+        if (numChunks == 1) {
+            Nd4jLong position = 0;
+            for (Nd4jLong e = 0; e < length; e++)
+                if (selected(e))
+                    write(position++, e);
+
+            return position;
+        }
+
+        const Nd4jLong chunk = (length + numChunks - 1) / numChunks;
+        std::vector<Nd4jLong> positions(numChunks, 0);
+
+        auto countChunks = PRAGMA_THREADS_FOR {
+            for (auto c = start; c < stop; c++) {
+                const auto last = sd::math::nd4j_min<Nd4jLong>((c + 1) * chunk, length);
+                Nd4jLong cnt = 0;
+                for (auto e = c * chunk; e < last; e++)
+                    if (selected(e))
+                        cnt++;
+
+                positions[c] = cnt;
+            }
+        };
+
+        samediff::Threads::parallel_for(countChunks, 0, numChunks, 1, numChunks);
+
+        // exclusive scan of counts gives first output position of every chunk
+        Nd4jLong total = 0;
+        for (Nd4jLong c = 0; c < numChunks; c++) {
+            const auto cnt = positions[c];
+            positions[c] = total;
+            total += cnt;
+        }
+
+        auto writeChunks = PRAGMA_THREADS_FOR {
+            for (auto c = start; c < stop; c++) {
+                const auto last = sd::math::nd4j_min<Nd4jLong>((c + 1) * chunk, length);
+                auto position = positions[c];
+                for (auto e = c * chunk; e < last; e++)
+                    if (selected(e))
+                        write(position++, e);
+            }
+        };
+
+        samediff::Threads::parallel_for(writeChunks, 0, numChunks, 1, numChunks);
+
+        return total;
+    }
+}
+
+#endif //LIBND4J_PREFIXSCAN_H
@@ -30,11 +30,7 @@
 
 namespace sd {
     ConstantShapeHelper::ConstantShapeHelper() {
-        _cache.resize(32);
-        for (int e = 0; e < 32; e++) {
-            MAP_IMPL<ShapeDescriptor, ConstantShapeBuffer> cache;
-            _cache[e] = cache;
-        }
+        _cache.emplace_back(new ShapeCache());
     }
 
     ConstantShapeHelper& ConstantShapeHelper::getInstance() {
@@ -55,18 +51,22 @@ ConstantShapeBuffer& ConstantShapeHelper::bufferForShapeInfo(const sd::DataType
 
 ConstantShapeBuffer& ConstantShapeHelper::bufferForShapeInfo(const ShapeDescriptor &descriptor) {
   int deviceId = 0;
+  const auto hash = std::hash<ShapeDescriptor>()(descriptor);
 
-  std::lock_guard<std::mutex> lock(_mutex);
+  auto entry = frontLookup(descriptor, hash, deviceId);
+  if (entry != nullptr)
+    return entry->value;
 
-  if (_cache[deviceId].count(descriptor) == 0) {
+  auto &cache = *_cache[deviceId];
+  entry = cache.find(descriptor, hash);
+  if (entry == nullptr) {
     auto hPtr = std::make_shared<PointerWrapper>(descriptor.toShapeInfo(), std::make_shared<PrimaryPointerDeallocator>());
     ConstantShapeBuffer buffer(hPtr);
-    ShapeDescriptor descriptor1(descriptor);
-    _cache[deviceId][descriptor1] = buffer;
-    return _cache[deviceId][descriptor1];
-  } else {
-    return _cache[deviceId].at(descriptor);
+    entry = cache.insert(descriptor, hash, buffer, shape::shapeInfoByteLength(hPtr->pointerAsT<Nd4jLong>()));
   }
+
+  frontStore(hash, deviceId, entry);
+  return entry->value;
 }
 
 ConstantShapeBuffer& ConstantShapeHelper::bufferForShapeInfo(const Nd4jLong *shapeInfo) {
@@ -75,11 +75,9 @@ ConstantShapeBuffer& ConstantShapeHelper::bufferForShapeInfo(const Nd4jLong *sha
     }
 
     bool ConstantShapeHelper::checkBufferExistenceForShapeInfo(ShapeDescriptor &descriptor) {
-        bool result;
         int deviceId = 0;
-        std::lock_guard<std::mutex> lock(_mutex);
 
-        return _cache[deviceId].count(descriptor) != 0;
+        return _cache[deviceId]->find(descriptor, std::hash<ShapeDescriptor>()(descriptor)) != nullptr;
     }
 
     const Nd4jLong* ConstantShapeHelper::createShapeInfo(const sd::DataType dataType, const char order, const int rank, const Nd4jLong* shape) {
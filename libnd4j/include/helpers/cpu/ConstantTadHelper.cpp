@@ -25,6 +25,7 @@
 #include <helpers/ShapeUtils.h>
 #include <array/ConstantOffsetsBuffer.h>
 #include <array/PrimaryPointerDeallocator.h>
+#include <system/Environment.h>
 
 #ifndef __CUDABLAS__
 
@@ -32,8 +33,7 @@
 namespace sd {
 
     ConstantTadHelper::ConstantTadHelper() {
-        MAP_IMPL<TadDescriptor, TadPack> pack;
-        _cache.emplace_back(pack);
+        _cache.emplace_back(new ConcurrentCache<TadDescriptor, TadPack>());
     }
 
     ConstantTadHelper& ConstantTadHelper::getInstance() {
@@ -61,31 +61,41 @@ namespace sd {
 
     TadPack ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
         const int deviceId = 0;
+        auto &cache = *_cache[deviceId];
 
-        std::lock_guard<std::mutex> lock(_mutex);
-        if (_cache[deviceId].count(descriptor) == 0) {
-          // if there's no TadPack matching this descriptor - create one
-            const auto shapeInfo = descriptor.originalShape().toShapeInfo();
-            const int rank = shape::rank(shapeInfo);
-            const std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(rank, descriptor.axis());
-            const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(shapeInfo, dimsToExclude);
-            const int subArrRank = (rank == dimsToExclude.size() || descriptor.areUnitiesinShape()) ? rank : rank - dimsToExclude.size();
+        TadPack pack;
+        if (cache.get(descriptor, pack))
+            return pack;
 
-            auto sPtr = std::make_shared<PointerWrapper>(new Nd4jLong[shape::shapeInfoLength(subArrRank)], std::make_shared<PrimaryPointerDeallocator>());   // shape of sub-arrays (same for all for them)
-            auto oPtr = std::make_shared<PointerWrapper>(new Nd4jLong[numOfSubArrs], std::make_shared<PrimaryPointerDeallocator>());
+        // if there's no TadPack matching this descriptor - create one. no locks are held here, so concurrent misses
+        // might build the same pack more than once, but only one of them gets cached and returned
+        pack = buildTadPack(descriptor);
 
-            if (numOfSubArrs > 0)
-                shape::calcSubArrsShapeInfoAndOffsets(shapeInfo, numOfSubArrs, dimsToExclude.size(), dimsToExclude.data(), sPtr->pointerAsT<Nd4jLong>(), oPtr->pointerAsT<Nd4jLong>(), descriptor.areUnitiesinShape());
+        const auto bytes = (pack.shapeInfoLength() + pack.numberOfTads()) * sizeof(Nd4jLong);
+        auto &env = Environment::getInstance();
+        return cache.put(descriptor, pack, bytes, env.tadCacheLimit(), env.tadCacheBytesLimit());
+    }
+
+    TadPack ConstantTadHelper::buildTadPack(TadDescriptor &descriptor) {
+        const auto shapeInfo = descriptor.originalShape().toShapeInfo();
+        const int rank = shape::rank(shapeInfo);
+        const std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(rank, descriptor.axis());
+        const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(shapeInfo, dimsToExclude);
+        const int subArrRank = (rank == (int) dimsToExclude.size() || descriptor.areUnitiesinShape()) ? rank : rank - dimsToExclude.size();
+
+        auto sPtr = std::make_shared<PointerWrapper>(new Nd4jLong[shape::shapeInfoLength(subArrRank)], std::make_shared<PrimaryPointerDeallocator>());   // shape of sub-arrays (same for all for them)
+        auto oPtr = std::make_shared<PointerWrapper>(new Nd4jLong[numOfSubArrs], std::make_shared<PrimaryPointerDeallocator>());
+
+        if (numOfSubArrs > 0)
+            shape::calcSubArrsShapeInfoAndOffsets(shapeInfo, numOfSubArrs, dimsToExclude.size(), dimsToExclude.data(), sPtr->pointerAsT<Nd4jLong>(), oPtr->pointerAsT<Nd4jLong>(), descriptor.areUnitiesinShape());
 
-            ConstantShapeBuffer shapeBuffer(sPtr);
-            ConstantOffsetsBuffer offsetsBuffer(oPtr);
-            TadPack t(shapeBuffer, offsetsBuffer, numOfSubArrs);
-            _cache[deviceId][descriptor] = t;
+        ConstantShapeBuffer shapeBuffer(sPtr);
+        ConstantOffsetsBuffer offsetsBuffer(oPtr);
+        TadPack t(shapeBuffer, offsetsBuffer, numOfSubArrs);
 
-            delete[] shapeInfo;
-        }
+        delete[] shapeInfo;
 
-        return _cache[deviceId][descriptor];
+        return t;
     }
 }
 
@@ -0,0 +1,155 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/FusedLoops.h>
+#include <execution/Threads.h>
+#include <system/op_boilerplate.h>
+#include <types/types.h>
+#include <ops/ops.h>
+#include <loops/legacy_ops.h>
+
+using namespace simdOps;
+
+namespace sd {
+
+    // number of elements processed by all steps of program before moving on, small enough to stay in L1
+    static const Nd4jLong FUSED_BLOCK_SIZE = 1024;
+
+    template <typename X>
+    template <typename OpType>
+    void FusedLoops<X>::transformBlock(X *buffer, Nd4jLong length) {
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong e = 0; e < length; e++)
+            buffer[e] = OpType::op(buffer[e], nullptr);
+    }
+
+    template <typename X>
+    template <typename OpType>
+    void FusedLoops<X>::scalarBlock(X *buffer, X scalar, Nd4jLong length) {
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong e = 0; e < length; e++)
+            buffer[e] = OpType::op(buffer[e], scalar, nullptr);
+    }
+
+    template <typename X>
+    template <typename OpType>
+    void FusedLoops<X>::pairwiseBlock(X *buffer, const X *y, Nd4jLong length) {
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong e = 0; e < length; e++)
+            buffer[e] = OpType::op(buffer[e], y[e], nullptr);
+    }
+
+    template <typename X>
+    void FusedLoops<X>::execProgram(const std::vector<FusedStep> &program, const void *vx, const Nd4jLong *xShapeInfo, void *vz, const Nd4jLong *zShapeInfo) {
+        auto x = reinterpret_cast<const X*>(vx);
+        auto z = reinterpret_cast<X*>(vz);
+
+        // pairwise and scalar ops are applied with all types equal
+        typedef X Y;
+        typedef X Z;
+
+        const Nd4jLong length = shape::length(zShapeInfo);
+
+        // blocks are contiguous ranges of logical indices, so only c-ordered arrays with ews 1 are read/written in place
+        const bool xLinear = shape::order(xShapeInfo) == 'c' && shape::elementWiseStride(xShapeInfo) == 1;
+        const bool zLinear = shape::order(zShapeInfo) == 'c' && shape::elementWiseStride(zShapeInfo) == 1;
+
+        // if z is contiguous, its own memory is used as block, unless some step reads z as operand
+        bool zDirect = zLinear;
+
+        std::vector<bool> yLinear(program.size(), false);
+        std::vector<bool> yScalar(program.size(), false);
+        for (size_t s = 0; s < program.size(); s++) {
+            if (program[s].kind == FusedStep::PAIRWISE) {
+                yScalar[s] = shape::length(program[s].yShapeInfo) == 1;
+                yLinear[s] = shape::order(program[s].yShapeInfo) == 'c' && shape::elementWiseStride(program[s].yShapeInfo) == 1;
+                zDirect &= program[s].y != z;
+            }
+        }
+
+        auto func = PRAGMA_THREADS_FOR {
+            X block[FUSED_BLOCK_SIZE];
+            X operand[FUSED_BLOCK_SIZE];
+
+            for (auto b = start; b < stop; b += FUSED_BLOCK_SIZE) {
+                const Nd4jLong blockLength = sd::math::nd4j_min<Nd4jLong>(FUSED_BLOCK_SIZE, stop - b);
+
+                X *buffer = zDirect ? z + b : block;
+
+                if (xLinear) {
+                    if (buffer != x + b)
+                        for (Nd4jLong e = 0; e < blockLength; e++)
+                            buffer[e] = x[b + e];
+                } else {
+                    for (Nd4jLong e = 0; e < blockLength; e++)
+                        buffer[e] = x[shape::getIndexOffset(b + e, xShapeInfo)];
+                }
+
+                for (size_t s = 0; s < program.size(); s++) {
+                    const auto &step = program[s];
+                    const int opNum = step.opNum;
+
+                    switch (step.kind) {
+                        case FusedStep::TRANSFORM_STRICT: {
+                            DISPATCH_BY_OPNUM_T(transformBlock, PARAMS(buffer, blockLength), TRANSFORM_STRICT_OPS);
+                        }
+                        break;
+                        case FusedStep::TRANSFORM_SAME: {
+                            DISPATCH_BY_OPNUM_T(transformBlock, PARAMS(buffer, blockLength), TRANSFORM_SAME_OPS);
+                        }
+                        break;
+                        case FusedStep::SCALAR: {
+                            const auto scalar = static_cast<X>(step.scalar);
+                            DISPATCH_BY_OPNUM_TTT(scalarBlock, PARAMS(buffer, scalar, blockLength), SCALAR_OPS);
+                        }
+                        break;
+                        case FusedStep::PAIRWISE: {
+                            auto y = reinterpret_cast<const X*>(step.y);
+                            const X *yBlock = operand;
+
+                            if (yScalar[s]) {
+                                for (Nd4jLong e = 0; e < blockLength; e++)
+                                    operand[e] = y[0];
+                            } else if (yLinear[s]) {
+                                yBlock = y + b;
+                            } else {
+                                for (Nd4jLong e = 0; e < blockLength; e++)
+                                    operand[e] = y[shape::getIndexOffset(b + e, step.yShapeInfo)];
+                            }
+
+                            DISPATCH_BY_OPNUM_TTT(pairwiseBlock, PARAMS(buffer, yBlock, blockLength), PAIRWISE_TRANSFORM_OPS);
+                        }
+                        break;
+                    }
+                }
+
+                if (zLinear && !zDirect) {
+                    for (Nd4jLong e = 0; e < blockLength; e++)
+                        z[b + e] = buffer[e];
+                } else if (!zLinear) {
+                    for (Nd4jLong e = 0; e < blockLength; e++)
+                        z[shape::getIndexOffset(b + e, zShapeInfo)] = buffer[e];
+                }
+            }
+        };
+
+        samediff::Threads::parallel_for(func, 0, length);
+    }
+
+    BUILD_SINGLE_TEMPLATE(template class ND4J_EXPORT FusedLoops, , FLOAT_TYPES);
+}
@@ -23,6 +23,7 @@
 #include "../MmulHelper.h"
 #include <array/NDArrayFactory.h>
 #include <helpers/BlasHelper.h>
+#include <helpers/PackedGemm.h>
 #include <helpers/ShapeUtils.h>
 #include <exceptions/datatype_exception.h>
 #include <execution/Threads.h>
@@ -217,7 +218,11 @@ NDArray* MmulHelper::mmulMxM(const NDArray* A, const NDArray* B, NDArray* C, con
     const bool typeDouble = hasGemm && ABC &&  aType == DataType::DOUBLE;
     const bool typeFloat  = hasGemm && ABC &&  aType == DataType::FLOAT32;
 
-    if(!typeFloat && !typeDouble) {
+    if(!typeFloat && !typeDouble && ABC && PackedGemm::isSupported(aType)) {
+        // half, bfloat16 and integer types, or float types if there's no BLAS available
+        PackedGemm::gemm(aType, M, N, K, alpha, A->buffer(), A->strideAt(0), A->strideAt(1), B->buffer(), B->strideAt(0), B->strideAt(1), beta, C->buffer(), C->strideAt(0), C->strideAt(1));
+    }
+    else if(!typeFloat && !typeDouble) {
         BUILD_SINGLE_SELECTOR_THRICE(aType, usualGemm, (A, B, C, 0, 1, 0, 1, 0, 1, alpha, beta), NUMERIC_TYPES);
         // BUILD_TRIPLE_SELECTOR(aType, bType, cType, usualGemm, (A, B, C, 0, 1, 0, 1, 0, 1, alpha, beta), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
     }
@@ -535,8 +540,39 @@ NDArray* MmulHelper::mmulNxN(const NDArray* A, const NDArray* B, NDArray* C, con
     if(cRank > 2)
         cBatchDims = ShapeUtils::evalDimsToExclude(cRank, {cMaxis, cNaxis});
 
-    // BUILD_TRIPLE_SELECTOR(A->dataType(), B->dataType(), C->dataType(), batchedGemm, (A, B, C, aBatchDims.data(), bBatchDims.data(), cBatchDims.data(), aMaxis, aKaxis, bKaxis, bNaxis, cMaxis, cNaxis, alpha, beta), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
-    BUILD_SINGLE_SELECTOR_THRICE(A->dataType(), batchedGemm, (A, B, C, aBatchDims.data(), bBatchDims.data(), cBatchDims.data(), aMaxis, aKaxis, bKaxis, bNaxis, cMaxis, cNaxis, alpha, beta), NUMERIC_TYPES);
+    const auto cType = C->dataType();
+    if (A->dataType() == cType && B->dataType() == cType && PackedGemm::isSupported(cType)) {
+        // every batch is a separate packed gemm: either batches run in parallel with one thread each, or one by one with all threads
+        auto aSubArrs = A->allTensorsAlongDimension({aMaxis, aKaxis});
+        auto bSubArrs = B->allTensorsAlongDimension({bKaxis, bNaxis});
+        auto cSubArrs = C->allTensorsAlongDimension({cMaxis, cNaxis});
+
+        const Nd4jLong numBatches = cSubArrs.size();
+        const int maxThreads = Environment::getInstance().maxThreads();
+        const bool batchParallel = numBatches >= maxThreads;
+
+        auto func = PRAGMA_THREADS_FOR {
+            for (auto i = start; i < stop; i++) {
+                auto a = aSubArrs.at(aRank > 2 ? i : 0);
+                auto b = bSubArrs.at(bRank > 2 ? i : 0);
+                auto c = cSubArrs.at(i);
+
+                PackedGemm::gemm(cType, c->sizeAt(0), c->sizeAt(1), a->sizeAt(1), alpha,
+                                 a->buffer(), a->strideAt(0), a->strideAt(1),
+                                 b->buffer(), b->strideAt(0), b->strideAt(1),
+                                 beta, c->buffer(), c->strideAt(0), c->strideAt(1), batchParallel ? 1 : maxThreads);
+            }
+        };
+
+        if (batchParallel)
+            samediff::Threads::parallel_tad(func, 0, numBatches);
+        else
+            func(0, 0, numBatches, 1);
+    }
+    else {
+        // BUILD_TRIPLE_SELECTOR(A->dataType(), B->dataType(), C->dataType(), batchedGemm, (A, B, C, aBatchDims.data(), bBatchDims.data(), cBatchDims.data(), aMaxis, aKaxis, bKaxis, bNaxis, cMaxis, cNaxis, alpha, beta), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
+        BUILD_SINGLE_SELECTOR_THRICE(A->dataType(), batchedGemm, (A, B, C, aBatchDims.data(), bBatchDims.data(), cBatchDims.data(), aMaxis, aKaxis, bKaxis, bNaxis, cMaxis, cNaxis, alpha, beta), NUMERIC_TYPES);
+    }
 
     return C;
 }
@@ -0,0 +1,414 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/PackedGemm.h>
+#include <system/Environment.h>
+#include <system/op_boilerplate.h>
+#include <types/float16.h>
+#include <types/bfloat16.h>
+#include <execution/Threads.h>
+#include <math/templatemath.h>
+#include <exceptions/datatype_exception.h>
+#include <vector>
+#include <algorithm>
+
+#if defined(__AVX512BF16__) || defined(__AVX512VNNI__)
+#include <immintrin.h>
+#endif
+
+namespace sd {
+
+// width of SIMD registers we're building for, micro-tiles are 2 registers wide
+#if defined(__AVX512F__)
+static const int GEMM_VECTOR_BYTES = 64;
+#elif defined(__AVX__)
+static const int GEMM_VECTOR_BYTES = 32;
+#else
+static const int GEMM_VECTOR_BYTES = 16;
+#endif
+
+// blocking: KC groups of K per pass keep B sliver in L1, MC x KC block of A stays in L2, MC x NC tile is a unit of parallel work
+static const int GEMM_KC = 256;
+static const int GEMM_MC_SLIVERS = 16;
+static const int GEMM_NC_SLIVERS = 8;
+
+// below this amount of multiply-adds threading costs more than it gives
+static const Nd4jLong GEMM_THREADING_THRESHOLD = 32768;
+
+//////////////////////////////////////////////////////////////////////////////
+// portable kernel: operands are converted to accumulation type while packing, micro-kernel is vectorized by compiler
+template <typename T, typename Z>
+struct GenericKernel {
+    typedef Z P;
+    typedef Z Acc;
+
+    static const int MR = 6;
+    static const int NR = 2 * GEMM_VECTOR_BYTES / sizeof(Z);
+    static const int KG = 1;
+    static const bool biased = false;
+
+    static FORCEINLINE P packLeft(const T *src, Nd4jLong stride, int valid) {
+        return valid > 0 ? static_cast<Z>(src[0]) : static_cast<Z>(0);
+    }
+
+    static FORCEINLINE P packRight(const T *src, Nd4jLong stride, int valid) {
+        return valid > 0 ? static_cast<Z>(src[0]) : static_cast<Z>(0);
+    }
+
+    static FORCEINLINE Acc bias(const T *src, Nd4jLong stride, Nd4jLong length) {
+        return static_cast<Acc>(0);
+    }
+
+    static void micro(const P *a, const P *b, Nd4jLong groups, Acc *c, bool accumulate) {
+        Acc r[MR * NR];
+        for (int e = 0; e < MR * NR; e++)
+            r[e] = accumulate ? c[e] : static_cast<Acc>(0);
+
+        for (Nd4jLong g = 0; g < groups; g++, a += MR, b += NR) {
+            for (int i = 0; i < MR; i++) {
+                const Acc av = a[i];
+
+                PRAGMA_OMP_SIMD
+                for (int j = 0; j < NR; j++)
+                    r[i * NR + j] += av * b[j];
+            }
+        }
+
+        for (int e = 0; e < MR * NR; e++)
+            c[e] = r[e];
+    }
+};
+
+#if defined(__AVX512BF16__)
+//////////////////////////////////////////////////////////////////////////////
+// bf16 kernel: pairs of K values are packed into 32-bit lanes and multiplied with vdpbf16ps, accumulating in fp32
+struct Bf16Kernel {
+    typedef uint32_t P;
+    typedef float Acc;
+
+    static const int MR = 6;
+    static const int NR = 32;
+    static const int KG = 2;
+    static const bool biased = false;
+
+    static FORCEINLINE P pair(const bfloat16 *src, Nd4jLong stride, int valid) {
+        uint32_t lo = valid > 0 ? static_cast<uint16_t>(src[0]._data) : 0;
+        uint32_t hi = valid > 1 ? static_cast<uint16_t>(src[stride]._data) : 0;
+        return lo | (hi << 16);
+    }
+
+    static FORCEINLINE P packLeft(const bfloat16 *src, Nd4jLong stride, int valid) {
+        return pair(src, stride, valid);
+    }
+
+    static FORCEINLINE P packRight(const bfloat16 *src, Nd4jLong stride, int valid) {
+        return pair(src, stride, valid);
+    }
+
+    static FORCEINLINE Acc bias(const bfloat16 *src, Nd4jLong stride, Nd4jLong length) {
+        return 0.f;
+    }
+
+    static void micro(const P *a, const P *b, Nd4jLong groups, Acc *c, bool accumulate) {
+        __m512 r[MR][2];
+        for (int i = 0; i < MR; i++) {
+            r[i][0] = accumulate ? _mm512_loadu_ps(c + i * NR) : _mm512_setzero_ps();
+            r[i][1] = accumulate ? _mm512_loadu_ps(c + i * NR + 16) : _mm512_setzero_ps();
+        }
+
+        for (Nd4jLong g = 0; g < groups; g++, a += MR, b += NR) {
+            auto b0 = (__m512bh) _mm512_loadu_si512(b);
+            auto b1 = (__m512bh) _mm512_loadu_si512(b + 16);
+            for (int i = 0; i < MR; i++) {
+                auto av = (__m512bh) _mm512_set1_epi32(a[i]);
+                r[i][0] = _mm512_dpbf16_ps(r[i][0], av, b0);
+                r[i][1] = _mm512_dpbf16_ps(r[i][1], av, b1);
+            }
+        }
+
+        for (int i = 0; i < MR; i++) {
+            _mm512_storeu_ps(c + i * NR, r[i][0]);
+            _mm512_storeu_ps(c + i * NR + 16, r[i][1]);
+        }
+    }
+};
+#endif
+
+#if defined(__AVX512VNNI__)
+//////////////////////////////////////////////////////////////////////////////
+// int8 kernel: quads of K values are multiplied with vpdpbusd, which takes unsigned left operand.
+// So A is shifted by +128 while packing, and 128 * sum(B column) is subtracted when tile is written out
+struct Int8Kernel {
+    typedef uint32_t P;
+    typedef int32_t Acc;
+
+    static const int MR = 6;
+    static const int NR = 32;
+    static const int KG = 4;
+    static const bool biased = true;
+
+    static FORCEINLINE P packLeft(const int8_t *src, Nd4jLong stride, int valid) {
+        uint32_t r = 0;
+        for (int e = 0; e < valid; e++)
+            r |= static_cast<uint32_t>(static_cast<uint8_t>(src[e * stride]) ^ 0x80) << (8 * e);
+
+        return r;
+    }
+
+    static FORCEINLINE P packRight(const int8_t *src, Nd4jLong stride, int valid) {
+        uint32_t r = 0;
+        for (int e = 0; e < valid; e++)
+            r |= static_cast<uint32_t>(static_cast<uint8_t>(src[e * stride])) << (8 * e);
+
+        return r;
+    }
+
+    static FORCEINLINE Acc bias(const int8_t *src, Nd4jLong stride, Nd4jLong length) {
+        Acc sum = 0;
+        for (Nd4jLong e = 0; e < length; e++)
+            sum += src[e * stride];
+
+        return 128 * sum;
+    }
+
+    static void micro(const P *a, const P *b, Nd4jLong groups, Acc *c, bool accumulate) {
+        __m512i r[MR][2];
+        for (int i = 0; i < MR; i++) {
+            r[i][0] = accumulate ? _mm512_loadu_si512(c + i * NR) : _mm512_setzero_si512();
+            r[i][1] = accumulate ? _mm512_loadu_si512(c + i * NR + 16) : _mm512_setzero_si512();
+        }
+
+        for (Nd4jLong g = 0; g < groups; g++, a += MR, b += NR) {
+            auto b0 = _mm512_loadu_si512(b);
+            auto b1 = _mm512_loadu_si512(b + 16);
+            for (int i = 0; i < MR; i++) {
+                auto av = _mm512_set1_epi32(a[i]);
+                r[i][0] = _mm512_dpbusd_epi32(r[i][0], av, b0);
+                r[i][1] = _mm512_dpbusd_epi32(r[i][1], av, b1);
+            }
+        }
+
+        for (int i = 0; i < MR; i++) {
+            _mm512_storeu_si512(c + i * NR, r[i][0]);
+            _mm512_storeu_si512(c + i * NR + 16, r[i][1]);
+        }
+    }
+};
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+template <typename T, typename Kernel>
+static void packedGemm_(const Nd4jLong M, const Nd4jLong N, const Nd4jLong K, const double alpha,
+                        const T *A, const Nd4jLong aStrideM, const Nd4jLong aStrideK,
+                        const T *B, const Nd4jLong bStrideK, const Nd4jLong bStrideN,
+                        const double beta, T *C, const Nd4jLong cStrideM, const Nd4jLong cStrideN, int numThreads) {
+
+    typedef typename Kernel::P P;
+    typedef typename Kernel::Acc Acc;
+
+    const int MR = Kernel::MR;
+    const int NR = Kernel::NR;
+    const int KG = Kernel::KG;
+
+    const Nd4jLong groups   = (K + KG - 1) / KG;
+    const Nd4jLong mSlivers = (M + MR - 1) / MR;
+    const Nd4jLong nSlivers = (N + NR - 1) / NR;
+    const Nd4jLong kcGroups = sd::math::nd4j_max<Nd4jLong>(1, GEMM_KC / KG);
+
+    if (M * N * K < GEMM_THREADING_THRESHOLD)
+        numThreads = 1;
+
+    // packing: every sliver holds MR rows of A (or NR columns of B) interleaved along K, padded with zeros
+    std::vector<P> packedA(mSlivers * groups * MR);
+    std::vector<P> packedB(nSlivers * groups * NR);
+    std::vector<Acc> biases(Kernel::biased ? nSlivers * NR : 0);
+
+    auto packA = PRAGMA_THREADS_FOR {
+        for (auto s = start; s < stop; s++) {
+            auto dst = packedA.data() + s * groups * MR;
+            for (Nd4jLong g = 0; g < groups; g++) {
+                const int valid = static_cast<int>(sd::math::nd4j_min<Nd4jLong>(KG, K - g * KG));
+                for (int i = 0; i < MR; i++) {
+                    const auto row = s * MR + i;
+                    dst[g * MR + i] = row < M ? Kernel::packLeft(A + row * aStrideM + g * KG * aStrideK, aStrideK, valid) : static_cast<P>(0);
+                }
+            }
+        }
+    };
+
+    auto packB = PRAGMA_THREADS_FOR {
+        for (auto s = start; s < stop; s++) {
+            auto dst = packedB.data() + s * groups * NR;
+            for (Nd4jLong g = 0; g < groups; g++) {
+                const int valid = static_cast<int>(sd::math::nd4j_min<Nd4jLong>(KG, K - g * KG));
+                for (int j = 0; j < NR; j++) {
+                    const auto col = s * NR + j;
+                    dst[g * NR + j] = col < N ? Kernel::packRight(B + g * KG * bStrideK + col * bStrideN, bStrideK, valid) : static_cast<P>(0);
+                }
+            }
+
+            if (Kernel::biased)
+                for (int j = 0; j < NR; j++)
+                    if (s * NR + j < N)
+                        biases[s * NR + j] = Kernel::bias(B + (s * NR + j) * bStrideN, bStrideK, K);
+        }
+    };
+
+    samediff::Threads::parallel_tad(packA, 0, mSlivers, 1, numThreads);
+    samediff::Threads::parallel_tad(packB, 0, nSlivers, 1, numThreads);
+
+    const Nd4jLong mTiles = (mSlivers + GEMM_MC_SLIVERS - 1) / GEMM_MC_SLIVERS;
+    const Nd4jLong nTiles = (nSlivers + GEMM_NC_SLIVERS - 1) / GEMM_NC_SLIVERS;
+
+    const Acc alphaZ = static_cast<Acc>(alpha);
+    const Acc betaZ  = static_cast<Acc>(beta);
+    const bool betaPresent = beta;
+
+    auto func = PRAGMA_THREADS_FOR {
+        // accumulators for the whole tile, laid out as MR x NR blocks
+        std::vector<Acc> tile(GEMM_MC_SLIVERS * MR * GEMM_NC_SLIVERS * NR, static_cast<Acc>(0));
+
+        for (auto t = start; t < stop; t++) {
+            const Nd4jLong s0 = (t / nTiles) * GEMM_MC_SLIVERS;
+            const Nd4jLong s1 = sd::math::nd4j_min<Nd4jLong>(mSlivers, s0 + GEMM_MC_SLIVERS);
+            const Nd4jLong q0 = (t % nTiles) * GEMM_NC_SLIVERS;
+            const Nd4jLong q1 = sd::math::nd4j_min<Nd4jLong>(nSlivers, q0 + GEMM_NC_SLIVERS);
+
+            if (groups == 0)
+                std::fill(tile.begin(), tile.end(), static_cast<Acc>(0));
+
+            for (Nd4jLong g0 = 0; g0 < groups; g0 += kcGroups) {
+                const Nd4jLong kc = sd::math::nd4j_min<Nd4jLong>(kcGroups, groups - g0);
+
+                for (Nd4jLong q = q0; q < q1; q++) {
+                    auto b = packedB.data() + (q * groups + g0) * NR;
+                    for (Nd4jLong s = s0; s < s1; s++) {
+                        auto a = packedA.data() + (s * groups + g0) * MR;
+                        Kernel::micro(a, b, kc, tile.data() + ((s - s0) * GEMM_NC_SLIVERS + (q - q0)) * MR * NR, g0 > 0);
+                    }
+                }
+            }
+
+            // writing tile out, applying alpha/beta and converting back to T
+            for (Nd4jLong s = s0; s < s1; s++) {
+                for (Nd4jLong q = q0; q < q1; q++) {
+                    auto block = tile.data() + ((s - s0) * GEMM_NC_SLIVERS + (q - q0)) * MR * NR;
+                    const int rows = static_cast<int>(sd::math::nd4j_min<Nd4jLong>(MR, M - s * MR));
+                    const int cols = static_cast<int>(sd::math::nd4j_min<Nd4jLong>(NR, N - q * NR));
+
+                    for (int i = 0; i < rows; i++) {
+                        auto c = C + (s * MR + i) * cStrideM + q * NR * cStrideN;
+                        for (int j = 0; j < cols; j++) {
+                            Acc val = block[i * NR + j];
+                            if (Kernel::biased)
+                                val -= biases[q * NR + j];
+
+                            if (betaPresent)
+                                c[j * cStrideN] = static_cast<T>(alphaZ * val + betaZ * static_cast<Acc>(c[j * cStrideN]));
+                            else
+                                c[j * cStrideN] = static_cast<T>(alphaZ * val);
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, mTiles * nTiles, 1, numThreads);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+bool PackedGemm::isSupported(sd::DataType dataType) {
+    switch (dataType) {
+        case sd::DataType::HALF:
+        case sd::DataType::BFLOAT16:
+        case sd::DataType::FLOAT32:
+        case sd::DataType::DOUBLE:
+        case sd::DataType::INT8:
+        case sd::DataType::UINT8:
+        case sd::DataType::INT16:
+        case sd::DataType::UINT16:
+        case sd::DataType::INT32:
+        case sd::DataType::INT64:
+            return true;
+        default:
+            return false;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+void PackedGemm::gemm(sd::DataType dataType, Nd4jLong M, Nd4jLong N, Nd4jLong K, double alpha,
+                      const void *A, Nd4jLong aStrideM, Nd4jLong aStrideK,
+                      const void *B, Nd4jLong bStrideK, Nd4jLong bStrideN,
+                      double beta, void *C, Nd4jLong cStrideM, Nd4jLong cStrideN, int numThreads) {
+
+    if (M <= 0 || N <= 0)
+        return;
+
+    if (numThreads <= 0)
+        numThreads = sd::Environment::getInstance().maxThreads();
+
+#define SD_PACKED_GEMM_ARGS(T) M, N, K, alpha, reinterpret_cast<const T*>(A), aStrideM, aStrideK, reinterpret_cast<const T*>(B), bStrideK, bStrideN, beta, reinterpret_cast<T*>(C), cStrideM, cStrideN, numThreads
+
+    switch (dataType) {
+        case sd::DataType::HALF:
+            packedGemm_<float16, GenericKernel<float16, float>>(SD_PACKED_GEMM_ARGS(float16));
+            break;
+        case sd::DataType::BFLOAT16:
+#if defined(__AVX512BF16__)
+            packedGemm_<bfloat16, Bf16Kernel>(SD_PACKED_GEMM_ARGS(bfloat16));
+#else
+            packedGemm_<bfloat16, GenericKernel<bfloat16, float>>(SD_PACKED_GEMM_ARGS(bfloat16));
+#endif
+            break;
+        case sd::DataType::FLOAT32:
+            packedGemm_<float, GenericKernel<float, float>>(SD_PACKED_GEMM_ARGS(float));
+            break;
+        case sd::DataType::DOUBLE:
+            packedGemm_<double, GenericKernel<double, double>>(SD_PACKED_GEMM_ARGS(double));
+            break;
+        case sd::DataType::INT8:
+#if defined(__AVX512VNNI__)
+            packedGemm_<int8_t, Int8Kernel>(SD_PACKED_GEMM_ARGS(int8_t));
+#else
+            packedGemm_<int8_t, GenericKernel<int8_t, int32_t>>(SD_PACKED_GEMM_ARGS(int8_t));
+#endif
+            break;
+        case sd::DataType::UINT8:
+            packedGemm_<uint8_t, GenericKernel<uint8_t, int32_t>>(SD_PACKED_GEMM_ARGS(uint8_t));
+            break;
+        case sd::DataType::INT16:
+            packedGemm_<int16_t, GenericKernel<int16_t, int32_t>>(SD_PACKED_GEMM_ARGS(int16_t));
+            break;
+        case sd::DataType::UINT16:
+            packedGemm_<uint16_t, GenericKernel<uint16_t, int32_t>>(SD_PACKED_GEMM_ARGS(uint16_t));
+            break;
+        case sd::DataType::INT32:
+            packedGemm_<int32_t, GenericKernel<int32_t, int32_t>>(SD_PACKED_GEMM_ARGS(int32_t));
+            break;
+        case sd::DataType::INT64:
+            packedGemm_<Nd4jLong, GenericKernel<Nd4jLong, Nd4jLong>>(SD_PACKED_GEMM_ARGS(Nd4jLong));
+            break;
+        default:
+            throw datatype_exception::build("PackedGemm::gemm: unsupported data type", dataType);
+    }
+
+#undef SD_PACKED_GEMM_ARGS
+}
+
+}
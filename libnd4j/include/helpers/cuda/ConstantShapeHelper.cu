@@ -35,11 +35,8 @@ namespace sd {
     ConstantShapeHelper::ConstantShapeHelper() {
         auto numDevices = AffinityManager::numberOfDevices();
 
-        _cache.resize(numDevices);
-        for (int e = 0; e < numDevices; e++) {
-            MAP_IMPL<ShapeDescriptor, ConstantShapeBuffer> cache;
-            _cache[e] = cache;
-        }
+        for (int e = 0; e < numDevices; e++)
+            _cache.emplace_back(new ShapeCache());
     }
 
     ConstantShapeHelper& ConstantShapeHelper::getInstance() {
@@ -59,19 +56,23 @@ ConstantShapeBuffer& ConstantShapeHelper::bufferForShapeInfo(const sd::DataType
 
 ConstantShapeBuffer&  ConstantShapeHelper::bufferForShapeInfo(const ShapeDescriptor &descriptor) {
         int deviceId = AffinityManager::currentDeviceId();
+        const auto hash = std::hash<ShapeDescriptor>()(descriptor);
 
-        std::lock_guard<std::mutex> lock(_mutex);
+        auto entry = frontLookup(descriptor, hash, deviceId);
+        if (entry != nullptr)
+          return entry->value;
 
-        if (_cache[deviceId].count(descriptor) == 0) {
+        auto &cache = *_cache[deviceId];
+        entry = cache.find(descriptor, hash);
+        if (entry == nullptr) {
           auto hPtr = std::make_shared<PointerWrapper>(descriptor.toShapeInfo(), std::make_shared<PrimaryPointerDeallocator>());
           auto dPtr = std::make_shared<PointerWrapper>(ConstantHelper::getInstance().replicatePointer(hPtr->pointer(), shape::shapeInfoByteLength(hPtr->pointerAsT<Nd4jLong>())), std::make_shared<CudaPointerDeallocator>());
           ConstantShapeBuffer buffer(hPtr, dPtr);
-          ShapeDescriptor descriptor1(descriptor);
-          _cache[deviceId][descriptor1] = buffer;
-          return _cache[deviceId][descriptor1];
-        } else {
-          return _cache[deviceId].at(descriptor);
+          entry = cache.insert(descriptor, hash, buffer, 2 * shape::shapeInfoByteLength(hPtr->pointerAsT<Nd4jLong>()));
         }
+
+        frontStore(hash, deviceId, entry);
+        return entry->value;
     }
 
 ConstantShapeBuffer&  ConstantShapeHelper::bufferForShapeInfo(const Nd4jLong *shapeInfo) {
@@ -81,9 +82,8 @@ ConstantShapeBuffer&  ConstantShapeHelper::bufferForShapeInfo(const Nd4jLong *sh
 
     bool ConstantShapeHelper::checkBufferExistenceForShapeInfo(ShapeDescriptor &descriptor) {
         auto deviceId = AffinityManager::currentDeviceId();
-        std::lock_guard<std::mutex> lock(_mutex);
 
-        return _cache[deviceId].count(descriptor) != 0;
+        return _cache[deviceId]->find(descriptor, std::hash<ShapeDescriptor>()(descriptor)) != nullptr;
     }
 
     Nd4jLong const* ConstantShapeHelper::createShapeInfo(const sd::DataType dataType, const char order, const int rank, const Nd4jLong* shape) {
@@ -29,15 +29,14 @@
 #include <helpers/ShapeUtils.h>
 #include <array/PrimaryPointerDeallocator.h>
 #include <array/CudaPointerDeallocator.h>
+#include <system/Environment.h>
 
 namespace sd {
     ConstantTadHelper::ConstantTadHelper() {
         auto numDevices = AffinityManager::numberOfDevices();
 
-        for (int e = 0; e < numDevices; e++) {
-            MAP_IMPL<TadDescriptor, TadPack> pack;
-            _cache.emplace_back(pack);
-        }
+        for (int e = 0; e < numDevices; e++)
+            _cache.emplace_back(new ConcurrentCache<TadDescriptor, TadPack>());
     }
 
     ConstantTadHelper& ConstantTadHelper::getInstance() {
@@ -65,51 +64,59 @@ namespace sd {
 
     TadPack ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
         const int deviceId = AffinityManager::currentDeviceId();
+        auto &cache = *_cache[deviceId];
 
-        std::lock_guard<std::mutex> lock(_mutex);
+        TadPack pack;
+        if (cache.get(descriptor, pack))
+            return pack;
 
-        if (_cache[deviceId].count(descriptor) == 0) {
-            const auto shapeInfo = descriptor.originalShape().toShapeInfo();
-            const int rank = shape::rank(shapeInfo);
-            const std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(rank, descriptor.axis());
-            const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(shapeInfo, dimsToExclude);
-            const int subArrRank = (rank == dimsToExclude.size() || descriptor.areUnitiesinShape()) ? rank : rank - dimsToExclude.size();
+        pack = buildTadPack(descriptor);
 
-            auto sPtr = std::make_shared<PointerWrapper>(new Nd4jLong[shape::shapeInfoLength(subArrRank)], std::make_shared<PrimaryPointerDeallocator>());
-            auto oPtr = std::make_shared<PointerWrapper>(new Nd4jLong[numOfSubArrs], std::make_shared<PrimaryPointerDeallocator>());
-
-            if (numOfSubArrs > 0)
-                shape::calcSubArrsShapeInfoAndOffsets(shapeInfo, numOfSubArrs, dimsToExclude.size(), dimsToExclude.data(), sPtr->pointerAsT<Nd4jLong>(), oPtr->pointerAsT<Nd4jLong>(), descriptor.areUnitiesinShape());
+        // host and device copies
+        const auto bytes = 2 * (pack.shapeInfoLength() + pack.numberOfTads()) * sizeof(Nd4jLong);
+        auto &env = Environment::getInstance();
+        return cache.put(descriptor, pack, bytes, env.tadCacheLimit(), env.tadCacheBytesLimit());
+    }
 
-            Nd4jPointer soPtr;
-            auto res = cudaMalloc(reinterpret_cast<void**>(&soPtr),  numOfSubArrs * sizeof(Nd4jLong));
-            if (res != 0)
-                throw cuda_exception::build("Memory allocation for tadOffsets failed", res);
+    TadPack ConstantTadHelper::buildTadPack(TadDescriptor &descriptor) {
+        const auto shapeInfo = descriptor.originalShape().toShapeInfo();
+        const int rank = shape::rank(shapeInfo);
+        const std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(rank, descriptor.axis());
+        const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(shapeInfo, dimsToExclude);
+        const int subArrRank = (rank == (int) dimsToExclude.size() || descriptor.areUnitiesinShape()) ? rank : rank - dimsToExclude.size();
 
-            res = cudaMemcpy(soPtr, oPtr->pointer(), numOfSubArrs * sizeof(Nd4jLong), cudaMemcpyHostToDevice);
-            if (res != 0)
-                throw cuda_exception::build("tadOffsets copy failed", res);
+        auto sPtr = std::make_shared<PointerWrapper>(new Nd4jLong[shape::shapeInfoLength(subArrRank)], std::make_shared<PrimaryPointerDeallocator>());
+        auto oPtr = std::make_shared<PointerWrapper>(new Nd4jLong[numOfSubArrs], std::make_shared<PrimaryPointerDeallocator>());
 
-            // TODO: add deallocator here?
-            auto ssPtr = std::make_shared<PointerWrapper>(ConstantHelper::getInstance().replicatePointer(sPtr->pointer(), shape::shapeInfoByteLength(subArrRank)));
+        if (numOfSubArrs > 0)
+            shape::calcSubArrsShapeInfoAndOffsets(shapeInfo, numOfSubArrs, dimsToExclude.size(), dimsToExclude.data(), sPtr->pointerAsT<Nd4jLong>(), oPtr->pointerAsT<Nd4jLong>(), descriptor.areUnitiesinShape());
 
+        Nd4jPointer soPtr;
+        auto res = cudaMalloc(reinterpret_cast<void**>(&soPtr),  numOfSubArrs * sizeof(Nd4jLong));
+        if (res != 0)
+            throw cuda_exception::build("Memory allocation for tadOffsets failed", res);
 
+        res = cudaMemcpy(soPtr, oPtr->pointer(), numOfSubArrs * sizeof(Nd4jLong), cudaMemcpyHostToDevice);
+        if (res != 0)
+            throw cuda_exception::build("tadOffsets copy failed", res);
 
-            ConstantShapeBuffer shapesBuffer(sPtr, ssPtr);
-            ConstantOffsetsBuffer offsetsBuffer(oPtr, std::make_shared<PointerWrapper>(soPtr, std::make_shared<CudaPointerDeallocator>()));
+        // packs might be evicted, so device shapeInfo goes to regular device memory instead of constant space, which is never released
+        Nd4jPointer ssPtr;
+        res = cudaMalloc(reinterpret_cast<void**>(&ssPtr), shape::shapeInfoByteLength(subArrRank));
+        if (res != 0)
+            throw cuda_exception::build("Memory allocation for tadShapeInfo failed", res);
 
-            TadPack t(shapesBuffer, offsetsBuffer, numOfSubArrs);
-            _cache[deviceId][descriptor] = t;
+        res = cudaMemcpy(ssPtr, sPtr->pointer(), shape::shapeInfoByteLength(subArrRank), cudaMemcpyHostToDevice);
+        if (res != 0)
+            throw cuda_exception::build("tadShapeInfo copy failed", res);
 
-            TadPack r = _cache[deviceId][descriptor];
+        ConstantShapeBuffer shapesBuffer(sPtr, std::make_shared<PointerWrapper>(ssPtr, std::make_shared<CudaPointerDeallocator>()));
+        ConstantOffsetsBuffer offsetsBuffer(oPtr, std::make_shared<PointerWrapper>(soPtr, std::make_shared<CudaPointerDeallocator>()));
 
-            delete[] shapeInfo;
+        TadPack t(shapesBuffer, offsetsBuffer, numOfSubArrs);
 
-            return r;
-        } else {
-            TadPack r = _cache[deviceId][descriptor];
+        delete[] shapeInfo;
 
-            return r;
-        }
+        return t;
     }
 }
\ No newline at end of file
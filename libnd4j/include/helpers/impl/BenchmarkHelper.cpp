@@ -25,6 +25,7 @@
 #include <array/NDArrayFactory.h>
 #include <chrono>
 #include <helpers/ShapeUtils.h>
+#include <helpers/MmulHelper.h>
 
 namespace sd {
     BenchmarkHelper::BenchmarkHelper(unsigned int warmUpIterations, unsigned int runIterations) {
@@ -134,6 +135,57 @@ namespace sd {
                     sd::math::nd4j_floor<double, Nd4jLong>(sumT), median, min, max, stdev);
     }
 
+    std::string BenchmarkHelper::benchmarkGEMM(char orderA, std::initializer_list<Nd4jLong> shapeA, char orderB, std::initializer_list<Nd4jLong> shapeB, char orderC, std::initializer_list<Nd4jLong> shapeC, std::initializer_list<sd::DataType> dataTypes) {
+        std::string result("TestName\tDataType\tShape\tOrders\tmedian (us)\tmin (us)\tGFLOP/s\n");
+
+        for (auto dataType : dataTypes) {
+            NDArray a(orderA, shapeA, dataType);
+            NDArray b(orderB, shapeB, dataType);
+            NDArray c(orderC, shapeC, dataType);
+
+            a.linspace(0.0, 0.01);
+            b.linspace(0.0, 0.01);
+
+            // every element of C takes K multiply-adds
+            const double flops = 2.0 * c.lengthOf() * a.sizeAt(-1);
+
+            for (uint i = 0; i < _wIterations; i++)
+                MmulHelper::mmul(&a, &b, &c, 1.0, 0.0);
+
+            std::vector<Nd4jLong> timings(_rIterations);
+            for (uint i = 0; i < _rIterations; i++) {
+                auto timeStart = std::chrono::system_clock::now();
+
+                MmulHelper::mmul(&a, &b, &c, 1.0, 0.0);
+
+                auto timeEnd = std::chrono::system_clock::now();
+                timings[i] = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeStart)).count();
+            }
+
+            std::sort(timings.begin(), timings.end());
+            Nd4jLong median = timings[_rIterations / 2];
+            Nd4jLong min = timings[0];
+
+            auto t = DataTypeUtils::asString(dataType);
+            auto s = ShapeUtils::shapeAsString(&a) + "x" + ShapeUtils::shapeAsString(&b);
+            std::string o;
+            o += orderA;
+            o += "/";
+            o += orderB;
+            o += "/";
+            o += orderC;
+
+            std::string temp;
+            temp.resize(4096);
+            snprintf(const_cast<char *>(temp.data()), temp.length(), "gemm\t%s\t%s\t%s\t%lld\t%lld\t%.2f\n", t.c_str(), s.c_str(), o.c_str(), median, min, flops / sd::math::nd4j_max<double>(1.0, (double) median) / 1e3);
+
+            result += temp.substr(0, temp.find('\n') + 1);
+        }
+
+        nd4j_printf("%s", result.c_str());
+        return result;
+    }
+
     std::string BenchmarkHelper::runOperationSuit(std::initializer_list<OpBenchmark*> benchmarks, const char *msg) {
         std::vector<OpBenchmark*> ops(benchmarks);
         return runOperationSuit(ops, msg);
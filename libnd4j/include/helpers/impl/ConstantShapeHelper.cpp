@@ -0,0 +1,67 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Backend-independent part of ConstantShapeHelper: per-thread front cache
+//
+
+#include <helpers/ConstantShapeHelper.h>
+#include <system/Environment.h>
+
+namespace sd {
+    namespace {
+        struct FrontSlot {
+            size_t hash = 0;
+            int deviceId = -1;
+            ConcurrentCache<ShapeDescriptor, ConstantShapeBuffer>::Entry *entry = nullptr;
+        };
+
+        thread_local std::vector<FrontSlot> frontCache;
+
+        // returns slot for given hash, or nullptr if front cache is disabled
+        FORCEINLINE FrontSlot* frontSlot(size_t hash) {
+            const auto size = static_cast<size_t>(Environment::getInstance().shapeFrontCacheSlots());
+            if (size == 0)
+                return nullptr;
+
+            if (frontCache.size() != size)
+                frontCache.assign(size, FrontSlot());
+
+            return &frontCache[hash % size];
+        }
+    }
+
+    ConstantShapeHelper::ShapeCache::Entry* ConstantShapeHelper::frontLookup(const ShapeDescriptor &descriptor, size_t hash, int deviceId) {
+        auto slot = frontSlot(hash);
+        if (slot == nullptr || slot->entry == nullptr || slot->hash != hash || slot->deviceId != deviceId)
+            return nullptr;
+
+        // hash collision is still possible, so we compare descriptors
+        return slot->entry->key == descriptor ? slot->entry : nullptr;
+    }
+
+    void ConstantShapeHelper::frontStore(size_t hash, int deviceId, ShapeCache::Entry *entry) {
+        auto slot = frontSlot(hash);
+        if (slot == nullptr)
+            return;
+
+        slot->hash = hash;
+        slot->deviceId = deviceId;
+        slot->entry = entry;
+    }
+}
@@ -0,0 +1,236 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/FloatConversions.h>
+#include <system/CpuDispatch.h>
+#include <system/openmp_pragmas.h>
+#include <execution/Threads.h>
+#include <math/templatemath.h>
+#include <cstring>
+
+#if defined(__x86_64__) && !defined(__CUDACC__) && (defined(SD_F16C) || defined(SD_CPU_DISPATCH))
+#include <immintrin.h>
+#define SD_F16C_KERNELS
+
+// binary built with -mf16c needs no target attribute
+#ifdef SD_F16C
+#define SD_TARGET_F16C
+#else
+#define SD_TARGET_F16C SD_TARGET_AVX2
+#endif
+#endif
+
+namespace sd {
+
+    // number of elements converted via float32 at once, so intermediate block stays in L1
+    static const Nd4jLong CONVERSION_BLOCK_SIZE = 1024;
+
+    namespace {
+        // kernels below are compiled for every ISA level via cpuDispatch
+        struct DoubleToFloat {
+            static FORCEINLINE void run(const double *x, float *z, Nd4jLong length) {
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < length; e++)
+                    z[e] = static_cast<float>(x[e]);
+            }
+        };
+
+        struct FloatToDouble {
+            static FORCEINLINE void run(const float *x, double *z, Nd4jLong length) {
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < length; e++)
+                    z[e] = static_cast<double>(x[e]);
+            }
+        };
+
+        // bfloat16 is the upper half of float32
+        struct Bfloat16ToFloat {
+            static FORCEINLINE void run(const uint16_t *x, uint32_t *z, Nd4jLong length) {
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < length; e++)
+                    z[e] = static_cast<uint32_t>(x[e]) << 16;
+            }
+        };
+
+        // round to nearest even, same as bfloat16::operator=(float)
+        struct FloatToBfloat16 {
+            static FORCEINLINE void run(const uint32_t *x, uint16_t *z, Nd4jLong length) {
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < length; e++) {
+                    const auto u = x[e];
+                    z[e] = static_cast<uint16_t>((u + 0x7fffu + ((u >> 16) & 1u)) >> 16);
+                }
+            }
+        };
+
+#ifdef SD_F16C_KERNELS
+        FORCEINLINE bool hasF16C() {
+#ifdef SD_F16C
+            return true;
+#else
+            return CpuDispatch::level() >= CpuDispatch::AVX2;
+#endif
+        }
+
+        SD_TARGET_F16C void halfToFloatF16C(const uint16_t *x, float *z, Nd4jLong length) {
+            Nd4jLong e = 0;
+            for (; e + 8 <= length; e += 8)
+                _mm256_storeu_ps(z + e, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(x + e))));
+
+            for (; e < length; e++)
+                z[e] = _cvtsh_ss(x[e]);
+        }
+
+        SD_TARGET_F16C void floatToHalfF16C(const float *x, uint16_t *z, Nd4jLong length) {
+            Nd4jLong e = 0;
+            for (; e + 8 <= length; e += 8)
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(z + e), _mm256_cvtps_ph(_mm256_loadu_ps(x + e), _MM_FROUND_TO_NEAREST_INT));
+
+            for (; e < length; e++)
+                z[e] = _cvtss_sh(x[e], _MM_FROUND_TO_NEAREST_INT);
+        }
+#endif
+
+        // pairs without float32 on either side go through float32 block
+        template <typename S, typename T>
+        void convertBlocks(const S *x, T *z, Nd4jLong length) {
+            float block[CONVERSION_BLOCK_SIZE];
+
+            for (Nd4jLong b = 0; b < length; b += CONVERSION_BLOCK_SIZE) {
+                const auto blockLength = sd::math::nd4j_min<Nd4jLong>(CONVERSION_BLOCK_SIZE, length - b);
+                FloatConversions::convert(x + b, block, blockLength);
+                FloatConversions::convert(block, z + b, blockLength);
+            }
+        }
+
+        template <typename S, typename T>
+        struct Converter {
+            static void run(const void *x, void *z, Nd4jLong offset, Nd4jLong length) {
+                convertBlocks(reinterpret_cast<const S *>(x) + offset, reinterpret_cast<T *>(z) + offset, length);
+            }
+        };
+
+        template <typename T>
+        struct Converter<float, T> {
+            static void run(const void *x, void *z, Nd4jLong offset, Nd4jLong length) {
+                FloatConversions::convert(reinterpret_cast<const float *>(x) + offset, reinterpret_cast<T *>(z) + offset, length);
+            }
+        };
+
+        template <typename S>
+        struct Converter<S, float> {
+            static void run(const void *x, void *z, Nd4jLong offset, Nd4jLong length) {
+                FloatConversions::convert(reinterpret_cast<const S *>(x) + offset, reinterpret_cast<float *>(z) + offset, length);
+            }
+        };
+
+        // equal types are never passed here, see isSupported()
+        template <>
+        struct Converter<float, float> {
+            static void run(const void *x, void *z, Nd4jLong offset, Nd4jLong length) {
+                std::memcpy(reinterpret_cast<float *>(z) + offset, reinterpret_cast<const float *>(x) + offset, length * sizeof(float));
+            }
+        };
+
+        template <typename S>
+        void convertFrom(sd::DataType zType, const void *x, void *z, Nd4jLong offset, Nd4jLong length) {
+            switch (zType) {
+                case sd::DataType::FLOAT32: Converter<S, float>::run(x, z, offset, length); break;
+                case sd::DataType::DOUBLE: Converter<S, double>::run(x, z, offset, length); break;
+                case sd::DataType::HALF: Converter<S, float16>::run(x, z, offset, length); break;
+                case sd::DataType::BFLOAT16: Converter<S, bfloat16>::run(x, z, offset, length); break;
+                default: break;
+            }
+        }
+
+        void convertRange(sd::DataType xType, const void *x, sd::DataType zType, void *z, Nd4jLong offset, Nd4jLong length) {
+            switch (xType) {
+                case sd::DataType::FLOAT32: convertFrom<float>(zType, x, z, offset, length); break;
+                case sd::DataType::DOUBLE: convertFrom<double>(zType, x, z, offset, length); break;
+                case sd::DataType::HALF: convertFrom<float16>(zType, x, z, offset, length); break;
+                case sd::DataType::BFLOAT16: convertFrom<bfloat16>(zType, x, z, offset, length); break;
+                default: break;
+            }
+        }
+
+        FORCEINLINE bool isFloatType(sd::DataType type) {
+            return type == sd::DataType::FLOAT32 || type == sd::DataType::DOUBLE || type == sd::DataType::HALF || type == sd::DataType::BFLOAT16;
+        }
+    }
+
+    bool FloatConversions::isSupported(sd::DataType xType, sd::DataType zType) {
+        return xType != zType && isFloatType(xType) && isFloatType(zType);
+    }
+
+    bool FloatConversions::convert(sd::DataType xType, const void *x, sd::DataType zType, void *z, Nd4jLong length, bool parallel) {
+        if (!isSupported(xType, zType))
+            return false;
+
+        if (length <= 0)
+            return true;
+
+        auto func = PRAGMA_THREADS_FOR {
+            convertRange(xType, x, zType, z, start, stop - start);
+        };
+
+        if (parallel)
+            samediff::Threads::parallel_for(func, 0, length);
+        else
+            func(0, 0, length, 1);
+
+        return true;
+    }
+
+    void FloatConversions::convert(const float16 *x, float *z, Nd4jLong length) {
+#ifdef SD_F16C_KERNELS
+        if (hasF16C()) {
+            halfToFloatF16C(reinterpret_cast<const uint16_t *>(x), z, length);
+            return;
+        }
+#endif
+        for (Nd4jLong e = 0; e < length; e++)
+            z[e] = static_cast<float>(x[e]);
+    }
+
+    void FloatConversions::convert(const float *x, float16 *z, Nd4jLong length) {
+#ifdef SD_F16C_KERNELS
+        if (hasF16C()) {
+            floatToHalfF16C(x, reinterpret_cast<uint16_t *>(z), length);
+            return;
+        }
+#endif
+        for (Nd4jLong e = 0; e < length; e++)
+            z[e] = static_cast<float16>(x[e]);
+    }
+
+    void FloatConversions::convert(const bfloat16 *x, float *z, Nd4jLong length) {
+        cpuDispatch<Bfloat16ToFloat>(reinterpret_cast<const uint16_t *>(x), reinterpret_cast<uint32_t *>(z), length);
+    }
+
+    void FloatConversions::convert(const float *x, bfloat16 *z, Nd4jLong length) {
+        cpuDispatch<FloatToBfloat16>(reinterpret_cast<const uint32_t *>(x), reinterpret_cast<uint16_t *>(z), length);
+    }
+
+    void FloatConversions::convert(const double *x, float *z, Nd4jLong length) {
+        cpuDispatch<DoubleToFloat>(x, z, length);
+    }
+
+    void FloatConversions::convert(const float *x, double *z, Nd4jLong length) {
+        cpuDispatch<FloatToDouble>(x, z, length);
+    }
+}
@@ -0,0 +1,108 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/MappedFile.h>
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sd {
+    MappedFile::MappedFile(const char *fileName) {
+#if defined(_WIN32) || defined(_WIN64)
+        auto file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("MappedFile: can't open file [" + std::string(fileName) + "]");
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            CloseHandle(file);
+            throw std::runtime_error("MappedFile: file [" + std::string(fileName) + "] is empty");
+        }
+
+        auto mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            CloseHandle(file);
+            throw std::runtime_error("MappedFile: can't map file [" + std::string(fileName) + "]");
+        }
+
+        auto ptr = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+        if (ptr == nullptr) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            throw std::runtime_error("MappedFile: can't map file [" + std::string(fileName) + "]");
+        }
+
+        _file = file;
+        _mapping = mapping;
+        _data = reinterpret_cast<uint8_t *>(ptr);
+        _length = static_cast<Nd4jLong>(size.QuadPart);
+#else
+        int fd = open(fileName, O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("MappedFile: can't open file [" + std::string(fileName) + "]");
+
+        struct stat stat_buf;
+        if (fstat(fd, &stat_buf) != 0 || stat_buf.st_size == 0) {
+            close(fd);
+            throw std::runtime_error("MappedFile: file [" + std::string(fileName) + "] is empty");
+        }
+
+        auto ptr = mmap(nullptr, stat_buf.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+        // mapping holds its own reference to the file
+        close(fd);
+
+        if (ptr == MAP_FAILED)
+            throw std::runtime_error("MappedFile: can't map file [" + std::string(fileName) + "]");
+
+        _data = reinterpret_cast<uint8_t *>(ptr);
+        _length = static_cast<Nd4jLong>(stat_buf.st_size);
+#endif
+    }
+
+    MappedFile::~MappedFile() {
+#if defined(_WIN32) || defined(_WIN64)
+        UnmapViewOfFile(_data);
+        CloseHandle(reinterpret_cast<HANDLE>(_mapping));
+        CloseHandle(reinterpret_cast<HANDLE>(_file));
+#else
+        munmap(_data, _length);
+#endif
+    }
+
+    uint8_t* MappedFile::data() const {
+        return _data;
+    }
+
+    Nd4jLong MappedFile::length() const {
+        return _length;
+    }
+
+    bool MappedFile::contains(const void *ptr, Nd4jLong numBytes) const {
+        auto p = reinterpret_cast<const uint8_t *>(ptr);
+        return p >= _data && numBytes >= 0 && numBytes <= _length - (p - _data);
+    }
+}
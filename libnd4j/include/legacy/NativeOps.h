@@ -665,6 +665,23 @@ ND4J_EXPORT int getDeviceMajor(int deviceId);
  */
 ND4J_EXPORT Nd4jLong getCachedMemory(int deviceId);
 
+/**
+ * These methods return TAD cache statistics
+ * @return
+ */
+ND4J_EXPORT Nd4jLong getTadCacheHits();
+ND4J_EXPORT Nd4jLong getTadCacheMisses();
+ND4J_EXPORT Nd4jLong getTadCacheEvictions();
+ND4J_EXPORT Nd4jLong getTadCacheEntries();
+ND4J_EXPORT Nd4jLong getTadCacheBytes();
+
+/**
+ * This method sets TAD cache limits, 0 means no limit
+ * @param maxEntries
+ * @param maxBytes
+ */
+ND4J_EXPORT void setTadCacheLimits(Nd4jLong maxEntries, Nd4jLong maxBytes);
+
 /**
  *
  * @param ptrToDeviceId
@@ -75,6 +75,7 @@ bool experimentalSupport = false;
 #include <helpers/ConstantTadHelper.h>
 
 #include <execution/Threads.h>
+#include <system/CpuDispatch.h>
 
 #ifdef CPU_FEATURES
 #include <cpuinfo_x86.h>
@@ -3013,6 +3014,31 @@ Nd4jLong getCachedMemory(int deviceId) {
     return sd::ConstantHelper::getInstance().getCachedAmount(deviceId);
 }
 
+Nd4jLong getTadCacheHits() {
+    return sd::ConstantTadHelper::getInstance().cacheHits();
+}
+
+Nd4jLong getTadCacheMisses() {
+    return sd::ConstantTadHelper::getInstance().cacheMisses();
+}
+
+Nd4jLong getTadCacheEvictions() {
+    return sd::ConstantTadHelper::getInstance().cacheEvictions();
+}
+
+Nd4jLong getTadCacheEntries() {
+    return sd::ConstantTadHelper::getInstance().totalCachedEntries();
+}
+
+Nd4jLong getTadCacheBytes() {
+    return sd::ConstantTadHelper::getInstance().cachedBytes();
+}
+
+void setTadCacheLimits(Nd4jLong maxEntries, Nd4jLong maxBytes) {
+    sd::Environment::getInstance().setTadCacheLimit(maxEntries);
+    sd::Environment::getInstance().setTadCacheBytesLimit(maxBytes);
+}
+
 
 sd::LaunchContext* defaultLaunchContext() {
     return LaunchContext::defaultContext();
@@ -3078,15 +3104,7 @@ int  binaryLevel() {
 
 int optimalLevel() {
 #ifdef CPU_FEATURES
-    auto features = cpu_features::GetX86Info().features;
-
-    if (features.avx && features.avx2 && features.avx512f && features.avx512vl && features.avx512bw && features.avx512dq && features.avx512cd)
-        return 3;
-    else if (features.avx && features.avx2)
-        return 2;
-    else
-        return 1;
-
+    return sd::CpuDispatch::detectedLevel();
 #else
     return 0;
 #endif
@@ -3114,7 +3132,8 @@ bool isMinimalRequirementsMet() {
 
 bool isOptimalRequirementsMet() {
 #ifdef CPU_FEATURES
-    auto b = ::binaryLevel();
+    // loop kernels might be running at higher level than binary was built for
+    auto b = sd::math::nd4j_max<int>(::binaryLevel(), sd::CpuDispatch::level());
     auto o = ::optimalLevel();
 
     if (b == o)
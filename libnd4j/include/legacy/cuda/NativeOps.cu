@@ -3659,6 +3659,31 @@ Nd4jLong getCachedMemory(int deviceId) {
     return sd::ConstantHelper::getInstance().getCachedAmount(deviceId);
 }
 
+Nd4jLong getTadCacheHits() {
+    return sd::ConstantTadHelper::getInstance().cacheHits();
+}
+
+Nd4jLong getTadCacheMisses() {
+    return sd::ConstantTadHelper::getInstance().cacheMisses();
+}
+
+Nd4jLong getTadCacheEvictions() {
+    return sd::ConstantTadHelper::getInstance().cacheEvictions();
+}
+
+Nd4jLong getTadCacheEntries() {
+    return sd::ConstantTadHelper::getInstance().totalCachedEntries();
+}
+
+Nd4jLong getTadCacheBytes() {
+    return sd::ConstantTadHelper::getInstance().cachedBytes();
+}
+
+void setTadCacheLimits(Nd4jLong maxEntries, Nd4jLong maxBytes) {
+    sd::Environment::getInstance().setTadCacheLimit(maxEntries);
+    sd::Environment::getInstance().setTadCacheBytesLimit(maxBytes);
+}
+
 sd::LaunchContext* defaultLaunchContext() {
     return LaunchContext::defaultContext();
 }
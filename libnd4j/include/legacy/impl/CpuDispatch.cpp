@@ -0,0 +1,87 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <system/CpuDispatch.h>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+#ifdef CPU_FEATURES
+#include <cpuinfo_x86.h>
+#endif
+
+namespace sd {
+
+    static int detectLevel() {
+#ifdef CPU_FEATURES
+        auto features = cpu_features::GetX86Info().features;
+
+        if (features.avx && features.avx2 && features.avx512f && features.avx512vl && features.avx512bw && features.avx512dq && features.avx512cd)
+            return CpuDispatch::AVX512;
+        else if (features.avx && features.avx2 && features.fma3 && features.f16c)
+            return CpuDispatch::AVX2;
+        else
+            return CpuDispatch::GENERIC;
+#else
+        return 0;
+#endif
+    }
+
+    static int initialLevel(int detected) {
+        auto level = detected;
+
+        /**
+         * Defines highest ISA level used by loop kernels: 1 - generic x86_64, 2 - AVX2, 3 - AVX512
+         */
+        const char* max_level = std::getenv("SD_MAX_CPU_LEVEL");
+        if (max_level != nullptr) {
+            try {
+                std::string t(max_level);
+                int val = std::stoi(t);
+                if (val < level)
+                    level = val < CpuDispatch::GENERIC ? CpuDispatch::GENERIC : val;
+            } catch (std::invalid_argument &e) {
+                // just do nothing
+            } catch (std::out_of_range &e) {
+                // still do nothing
+            }
+        }
+
+        return level;
+    }
+
+    int CpuDispatch::_detectedLevel = detectLevel();
+    std::atomic<int> CpuDispatch::_level(initialLevel(CpuDispatch::_detectedLevel));
+
+    int CpuDispatch::detectedLevel() {
+        return _detectedLevel;
+    }
+
+    void CpuDispatch::setLevel(int level) {
+        if (_detectedLevel == 0)
+            return;
+
+        if (level > _detectedLevel)
+            level = _detectedLevel;
+
+        if (level < GENERIC)
+            level = GENERIC;
+
+        _level.store(level);
+    }
+}
@@ -117,6 +117,14 @@ namespace sd {
             _allowHelpers = false;
         }
 
+        /**
+         * If this env var is defined - loops will always use static split, even if dynamic schedule was requested
+         */
+        const char* static_scheduling = std::getenv("SD_STATIC_SCHEDULING");
+        if (static_scheduling != nullptr) {
+            _allowDynamicScheduling = false;
+        }
+
         /**
          * This var defines max amount of host memory library can allocate
          */
@@ -165,6 +173,158 @@ namespace sd {
             }
         }
 
+        /**
+         * This var defines max number of cached TAD packs
+         */
+        const char* tad_cache_limit = std::getenv("SD_TAD_CACHE_LIMIT");
+        if (tad_cache_limit != nullptr) {
+            try {
+                std::string t(tad_cache_limit);
+                auto val = std::stol(t);
+                _tadCacheLimit.store(val);
+            } catch (std::invalid_argument &e) {
+                // just do nothing
+            } catch (std::out_of_range &e) {
+                // still do nothing
+            }
+        }
+
+        /**
+         * This var defines max amount of host memory used by cached TAD packs
+         */
+        const char* tad_cache_bytes = std::getenv("SD_TAD_CACHE_BYTES");
+        if (tad_cache_bytes != nullptr) {
+            try {
+                std::string t(tad_cache_bytes);
+                auto val = std::stol(t);
+                _tadCacheBytesLimit.store(val);
+            } catch (std::invalid_argument &e) {
+                // just do nothing
+            } catch (std::out_of_range &e) {
+                // still do nothing
+            }
+        }
+
+        /**
+         * This var defines number of slots in per-thread front cache of interned shapes, 0 disables it
+         */
+        const char* shape_front_cache_slots = std::getenv("SD_SHAPE_FRONT_CACHE_SLOTS");
+        if (shape_front_cache_slots != nullptr) {
+            try {
+                std::string t(shape_front_cache_slots);
+                int val = std::stoi(t);
+                _shapeFrontCacheSlots.store(val > 0 ? val : 0);
+            } catch (std::invalid_argument &e) {
+                // just do nothing
+            } catch (std::out_of_range &e) {
+                // still do nothing
+            }
+        }
+
+        /**
+         * This var defines number of input signatures every op caches output shapes for, 0 disables it
+         */
+        const char* shape_function_cache = std::getenv("SD_SHAPE_FUNCTION_CACHE");
+        if (shape_function_cache != nullptr) {
+            try {
+                std::string t(shape_function_cache);
+                int val = std::stoi(t);
+                _shapeFunctionCacheSize.store(val > 0 ? val : 0);
+            } catch (std::invalid_argument &e) {
+                // just do nothing
+            } catch (std::out_of_range &e) {
+                // still do nothing
+            }
+        }
+
+        /**
+         * If this env var is defined - ThreadPool threads are grouped and bound per NUMA node
+         */
+        const char* numa_aware = std::getenv("SD_NUMA_AWARE");
+        if (numa_aware != nullptr) {
+            _numaAware = true;
+        }
+
+        /**
+         * This var defines min size of host buffer, in bytes, that gets first-touched in NUMA-aware mode
+         */
+        const char* numa_first_touch = std::getenv("SD_NUMA_FIRST_TOUCH");
+        if (numa_first_touch != nullptr) {
+            try {
+                std::string t(numa_first_touch);
+                auto val = std::stol(t);
+                _numaFirstTouchThreshold.store(val > 0 ? val : 0);
+            } catch (std::invalid_argument &e) {
+                // just do nothing
+            } catch (std::out_of_range &e) {
+                // still do nothing
+            }
+        }
+
+        /**
+         * This var forces conv2d algorithm: 0 - heuristic, 1 - autotune, 2 - im2col, 3 - direct, 4 - Winograd F(2x2,3x3), 5 - Winograd F(4x4,3x3)
+         */
+        const char* conv2d_algorithm = std::getenv("SD_CONV2D_ALGORITHM");
+        if (conv2d_algorithm != nullptr) {
+            try {
+                std::string t(conv2d_algorithm);
+                int val = std::stoi(t);
+                _conv2dAlgorithm.store(val > 0 ? val : 0);
+            } catch (std::invalid_argument &e) {
+                // just do nothing
+            } catch (std::out_of_range &e) {
+                // still do nothing
+            }
+        }
+
+        /**
+         * This var sets number of graph nodes executed concurrently
+         */
+        const char* inter_op_threads = std::getenv("SD_INTER_OP_THREADS");
+        if (inter_op_threads != nullptr) {
+            try {
+                std::string t(inter_op_threads);
+                int val = std::stoi(t);
+                _interOpThreads.store(val > 1 ? val : 1);
+            } catch (std::invalid_argument &e) {
+                // just do nothing
+            } catch (std::out_of_range &e) {
+                // still do nothing
+            }
+        }
+
+        /**
+         * If this env var is defined - graph intermediates are placed into planned arena
+         */
+        const char* memory_planning = std::getenv("SD_MEMORY_PLANNING");
+        if (memory_planning != nullptr) {
+            _memoryPlanning = true;
+        }
+
+        /**
+         * If this env var is defined - chains of legacy elementwise ops are fused
+         */
+        const char* elementwise_fusion = std::getenv("SD_ELEMENTWISE_FUSION");
+        if (elementwise_fusion != nullptr) {
+            _elementwiseFusion = true;
+        }
+
+        /**
+         * If this env var is defined - host buffers without workspace are taken from pool
+         */
+        const char* pooled_allocation = std::getenv("SD_POOLED_ALLOCATION");
+        if (pooled_allocation != nullptr) {
+            _pooledAllocation = true;
+        }
+
+        /**
+         * If this env var is defined - big pooled blocks are backed by huge pages
+         */
+        const char* pooled_huge_pages = std::getenv("SD_POOLED_HUGE_PAGES");
+        if (pooled_huge_pages != nullptr) {
+            _pooledHugePages = true;
+        }
+
         const char* blas_fallback = std::getenv("SD_BLAS_FALLBACK");
         if (blas_fallback != nullptr) {
             _blasFallback = true;
@@ -296,8 +456,16 @@ namespace sd {
         return _maxThreads.load();
     }
 
+    // per-thread limit of master threads, 0 means no limit
+    static thread_local int threadMaxMasterThreads = 0;
+
     int Environment::maxMasterThreads() {
-        return _maxMasterThreads.load();
+        auto max = _maxMasterThreads.load();
+        return threadMaxMasterThreads > 0 && threadMaxMasterThreads < max ? threadMaxMasterThreads : max;
+    }
+
+    void Environment::setThreadMaxMasterThreads(int max) {
+        threadMaxMasterThreads = max > 0 ? max : 0;
     }
 
     void Environment::setMaxThreads(int max) {
@@ -352,6 +520,14 @@ namespace sd {
         _allowHelpers.store(reallyAllow);
     }
 
+    bool Environment::dynamicSchedulingAllowed() {
+        return _allowDynamicScheduling.load();
+    }
+
+    void Environment::allowDynamicScheduling(bool reallyAllow) {
+        _allowDynamicScheduling.store(reallyAllow);
+    }
+
     void Environment::setGroupLimit(int group, Nd4jLong numBytes) {
         sd::memory::MemoryCounter::getInstance().setGroupLimit((sd::memory::MemoryType) group, numBytes);
     }
@@ -376,6 +552,102 @@ namespace sd {
         return sd::memory::MemoryCounter::getInstance().allocatedDevice(deviceId);
     }
 
+    Nd4jLong Environment::tadCacheLimit() {
+        return _tadCacheLimit.load();
+    }
+
+    void Environment::setTadCacheLimit(Nd4jLong numEntries) {
+        _tadCacheLimit.store(numEntries > 0 ? numEntries : 0);
+    }
+
+    Nd4jLong Environment::tadCacheBytesLimit() {
+        return _tadCacheBytesLimit.load();
+    }
+
+    void Environment::setTadCacheBytesLimit(Nd4jLong numBytes) {
+        _tadCacheBytesLimit.store(numBytes > 0 ? numBytes : 0);
+    }
+
+    int Environment::shapeFrontCacheSlots() {
+        return _shapeFrontCacheSlots.load(std::memory_order_relaxed);
+    }
+
+    void Environment::setShapeFrontCacheSlots(int numSlots) {
+        _shapeFrontCacheSlots.store(numSlots > 0 ? numSlots : 0);
+    }
+
+    int Environment::shapeFunctionCacheSize() {
+        return _shapeFunctionCacheSize.load(std::memory_order_relaxed);
+    }
+
+    void Environment::setShapeFunctionCacheSize(int numEntries) {
+        _shapeFunctionCacheSize.store(numEntries > 0 ? numEntries : 0);
+    }
+
+    int Environment::conv2dAlgorithm() {
+        return _conv2dAlgorithm.load(std::memory_order_relaxed);
+    }
+
+    void Environment::setConv2dAlgorithm(int algorithm) {
+        _conv2dAlgorithm.store(algorithm > 0 ? algorithm : 0);
+    }
+
+    int Environment::interOpThreads() {
+        return _interOpThreads.load(std::memory_order_relaxed);
+    }
+
+    void Environment::setInterOpThreads(int numThreads) {
+        _interOpThreads.store(numThreads > 1 ? numThreads : 1);
+    }
+
+    bool Environment::isMemoryPlanning() {
+        return _memoryPlanning.load(std::memory_order_relaxed);
+    }
+
+    void Environment::setMemoryPlanning(bool reallyPlan) {
+        _memoryPlanning.store(reallyPlan);
+    }
+
+    bool Environment::isElementwiseFusion() {
+        return _elementwiseFusion.load(std::memory_order_relaxed);
+    }
+
+    void Environment::setElementwiseFusion(bool reallyFuse) {
+        _elementwiseFusion.store(reallyFuse);
+    }
+
+    bool Environment::isPooledAllocation() {
+        return _pooledAllocation.load(std::memory_order_relaxed);
+    }
+
+    void Environment::setPooledAllocation(bool reallyPool) {
+        _pooledAllocation.store(reallyPool);
+    }
+
+    bool Environment::isPooledHugePages() {
+        return _pooledHugePages.load(std::memory_order_relaxed);
+    }
+
+    void Environment::setPooledHugePages(bool reallyHuge) {
+        _pooledHugePages.store(reallyHuge);
+    }
+
+    bool Environment::isNumaAware() {
+        return _numaAware.load();
+    }
+
+    void Environment::setNumaAware(bool reallyNuma) {
+        _numaAware.store(reallyNuma);
+    }
+
+    Nd4jLong Environment::numaFirstTouchThreshold() {
+        return _numaFirstTouchThreshold.load();
+    }
+
+    void Environment::setNumaFirstTouchThreshold(Nd4jLong numBytes) {
+        _numaFirstTouchThreshold.store(numBytes > 0 ? numBytes : 0);
+    }
+
     uint64_t Environment::maxPrimaryMemory() {
         return _maxTotalPrimaryMemory.load();
     }
@@ -27,6 +27,7 @@
 #include <helpers/LoopKind.h>
 #include <helpers/ConstantTadHelper.h>
 #include <execution/Threads.h>
+#include <system/CpuDispatch.h>
 #include <helpers/ShapeUtils.h>
 
 using namespace simdOps;
@@ -34,6 +35,87 @@ using namespace simdOps;
 namespace functions {
 namespace broadcast {
 
+        // x TADs combined with whole y
+        template <typename X, typename Y, typename Z, typename OpType>
+        struct BroadcastTadKernel {
+            static FORCEINLINE void run(const X *x, const Nd4jLong *xOffsets, Nd4jLong xEws, const Y *y, Nd4jLong yEws, Z *z, const Nd4jLong *zOffsets, Nd4jLong zEws, Nd4jLong tadLength, uint64_t start, uint64_t stop) {
+                if (xEws == 1 && yEws == 1 && zEws == 1) {
+                    for (auto i = start; i < stop; i++) {
+                        auto oX = x + xOffsets[i];
+                        auto oZ = z + zOffsets[i];
+
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong f = 0; f < tadLength; f++)
+                            oZ[f] = OpType::op(oX[f], y[f]);
+                    }
+                }
+                else {
+                    for (auto i = start; i < stop; i++) {
+                        auto oX = x + xOffsets[i];
+                        auto oZ = z + zOffsets[i];
+
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong f = 0; f < tadLength; f++)
+                            oZ[f * zEws] = OpType::op(oX[f * xEws], y[f * yEws]);
+                    }
+                }
+            }
+        };
+
+        // whole x combined with y TADs
+        template <typename X, typename Y, typename Z, typename OpType>
+        struct BroadcastInverseTadKernel {
+            static FORCEINLINE void run(const X *x, Nd4jLong xEws, const Y *y, const Nd4jLong *yOffsets, Nd4jLong yEws, Z *z, const Nd4jLong *zOffsets, Nd4jLong zEws, Nd4jLong tadLength, uint64_t start, uint64_t stop) {
+                if (xEws == 1 && yEws == 1 && zEws == 1) {
+                    for (auto i = start; i < stop; i++) {
+                        auto oY = y + yOffsets[i];
+                        auto oZ = z + zOffsets[i];
+
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong f = 0; f < tadLength; f++)
+                            oZ[f] = OpType::op(x[f], oY[f]);
+                    }
+                }
+                else {
+                    for (auto i = start; i < stop; i++) {
+                        auto oY = y + yOffsets[i];
+                        auto oZ = z + zOffsets[i];
+
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong f = 0; f < tadLength; f++)
+                            oZ[f * zEws] = OpType::op(x[f * xEws], oY[f * yEws]);
+                    }
+                }
+            }
+        };
+
+        // series of scalar ops, scalar is taken from x if scalarX is true, from y otherwise
+        template <typename X, typename Y, typename Z, typename OpType, bool scalarX>
+        struct BroadcastScalarKernel {
+            static FORCEINLINE void run(const X *x, const Y *y, Z *z, Nd4jLong loopLength, uint64_t start, uint64_t stop) {
+                for (auto i = start; i < stop; i++) {
+                    auto oZ = z + (i * loopLength);
+
+                    if (scalarX) {
+                        auto oY = y + (i * loopLength);
+                        const auto oX = x[i];
+
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong f = 0; f < loopLength; f++)
+                            oZ[f] = OpType::op(oX, oY[f]);
+                    }
+                    else {
+                        auto oX = x + (i * loopLength);
+                        const auto oY = y[i];
+
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong f = 0; f < loopLength; f++)
+                            oZ[f] = OpType::op(oX[f], oY);
+                    }
+                }
+            }
+        };
+
         template <typename X, typename Y, typename Z>
         void Broadcast<X, Y, Z>::execInverse(const int opNum,
                                              const void *x, const Nd4jLong *xShapeInfo,
@@ -104,8 +186,9 @@ namespace broadcast {
                 auto xTadShapeShapeInfo = xTadShapeInfo;
                 auto tadOffsets = xTadOffset;
 
+                sd::TadPack tadPack;
                 if (xTadShapeInfo == nullptr || tadOffsets == nullptr) {
-                    auto tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(xShapeInfo, dimension, dimensionLength);
+                    tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(xShapeInfo, dimension, dimensionLength);
 
                     xTadShapeShapeInfo = tadPack.primaryShapeInfo();
                     tadOffsets = tadPack.primaryOffsets();
@@ -136,53 +219,18 @@ namespace broadcast {
                         loopKind == sd::LoopKind::BROADCAST_5D)
                     ? loopKind : sd::LoopKind::deduceKindOfLoopXYZ(xTadShapeShapeInfo, yShapeInfo, zTadShapeInfo);
 
-                if (kindOfLoop == sd::LoopKind::EWS1) {
-                    for (auto i = start; i < stop; i++) {
-                        auto oX = x + tadOffsets[i];
-                        auto oZ = z + zTadOffset[i];
-
-                        PRAGMA_OMP_SIMD
-                        for (unsigned int f = 0; f < tadLength; f++)
-                            oZ[f] = OpType::op(oX[f], y[f]);
-                    }
-                }
-                else if(kindOfLoop == sd::LoopKind::EWSNONZERO){
-                    for (auto i = start; i < stop; i++) {
-                        auto oX = x + tadOffsets[i];
-                        auto oZ = z + zTadOffset[i];
-
-                        PRAGMA_OMP_SIMD
-                        for (unsigned int f = 0; f < tadLength; f++)
-                            oZ[f * zEws] = OpType::op(oX[f * xEws], y[f * yEws]);
-                    }
+                if (kindOfLoop == sd::LoopKind::EWS1 || kindOfLoop == sd::LoopKind::EWSNONZERO) {
+                    sd::cpuDispatch<BroadcastTadKernel<X, Y, Z, OpType>>(x, tadOffsets, (Nd4jLong) xEws, y, (Nd4jLong) yEws, z, zTadOffset, (Nd4jLong) zEws, (Nd4jLong) tadLength, start, stop);
                 } else if(kindOfLoop == sd::LoopKind::BROADCAST_SCALAR_X){
                     // this loop effectively turns broadcast into series of scalar ops
                     auto loopLength = yShapeInfo[shape::rank(yShapeInfo)];
 
-                    for (auto i = start; i < stop; i++) {
-                        auto oY = y + (i * loopLength);
-                        auto oZ = z + (i * loopLength);
-
-                        const auto oX = x[i];
-
-                        PRAGMA_OMP_SIMD
-                        for (Nd4jLong f = 0; f < loopLength; f++)
-                            oZ[f] = OpType::op(oX, oY[f]);
-                    }
+                    sd::cpuDispatch<BroadcastScalarKernel<X, Y, Z, OpType, true>>(x, y, z, loopLength, start, stop);
                 } else if(kindOfLoop == sd::LoopKind::BROADCAST_SCALAR_Y){
                     // this loop effectively turns broadcast into series of scalar ops
                     auto loopLength = xShapeInfo[shape::rank(xShapeInfo)];
 
-                    for (auto i = start; i < stop; i++) {
-                        auto oX = x + (i * loopLength);
-                        auto oZ = z + (i * loopLength);
-
-                        const auto oY = y[i];
-
-                        PRAGMA_OMP_SIMD
-                        for (Nd4jLong f = 0; f < loopLength; f++)
-                            oZ[f] = OpType::op(oX[f], oY);
-                    }
+                    sd::cpuDispatch<BroadcastScalarKernel<X, Y, Z, OpType, false>>(x, y, z, loopLength, start, stop);
                 }
                 else if (kindOfLoop == sd::LoopKind::BROADCAST_3D) {
 
@@ -397,8 +445,9 @@ namespace broadcast {
             auto yTadShapeShapeInfo = yTadShapeInfo;
             auto tadOffsets = yTadOffset;
 
+            sd::TadPack tadPack;
             if (yTadShapeInfo == nullptr || tadOffsets == nullptr) {
-                auto tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(yShapeInfo, dimension, dimensionLength);
+                tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(yShapeInfo, dimension, dimensionLength);
 
                 yTadShapeShapeInfo = tadPack.primaryShapeInfo();
                 tadOffsets = tadPack.primaryOffsets();
@@ -426,25 +475,8 @@ namespace broadcast {
 
             const sd::LoopKind::Kind kindOfLoop = sd::LoopKind::deduceKindOfLoopXYZ(yTadShapeShapeInfo, xShapeInfo, zTadShapeInfo);
 
-            if(kindOfLoop == sd::LoopKind::EWS1) {
-                for (auto i = start; i < stop; i++) {
-                    auto oY = y + tadOffsets[i];
-                    auto oZ = z + zTadOffset[i];
-
-                    PRAGMA_OMP_SIMD
-                    for (unsigned int f = 0; f < tadLength; f++)
-                        oZ[f] = OpType::op(x[f], oY[f]);
-                }
-            }
-            else if(kindOfLoop == sd::LoopKind::EWSNONZERO) {
-                for (auto i = start; i < stop; i++) {
-                    auto oY = y + tadOffsets[i];
-                    auto oZ = z + zTadOffset[i];
-
-                    PRAGMA_OMP_SIMD
-                    for (unsigned int f = 0; f < tadLength; f++)
-                        oZ[f * zEws] = OpType::op(x[f * xEws], oY[f * yEws]);
-                };
+            if(kindOfLoop == sd::LoopKind::EWS1 || kindOfLoop == sd::LoopKind::EWSNONZERO) {
+                sd::cpuDispatch<BroadcastInverseTadKernel<X, Y, Z, OpType>>(x, (Nd4jLong) xEws, y, tadOffsets, (Nd4jLong) yEws, z, zTadOffset, (Nd4jLong) zEws, (Nd4jLong) tadLength, start, stop);
             }
             else if(shape::haveSameShapeAndStrides(yTadShapeShapeInfo, xShapeInfo) && shape::haveSameShapeAndStrides(yTadShapeShapeInfo, zTadShapeInfo)) {
                 uint tadShapeShapeInfoCast[MAX_RANK];
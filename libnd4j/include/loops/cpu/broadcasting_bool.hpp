@@ -116,8 +116,9 @@ namespace broadcast {
                 auto xTadShapeShapeInfo = xTadShapeInfo;
                 auto tadOffsets = xTadOffset;
 
+                sd::TadPack tadPack;
                 if (xTadShapeInfo == nullptr || tadOffsets == nullptr) {
-                    auto tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(xShapeInfo, dimension, dimensionLength);
+                    tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(xShapeInfo, dimension, dimensionLength);
 
                     xTadShapeShapeInfo = const_cast<Nd4jLong*>(tadPack.primaryShapeInfo());
                     tadOffsets = const_cast<Nd4jLong*>(tadPack.primaryOffsets());
@@ -281,8 +282,9 @@ namespace broadcast {
                 auto yTadShapeShapeInfo = yTadShapeInfo;
                 auto tadOffsets = yTadOffset;
 
+                sd::TadPack tadPack;
                 if (yTadShapeInfo == nullptr || tadOffsets == nullptr) {
-                    auto tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(yShapeInfo, dimension, dimensionLength);
+                    tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(yShapeInfo, dimension, dimensionLength);
 
                     yTadShapeShapeInfo = const_cast<Nd4jLong*>(tadPack.primaryShapeInfo());
                     tadOffsets = const_cast<Nd4jLong*>(tadPack.primaryOffsets());
@@ -109,8 +109,9 @@ namespace functions {
                 auto xTadShapeShapeInfo = xTadShapeInfo;
                 auto tadOffsets = xTadOffset;
 
+                sd::TadPack tadPack;
                 if (xTadShapeInfo == nullptr || tadOffsets == nullptr) {
-                    auto tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(xShapeInfo, dimension, dimensionLength);
+                    tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(xShapeInfo, dimension, dimensionLength);
 
                     xTadShapeShapeInfo = const_cast<Nd4jLong*>(tadPack.primaryShapeInfo());
                     tadOffsets = const_cast<Nd4jLong*>(tadPack.primaryOffsets());
@@ -272,8 +273,9 @@ namespace functions {
                 auto yTadShapeShapeInfo = yTadShapeInfo;
                 auto tadOffsets = yTadOffset;
 
+                sd::TadPack tadPack;
                 if (yTadShapeInfo == nullptr || tadOffsets == nullptr) {
-                    auto tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(yShapeInfo, dimension, dimensionLength);
+                    tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(yShapeInfo, dimension, dimensionLength);
 
                     yTadShapeShapeInfo = const_cast<Nd4jLong*>(tadPack.primaryShapeInfo());
                     tadOffsets = const_cast<Nd4jLong*>(tadPack.primaryOffsets());
@@ -140,11 +140,12 @@ void IndexReduce<X, Z>::exec(const void *vx, const Nd4jLong *xShapeInfo,
     auto tadOnlyShapeInfo = tadShapeInfo;
     auto tadOffsets = tadOffset;
 
+    sd::TadPack tadPack;
     if (tadOnlyShapeInfo == nullptr || tadOffsets == nullptr) {
         if (dimensionLength < 1)
             return;
 
-        auto tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(xShapeInfo, dimension, dimensionLength);
+        tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(xShapeInfo, dimension, dimensionLength);
 
         tadOnlyShapeInfo = tadPack.primaryShapeInfo();
         tadOffsets = tadPack.primaryOffsets();
@@ -29,12 +29,29 @@
 #include <system/op_boilerplate.h>
 #include <helpers/OmpLaunchHelper.h>
 #include <execution/Threads.h>
+#include <system/CpuDispatch.h>
 
 using namespace simdOps;
 
 namespace functions {
     namespace pairwise_transforms {
 
+        template <typename X, typename Y, typename Z, typename OpType>
+        struct PairWiseEwsKernel {
+            static FORCEINLINE void run(const X *x, Nd4jLong xEws, const Y *y, Nd4jLong yEws, Z *z, Nd4jLong zEws, Z *extraParams, uint64_t start, uint64_t stop) {
+                if (xEws == 1 && yEws == 1 && zEws == 1) {
+                    PRAGMA_OMP_SIMD
+                    for (auto i = start; i < stop; i++)
+                        z[i] = OpType::op(x[i], y[i], extraParams);
+                }
+                else {
+                    PRAGMA_OMP_SIMD
+                    for (auto i = start; i < stop; i++)
+                        z[i*zEws] = OpType::op(x[i*xEws], y[i*yEws], extraParams);
+                }
+            }
+        };
+
         template <typename X, typename Y, typename Z>
         void PairWiseTransform<X, Y, Z>::exec(const int opNum,
                                               const void *x, Nd4jLong xEws,
@@ -70,16 +87,7 @@ namespace functions {
             auto z = reinterpret_cast<Z *>(vz);
             auto extraParams = reinterpret_cast<Z *>(vextraParams);
 
-            if (xEws == 1 && yEws == 1 && zEws == 1) {
-                PRAGMA_OMP_SIMD
-                for (auto i = start; i < stop; i++)
-                        z[i] = OpType::op(x[i], y[i], extraParams);
-            }
-            else {
-                PRAGMA_OMP_SIMD
-                for (auto i = start; i < stop; i++)
-                    z[i*zEws] = OpType::op(x[i*xEws], y[i*yEws], extraParams);
-            }
+            sd::cpuDispatch<PairWiseEwsKernel<X, Y, Z, OpType>>(x, xEws, y, yEws, z, zEws, extraParams, start, stop);
         }
 
         template <typename X, typename Y, typename Z>
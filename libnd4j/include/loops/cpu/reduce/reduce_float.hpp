@@ -29,12 +29,30 @@
 #include <helpers/Loops.h>
 #include <helpers/ConstantTadHelper.h>
 #include <helpers/ShapeBuilders.h>
+#include <system/CpuDispatch.h>
 
 using namespace simdOps;
 
 namespace functions {
 namespace reduce    {
 
+        template <typename X, typename Z, typename OpType>
+        struct ReduceFloatEwsKernel {
+            static FORCEINLINE void run(const X *x, Nd4jLong xEws, Z *extraParams, typename OpType::InterType *result, int64_t start, int64_t stop) {
+                auto intermediate = *result;
+
+                if (xEws == 1) {
+                    for (auto i = start; i < stop; i++)
+                        intermediate = OpType::update(intermediate, OpType::op(x[i], extraParams), extraParams);
+                } else {
+                    for (auto i = start; i < stop; i++)
+                        intermediate = OpType::update(intermediate, OpType::op(x[i * xEws], extraParams), extraParams);
+                }
+
+                *result = intermediate;
+            }
+        };
+
         template <typename X, typename Z>
         template <typename OpType>
         void _CUDA_H ReduceFloatFunction<X,Z>::execScalar(const void *vx, const Nd4jLong *xShapeInfo,
@@ -163,13 +181,7 @@ namespace reduce    {
                 intermediate[e] = OpType::startingValue(x);
 
             auto func = PRAGMA_THREADS_FOR {
-                if (xEws == 1) {
-                    for (auto i = start; i < stop; i++)
-                        intermediate[thread_id] = OpType::update(intermediate[thread_id], OpType::op(x[i], extraParams), extraParams);
-                } else {
-                    for (auto i = start; i < stop; i++)
-                        intermediate[thread_id] = OpType::update(intermediate[thread_id], OpType::op(x[i * xEws], extraParams), extraParams);
-                }
+                sd::cpuDispatch<ReduceFloatEwsKernel<X, Z, OpType>>(x, xEws, extraParams, &intermediate[thread_id], start, stop);
             };
 
             maxThreads = samediff::Threads::parallel_for(func, 0, length, 1, maxThreads);
@@ -25,6 +25,7 @@
 #include <types/types.h>
 #include <helpers/LoopKind.h>
 #include <execution/Threads.h>
+#include <system/CpuDispatch.h>
 #include "../legacy_ops.h"
 
 using namespace simdOps;
@@ -32,6 +33,50 @@ using namespace simdOps;
 namespace functions {
 namespace scalar    {
 
+////////////////////////////////////////////////////////////////////////
+template<typename X, typename Y, typename Z, typename OpType>
+struct ScalarEwsKernel {
+    static FORCEINLINE void run(const X *x, Nd4jLong xEws, Z *z, Nd4jLong zEws, Y scalar, Z *extraParams, uint64_t start, uint64_t stop) {
+        if (xEws == 1 && zEws == 1) {
+            PRAGMA_OMP_SIMD
+            for (auto i = start; i < stop; i++)
+                z[i] = OpType::op(x[i], scalar, extraParams);
+        }
+        else {
+            PRAGMA_OMP_SIMD
+            for (auto i = start; i < stop; i++)
+                z[i * zEws] = OpType::op(x[i * xEws], scalar, extraParams);
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////
+template<typename X, typename Y, typename Z, typename OpType>
+struct ScalarTadKernel {
+    static FORCEINLINE void run(const X *x, const Nd4jLong *xTadOffsets, int xTadEws, Z *z, const Nd4jLong *zTadOffsets, int zTadEws, const Y *scalars, Z *extraParams, int tadLength, uint64_t start, uint64_t stop) {
+        if (xTadEws == 1 && zTadEws == 1) {
+            for (auto r = start; r < stop; r++) {
+                auto oZ = z + zTadOffsets[r];
+                auto oX = x + xTadOffsets[r];
+
+                PRAGMA_OMP_SIMD
+                for (int f = 0; f < tadLength; f++)
+                    oZ[f] = OpType::op(oX[f], scalars[r], extraParams);
+            }
+        }
+        else {
+            for (auto r = start; r < stop; r++) {
+                auto oZ = z + zTadOffsets[r];
+                auto oX = x + xTadOffsets[r];
+
+                PRAGMA_OMP_SIMD
+                for (int f = 0; f < tadLength; f++)
+                    oZ[f * zTadEws] = OpType::op(oX[f * xTadEws], scalars[r], extraParams);
+            }
+        }
+    }
+};
+
 
 ////////////////////////////////////////////////////////////////////////
 template<typename X, typename Y, typename Z>
@@ -69,26 +114,7 @@ void ScalarTransform<X, Y, Z>::transform(const void *vx, const Nd4jLong *xShapeI
 
     int num_threads = sd::math::nd4j_min<int>(numTads, sd::Environment::getInstance().maxThreads());
 
-    if (kindOfLoop == sd::LoopKind::EWS1) {
-        for (auto r = start; r < stop; r++) {
-            auto oZ = z + zTadOffsets[r];
-            auto oX = x + xTadOffsets[r];
-
-            PRAGMA_OMP_SIMD
-            for (int f = 0; f < tadLength; f++)
-                oZ[f] = OpType::op(oX[f], scalars[r], extraParams);
-        };
-    }
-    else {
-        for (auto r = start; r < stop; r++) {
-            auto oZ = z + zTadOffsets[r];
-            auto oX = x + xTadOffsets[r];
-
-            PRAGMA_OMP_SIMD
-            for (int f = 0; f < tadLength; f++)
-                oZ[f * zTadEws] = OpType::op(oX[f * xTadEws], scalars[r], extraParams);
-        };
-    }
+    sd::cpuDispatch<ScalarTadKernel<X, Y, Z, OpType>>(x, xTadOffsets, xTadEws, z, zTadOffsets, zTadEws, scalars, extraParams, tadLength, start, stop);
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -194,16 +220,7 @@ void ScalarTransform<X, Y, Z>::transform(const void *vx, Nd4jLong xEws,
     auto scalar = reinterpret_cast<const Y *>(vscalar)[0];
     auto extraParams = reinterpret_cast<Z *>(vextraParams);
 
-    if (xEws == 1 && zEws == 1) {
-        PRAGMA_OMP_SIMD
-        for (auto i = start; i < stop; i++)
-            z[i] = OpType::op(x[i], scalar, extraParams);
-    }
-    else {
-        PRAGMA_OMP_SIMD
-        for (auto i = start; i < stop; i++)
-            z[i * zEws] = OpType::op(x[i * xEws], scalar, extraParams);
-    }
+    sd::cpuDispatch<ScalarEwsKernel<X, Y, Z, OpType>>(x, xEws, z, zEws, scalar, extraParams, start, stop);
 }
 
 
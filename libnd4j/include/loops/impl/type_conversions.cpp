@@ -25,6 +25,8 @@
 #include <loops/type_conversions.h>
 #include <helpers/OmpLaunchHelper.h>
 #include <execution/Threads.h>
+#include <helpers/FloatConversions.h>
+#include <array/DataTypeUtils.h>
 
 namespace sd {
 
@@ -206,6 +208,10 @@ PRAGMA_OMP_ATOMIC_ARGS(write)
      */
     template<typename S, typename T>
     ND4J_LOCAL void TypeCast::convertGeneric(Nd4jPointer * extras, void *dx, Nd4jLong N, void *dz) {
+        // float types are converted with vectorized kernels
+        if (FloatConversions::convert(DataTypeUtils::fromT<S>(), dx, DataTypeUtils::fromT<T>(), dz, N))
+            return;
+
         auto x = reinterpret_cast<S *>(dx);
         auto z = reinterpret_cast<T *>(dz);
 
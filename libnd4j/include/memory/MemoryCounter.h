@@ -27,6 +27,7 @@
 #include <system/dll.h>
 #include <map>
 #include <memory/MemoryType.h>
+#include <memory/PooledAllocator.h>
 #include <mutex>
 
 namespace sd {
@@ -138,6 +139,13 @@ namespace sd {
              * @return
              */
             Nd4jLong groupLimit(sd::memory::MemoryType group);
+
+            /**
+             * This method returns hits, misses and cached bytes of pooled host allocations.
+             * Bytes of pooled buffers are counted by per-device and per-group counters as usual
+             * @return
+             */
+            PoolStatistics pooledStatistics();
         };
     }
 }
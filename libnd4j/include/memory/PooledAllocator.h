@@ -0,0 +1,125 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_POOLEDALLOCATOR_H
+#define SD_POOLEDALLOCATOR_H
+
+#include <system/pointercast.h>
+#include <system/dll.h>
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace sd {
+    namespace memory {
+        /**
+         * Snapshot of PooledAllocator counters. Hits and misses of other threads are flushed in batches, so they might lag a bit
+         */
+        struct ND4J_EXPORT PoolStatistics {
+            // allocations served from caches
+            Nd4jLong hits = 0;
+
+            // allocations that went to system allocator
+            Nd4jLong misses = 0;
+
+            // bytes of released blocks kept in shared pool for reuse
+            Nd4jLong cachedBytes = 0;
+
+            // bytes currently taken from system, both in use and cached
+            Nd4jLong reservedBytes = 0;
+
+            // part of reservedBytes backed by huge pages
+            Nd4jLong hugePageBytes = 0;
+        };
+
+        /**
+         * This class is a host allocator for buffers allocated outside of workspaces.
+         *
+         * Requests are rounded up to one of size classes (4 classes per power of 2, up to MAX_POOLED_SIZE bytes).
+         * Released blocks go to per-thread bins first, and overflow into shared pool, so alloc/free pairs within
+         * single thread never take locks. Bigger blocks are taken from system directly, optionally backed by huge pages.
+         * All blocks are aligned to ALIGNMENT bytes.
+         *
+         * PLEASE NOTE: caller must pass the same numBytes to release() that was passed to allocate()
+         */
+        class ND4J_EXPORT PooledAllocator {
+        public:
+            static const size_t ALIGNMENT = 64;
+            static const size_t MAX_POOLED_SIZE = 4 * 1024 * 1024;
+            static const int NUM_CLASSES = 60;
+
+        private:
+            std::vector<void*> _bins[NUM_CLASSES];
+            std::mutex _locks[NUM_CLASSES];
+
+            // blocks mapped with huge pages, they're released with munmap
+            std::unordered_set<void*> _hugeBlocks;
+            std::mutex _hugeLock;
+
+            std::atomic<Nd4jLong> _hits{0};
+            std::atomic<Nd4jLong> _misses{0};
+            std::atomic<Nd4jLong> _cachedBytes{0};
+            std::atomic<Nd4jLong> _reservedBytes{0};
+            std::atomic<Nd4jLong> _hugePageBytes{0};
+
+            PooledAllocator() = default;
+            ~PooledAllocator() = default;
+
+            void* systemAllocate(size_t numBytes);
+            void systemRelease(void *ptr, size_t numBytes);
+
+        public:
+            static PooledAllocator& getInstance();
+
+            /**
+             * This method returns index of size class for given number of bytes, or -1 if block isn't pooled
+             */
+            static int sizeClass(size_t numBytes);
+
+            /**
+             * This method returns actual size of blocks within given size class
+             */
+            static size_t classSize(int sizeClass);
+
+            /**
+             * This method returns aligned uninitialized block of at least numBytes bytes
+             */
+            void* allocate(size_t numBytes);
+
+            /**
+             * This method returns block to the pool, or to the system if pool is full
+             */
+            void release(void *ptr, size_t numBytes);
+
+            PoolStatistics statistics();
+
+            /**
+             * This method returns blocks cached by shared pool and calling thread to the system
+             */
+            void purge();
+
+            // these methods are used by per-thread caches
+            bool fetch(int sizeClass, std::vector<void*> &bin, size_t numBlocks);
+            void store(int sizeClass, std::vector<void*> &bin, size_t numBlocks);
+            void countHits(Nd4jLong numHits);
+        };
+    }
+}
+
+#endif //SD_POOLEDALLOCATOR_H
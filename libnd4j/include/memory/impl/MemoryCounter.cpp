@@ -127,5 +127,9 @@ namespace sd {
             std::lock_guard<std::mutex> lock(_locker);
             return _groupLimits[group];
         }
+
+        PoolStatistics MemoryCounter::pooledStatistics() {
+            return PooledAllocator::getInstance().statistics();
+        }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,338 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <memory/PooledAllocator.h>
+#include <system/Environment.h>
+#include <system/op_boilerplate.h>
+#include <exceptions/allocation_exception.h>
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace sd {
+    namespace memory {
+
+        // size of huge page, blocks of this size and bigger might be backed by huge pages
+        static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+        // per-thread bins keep up to this number of bytes per size class, but at least 1 block
+        static const size_t THREAD_BIN_BYTES = 1024 * 1024;
+
+        // total limit of per-thread bins, extra blocks go to shared pool
+        static const size_t THREAD_CACHE_BYTES = 8 * 1024 * 1024;
+
+        // limit of shared pool, extra blocks go back to system
+        static const Nd4jLong SHARED_POOL_BYTES = 256 * 1024 * 1024;
+
+        // hits of every thread are added to shared counter in batches of this size
+        static const Nd4jLong HITS_BATCH = 1024;
+
+        const size_t PooledAllocator::ALIGNMENT;
+        const size_t PooledAllocator::MAX_POOLED_SIZE;
+        const int PooledAllocator::NUM_CLASSES;
+
+        static FORCEINLINE size_t maxThreadBlocks(int sizeClass) {
+            return std::max<size_t>(1, THREAD_BIN_BYTES / PooledAllocator::classSize(sizeClass));
+        }
+
+        namespace {
+            struct ThreadCache {
+                std::vector<void*> bins[PooledAllocator::NUM_CLASSES];
+                size_t bytes = 0;
+                Nd4jLong hits = 0;
+
+                ThreadCache();
+                ~ThreadCache();
+            };
+
+            // 0 - not created yet, 1 - alive, 2 - destroyed.
+            // buffers released during thread/program shutdown must not touch destroyed cache, so they go to shared pool directly
+            thread_local int threadCacheState = 0;
+            thread_local ThreadCache threadCache;
+
+            ThreadCache::ThreadCache() {
+                threadCacheState = 1;
+            }
+
+            ThreadCache::~ThreadCache() {
+                threadCacheState = 2;
+
+                auto &allocator = PooledAllocator::getInstance();
+                for (int c = 0; c < PooledAllocator::NUM_CLASSES; c++)
+                    allocator.store(c, bins[c], bins[c].size());
+
+                allocator.countHits(hits);
+            }
+
+            FORCEINLINE ThreadCache* currentCache() {
+                return threadCacheState != 2 ? &threadCache : nullptr;
+            }
+        }
+
+        PooledAllocator& PooledAllocator::getInstance() {
+            // never destroyed: buffers of static objects might be released after static destructors were called
+            static auto instance = new PooledAllocator();
+            return *instance;
+        }
+
+        int PooledAllocator::sizeClass(size_t numBytes) {
+            if (numBytes > MAX_POOLED_SIZE)
+                return -1;
+
+            if (numBytes <= 256)
+                return static_cast<int>((std::max<size_t>(numBytes, 1) + ALIGNMENT - 1) / ALIGNMENT) - 1;
+
+            // 2^p < numBytes <= 2^(p+1), split into 4 classes
+            int p = 8;
+            while (((numBytes - 1) >> (p + 1)) != 0)
+                p++;
+
+            const size_t step = static_cast<size_t>(1) << (p - 2);
+            const auto k = static_cast<int>((numBytes - (static_cast<size_t>(1) << p) + step - 1) / step);
+
+            return 4 + (p - 8) * 4 + (k - 1);
+        }
+
+        size_t PooledAllocator::classSize(int sizeClass) {
+            if (sizeClass < 4)
+                return (sizeClass + 1) * ALIGNMENT;
+
+            const int p = 8 + (sizeClass - 4) / 4;
+            const int k = (sizeClass - 4) % 4 + 1;
+
+            return (static_cast<size_t>(1) << p) + k * (static_cast<size_t>(1) << (p - 2));
+        }
+
+        void* PooledAllocator::systemAllocate(size_t numBytes) {
+            _misses.fetch_add(1, std::memory_order_relaxed);
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            if (numBytes >= HUGE_PAGE_SIZE && Environment::getInstance().isPooledHugePages()) {
+                const auto mappedBytes = (numBytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+                auto ptr = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (ptr != MAP_FAILED) {
+                    // this is a hint only, kernel falls back to regular pages if there are no huge pages available
+                    madvise(ptr, mappedBytes, MADV_HUGEPAGE);
+
+                    {
+                        std::lock_guard<std::mutex> lock(_hugeLock);
+                        _hugeBlocks.insert(ptr);
+                    }
+
+                    _reservedBytes.fetch_add(mappedBytes, std::memory_order_relaxed);
+                    _hugePageBytes.fetch_add(mappedBytes, std::memory_order_relaxed);
+                    return ptr;
+                }
+            }
+#endif
+
+            void *ptr = nullptr;
+#if defined(_WIN32)
+            ptr = _aligned_malloc(numBytes, ALIGNMENT);
+#else
+            if (posix_memalign(&ptr, ALIGNMENT, numBytes) != 0)
+                ptr = nullptr;
+#endif
+
+            if (ptr == nullptr)
+                throw sd::allocation_exception::build("PooledAllocator: failed to allocate host memory", numBytes);
+
+            _reservedBytes.fetch_add(numBytes, std::memory_order_relaxed);
+            return ptr;
+        }
+
+        void PooledAllocator::systemRelease(void *ptr, size_t numBytes) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            if (numBytes >= HUGE_PAGE_SIZE) {
+                bool huge = false;
+                {
+                    std::lock_guard<std::mutex> lock(_hugeLock);
+                    huge = _hugeBlocks.erase(ptr) > 0;
+                }
+
+                if (huge) {
+                    const auto mappedBytes = (numBytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+                    munmap(ptr, mappedBytes);
+
+                    _reservedBytes.fetch_sub(mappedBytes, std::memory_order_relaxed);
+                    _hugePageBytes.fetch_sub(mappedBytes, std::memory_order_relaxed);
+                    return;
+                }
+            }
+#endif
+
+#if defined(_WIN32)
+            _aligned_free(ptr);
+#else
+            free(ptr);
+#endif
+            _reservedBytes.fetch_sub(numBytes, std::memory_order_relaxed);
+        }
+
+        void* PooledAllocator::allocate(size_t numBytes) {
+            const auto c = sizeClass(numBytes);
+            if (c < 0)
+                return systemAllocate(numBytes);
+
+            auto cache = currentCache();
+            if (cache == nullptr) {
+                std::vector<void*> bin;
+                if (fetch(c, bin, 1)) {
+                    countHits(1);
+                    return bin.back();
+                }
+
+                return systemAllocate(classSize(c));
+            }
+
+            auto &bin = cache->bins[c];
+            if (bin.empty() && !fetch(c, bin, std::max<size_t>(1, maxThreadBlocks(c) / 2)))
+                return systemAllocate(classSize(c));
+
+            auto ptr = bin.back();
+            bin.pop_back();
+            cache->bytes -= classSize(c);
+
+            if (++cache->hits >= HITS_BATCH) {
+                countHits(cache->hits);
+                cache->hits = 0;
+            }
+
+            return ptr;
+        }
+
+        void PooledAllocator::release(void *ptr, size_t numBytes) {
+            if (ptr == nullptr)
+                return;
+
+            const auto c = sizeClass(numBytes);
+            if (c < 0) {
+                systemRelease(ptr, numBytes);
+                return;
+            }
+
+            auto cache = currentCache();
+            if (cache == nullptr) {
+                std::vector<void*> bin = {ptr};
+                store(c, bin, 1);
+                return;
+            }
+
+            const auto size = classSize(c);
+            auto &bin = cache->bins[c];
+            bin.emplace_back(ptr);
+            cache->bytes += size;
+
+            // half of the bin moves to shared pool, so threads that only release don't hold memory forever
+            if (bin.size() > maxThreadBlocks(c) || cache->bytes > THREAD_CACHE_BYTES) {
+                const auto numBlocks = (bin.size() + 1) / 2;
+                store(c, bin, numBlocks);
+                cache->bytes -= numBlocks * size;
+            }
+        }
+
+        bool PooledAllocator::fetch(int sizeClass, std::vector<void*> &bin, size_t numBlocks) {
+            std::lock_guard<std::mutex> lock(_locks[sizeClass]);
+
+            auto &shared = _bins[sizeClass];
+            const auto numFetched = std::min(numBlocks, shared.size());
+            if (numFetched == 0)
+                return false;
+
+            bin.insert(bin.end(), shared.end() - numFetched, shared.end());
+            shared.resize(shared.size() - numFetched);
+
+            _cachedBytes.fetch_sub(numFetched * classSize(sizeClass), std::memory_order_relaxed);
+            return true;
+        }
+
+        void PooledAllocator::store(int sizeClass, std::vector<void*> &bin, size_t numBlocks) {
+            const auto size = classSize(sizeClass);
+            std::vector<void*> extra;
+
+            {
+                std::lock_guard<std::mutex> lock(_locks[sizeClass]);
+
+                auto &shared = _bins[sizeClass];
+                for (size_t e = 0; e < numBlocks && !bin.empty(); e++) {
+                    if (_cachedBytes.load(std::memory_order_relaxed) + (Nd4jLong) size <= SHARED_POOL_BYTES) {
+                        shared.emplace_back(bin.back());
+                        _cachedBytes.fetch_add(size, std::memory_order_relaxed);
+                    } else {
+                        extra.emplace_back(bin.back());
+                    }
+
+                    bin.pop_back();
+                }
+            }
+
+            for (auto ptr : extra)
+                systemRelease(ptr, size);
+        }
+
+        void PooledAllocator::countHits(Nd4jLong numHits) {
+            _hits.fetch_add(numHits, std::memory_order_relaxed);
+        }
+
+        PoolStatistics PooledAllocator::statistics() {
+            auto cache = currentCache();
+            if (cache != nullptr) {
+                countHits(cache->hits);
+                cache->hits = 0;
+            }
+
+            PoolStatistics stats;
+            stats.hits = _hits.load();
+            stats.misses = _misses.load();
+            stats.cachedBytes = _cachedBytes.load();
+            stats.reservedBytes = _reservedBytes.load();
+            stats.hugePageBytes = _hugePageBytes.load();
+
+            return stats;
+        }
+
+        void PooledAllocator::purge() {
+            auto cache = currentCache();
+            if (cache != nullptr) {
+                for (int c = 0; c < NUM_CLASSES; c++) {
+                    for (auto ptr : cache->bins[c])
+                        systemRelease(ptr, classSize(c));
+
+                    cache->bins[c].clear();
+                }
+
+                cache->bytes = 0;
+            }
+
+            for (int c = 0; c < NUM_CLASSES; c++) {
+                std::vector<void*> blocks;
+                {
+                    std::lock_guard<std::mutex> lock(_locks[c]);
+                    blocks.swap(_bins[c]);
+                    _cachedBytes.fetch_sub(blocks.size() * classSize(c), std::memory_order_relaxed);
+                }
+
+                for (auto ptr : blocks)
+                    systemRelease(ptr, classSize(c));
+            }
+        }
+    }
+}
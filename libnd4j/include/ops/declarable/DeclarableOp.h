@@ -35,6 +35,7 @@
 #include <helpers/OpArgsHolder.h>
 #include <system/dll.h>
 #include <ops/declarable/EmptyHandling.h>
+#include <ops/declarable/ShapeFunctionCache.h>
 //#include <ops/declarable/declarable_ops.h>
 
 #include <chrono>
@@ -75,6 +76,9 @@ namespace sd {
             OpDescriptor *_descriptor;
             NDArray *_scalar = nullptr;
 
+            // output shapes of previous executions, used by prepareOutputs
+            ShapeFunctionCache _shapeFunctionCache;
+
             virtual void registerTypes();
 
             /**
@@ -142,6 +146,11 @@ namespace sd {
             */
             virtual ShapeList* calculateOutputShape(ShapeList* inputShape, sd::graph::Context& block) = 0;
 
+            /**
+             * This method returns cache of output shapes this op keeps for repeated executions
+             */
+            ShapeFunctionCache& shapeFunctionCache();
+
             /**
              * Returns opName
              *
@@ -0,0 +1,62 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_FUSEDELEMENTWISEOP_H
+#define LIBND4J_FUSEDELEMENTWISEOP_H
+
+#include <ops/declarable/DeclarableOp.h>
+#include <helpers/FusedLoops.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sd {
+    namespace ops {
+        /**
+         * This class executes chain of legacy elementwise ops (transform strict/same, scalar and pairwise) as single op.
+         *
+         * Input 0 is the input of the first op in chain, following inputs are second operands of pairwise steps in order.
+         * T arguments are scalars of scalar steps in order. Intermediate results aren't materialized on CPU.
+         */
+        class ND4J_EXPORT FusedElementwiseOp : public DeclarableOp {
+        protected:
+            // y operands aren't defined here, they are taken from inputs at execution time
+            std::vector<FusedStep> _program;
+
+            Nd4jStatus validateAndExecute(Context& block) override;
+
+            explicit FusedElementwiseOp(const std::vector<FusedStep> &program);
+
+        public:
+            ~FusedElementwiseOp() = default;
+
+            /**
+             * This method returns op for given chain of steps. Ops are cached and live until process exits,
+             * so graph nodes just refer to them
+             */
+            static FusedElementwiseOp* build(const std::vector<FusedStep> &program);
+
+            const std::vector<FusedStep>& program() const;
+
+            ShapeList* calculateOutputShape(ShapeList* inputShape, sd::graph::Context& block) override;
+        };
+    }
+}
+
+#endif //LIBND4J_FUSEDELEMENTWISEOP_H
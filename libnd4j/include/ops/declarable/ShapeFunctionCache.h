@@ -0,0 +1,108 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_SHAPEFUNCTIONCACHE_H
+#define LIBND4J_SHAPEFUNCTIONCACHE_H
+
+#include <system/pointercast.h>
+#include <system/dll.h>
+#include <array/ShapeList.h>
+#include <graph/Context.h>
+#include <helpers/ConcurrentCache.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace sd {
+    namespace ops {
+        /**
+         * This class holds output shapes of single op, keyed by everything its shape function depends on except input values:
+         * input shapeInfos (so data types, orders and strides as well), op arguments and default data types.
+         *
+         * Shape functions which read values of input arrays (i.e. reshape with shape given as array) are found on the first call,
+         * via DataBuffer access tracking, and op isn't cached since then. Shape functions which look only at shapes, data types
+         * or emptiness of inputs (i.e. concat or permute) stay cacheable. Calls with list inputs are never cached.
+         *
+         * Ops are registry singletons shared by all threads, so lookups never take a lock, see sd::ConcurrentCache
+         */
+        class ND4J_EXPORT ShapeFunctionCache {
+        public:
+            typedef std::vector<Nd4jLong> Key;
+
+            /**
+             * Output shapeInfos are owned by entry, so they stay valid while entry is used, even if cache is flushed meanwhile
+             */
+            class ND4J_EXPORT Entry {
+            protected:
+                std::vector<std::vector<Nd4jLong>> _shapes;
+
+            public:
+                explicit Entry(ShapeList &shapes);
+                ~Entry() = default;
+
+                /**
+                 * This method returns new ShapeList pointing to shapes of this entry
+                 */
+                ShapeList* shapeList() const;
+            };
+
+        protected:
+            struct KeyHash {
+                size_t operator()(const Key &key) const;
+            };
+
+            ConcurrentCache<Key, std::shared_ptr<Entry>, KeyHash> _entries;
+
+            std::atomic<bool> _dataDependent{false};
+
+        public:
+            ShapeFunctionCache();
+            ~ShapeFunctionCache() = default;
+
+            /**
+             * This method builds cache key for given input shapes and Context
+             */
+            static Key key(ShapeList &inputShapes, sd::graph::Context &ctx);
+
+            /**
+             * This method returns TRUE if shape function results can be taken from this cache
+             */
+            bool isApplicable() const;
+
+            /**
+             * This method returns cached shapes for given key, or nullptr
+             */
+            std::shared_ptr<Entry> get(const Key &key);
+            void put(const Key &key, ShapeList &outputShapes);
+
+            /**
+             * This method forbids caching, once shape function was found reading values of input arrays
+             */
+            void markDataDependent();
+            bool isDataDependent() const;
+
+            Nd4jLong hits() const;
+            Nd4jLong misses() const;
+
+            int size();
+            void purge();
+        };
+    }
+}
+
+#endif //LIBND4J_SHAPEFUNCTIONCACHE_H
@@ -25,6 +25,7 @@
 
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/axis.h>
+#include <ops/declarable/helpers/normalization.h>
 
 namespace sd {
     namespace ops {
@@ -51,6 +52,13 @@ namespace sd {
             }
 
             std::vector<int>& dims = axis;
+
+#ifndef __CUDABLAS__
+            // batchnorm training statistics: mean and variance in one pass
+            if (helpers::momentsFused(*input, axis, *means, *variances))
+                return Status::OK();
+#endif
+
             input->varianceAlongDimension(variance::SummaryStatsVariance, *variances, false, axis);
             input->reduceAlongDimension(reduce::Mean, *means, axis, keepDims);
 
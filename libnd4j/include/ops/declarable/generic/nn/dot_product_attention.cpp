@@ -27,6 +27,7 @@
 
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/reverse.h>
+#include <ops/declarable/helpers/attention.h>
 
 
 namespace sd {
@@ -41,13 +42,6 @@ namespace ops  {
         auto output = OUTPUT_VARIABLE(0);
         NDArray* weights;
         bool outputWeights = INT_ARG(1);
-        if(outputWeights){
-            weights = OUTPUT_VARIABLE(1);
-        }else{
-            auto weightShape = ShapeUtils::evalShapeForMatmul(keys->shapeInfo(), queries->shapeInfo(), true, false);
-            weights = new NDArray('c', weightShape, values->dataType(), block.launchContext());
-        }
-
         int normalization = INT_ARG(0);
 
         REQUIRE_TRUE(queries->rankOf() == keys->rankOf() && keys->rankOf() == values->rankOf(), 0,
@@ -71,6 +65,21 @@ namespace ops  {
                 "dot_product_attention: Keys and Values must have the same timestep length. "
                 "But got keys = %i, values = %i", keys->sizeAt(-1), values->sizeAt(-1));
 
+#ifndef __CUDABLAS__
+        // weights aren't requested, so there's no need to materialize them
+        if (!outputWeights && queries->dataType() == output->dataType() && keys->dataType() == output->dataType() && values->dataType() == output->dataType()) {
+            helpers::dotProductAttention(block.launchContext(), *queries, *keys, *values, mask, normalization, *output);
+            return Status::OK();
+        }
+#endif
+
+        if(outputWeights){
+            weights = OUTPUT_VARIABLE(1);
+        }else{
+            auto weightShape = ShapeUtils::evalShapeForMatmul(keys->shapeInfo(), queries->shapeInfo(), true, false);
+            weights = new NDArray('c', weightShape, values->dataType(), block.launchContext());
+        }
+
         sd::ops::matmul mmul;
         mmul.execute({keys, queries}, {weights}, {}, {1}, {});
         if(normalization) {
@@ -163,6 +172,12 @@ namespace ops  {
                      "dot_product_attention: Keys and Values must have the same timestep length. "
                      "But got keys = %i, values = %i", keys->sizeAt(-1), values->sizeAt(-1));
 
+#ifndef __CUDABLAS__
+        if (queries->dataType() == dLdq->dataType() && keys->dataType() == dLdq->dataType() && values->dataType() == dLdq->dataType() && eps->dataType() == dLdq->dataType()) {
+            helpers::dotProductAttentionBp(block.launchContext(), *queries, *keys, *values, *eps, mask, normalization, *dLdq, *dLdk, *dLdv);
+            return Status::OK();
+        }
+#endif
 
         double factor;
         if(normalization)
@@ -28,6 +28,7 @@
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/reverse.h>
 #include <ops/declarable/helpers/addBias.h>
+#include <ops/declarable/helpers/normalization.h>
 
 namespace sd {
 namespace ops  {
@@ -50,6 +51,12 @@ namespace ops  {
             REQUIRE_TRUE(bias->rankOf() == 1 && bias->sizeAt(0) == input->sizeAt(dimC), 0, "LAYER_NORM OP: wrong shape of bias array, expected is {%i}, but got %s instead !", input->sizeAt(dimC), ShapeUtils::shapeAsString(bias).c_str());
         }
 
+#ifndef __CUDABLAS__
+        // statistics, normalization, gain and bias in two passes over input
+        if (!axis.empty() && helpers::standardizeFused(*input, axis, gain, bias, dimC, *output))
+            return Status::OK();
+#endif
+
         std::vector<Nd4jLong> longAxis = ArrayUtils::toLongVector(axis);
 
         sd::ops::standardize standardizeOp;
@@ -95,8 +102,15 @@ namespace ops  {
 
         std::vector<Nd4jLong> longAxis = ArrayUtils::toLongVector(axis);
 
-        if(bias != nullptr) {
+        if(bias != nullptr)
             REQUIRE_TRUE(bias->rankOf() == 1 && bias->sizeAt(0) == input->sizeAt(dimC), 0, "LAYER_NORM_BP OP: wrong shape of bias array, expected is {%i}, but got %s instead !", input->sizeAt(dimC), ShapeUtils::shapeAsString(bias).c_str());
+
+#ifndef __CUDABLAS__
+        if (!axis.empty() && helpers::standardizeBpFused(*input, *eps, axis, gain, dimC, *dLdx, dLdg, dLdb))
+            return Status::OK();
+#endif
+
+        if(bias != nullptr) {
             // eps->reduceAlongDimension(sd::reduce::Sum, *dLdb, {0}, true);
             eps->reduceAlongDimension(sd::reduce::Sum, *dLdb, ShapeUtils::evalDimsToExclude(input->rankOf(), {dimC}));
         }
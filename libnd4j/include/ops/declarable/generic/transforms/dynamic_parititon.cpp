@@ -61,10 +61,10 @@ namespace ops {
         std::vector<int> partitionSizes(numPartition, 0);
         auto in = inputShape->at(0);
         auto idx = inputShape->at(1);
-        for (int i = 0; i < numPartition; i++) {
-            for (int e = 0; e < indices->lengthOf(); ++e)
-                if (indices->e<Nd4jLong>(e) == i)
-                    partitionSizes[i]++;
+        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
+            auto i = indices->e<Nd4jLong>(e);
+            if (i >= 0 && i < numPartition)
+                partitionSizes[i]++;
         }
 
         auto shapes = SHAPELIST();
@@ -76,7 +76,7 @@ namespace ops {
             newShape[0] = outRank;
             newShape[1] = partitionSizes[e];
             for (int i = 1; i < outRank; ++i)
-                newShape[i + 1] = shape::sizeAt(in, outRank + i - 1);
+                newShape[i + 1] = shape::sizeAt(in, shape::rank(idx) + i - 1);
 
             shape::updateStrides(newShape, shape::order(in));
             ArrayOptions::setDataType(newShape, ArrayOptions::dataType(in));
@@ -27,6 +27,7 @@
 
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/reverse.h>
+#include <ops/declarable/helpers/normalization.h>
 
 
 namespace sd {
@@ -48,6 +49,11 @@ namespace ops  {
 
         shape::checkDimensions(input->rankOf(), axis);
 
+#ifndef __CUDABLAS__
+        if (helpers::standardizeFused(*input, axis, nullptr, nullptr, 0, *output))
+            return Status::OK();
+#endif
+
         auto means = input->reduceAlongDimension(reduce::Mean, axis, true);
         auto stdev = input->varianceAlongDimension(variance::SummaryStatsStandardDeviation, false, axis);
         stdev.reshapei(means.getShapeAsVector());
@@ -82,6 +88,12 @@ namespace ops  {
 
 
         shape::checkDimensions(input->rankOf(), axis);
+
+#ifndef __CUDABLAS__
+        if (helpers::standardizeBpFused(*input, *eps, axis, nullptr, 0, *output, nullptr, nullptr))
+            return Status::OK();
+#endif
+
         auto longAxis = ArrayUtils::toLongVector(axis);
 
         auto means = input->reduceAlongDimension(reduce::Mean, axis, true);
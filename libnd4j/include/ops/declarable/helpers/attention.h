@@ -0,0 +1,50 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_HELPERS_ATTENTION_H
+#define LIBND4J_HELPERS_ATTENTION_H
+
+#include <ops/declarable/helpers/helpers.h>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+    /**
+     * Fused dot product attention: keys and values are processed in tiles, with online softmax,
+     * so [Tk, Tq] weights matrix is never materialized, and memory use stays linear in sequence length.
+     *
+     * queries: [bS, (nHeads,) dk, Tq]
+     * keys:    [bS, (nHeads,) dk, Tk]
+     * values:  [bS, (nHeads,) dv, Tk]
+     * mask:    [bS, Tk], 1 for positions to keep and 0 for positions to skip, or nullptr
+     * output:  [bS, (nHeads,) dv, Tq]
+     */
+    ND4J_EXPORT void dotProductAttention(sd::LaunchContext * context, const NDArray& queries, const NDArray& keys, const NDArray& values, const NDArray* mask, const bool scaled, NDArray& output);
+
+    /**
+     * Backprop for fused dot product attention, probabilities are recomputed tile by tile from per-query softmax statistics
+     * eps: [bS, (nHeads,) dv, Tq]
+     */
+    ND4J_EXPORT void dotProductAttentionBp(sd::LaunchContext * context, const NDArray& queries, const NDArray& keys, const NDArray& values, const NDArray& eps, const NDArray* mask, const bool scaled, NDArray& dLdq, NDArray& dLdk, NDArray& dLdv);
+
+}
+}
+}
+
+#endif //LIBND4J_HELPERS_ATTENTION_H
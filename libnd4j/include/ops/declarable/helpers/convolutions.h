@@ -38,6 +38,16 @@ namespace sd {
             PNORM_POOL = 2,
         };
 
+        // algorithms of CPU conv2d, selected via Environment::setConv2dAlgorithm()
+        enum Conv2dAlgorithm {
+            CONV2D_AUTO = 0,                // heuristic choice per layer
+            CONV2D_AUTOTUNE = 1,            // candidates are timed on first call for each layer shape, and the fastest one is cached
+            CONV2D_IM2COL = 2,              // im2col + tensorDot
+            CONV2D_DIRECT = 3,              // implicit GEMM over NHWC input, no im2col buffer
+            CONV2D_WINOGRAD_2X2 = 4,        // Winograd F(2x2, 3x3), 3x3 kernels with unit strides and dilations only. Never chosen by AUTO or AUTOTUNE, since it changes rounding
+            CONV2D_WINOGRAD_4X4 = 5,        // Winograd F(4x4, 3x3), same restrictions. Its transforms amplify rounding errors, so it doesn't suit HALF and BFLOAT16
+        };
+
         class ND4J_EXPORT ConvolutionUtils {
         public:
             static inline void calcOutSizePool2D(int& oH, int& oW, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int iH, const int iW, const int paddingMode) {
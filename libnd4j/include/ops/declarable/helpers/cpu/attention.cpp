@@ -0,0 +1,467 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/helpers/attention.h>
+#include <execution/Threads.h>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// number of queries and keys processed together, tiles of packed keys/values stay in L1/L2 while all queries of a tile consume them
+static const Nd4jLong ATTENTION_QUERY_TILE = 32;
+static const Nd4jLong ATTENTION_KEY_TILE = 128;
+
+//////////////////////////////////////////////////////////////////////////
+// [bS, (nHeads,) size, time] array, possibly permuted or strided view
+struct AttentionView {
+    Nd4jLong batchStride;
+    Nd4jLong headStride;
+    Nd4jLong sizeStride;
+    Nd4jLong timeStride;
+    Nd4jLong nHeads;
+
+    explicit AttentionView(const NDArray& array) {
+        const auto strides = array.stridesOf();
+        const bool multiHead = array.rankOf() == 4;
+
+        batchStride = strides[0];
+        headStride  = multiHead ? strides[1] : 0;
+        sizeStride  = strides[multiHead ? 2 : 1];
+        timeStride  = strides[multiHead ? 3 : 2];
+        nHeads      = multiHead ? array.sizeAt(1) : 1;
+    }
+
+    FORCEINLINE Nd4jLong offset(Nd4jLong slice, Nd4jLong s, Nd4jLong t) const {
+        return (slice / nHeads) * batchStride + (slice % nHeads) * headStride + s * sizeStride + t * timeStride;
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// copies [size, time] slice into contiguous buffer, either as is or transposed to [time, size]
+template <typename T, typename A>
+static void packSlice(const T* x, const AttentionView& view, const Nd4jLong slice, const Nd4jLong size, const Nd4jLong time, const bool timeMajor, const A factor, A* z) {
+    for (Nd4jLong s = 0; s < size; s++) {
+        for (Nd4jLong t = 0; t < time; t++) {
+            const auto v = static_cast<A>(x[view.offset(slice, s, t)]) * factor;
+            if (timeMajor)
+                z[t * size + s] = v;
+            else
+                z[s * time + t] = v;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// packed copies of inputs, all in accumulation type
+template <typename A>
+struct AttentionPack {
+    Nd4jLong numSlices, dk, dv, tq, tk, bS;
+    bool hasMask;
+
+    std::vector<A> q;       // [slices, Tq, dk], pre-multiplied by scale factor
+    std::vector<A> kT;      // [slices, dk, Tk]
+    std::vector<A> k;       // [slices, Tk, dk], backprop only
+    std::vector<A> v;       // [slices, Tk, dv], forward only
+    std::vector<A> vT;      // [slices, dv, Tk], backprop only
+    std::vector<A> eps;     // [slices, Tq, dv], backprop only
+    std::vector<A> bias;    // [bS, Tk], (mask - 1) * 1e9
+
+    FORCEINLINE const A* query(Nd4jLong slice, Nd4jLong j) const { return q.data() + (slice * tq + j) * dk; }
+    FORCEINLINE const A* maskBias(Nd4jLong slice) const { return hasMask ? bias.data() + (slice / (numSlices / bS)) * tk : nullptr; }
+};
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T, typename A>
+static void packInputs(const NDArray& queries, const NDArray& keys, const NDArray& values, const NDArray* eps, const NDArray* mask, const bool scaled, AttentionPack<A>& pack) {
+
+    const bool backprop = eps != nullptr;
+    const AttentionView qView(queries), kView(keys), vView(values);
+    const AttentionView eView(backprop ? *eps : queries);
+
+    pack.bS = queries.sizeAt(0);
+    pack.numSlices = pack.bS * qView.nHeads;
+    pack.dk = queries.sizeAt(-2);
+    pack.dv = values.sizeAt(-2);
+    pack.tq = queries.sizeAt(-1);
+    pack.tk = keys.sizeAt(-1);
+    pack.hasMask = mask != nullptr;
+
+    const auto numSlices = pack.numSlices, dk = pack.dk, dv = pack.dv, tq = pack.tq, tk = pack.tk;
+    const A factor = scaled ? static_cast<A>(1) / sd::math::nd4j_sqrt<A, A>(static_cast<A>(dk)) : static_cast<A>(1);
+
+    pack.q.resize(numSlices * tq * dk);
+    pack.kT.resize(numSlices * dk * tk);
+    if (backprop) {
+        pack.k.resize(numSlices * tk * dk);
+        pack.vT.resize(numSlices * dv * tk);
+        pack.eps.resize(numSlices * tq * dv);
+    }
+    else
+        pack.v.resize(numSlices * tk * dv);
+
+    if (mask != nullptr) {
+        // 1e9 effectively means infinity, and matches non-fused implementation
+        NDArray bias('c', {pack.bS, tk}, DataTypeUtils::fromT<A>(), queries.getContext());
+        bias.assign(mask->reshape(mask->ordering(), {mask->sizeAt(0), mask->sizeAt(1)}));
+        bias -= 1.f;
+        bias *= 1e9f;
+        pack.bias.assign(bias.bufferAsT<A>(), bias.bufferAsT<A>() + pack.bS * tk);
+    }
+
+    auto q = queries.bufferAsT<T>();
+    auto k = keys.bufferAsT<T>();
+    auto v = values.bufferAsT<T>();
+    auto e = backprop ? eps->bufferAsT<T>() : nullptr;
+
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto s = start; s < stop; s++) {
+            packSlice<T, A>(q, qView, s, dk, tq, true, factor, pack.q.data() + s * tq * dk);
+            packSlice<T, A>(k, kView, s, dk, tk, false, static_cast<A>(1), pack.kT.data() + s * dk * tk);
+
+            if (backprop) {
+                packSlice<T, A>(k, kView, s, dk, tk, true, static_cast<A>(1), pack.k.data() + s * tk * dk);
+                packSlice<T, A>(v, vView, s, dv, tk, false, static_cast<A>(1), pack.vT.data() + s * dv * tk);
+                packSlice<T, A>(e, eView, s, dv, tq, true, static_cast<A>(1), pack.eps.data() + s * tq * dv);
+            }
+            else
+                packSlice<T, A>(v, vView, s, dv, tk, true, static_cast<A>(1), pack.v.data() + s * tk * dv);
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, numSlices);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// scores of one query against tile of keys: s[i] = q * kT[:, i0 + i] + bias[i0 + i]
+template <typename A>
+static FORCEINLINE void tileScores(const A* query, const A* kT, const A* bias, const Nd4jLong dk, const Nd4jLong tk, const Nd4jLong i0, const Nd4jLong n, A* scores) {
+    PRAGMA_OMP_SIMD
+    for (Nd4jLong i = 0; i < n; i++)
+        scores[i] = static_cast<A>(0);
+
+    for (Nd4jLong d = 0; d < dk; d++) {
+        const auto qd = query[d];
+        const auto row = kT + d * tk + i0;
+
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong i = 0; i < n; i++)
+            scores[i] += qd * row[i];
+    }
+
+    // bias goes last, otherwise 1e9 would swallow partial sums
+    if (bias != nullptr) {
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong i = 0; i < n; i++)
+            scores[i] += bias[i0 + i];
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// dP[i] = eps_j * vT[:, i0 + i]
+template <typename A>
+static FORCEINLINE void tileEpsDot(const A* eps, const A* vT, const Nd4jLong dv, const Nd4jLong tk, const Nd4jLong i0, const Nd4jLong n, A* dP) {
+    PRAGMA_OMP_SIMD
+    for (Nd4jLong i = 0; i < n; i++)
+        dP[i] = static_cast<A>(0);
+
+    for (Nd4jLong d = 0; d < dv; d++) {
+        const auto ed = eps[d];
+        const auto row = vT + d * tk + i0;
+
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong i = 0; i < n; i++)
+            dP[i] += ed * row[i];
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void dotProductAttention_(const NDArray& queries, const NDArray& keys, const NDArray& values, const NDArray* mask, const bool scaled, NDArray& output) {
+    typedef typename std::conditional<std::is_same<T, double>::value, double, float>::type A;
+
+    AttentionPack<A> pack;
+    packInputs<T, A>(queries, keys, values, nullptr, mask, scaled, pack);
+
+    const auto dk = pack.dk, dv = pack.dv, tq = pack.tq, tk = pack.tk;
+    const auto numQueryTiles = (tq + ATTENTION_QUERY_TILE - 1) / ATTENTION_QUERY_TILE;
+    const AttentionView zView(output);
+    auto z = output.bufferAsT<T>();
+
+    auto func = PRAGMA_THREADS_FOR {
+        // running max, running sum and unnormalized output for each query of the tile
+        std::vector<A> maxes(ATTENTION_QUERY_TILE), sums(ATTENTION_QUERY_TILE), acc(ATTENTION_QUERY_TILE * dv);
+        A scores[ATTENTION_KEY_TILE];
+
+        for (auto task = start; task < stop; task++) {
+            const auto slice = task / numQueryTiles;
+            const auto j0 = (task % numQueryTiles) * ATTENTION_QUERY_TILE;
+            const auto numQueries = sd::math::nd4j_min<Nd4jLong>(ATTENTION_QUERY_TILE, tq - j0);
+
+            const auto kT = pack.kT.data() + slice * dk * tk;
+            const auto v = pack.v.data() + slice * tk * dv;
+            const auto bias = pack.maskBias(slice);
+
+            std::fill(maxes.begin(), maxes.end(), -DataTypeUtils::max<A>());
+            std::fill(sums.begin(), sums.end(), static_cast<A>(0));
+            std::fill(acc.begin(), acc.end(), static_cast<A>(0));
+
+            for (Nd4jLong i0 = 0; i0 < tk; i0 += ATTENTION_KEY_TILE) {
+                const auto n = sd::math::nd4j_min<Nd4jLong>(ATTENTION_KEY_TILE, tk - i0);
+
+                for (Nd4jLong jj = 0; jj < numQueries; jj++) {
+                    tileScores<A>(pack.query(slice, j0 + jj), kT, bias, dk, tk, i0, n, scores);
+
+                    auto tileMax = maxes[jj];
+                    for (Nd4jLong i = 0; i < n; i++)
+                        tileMax = sd::math::nd4j_max<A>(tileMax, scores[i]);
+
+                    // rescale everything accumulated so far to the new max
+                    const auto correction = sd::math::nd4j_exp<A, A>(maxes[jj] - tileMax);
+                    maxes[jj] = tileMax;
+
+                    auto out = acc.data() + jj * dv;
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong d = 0; d < dv; d++)
+                        out[d] *= correction;
+
+                    auto sum = sums[jj] * correction;
+                    for (Nd4jLong i = 0; i < n; i++) {
+                        const auto p = sd::math::nd4j_exp<A, A>(scores[i] - tileMax);
+                        sum += p;
+
+                        const auto row = v + (i0 + i) * dv;
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong d = 0; d < dv; d++)
+                            out[d] += p * row[d];
+                    }
+                    sums[jj] = sum;
+                }
+            }
+
+            for (Nd4jLong jj = 0; jj < numQueries; jj++) {
+                const auto out = acc.data() + jj * dv;
+                const auto norm = static_cast<A>(1) / sums[jj];
+
+                for (Nd4jLong d = 0; d < dv; d++)
+                    z[zView.offset(slice, d, j0 + jj)] = static_cast<T>(out[d] * norm);
+            }
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, pack.numSlices * numQueryTiles);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void dotProductAttentionBp_(const NDArray& queries, const NDArray& keys, const NDArray& values, const NDArray& eps, const NDArray* mask, const bool scaled, NDArray& dLdq, NDArray& dLdk, NDArray& dLdv) {
+    typedef typename std::conditional<std::is_same<T, double>::value, double, float>::type A;
+
+    AttentionPack<A> pack;
+    packInputs<T, A>(queries, keys, values, &eps, mask, scaled, pack);
+
+    const auto numSlices = pack.numSlices, dk = pack.dk, dv = pack.dv, tq = pack.tq, tk = pack.tk;
+    const auto numQueryTiles = (tq + ATTENTION_QUERY_TILE - 1) / ATTENTION_QUERY_TILE;
+    const auto numKeyTiles = (tk + ATTENTION_KEY_TILE - 1) / ATTENTION_KEY_TILE;
+    const A factor = scaled ? static_cast<A>(1) / sd::math::nd4j_sqrt<A, A>(static_cast<A>(dk)) : static_cast<A>(1);
+
+    // per query softmax statistics: log-sum-exp of scores, and D = sum(P * dP), which equals eps * output
+    std::vector<A> lse(numSlices * tq), delta(numSlices * tq);
+
+    // pass 1: statistics, over tiles of queries
+    auto funcStats = PRAGMA_THREADS_FOR {
+        std::vector<A> maxes(ATTENTION_QUERY_TILE), sums(ATTENTION_QUERY_TILE), deltas(ATTENTION_QUERY_TILE);
+        A scores[ATTENTION_KEY_TILE], dP[ATTENTION_KEY_TILE];
+
+        for (auto task = start; task < stop; task++) {
+            const auto slice = task / numQueryTiles;
+            const auto j0 = (task % numQueryTiles) * ATTENTION_QUERY_TILE;
+            const auto numQueries = sd::math::nd4j_min<Nd4jLong>(ATTENTION_QUERY_TILE, tq - j0);
+
+            const auto kT = pack.kT.data() + slice * dk * tk;
+            const auto vT = pack.vT.data() + slice * dv * tk;
+            const auto bias = pack.maskBias(slice);
+
+            std::fill(maxes.begin(), maxes.end(), -DataTypeUtils::max<A>());
+            std::fill(sums.begin(), sums.end(), static_cast<A>(0));
+            std::fill(deltas.begin(), deltas.end(), static_cast<A>(0));
+
+            for (Nd4jLong i0 = 0; i0 < tk; i0 += ATTENTION_KEY_TILE) {
+                const auto n = sd::math::nd4j_min<Nd4jLong>(ATTENTION_KEY_TILE, tk - i0);
+
+                for (Nd4jLong jj = 0; jj < numQueries; jj++) {
+                    const auto j = j0 + jj;
+                    tileScores<A>(pack.query(slice, j), kT, bias, dk, tk, i0, n, scores);
+                    tileEpsDot<A>(pack.eps.data() + (slice * tq + j) * dv, vT, dv, tk, i0, n, dP);
+
+                    auto tileMax = maxes[jj];
+                    for (Nd4jLong i = 0; i < n; i++)
+                        tileMax = sd::math::nd4j_max<A>(tileMax, scores[i]);
+
+                    const auto correction = sd::math::nd4j_exp<A, A>(maxes[jj] - tileMax);
+                    maxes[jj] = tileMax;
+
+                    auto sum = sums[jj] * correction;
+                    auto delta = deltas[jj] * correction;
+                    for (Nd4jLong i = 0; i < n; i++) {
+                        const auto p = sd::math::nd4j_exp<A, A>(scores[i] - tileMax);
+                        sum += p;
+                        delta += p * dP[i];
+                    }
+
+                    sums[jj] = sum;
+                    deltas[jj] = delta;
+                }
+            }
+
+            for (Nd4jLong jj = 0; jj < numQueries; jj++) {
+                lse[slice * tq + j0 + jj] = maxes[jj] + sd::math::nd4j_log<A, A>(sums[jj]);
+                delta[slice * tq + j0 + jj] = deltas[jj] / sums[jj];
+            }
+        }
+    };
+
+    samediff::Threads::parallel_tad(funcStats, 0, numSlices * numQueryTiles);
+
+    // pass 2: dLdk and dLdv, over tiles of keys, each tile visits all queries
+    const AttentionView dkView(dLdk), dvView(dLdv);
+    auto dK = dLdk.bufferAsT<T>();
+    auto dV = dLdv.bufferAsT<T>();
+
+    auto funcKeys = PRAGMA_THREADS_FOR {
+        std::vector<A> accK(ATTENTION_KEY_TILE * dk), accV(ATTENTION_KEY_TILE * dv);
+        A scores[ATTENTION_KEY_TILE], dP[ATTENTION_KEY_TILE];
+
+        for (auto task = start; task < stop; task++) {
+            const auto slice = task / numKeyTiles;
+            const auto i0 = (task % numKeyTiles) * ATTENTION_KEY_TILE;
+            const auto n = sd::math::nd4j_min<Nd4jLong>(ATTENTION_KEY_TILE, tk - i0);
+
+            const auto kT = pack.kT.data() + slice * dk * tk;
+            const auto vT = pack.vT.data() + slice * dv * tk;
+            const auto bias = pack.maskBias(slice);
+
+            std::fill(accK.begin(), accK.end(), static_cast<A>(0));
+            std::fill(accV.begin(), accV.end(), static_cast<A>(0));
+
+            for (Nd4jLong j = 0; j < tq; j++) {
+                const auto query = pack.query(slice, j);
+                const auto e = pack.eps.data() + (slice * tq + j) * dv;
+                const auto l = lse[slice * tq + j];
+                const auto dl = delta[slice * tq + j];
+
+                tileScores<A>(query, kT, bias, dk, tk, i0, n, scores);
+                tileEpsDot<A>(e, vT, dv, tk, i0, n, dP);
+
+                for (Nd4jLong i = 0; i < n; i++) {
+                    const auto p = sd::math::nd4j_exp<A, A>(scores[i] - l);
+                    const auto ds = p * (dP[i] - dl);
+
+                    auto rowV = accV.data() + i * dv;
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong d = 0; d < dv; d++)
+                        rowV[d] += p * e[d];
+
+                    // queries are pre-scaled, so scale factor is already applied here
+                    auto rowK = accK.data() + i * dk;
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong d = 0; d < dk; d++)
+                        rowK[d] += ds * query[d];
+                }
+            }
+
+            for (Nd4jLong i = 0; i < n; i++) {
+                for (Nd4jLong d = 0; d < dk; d++)
+                    dK[dkView.offset(slice, d, i0 + i)] = static_cast<T>(accK[i * dk + d]);
+
+                for (Nd4jLong d = 0; d < dv; d++)
+                    dV[dvView.offset(slice, d, i0 + i)] = static_cast<T>(accV[i * dv + d]);
+            }
+        }
+    };
+
+    samediff::Threads::parallel_tad(funcKeys, 0, numSlices * numKeyTiles);
+
+    // pass 3: dLdq, over tiles of queries
+    const AttentionView dqView(dLdq);
+    auto dQ = dLdq.bufferAsT<T>();
+
+    auto funcQueries = PRAGMA_THREADS_FOR {
+        std::vector<A> accQ(ATTENTION_QUERY_TILE * dk);
+        A scores[ATTENTION_KEY_TILE], dP[ATTENTION_KEY_TILE];
+
+        for (auto task = start; task < stop; task++) {
+            const auto slice = task / numQueryTiles;
+            const auto j0 = (task % numQueryTiles) * ATTENTION_QUERY_TILE;
+            const auto numQueries = sd::math::nd4j_min<Nd4jLong>(ATTENTION_QUERY_TILE, tq - j0);
+
+            const auto kT = pack.kT.data() + slice * dk * tk;
+            const auto k = pack.k.data() + slice * tk * dk;
+            const auto vT = pack.vT.data() + slice * dv * tk;
+            const auto bias = pack.maskBias(slice);
+
+            std::fill(accQ.begin(), accQ.end(), static_cast<A>(0));
+
+            for (Nd4jLong i0 = 0; i0 < tk; i0 += ATTENTION_KEY_TILE) {
+                const auto n = sd::math::nd4j_min<Nd4jLong>(ATTENTION_KEY_TILE, tk - i0);
+
+                for (Nd4jLong jj = 0; jj < numQueries; jj++) {
+                    const auto j = j0 + jj;
+                    const auto l = lse[slice * tq + j];
+                    const auto dl = delta[slice * tq + j];
+
+                    tileScores<A>(pack.query(slice, j), kT, bias, dk, tk, i0, n, scores);
+                    tileEpsDot<A>(pack.eps.data() + (slice * tq + j) * dv, vT, dv, tk, i0, n, dP);
+
+                    auto out = accQ.data() + jj * dk;
+                    for (Nd4jLong i = 0; i < n; i++) {
+                        const auto ds = sd::math::nd4j_exp<A, A>(scores[i] - l) * (dP[i] - dl);
+                        const auto row = k + (i0 + i) * dk;
+
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong d = 0; d < dk; d++)
+                            out[d] += ds * row[d];
+                    }
+                }
+            }
+
+            for (Nd4jLong jj = 0; jj < numQueries; jj++)
+                for (Nd4jLong d = 0; d < dk; d++)
+                    dQ[dqView.offset(slice, d, j0 + jj)] = static_cast<T>(accQ[jj * dk + d] * factor);
+        }
+    };
+
+    samediff::Threads::parallel_tad(funcQueries, 0, numSlices * numQueryTiles);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void dotProductAttention(sd::LaunchContext * context, const NDArray& queries, const NDArray& keys, const NDArray& values, const NDArray* mask, const bool scaled, NDArray& output) {
+    BUILD_SINGLE_SELECTOR(output.dataType(), dotProductAttention_, (queries, keys, values, mask, scaled, output), FLOAT_TYPES);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void dotProductAttentionBp(sd::LaunchContext * context, const NDArray& queries, const NDArray& keys, const NDArray& values, const NDArray& eps, const NDArray* mask, const bool scaled, NDArray& dLdq, NDArray& dLdk, NDArray& dLdv) {
+    BUILD_SINGLE_SELECTOR(dLdq.dataType(), dotProductAttentionBp_, (queries, keys, values, eps, mask, scaled, dLdq, dLdk, dLdv), FLOAT_TYPES);
+}
+
+}
+}
+}
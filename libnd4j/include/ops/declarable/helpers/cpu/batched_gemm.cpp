@@ -24,6 +24,8 @@
 #include <types/float16.h>
 #include <ops/declarable/helpers/batched_gemm.h>
 #include <helpers/BlasHelper.h>
+#include <helpers/PackedGemm.h>
+#include <array/DataTypeUtils.h>
 #include <execution/Threads.h>
 
 
@@ -89,6 +91,29 @@ ND4J_LOCAL void bgemm_(const std::vector<NDArray*>& vA, const std::vector<NDArra
         RELEASE(tldB, arr->getContext()->getWorkspace());
         RELEASE(tldC, arr->getContext()->getWorkspace());
         RELEASE(tsize, arr->getContext()->getWorkspace());
+    } else if (PackedGemm::isSupported(DataTypeUtils::fromT<T>())) {
+        // column-major matrices, so strides follow from leading dimensions
+        const Nd4jLong aStrideM = transA == CblasNoTrans ? 1 : lda;
+        const Nd4jLong aStrideK = transA == CblasNoTrans ? lda : 1;
+        const Nd4jLong bStrideK = transB == CblasNoTrans ? 1 : ldb;
+        const Nd4jLong bStrideN = transB == CblasNoTrans ? ldb : 1;
+
+        const int maxThreads = Environment::getInstance().maxThreads();
+        const bool batchParallel = batchSize >= maxThreads;
+
+        auto func = PRAGMA_THREADS_FOR {
+            for (auto p = start; p < stop; p++) {
+                PackedGemm::gemm(DataTypeUtils::fromT<T>(), M, N, K, alphas->e<double>(p),
+                                 vA.at(p)->buffer(), aStrideM, aStrideK,
+                                 vB.at(p)->buffer(), bStrideK, bStrideN,
+                                 betas->e<double>(p), vC.at(p)->buffer(), 1, ldc, batchParallel ? 1 : maxThreads);
+            }
+        };
+
+        if (batchParallel)
+            samediff::Threads::parallel_tad(func, 0, batchSize);
+        else
+            func(0, 0, batchSize, 1);
     } else {
         CBLAS_TRANSPOSE tA = (CBLAS_TRANSPOSE) transA;
         CBLAS_TRANSPOSE tB = (CBLAS_TRANSPOSE) transB;
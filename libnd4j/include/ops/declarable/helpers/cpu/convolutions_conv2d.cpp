@@ -27,38 +27,429 @@
 #include <array/NDArrayFactory.h>
 #include <helpers/MmulHelper.h>
 #include <execution/Threads.h>
+#include <system/Environment.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <type_traits>
+#include <vector>
 
 namespace sd {
     namespace ops  {
 
+// output pixels along width and output channels computed together by direct kernel, accumulators of one task stay in L1
+static const int CONV2D_DIRECT_PIXELS = 8;
+static const int CONV2D_DIRECT_CHANNELS = 64;
+
+// per-thread budget for transformed Winograd tiles, and input channels of transformed weights reused across tiles of a block
+static const Nd4jLong CONV2D_WINOGRAD_BUDGET = 1024 * 1024;
+static const int CONV2D_WINOGRAD_CHANNELS = 64;
+
+// im2col buffers above this size are rather memory-bound, so heuristic switches to direct kernel
+static const Nd4jLong CONV2D_IM2COL_LIMIT = 64 * 1024 * 1024;
+
+struct Conv2dParams {
+    int bS, iC, iH, iW, oC, oH, oW, kH, kW, sH, sW, pH, pW, dH, dW;
+};
 
 //////////////////////////////////////////////////////////////////////////
-template <typename X, typename Y>
-static void conv2d_(sd::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode, const int isNCHW, const int wFormat) {
+// Winograd transforms: input tile is B^T d B, weights are G g G^T, output is A^T m A
+template <int M>
+struct WinogradMatrices;
 
-            // input   [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW)
-            // weights [kH, kW, iC, oC], [oC, iC, kH, kW], [oC, kH, kW, iC]
-            // bias    [oC]
-            // output  [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW] (NCHW)
+template <>
+struct WinogradMatrices<2> {
+    static const double BT[16];
+    static const double G[12];
+    static const double AT[8];
+};
 
-            // kH  filter(kernel) height
-            // kW  filter(kernel) width
-            // sH  strides height
-            // sW  strides width
-            // pH  paddings height
-            // pW  paddings width
-            // dH  dilations height
-            // dW  dilations width
-            // paddingMode 0-VALID, 1-SAME
-            // isNCHW      1-NCHW,  0-NHWC
+const double WinogradMatrices<2>::BT[16] = {1,  0, -1,  0,
+                                             0,  1,  1,  0,
+                                             0, -1,  1,  0,
+                                             0,  1,  0, -1};
 
-            int bS, iC, iH, iW, oC, oH, oW;                             // batch size, input channels, input height/width, output channels, output height/width;
-            int indIOioC, indIiH, indWoC, indWiC, indWkH, indOoH;       // corresponding indexes
-            ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, wFormat, *input, *output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWoC, indWkH, indOoH);
+const double WinogradMatrices<2>::G[12] = {1,    0,    0,
+                                            0.5,  0.5,  0.5,
+                                            0.5, -0.5,  0.5,
+                                            0,    0,    1};
 
-            ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW, paddingMode);
+const double WinogradMatrices<2>::AT[8] = {1, 1,  1,  0,
+                                            0, 1, -1, -1};
 
-            nd4j_debug("MKL-DNN is not used for conv2d!\n", 0);
+template <>
+struct WinogradMatrices<4> {
+    static const double BT[36];
+    static const double G[18];
+    static const double AT[24];
+};
+
+const double WinogradMatrices<4>::BT[36] = {4,  0, -5,  0, 1, 0,
+                                             0, -4, -4,  1, 1, 0,
+                                             0,  4, -4, -1, 1, 0,
+                                             0, -2, -1,  2, 1, 0,
+                                             0,  2, -1, -2, 1, 0,
+                                             0,  4,  0, -5, 0, 1};
+
+const double WinogradMatrices<4>::G[18] = { 1./4,     0,       0,
+                                            -1./6,   -1./6,   -1./6,
+                                            -1./6,    1./6,   -1./6,
+                                             1./24,   1./12,   1./6,
+                                             1./24,  -1./12,   1./6,
+                                             0,       0,       1};
+
+const double WinogradMatrices<4>::AT[24] = {1, 1,  1, 1,  1, 0,
+                                             0, 1, -1, 2, -2, 0,
+                                             0, 1,  1, 4,  4, 0,
+                                             0, 1, -1, 8, -8, 1};
+
+//////////////////////////////////////////////////////////////////////////
+// z[n] += a * x[n]
+template <typename A>
+static FORCEINLINE void axpy(const A a, const A* x, A* z, const int n) {
+    PRAGMA_OMP_SIMD
+    for (int e = 0; e < n; e++)
+        z[e] += a * x[e];
+}
+
+//////////////////////////////////////////////////////////////////////////
+// weights of any format to [kH, kW, iC, oC] in accumulation type
+template <typename T, typename A>
+static void packWeights(const NDArray& weights, const int wFormat, const Conv2dParams& p, A* z) {
+
+    const auto s = weights.stridesOf();
+    Nd4jLong sKh, sKw, sIc, sOc;
+    if(0 == wFormat) {          // [kH, kW, iC, oC]
+        sKh = s[0]; sKw = s[1]; sIc = s[2]; sOc = s[3];
+    }
+    else if(1 == wFormat) {     // [oC, iC, kH, kW]
+        sOc = s[0]; sIc = s[1]; sKh = s[2]; sKw = s[3];
+    }
+    else {                      // [oC, kH, kW, iC]
+        sOc = s[0]; sKh = s[1]; sKw = s[2]; sIc = s[3];
+    }
+
+    auto w = weights.bufferAsT<T>();
+
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto tap = start; tap < stop; tap++) {
+            const auto kh = tap / p.kW, kw = tap % p.kW;
+            for (int ic = 0; ic < p.iC; ic++)
+                for (int oc = 0; oc < p.oC; oc++)
+                    z[(tap * p.iC + ic) * p.oC + oc] = static_cast<A>(w[kh * sKh + kw * sKw + ic * sIc + oc * sOc]);
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, p.kH * p.kW);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// input of any layout to contiguous [bS, iH, iW, iC] in accumulation type
+template <typename T, typename A>
+static void packInput(const NDArray& input, const int isNCHW, const Conv2dParams& p, A* z) {
+
+    const auto s = input.stridesOf();
+    const Nd4jLong sB = s[0];
+    const Nd4jLong sC = isNCHW ? s[1] : s[3];
+    const Nd4jLong sH = isNCHW ? s[2] : s[1];
+    const Nd4jLong sW = isNCHW ? s[3] : s[2];
+
+    auto x = input.bufferAsT<T>();
+
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto row = start; row < stop; row++) {
+            const auto b = row / p.iH, ih = row % p.iH;
+            const T* xRow = x + b * sB + ih * sH;
+            A* zRow = z + row * p.iW * p.iC;
+
+            // follow source order, so reads stay sequential for both layouts
+            if (isNCHW) {
+                for (int ic = 0; ic < p.iC; ic++)
+                    for (int iw = 0; iw < p.iW; iw++)
+                        zRow[iw * p.iC + ic] = static_cast<A>(xRow[ic * sC + iw * sW]);
+            }
+            else {
+                for (int iw = 0; iw < p.iW; iw++)
+                    for (int ic = 0; ic < p.iC; ic++)
+                        zRow[iw * p.iC + ic] = static_cast<A>(xRow[iw * sW + ic * sC]);
+            }
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, p.bS * p.iH);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW] (NCHW) output, possibly strided
+struct Conv2dOutputView {
+    Nd4jLong sB, sC, sH, sW;
+
+    Conv2dOutputView(const NDArray& output, const int isNCHW) {
+        const auto s = output.stridesOf();
+        sB = s[0];
+        sC = isNCHW ? s[1] : s[3];
+        sH = isNCHW ? s[2] : s[1];
+        sW = isNCHW ? s[3] : s[2];
+    }
+
+    FORCEINLINE Nd4jLong offset(Nd4jLong b, Nd4jLong oh, Nd4jLong ow) const {
+        return b * sB + oh * sH + ow * sW;
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// implicit GEMM: every tap of the kernel multiplies iC-long rows of NHWC input by [iC, oC] slice of packed weights,
+// so nothing like [bS, oH, oW, kH, kW, iC] buffer is ever created
+template <typename T, typename A>
+static void conv2dDirect_(const Conv2dParams& p, const A* x, const A* w, const A* bias, NDArray& output, const int isNCHW) {
+
+    const int numPixelTiles = (p.oW + CONV2D_DIRECT_PIXELS - 1) / CONV2D_DIRECT_PIXELS;
+    const int numChannelBlocks = (p.oC + CONV2D_DIRECT_CHANNELS - 1) / CONV2D_DIRECT_CHANNELS;
+    const Conv2dOutputView zView(output, isNCHW);
+    auto z = output.bufferAsT<T>();
+
+    auto func = PRAGMA_THREADS_FOR {
+        A acc[CONV2D_DIRECT_PIXELS * CONV2D_DIRECT_CHANNELS];
+
+        for (auto task = start; task < stop; task++) {
+            // channel blocks are innermost, so consecutive tasks read the same input pixels
+            const int oc0 = (task % numChannelBlocks) * CONV2D_DIRECT_CHANNELS;
+            const int ow0 = ((task / numChannelBlocks) % numPixelTiles) * CONV2D_DIRECT_PIXELS;
+            const int oh = (task / ((Nd4jLong) numChannelBlocks * numPixelTiles)) % p.oH;
+            const Nd4jLong b = task / ((Nd4jLong) numChannelBlocks * numPixelTiles * p.oH);
+            const int nC = sd::math::nd4j_min<int>(CONV2D_DIRECT_CHANNELS, p.oC - oc0);
+            const int nP = sd::math::nd4j_min<int>(CONV2D_DIRECT_PIXELS, p.oW - ow0);
+
+            for (int e = 0; e < nP; e++)
+                for (int c = 0; c < nC; c++)
+                    acc[e * CONV2D_DIRECT_CHANNELS + c] = bias[oc0 + c];
+
+            for (int kh = 0; kh < p.kH; kh++) {
+                const int ih = oh * p.sH - p.pH + kh * p.dH;
+                if (ih < 0 || ih >= p.iH)
+                    continue;
+
+                const A* xRow = x + (b * p.iH + ih) * p.iW * p.iC;
+
+                for (int kw = 0; kw < p.kW; kw++) {
+                    // input column grows with pixel index, so pixels that don't hit padding form contiguous range
+                    const int shift = kw * p.dW - p.pW;
+                    int first = 0, last = nP;
+                    while (first < nP && (ow0 + first) * p.sW + shift < 0)
+                        first++;
+                    while (last > first && (ow0 + last - 1) * p.sW + shift >= p.iW)
+                        last--;
+
+                    const A* wTap = w + (Nd4jLong) (kh * p.kW + kw) * p.iC * p.oC + oc0;
+
+                    for (int ic = 0; ic < p.iC; ic++) {
+                        const A* wRow = wTap + (Nd4jLong) ic * p.oC;
+                        for (int e = first; e < last; e++)
+                            axpy<A>(xRow[(Nd4jLong) ((ow0 + e) * p.sW + shift) * p.iC + ic], wRow, acc + e * CONV2D_DIRECT_CHANNELS, nC);
+                    }
+                }
+            }
+
+            for (int e = 0; e < nP; e++) {
+                T* zPixel = z + zView.offset(b, oh, ow0 + e) + oc0 * zView.sC;
+                for (int c = 0; c < nC; c++)
+                    zPixel[c * zView.sC] = static_cast<T>(acc[e * CONV2D_DIRECT_CHANNELS + c]);
+            }
+        }
+    };
+
+    samediff::Threads::parallel_for(func, 0, (Nd4jLong) p.bS * p.oH * numPixelTiles * numChannelBlocks);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Winograd F(MxM, 3x3): each (M+2)x(M+2) input tile gives MxM outputs, so multiplications are cut by 9M^2/(M+2)^2 times.
+// Tiles are processed in per-thread blocks: input transform, (M+2)^2 small GEMMs against transformed weights, output transform,
+// so transformed data never leaves cache either
+template <typename T, typename A, int M>
+static void conv2dWinograd_(const Conv2dParams& p, const A* x, const A* w, const A* bias, NDArray& output, const int isNCHW) {
+
+    const int R = M + 2;
+    const int iC = p.iC, oC = p.oC;
+
+    A bt[R * R], g[R * 3], at[M * R];
+    for (int e = 0; e < R * R; e++)
+        bt[e] = static_cast<A>(WinogradMatrices<M>::BT[e]);
+    for (int e = 0; e < R * 3; e++)
+        g[e] = static_cast<A>(WinogradMatrices<M>::G[e]);
+    for (int e = 0; e < M * R; e++)
+        at[e] = static_cast<A>(WinogradMatrices<M>::AT[e]);
+
+    // transformed weights [R*R, iC, oC]
+    std::vector<A> u((Nd4jLong) R * R * iC * oC);
+
+    auto funcWeights = PRAGMA_THREADS_FOR {
+        std::vector<A> tmp(R * 3 * oC);
+
+        for (auto ic = start; ic < stop; ic++) {
+            // tmp[i][k] = sum_r G[i][r] * w[r][k]
+            std::fill(tmp.begin(), tmp.end(), static_cast<A>(0));
+            for (int i = 0; i < R; i++)
+                for (int r = 0; r < 3; r++)
+                    for (int k = 0; k < 3; k++)
+                        if (g[i * 3 + r] != static_cast<A>(0))
+                            axpy<A>(g[i * 3 + r], w + ((Nd4jLong) (r * 3 + k) * iC + ic) * oC, tmp.data() + (i * 3 + k) * oC, oC);
+
+            // u[i][j] = sum_k tmp[i][k] * G[j][k]
+            for (int i = 0; i < R; i++)
+                for (int j = 0; j < R; j++) {
+                    A* uRow = u.data() + ((Nd4jLong) (i * R + j) * iC + ic) * oC;
+                    std::fill(uRow, uRow + oC, static_cast<A>(0));
+                    for (int k = 0; k < 3; k++)
+                        if (g[j * 3 + k] != static_cast<A>(0))
+                            axpy<A>(g[j * 3 + k], tmp.data() + (i * 3 + k) * oC, uRow, oC);
+                }
+        }
+    };
+
+    samediff::Threads::parallel_tad(funcWeights, 0, iC);
+
+    const int tilesH = (p.oH + M - 1) / M;
+    const int tilesW = (p.oW + M - 1) / M;
+    const Nd4jLong numTiles = (Nd4jLong) p.bS * tilesH * tilesW;
+
+    // block size is limited by cache budget, and by number of threads, so that small layers still use all of them
+    const Nd4jLong numThreads = sd::Environment::getInstance().maxThreads();
+    Nd4jLong blockSize = CONV2D_WINOGRAD_BUDGET / ((Nd4jLong) R * R * (iC + oC) * sizeof(A));
+    blockSize = sd::math::nd4j_max<Nd4jLong>(1, sd::math::nd4j_min<Nd4jLong>(blockSize, (numTiles + numThreads - 1) / numThreads));
+    const Nd4jLong numBlocks = (numTiles + blockSize - 1) / blockSize;
+
+    const Conv2dOutputView zView(output, isNCHW);
+    auto z = output.bufferAsT<T>();
+
+    auto func = PRAGMA_THREADS_FOR {
+        std::vector<A> patch(R * R * iC), tmpIn(R * R * iC);
+        std::vector<A> v(R * R * blockSize * iC);       // [R*R, blockSize, iC]
+        std::vector<A> m(R * R * blockSize * oC);       // [R*R, blockSize, oC]
+        std::vector<A> tmpOut(M * R * oC), y(oC);
+
+        for (auto block = start; block < stop; block++) {
+            const Nd4jLong tile0 = block * blockSize;
+            const int nT = sd::math::nd4j_min<Nd4jLong>(blockSize, numTiles - tile0);
+
+            // input transform: v = B^T d B
+            for (int t = 0; t < nT; t++) {
+                const Nd4jLong tile = tile0 + t;
+                const Nd4jLong b = tile / (tilesH * tilesW);
+                const int ih0 = ((tile / tilesW) % tilesH) * M - p.pH;
+                const int iw0 = (tile % tilesW) * M - p.pW;
+
+                for (int r = 0; r < R; r++)
+                    for (int c = 0; c < R; c++) {
+                        A* dst = patch.data() + (r * R + c) * iC;
+                        const int ih = ih0 + r, iw = iw0 + c;
+                        if (ih < 0 || ih >= p.iH || iw < 0 || iw >= p.iW)
+                            std::fill(dst, dst + iC, static_cast<A>(0));
+                        else
+                            std::copy(x + ((b * p.iH + ih) * p.iW + iw) * iC, x + ((b * p.iH + ih) * p.iW + iw + 1) * iC, dst);
+                    }
+
+                std::fill(tmpIn.begin(), tmpIn.end(), static_cast<A>(0));
+                for (int i = 0; i < R; i++)
+                    for (int r = 0; r < R; r++)
+                        if (bt[i * R + r] != static_cast<A>(0))
+                            for (int c = 0; c < R; c++)
+                                axpy<A>(bt[i * R + r], patch.data() + (r * R + c) * iC, tmpIn.data() + (i * R + c) * iC, iC);
+
+                for (int i = 0; i < R; i++)
+                    for (int j = 0; j < R; j++) {
+                        A* vRow = v.data() + ((Nd4jLong) (i * R + j) * blockSize + t) * iC;
+                        std::fill(vRow, vRow + iC, static_cast<A>(0));
+                        for (int c = 0; c < R; c++)
+                            if (bt[j * R + c] != static_cast<A>(0))
+                                axpy<A>(bt[j * R + c], tmpIn.data() + (i * R + c) * iC, vRow, iC);
+                    }
+            }
+
+            // elementwise products of transforms, summed over input channels: m[xi] = v[xi] x u[xi]
+            std::fill(m.begin(), m.end(), static_cast<A>(0));
+            for (int xi = 0; xi < R * R; xi++)
+                for (int ic0 = 0; ic0 < iC; ic0 += CONV2D_WINOGRAD_CHANNELS) {
+                    const int icEnd = sd::math::nd4j_min<int>(iC, ic0 + CONV2D_WINOGRAD_CHANNELS);
+                    for (int t = 0; t < nT; t++) {
+                        const A* vRow = v.data() + ((Nd4jLong) xi * blockSize + t) * iC;
+                        A* mRow = m.data() + ((Nd4jLong) xi * blockSize + t) * oC;
+                        for (int ic = ic0; ic < icEnd; ic++)
+                            axpy<A>(vRow[ic], u.data() + ((Nd4jLong) xi * iC + ic) * oC, mRow, oC);
+                    }
+                }
+
+            // output transform: y = A^T m A
+            for (int t = 0; t < nT; t++) {
+                const Nd4jLong tile = tile0 + t;
+                const Nd4jLong b = tile / (tilesH * tilesW);
+                const int oh0 = ((tile / tilesW) % tilesH) * M;
+                const int ow0 = (tile % tilesW) * M;
+
+                std::fill(tmpOut.begin(), tmpOut.end(), static_cast<A>(0));
+                for (int i = 0; i < M; i++)
+                    for (int r = 0; r < R; r++)
+                        if (at[i * R + r] != static_cast<A>(0))
+                            for (int c = 0; c < R; c++)
+                                axpy<A>(at[i * R + r], m.data() + ((Nd4jLong) (r * R + c) * blockSize + t) * oC, tmpOut.data() + (i * R + c) * oC, oC);
+
+                for (int i = 0; i < M && oh0 + i < p.oH; i++)
+                    for (int j = 0; j < M && ow0 + j < p.oW; j++) {
+                        std::copy(bias, bias + oC, y.begin());
+                        for (int c = 0; c < R; c++)
+                            if (at[j * R + c] != static_cast<A>(0))
+                                axpy<A>(at[j * R + c], tmpOut.data() + (i * R + c) * oC, y.data(), oC);
+
+                        T* zPixel = z + zView.offset(b, oh0 + i, ow0 + j);
+                        for (int oc = 0; oc < oC; oc++)
+                            zPixel[oc * zView.sC] = static_cast<T>(y[oc]);
+                    }
+            }
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, numBlocks);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// direct and Winograd engines work with NHWC input, weights and bias packed into accumulation type
+template <typename T>
+static void conv2dNative_(const int algorithm, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const Conv2dParams& p, const int isNCHW, const int wFormat) {
+    typedef typename std::conditional<std::is_same<T, double>::value, double, float>::type A;
+
+    std::vector<A> w((Nd4jLong) p.kH * p.kW * p.iC * p.oC);
+    packWeights<T, A>(*weights, wFormat, p, w.data());
+
+    std::vector<A> b(p.oC, static_cast<A>(0));
+    if (bias)
+        for (int oc = 0; oc < p.oC; oc++)
+            b[oc] = bias->e<A>(oc);
+
+    // contiguous NHWC input of accumulation type is used as is
+    std::vector<A> packed;
+    const A* x;
+    if (std::is_same<T, A>::value && !isNCHW && input->ordering() == 'c' && input->ews() == 1) {
+        x = reinterpret_cast<const A*>(input->bufferAsT<T>());
+    }
+    else {
+        packed.resize((Nd4jLong) p.bS * p.iH * p.iW * p.iC);
+        packInput<T, A>(*input, isNCHW, p, packed.data());
+        x = packed.data();
+    }
+
+    if (algorithm == CONV2D_WINOGRAD_2X2)
+        conv2dWinograd_<T, A, 2>(p, x, w.data(), b.data(), *output, isNCHW);
+    else if (algorithm == CONV2D_WINOGRAD_4X4)
+        conv2dWinograd_<T, A, 4>(p, x, w.data(), b.data(), *output, isNCHW);
+    else
+        conv2dDirect_<T, A>(p, x, w.data(), b.data(), *output, isNCHW);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X, typename Y>
+static void conv2dIm2col_(sd::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const Conv2dParams& p, const int isNCHW, const int wFormat) {
+
+            const int bS = p.bS, iC = p.iC, oC = p.oC, oH = p.oH, oW = p.oW, kH = p.kH, kW = p.kW;
 
             std::vector<int> permutForOutput;
 
@@ -81,7 +472,7 @@ static void conv2d_(sd::graph::Context& block, const NDArray* input, const NDArr
 
             //----- calculation of output -----//
             auto ctx = block.launchContext();
-            helpers::im2col(*ctx, *input, colP, kH, kW, sH, sW, pH, pW, dH, dW, NDArrayFactory::create(0.f, input->getContext()));  // [bS, iC, iH, iW] is convoluted to [bS, iC, kH, kW, oH, oW]
+            helpers::im2col(*ctx, *input, colP, kH, kW, p.sH, p.sW, p.pH, p.pW, p.dH, p.dW, NDArrayFactory::create(0.f, input->getContext()));  // [bS, iC, iH, iW] is convoluted to [bS, iC, kH, kW, oH, oW]
             MmulHelper::tensorDot(&col, weights, &mmulResult, {3,4,5}, wAxes, {}); // [bS, oH, oW, kH, kW, iC] x [kH, kW, iC, oC] = [bS, oH, oW, oC]
 
             //----- assign outTemp to output  -----//
@@ -98,7 +489,118 @@ static void conv2d_(sd::graph::Context& block, const NDArray* input, const NDArr
 
             if(!isNCHW)
                 delete input;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static bool isWinogradApplicable(const Conv2dParams& p) {
+    return p.kH == 3 && p.kW == 3 && p.sH == 1 && p.sW == 1 && p.dH == 1 && p.dW == 1;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static int conv2dHeuristic(const Conv2dParams& p, const sd::DataType dataType) {
+
+    // Winograd isn't considered here: its transforms amplify rounding errors, so it's used only if requested explicitly
+
+    // there's no BLAS for half types anyway
+    if (dataType == sd::DataType::HALF || dataType == sd::DataType::BFLOAT16)
+        return CONV2D_DIRECT;
+
+    const Nd4jLong colBytes = (Nd4jLong) p.bS * p.oH * p.oW * p.kH * p.kW * p.iC * DataTypeUtils::sizeOfElement(dataType);
+    return colBytes > CONV2D_IM2COL_LIMIT ? CONV2D_DIRECT : CONV2D_IM2COL;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X, typename Y>
+static void conv2dRun_(const int algorithm, sd::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const Conv2dParams& p, const int isNCHW, const int wFormat) {
+    if (algorithm == CONV2D_IM2COL)
+        conv2dIm2col_<X, Y>(block, input, weights, bias, output, p, isNCHW, wFormat);
+    else
+        conv2dNative_<X>(algorithm, input, weights, bias, output, p, isNCHW, wFormat);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// autotune results, keyed by data type, layer geometry and layouts
+static std::mutex conv2dTuningMutex;
+static std::map<std::vector<int>, int> conv2dTuning;
+
+template <typename X, typename Y>
+static int conv2dAutotune_(sd::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const Conv2dParams& p, const int isNCHW, const int wFormat) {
+
+    const std::vector<int> key = {(int) input->dataType(), p.bS, p.iC, p.iH, p.iW, p.oC, p.kH, p.kW, p.sH, p.sW, p.pH, p.pW, p.dH, p.dW, isNCHW, wFormat};
+    {
+        std::lock_guard<std::mutex> lock(conv2dTuningMutex);
+        auto it = conv2dTuning.find(key);
+        if (it != conv2dTuning.end())
+            return it->second;
+    }
+
+    // Winograd isn't timed: its transforms change results far more than summation order does, so it has to be requested explicitly
+    std::vector<int> candidates = {CONV2D_IM2COL, CONV2D_DIRECT};
+
+    // every candidate computes full output, so the output of the last one is the result of this call
+    int best = candidates[0];
+    Nd4jLong bestTime = DataTypeUtils::max<Nd4jLong>();
+    for (auto algorithm : candidates) {
+        auto timeStart = std::chrono::system_clock::now();
+        conv2dRun_<X, Y>(algorithm, block, input, weights, bias, output, p, isNCHW, wFormat);
+        auto timeEnd = std::chrono::system_clock::now();
+
+        auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count();
+        if (time < bestTime) {
+            bestTime = time;
+            best = algorithm;
+        }
+    }
+
+    nd4j_debug("conv2d autotune: algorithm %i was chosen\n", best);
+
+    std::lock_guard<std::mutex> lock(conv2dTuningMutex);
+    conv2dTuning[key] = best;
+    return -1;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X, typename Y>
+static void conv2d_(sd::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode, const int isNCHW, const int wFormat) {
+
+            // input   [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW)
+            // weights [kH, kW, iC, oC], [oC, iC, kH, kW], [oC, kH, kW, iC]
+            // bias    [oC]
+            // output  [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW] (NCHW)
+
+            // kH  filter(kernel) height
+            // kW  filter(kernel) width
+            // sH  strides height
+            // sW  strides width
+            // pH  paddings height
+            // pW  paddings width
+            // dH  dilations height
+            // dW  dilations width
+            // paddingMode 0-VALID, 1-SAME
+            // isNCHW      1-NCHW,  0-NHWC
+
+            int bS, iC, iH, iW, oC, oH, oW;                             // batch size, input channels, input height/width, output channels, output height/width;
+            int indIOioC, indIiH, indWoC, indWiC, indWkH, indOoH;       // corresponding indexes
+            ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, wFormat, *input, *output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWoC, indWkH, indOoH);
+
+            ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW, paddingMode);
+
+            nd4j_debug("MKL-DNN is not used for conv2d!\n", 0);
+
+            const Conv2dParams p = {bS, iC, iH, iW, oC, oH, oW, kH, kW, sH, sW, pH, pW, dH, dW};
+
+            int algorithm = sd::Environment::getInstance().conv2dAlgorithm();
+
+            if (algorithm == CONV2D_AUTOTUNE) {
+                algorithm = conv2dAutotune_<X, Y>(block, input, weights, bias, output, p, isNCHW, wFormat);
+                // output is computed already if layer was just tuned
+                if (algorithm < 0)
+                    return;
+            }
+            else if (algorithm < CONV2D_IM2COL || algorithm > CONV2D_WINOGRAD_4X4 || ((algorithm == CONV2D_WINOGRAD_2X2 || algorithm == CONV2D_WINOGRAD_4X4) && !isWinogradApplicable(p)))
+                algorithm = conv2dHeuristic(p, input->dataType());
 
+            conv2dRun_<X, Y>(algorithm, block, input, weights, bias, output, p, isNCHW, wFormat);
         }
 
 ND4J_LOCAL void ConvolutionUtils::conv2d(sd::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode, const int isNCHW, const int wFormat) {
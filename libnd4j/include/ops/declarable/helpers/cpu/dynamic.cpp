@@ -20,167 +20,270 @@
 // Created by george on 05.04.18.
 //
 #include <ops/declarable/helpers/dynamic.h>
+#include <helpers/ConstantTadHelper.h>
 #include <execution/Threads.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
 
 namespace sd {
     namespace ops {
         namespace helpers {
 
-            template <typename T>
-            static void _dynamicPartitionFunctor(NDArray const* input, NDArray const* indices, std::vector<NDArray*>& outputList) {
-                std::vector<std::pair<NDArray *, int>> outputs(outputList.size());
-                int sourceDimsLen = input->rankOf() - indices->rankOf();
-                if (sourceDimsLen) {
-                    std::vector<int> sourceDims(sourceDimsLen);
+            // minimal number of elements (rows x row length) copied by one chunk, so small arrays are partitioned by single thread
+            static const Nd4jLong DYNAMIC_MIN_CHUNK = 16384;
+
+            namespace {
+                /**
+                 * Rows of array along its leading dimensions: either contiguous slices of buffer, or TADs
+                 */
+                template <typename T>
+                class Rows {
+                private:
+                    T *_buffer = nullptr;
+                    const Nd4jLong *_shapeInfo = nullptr;
+                    // pack is held here, so TAD pointers stay valid even if pack gets evicted from TAD cache
+                    TadPack _pack;
+                    const Nd4jLong *_tadShapeInfo = nullptr;
+                    const Nd4jLong *_tadOffsets = nullptr;
+                    Nd4jLong _numRows = 0;
+                    Nd4jLong _rowLength = 0;
+                    bool _linear = true;
+
+                public:
+                    Rows() = default;
+
+                    Rows(const NDArray *array, int leadingDims) {
+                        _buffer = const_cast<T*>(array->bufferAsT<T>());
+                        _shapeInfo = array->shapeInfo();
+
+                        _numRows = 1;
+                        for (int e = 0; e < leadingDims; e++)
+                            _numRows *= array->sizeAt(e);
+
+                        _rowLength = _numRows > 0 ? array->lengthOf() / _numRows : 0;
+                        _linear = array->ordering() == 'c' && array->ews() == 1;
+
+                        if (!_linear && _rowLength > 1) {
+                            std::vector<int> dims(array->rankOf() - leadingDims);
+                            for (int e = 0; e < (int) dims.size(); e++)
+                                dims[e] = leadingDims + e;
+
+                            _pack = ConstantTadHelper::getInstance().tadForDimensions(_shapeInfo, dims);
+                            _tadShapeInfo = _pack.primaryShapeInfo();
+                            _tadOffsets = _pack.primaryOffsets();
+                        }
+                    }
 
-                    for (int i = sourceDimsLen; i > 0; i--)
-                        sourceDims[sourceDimsLen - i] = input->rankOf() - i;
+                    FORCEINLINE Nd4jLong numRows() const { return _numRows; }
+                    FORCEINLINE Nd4jLong rowLength() const { return _rowLength; }
 
-                    ResultSet listOfTensors = input->allTensorsAlongDimension(sourceDims);
+                    FORCEINLINE T* row(Nd4jLong r) const {
+                        if (_linear)
+                            return _buffer + r * _rowLength;
 
-                    unsigned int outSize = outputList.size();
+                        return _buffer + (_rowLength == 1 ? shape::getIndexOffset(r, _shapeInfo) : _tadOffsets[r]);
+                    }
 
-                    //PRAGMA_OMP_PARALLEL_FOR_IF(outSize > Environment::getInstance().tadThreshold())
-                    for (unsigned int i = 0; i < outSize; i++) {
-                        outputs[i].first = outputList[i];
-                        std::vector<int> outDims(outputs[i].first->rankOf() - 1);
+                    FORCEINLINE Nd4jLong elementOffset(Nd4jLong e) const {
+                        return _linear || _rowLength == 1 ? e : shape::getIndexOffset(e, _tadShapeInfo);
+                    }
 
-                        int r = outputs[i].first->rankOf();
+                    // copies row of source into row r, both rows have the same length
+                    FORCEINLINE void copyRow(Nd4jLong r, const Rows<T> &source, Nd4jLong s) const {
+                        auto z = row(r);
+                        auto x = source.row(s);
+
+                        if (_rowLength == 1) {
+                            z[0] = x[0];
+                        } else if (_linear && source._linear) {
+                            std::copy(x, x + _rowLength, z);
+                        } else {
+                            for (Nd4jLong e = 0; e < _rowLength; e++)
+                                z[elementOffset(e)] = x[source.elementOffset(e)];
+                        }
+                    }
+                };
+            }
+
+            static void readIndices(NDArray const* indices, std::vector<Nd4jLong> &values) {
+                const Nd4jLong length = indices->lengthOf();
+                values.resize(length);
+
+                const bool linear = indices->ordering() == 'c' && indices->ews() == 1;
+                const auto dataType = indices->dataType();
+
+                auto func = PRAGMA_THREADS_FOR {
+                    if (linear && dataType == sd::DataType::INT64) {
+                        auto x = indices->bufferAsT<Nd4jLong>();
+                        for (auto e = start; e < stop; e++)
+                            values[e] = x[e];
+                    } else if (linear && dataType == sd::DataType::INT32) {
+                        auto x = indices->bufferAsT<int>();
+                        for (auto e = start; e < stop; e++)
+                            values[e] = x[e];
+                    } else {
+                        for (auto e = start; e < stop; e++)
+                            values[e] = indices->e<Nd4jLong>(e);
+                    }
+                };
 
-                        for (int k = 1; k < r; k++)
-                            outDims[k - 1] = k;
+                samediff::Threads::parallel_for(func, 0, length);
+            }
 
-                        ResultSet listOutForCurrent = outputs[i].first->allTensorsAlongDimension(outDims);
+            static Nd4jLong numberOfChunks(Nd4jLong numRows, Nd4jLong rowLength) {
+                const Nd4jLong threads = Environment::getInstance().maxMasterThreads();
+                const Nd4jLong work = numRows * sd::math::nd4j_max<Nd4jLong>(1, rowLength);
 
-                        outputs[i].second = 0;
+                return sd::math::nd4j_max<Nd4jLong>(1, sd::math::nd4j_min<Nd4jLong>(sd::math::nd4j_min<Nd4jLong>(threads, numRows), work / DYNAMIC_MIN_CHUNK));
+            }
 
-                        //PRAGMA_OMP_PARALLEL_FOR_IF(indices->lengthOf() > Environment::getInstance().elementwiseThreshold())
-                        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-                            if ((*indices).e<Nd4jLong>(e) == i)
-                                listOutForCurrent.at(outputs[i].second++)->assign(listOfTensors.at(e));
+            /**
+             * Counting sort of rows by partition: every chunk of indices counts its rows per partition, counts are scanned into
+             * write positions, and then every chunk copies its rows. Rows keep their relative order within each partition.
+             * If backward is true, rows are copied from partitions back into input instead
+             */
+            template <typename T>
+            static void partitionRows(NDArray const* input, NDArray const* indices, std::vector<NDArray*> const& partitions, bool backward) {
+                std::vector<Nd4jLong> idx;
+                readIndices(indices, idx);
+
+                const Nd4jLong numRows = idx.size();
+                const Nd4jLong numPartitions = partitions.size();
+                if (numRows == 0 || numPartitions == 0)
+                    return;
+
+                Rows<T> inputRows(input, indices->rankOf());
+                const Nd4jLong numChunks = numberOfChunks(numRows, inputRows.rowLength());
+                const Nd4jLong chunk = (numRows + numChunks - 1) / numChunks;
+
+                // histogram: positions[c * numPartitions + p] is number of rows of chunk c which belong to partition p
+                std::vector<Nd4jLong> positions(numChunks * numPartitions, 0);
+
+                auto countChunks = PRAGMA_THREADS_FOR {
+                    for (auto c = start; c < stop; c++) {
+                        auto counts = positions.data() + c * numPartitions;
+                        const auto last = sd::math::nd4j_min<Nd4jLong>((c + 1) * chunk, numRows);
+                        for (auto e = c * chunk; e < last; e++)
+                            if (idx[e] >= 0 && idx[e] < numPartitions)
+                                counts[idx[e]]++;
+                    }
+                };
+
+                samediff::Threads::parallel_for(countChunks, 0, numChunks, 1, numChunks);
+
+                // exclusive scan over chunks turns counts into first position of every chunk within partition
+                std::vector<Rows<T>> partitionRows(numPartitions);
+                for (Nd4jLong p = 0; p < numPartitions; p++) {
+                    Nd4jLong total = 0;
+                    for (Nd4jLong c = 0; c < numChunks; c++) {
+                        const auto cnt = positions[c * numPartitions + p];
+                        positions[c * numPartitions + p] = total;
+                        total += cnt;
                     }
 
-                } else {
-                    unsigned int outSize = outputList.size();
+                    // empty partitions are never touched, their arrays might be empty or scalar
+                    if (total > 0)
+                        partitionRows[p] = Rows<T>(partitions[p], 1);
+                }
 
-                    auto func = PRAGMA_THREADS_FOR {
-                        for (auto i = start; i < stop; i++) {
-                            outputs[i].first = outputList[i];
-                            outputs[i].second = 0;
-                            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-                                if (indices->e<Nd4jLong>(e) == i)
-                                    outputs[i].first->p(outputs[i].second++, input->e<T>(e));
+                auto copyChunks = PRAGMA_THREADS_FOR {
+                    for (auto c = start; c < stop; c++) {
+                        auto offsets = positions.data() + c * numPartitions;
+                        const auto last = sd::math::nd4j_min<Nd4jLong>((c + 1) * chunk, numRows);
+                        for (auto e = c * chunk; e < last; e++) {
+                            const auto p = idx[e];
+                            if (p < 0 || p >= numPartitions)
+                                continue;
+
+                            if (backward)
+                                inputRows.copyRow(e, partitionRows[p], offsets[p]++);
+                            else
+                                partitionRows[p].copyRow(offsets[p]++, inputRows, e);
                         }
-                    };
+                    }
+                };
 
-                    samediff::Threads::parallel_tad(func, 0, outSize);
-                }
+                samediff::Threads::parallel_for(copyChunks, 0, numChunks, 1, numChunks);
+            }
+
+            template <typename T>
+            static void _dynamicPartitionFunctor(NDArray const* input, NDArray const* indices, std::vector<NDArray*>& outputList) {
+                partitionRows<T>(input, indices, outputList, false);
             }
+
             template <typename T>
             static int _dynamicStitchFunctor(std::vector<NDArray*> const& inputs, std::vector<NDArray*> const& indices, NDArray* output){
+                if (output->isEmpty())
+                    return ND4J_STATUS_OK;
 
                 int numOfData = inputs.size();
 
-                if (output->isVector()) {
-                    for (int e = 0; e < numOfData; e++) {
-                        auto data = inputs[e];
-                        auto index = indices[e];
-                        for (Nd4jLong i = 0; i < index->lengthOf(); i++) {
-                            Nd4jLong pos = index->e<Nd4jLong>(i);
-                            if (pos < 0) {
-                                nd4j_printf("dynamic_stitch: Index value should be non-negative. But %i was given", pos);
-                                return ND4J_STATUS_VALIDATION;
-                            }
-                            if (pos >= output->lengthOf()) {
-                                nd4j_printf("dynamic_stitch: Index should be less than %i. But %i was given",
-                                            output->lengthOf(), pos);
-                                return ND4J_STATUS_VALIDATION;
-                            }
-                            output->p<T>(pos, data->e<T>(i));
-                        }
-                    }
+                // all indices as single list, with first flat position of every input
+                std::vector<Nd4jLong> idx;
+                std::vector<Nd4jLong> firsts(numOfData + 1, 0);
+                for (int e = 0; e < numOfData; e++) {
+                    std::vector<Nd4jLong> values;
+                    readIndices(indices[e], values);
+                    idx.insert(idx.end(), values.begin(), values.end());
+                    firsts[e + 1] = idx.size();
                 }
-                else {
-                    std::vector<int> restDims(output->rankOf() - 1);
-                    for (auto i = restDims.size(); i > 0;  i--)
-                        restDims[restDims.size() - i] = output->rankOf() - i;
-
-                    ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-                    for (int e = 0; e < numOfData; e++) {
-                        auto data = inputs[e];
-                        auto index = indices[e];
-                        std::vector<int> sourceDims(data->rankOf() - index->rankOf());
-                        for (auto i = sourceDims.size(); i > 0;  i--)
-                            sourceDims[sourceDims.size() - i] = data->rankOf() - i;
-
-                        ResultSet listOfTensors = data->allTensorsAlongDimension(sourceDims)    ;
-
-                        for (Nd4jLong i = 0; i < index->lengthOf(); i++) {
-                            auto pos = index->e<Nd4jLong>(i);
-                            if (pos < 0) {
-                                nd4j_printf("dynamic_stitch: Index value should be non-negative. But %i was given", pos);
-                                return ND4J_STATUS_VALIDATION;
-                            }
-                            if (pos >= output->lengthOf()) {
-                                nd4j_printf("dynamic_stitch: Index should be less than %i. But %i was given",
-                                         output->lengthOf(), pos);
-                                return ND4J_STATUS_VALIDATION;
-                            }
-
-                            listOfOutTensors.at(pos)->assign(listOfTensors.at(i));
-                        }
+
+                Rows<T> outputRows(output, 1);
+                const Nd4jLong numOutRows = outputRows.numRows();
+                const Nd4jLong length = idx.size();
+
+                for (Nd4jLong i = 0; i < length; i++) {
+                    if (idx[i] < 0) {
+                        nd4j_printf("dynamic_stitch: Index value should be non-negative. But %i was given", idx[i]);
+                        return ND4J_STATUS_VALIDATION;
+                    }
+                    if (idx[i] >= numOutRows) {
+                        nd4j_printf("dynamic_stitch: Index should be less than %i. But %i was given", numOutRows, idx[i]);
+                        return ND4J_STATUS_VALIDATION;
                     }
                 }
-                return ND4J_STATUS_OK;
-            }
-
-            template <typename T>
-            static void _dynamicPartitionFunctorBP(NDArray const* input, NDArray const* indices, std::vector<NDArray*> const& inputGradientList, std::vector<NDArray*>& outputList) {
-                std::vector<std::pair<NDArray *, int>> outputs(inputGradientList.size());
 
-                int sourceDimsLen = input->rankOf() - indices->rankOf();
-                if (sourceDimsLen) { // multidimensional case
-                    std::vector<int> sourceDims(sourceDimsLen);
+                // duplicate indices resolve to the last one, so every output row takes its source from the last position referring to it
+                std::unique_ptr<std::atomic<Nd4jLong>[]> owners(new std::atomic<Nd4jLong>[numOutRows]);
+                for (Nd4jLong r = 0; r < numOutRows; r++)
+                    owners[r].store(-1, std::memory_order_relaxed);
 
-                    for (int i = sourceDimsLen; i > 0; i--)
-                        sourceDims[sourceDimsLen - i] = input->rankOf() - i;
+                auto findOwners = PRAGMA_THREADS_FOR {
+                    for (auto i = start; i < stop; i++) {
+                        auto &owner = owners[idx[i]];
+                        auto current = owner.load(std::memory_order_relaxed);
+                        while (current < i && !owner.compare_exchange_weak(current, i, std::memory_order_relaxed));
+                    }
+                };
 
-                    ResultSet listOfTensors = outputList[0]->allTensorsAlongDimension(sourceDims);
+                samediff::Threads::parallel_for(findOwners, 0, length);
 
-                    for (auto i = 0; i < inputGradientList.size(); i++) {
-                        outputs[i].first = inputGradientList[i];
-                        if (outputs[i].first->rankOf() < 1) continue; // skip empty gradient outs
-                        std::vector<int> outDims(outputs[i].first->rankOf() - 1);
+                std::vector<Rows<T>> inputRows(numOfData);
+                for (int e = 0; e < numOfData; e++)
+                    if (firsts[e + 1] > firsts[e])
+                        inputRows[e] = Rows<T>(inputs[e], indices[e]->rankOf());
 
-                        for (int k = 1; k < outputs[i].first->rankOf(); k++)
-                            outDims[k - 1] = k;
+                // inverse of partition: every output row is written exactly once, so rows are copied without any ordering between threads
+                auto copyRows = PRAGMA_THREADS_FOR {
+                    for (auto r = start; r < stop; r++) {
+                        const auto owner = owners[r].load(std::memory_order_relaxed);
+                        if (owner < 0)
+                            continue;
 
-                        ResultSet listOutForCurrent = outputs[i].first->allTensorsAlongDimension(outDims);
+                        const auto e = std::upper_bound(firsts.begin(), firsts.end(), owner) - firsts.begin() - 1;
+                        outputRows.copyRow(r, inputRows[e], owner - firsts[e]);
+                    }
+                };
 
-                        outputs[i].second = 0;
+                samediff::Threads::parallel_for(copyRows, 0, numOutRows);
 
-                        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-                            if (indices->e<Nd4jLong>(e) == i)
-                                listOfTensors.at(e)->assign(listOutForCurrent.at(outputs[i].second++));
-                    }
-                }
-                else { // one-dimensional case
-                    auto output = outputList[0];
-                    unsigned int gradsSize = inputGradientList.size();
-
-                    auto func = PRAGMA_THREADS_FOR {
-                        for (auto i = start; i < stop; i++) {
-                            outputs[i].first = inputGradientList[i];
-                            outputs[i].second = 0;
-                            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-                                if (indices->e<Nd4jLong>(e) == i)
-                                    output->p<T>(e, outputs[i].first->e<T>(outputs[i].second++));
-                        }
-                    };
+                return ND4J_STATUS_OK;
+            }
 
-                    samediff::Threads::parallel_tad(func, 0, gradsSize);
-                }
+            template <typename T>
+            static void _dynamicPartitionFunctorBP(NDArray const* input, NDArray const* indices, std::vector<NDArray*> const& inputGradientList, std::vector<NDArray*>& outputList) {
+                partitionRows<T>(outputList[0], indices, inputGradientList, true);
 
                 outputList[1]->assign(indices);
             }
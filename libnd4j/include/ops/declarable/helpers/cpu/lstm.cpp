@@ -38,6 +38,8 @@
 #include <array/NDArrayList.h>
 #include <iterator>
 #include <helpers/MmulHelper.h>
+#include <helpers/FusedLoops.h>
+#include <ops/ops.h>
 #include <execution/Threads.h>
 
 namespace sd 	  {
@@ -45,6 +47,76 @@ namespace ops 	  {
 namespace helpers {
 
 
+//////////////////////////////////////////////////////////////////////////
+// gates, cell state and cell output (prior to projection) of lstmCell, every formula is a single fused pass,
+// so peephole terms, forget bias and activations never materialize as temporary arrays
+template <typename T>
+static void lstmCellGates_(NDArray& zit, NDArray& zft, const NDArray& zct, NDArray& zot, const NDArray* ct_1, const NDArray* Wc,
+                           const bool peephole, const double forgetBias, const double clippingCellValue, NDArray* ct, NDArray* h) {
+
+    typedef simdOps::Add<T, T, T> Add;
+    typedef simdOps::Multiply<T, T, T> Multiply;
+    typedef simdOps::Sigmoid<T> Sigmoid;
+    typedef simdOps::Tanh<T> Tanh;
+
+    const int nOut = ct_1->sizeAt(1);
+
+    if(peephole) {
+        auto Wci = (*Wc)({0,      nOut});
+        auto Wcf = (*Wc)({nOut, 2*nOut});
+
+        // it = sigmoid(zit + ct_1*Wci), inplace
+        FusedLoops<T>::exec(ct_1->bufferAsT<T>(), ct_1->shapeInfo(), zit.bufferAsT<T>(), zit.shapeInfo(),
+                            fused::Broadcast<T, Multiply>(Wci.bufferAsT<T>(), Wci.shapeInfo(), zit.shapeInfo(), 1),
+                            fused::Pairwise<T, Add>(zit.bufferAsT<T>(), zit.shapeInfo()),
+                            fused::Transform<T, Sigmoid>());
+
+        // ct = sigmoid(zft + ct_1*Wcf + forgetBias) * ct_1
+        FusedLoops<T>::exec(ct_1->bufferAsT<T>(), ct_1->shapeInfo(), ct->bufferAsT<T>(), ct->shapeInfo(),
+                            fused::Broadcast<T, Multiply>(Wcf.bufferAsT<T>(), Wcf.shapeInfo(), ct->shapeInfo(), 1),
+                            fused::Pairwise<T, Add>(zft.bufferAsT<T>(), zft.shapeInfo()),
+                            fused::Scalar<T, Add>(static_cast<T>(forgetBias)),
+                            fused::Transform<T, Sigmoid>(),
+                            fused::Pairwise<T, Multiply>(ct_1->bufferAsT<T>(), ct_1->shapeInfo()));
+    }
+    else {
+        zit.applyTransform(transform::Sigmoid, zit);
+
+        // ct = sigmoid(zft + forgetBias) * ct_1
+        FusedLoops<T>::exec(zft.bufferAsT<T>(), zft.shapeInfo(), ct->bufferAsT<T>(), ct->shapeInfo(),
+                            fused::Scalar<T, Add>(static_cast<T>(forgetBias)),
+                            fused::Transform<T, Sigmoid>(),
+                            fused::Pairwise<T, Multiply>(ct_1->bufferAsT<T>(), ct_1->shapeInfo()));
+    }
+
+    // ct = tanh(zct) * it + ct
+    FusedLoops<T>::exec(zct.bufferAsT<T>(), zct.shapeInfo(), ct->bufferAsT<T>(), ct->shapeInfo(),
+                        fused::Transform<T, Tanh>(),
+                        fused::Pairwise<T, Multiply>(zit.bufferAsT<T>(), zit.shapeInfo()),
+                        fused::Pairwise<T, Add>(ct->bufferAsT<T>(), ct->shapeInfo()));
+
+    // if clipping value is provided then cell state is clipped by this value prior to the cell output activation
+    if(clippingCellValue > 0.0)
+        ct->applyScalar(scalar::LstmClip, clippingCellValue, *ct);
+
+    if(peephole) {
+        auto Wco = (*Wc)({2*nOut, 3*nOut});
+
+        // ot = sigmoid(zot + ct*Wco), inplace
+        FusedLoops<T>::exec(ct->bufferAsT<T>(), ct->shapeInfo(), zot.bufferAsT<T>(), zot.shapeInfo(),
+                            fused::Broadcast<T, Multiply>(Wco.bufferAsT<T>(), Wco.shapeInfo(), zot.shapeInfo(), 1),
+                            fused::Pairwise<T, Add>(zot.bufferAsT<T>(), zot.shapeInfo()),
+                            fused::Transform<T, Sigmoid>());
+    }
+    else
+        zot.applyTransform(transform::Sigmoid, zot);
+
+    // current cell output = ot*tanh(ct)
+    FusedLoops<T>::exec(ct->bufferAsT<T>(), ct->shapeInfo(), h->bufferAsT<T>(), h->shapeInfo(),
+                        fused::Transform<T, Tanh>(),
+                        fused::Pairwise<T, Multiply>(zot.bufferAsT<T>(), zot.shapeInfo()));
+}
+
 //////////////////////////////////////////////////////////////////////////
 ND4J_LOCAL void lstmCell(sd::LaunchContext * context, const NDArray* xt, const NDArray* ht_1, const NDArray* ct_1, const NDArray* Wx, const NDArray* Wh, const NDArray* Wc, const NDArray* Wp, const NDArray* b,
               NDArray* ht, NDArray* ct, const std::vector<double>& params) {
@@ -80,23 +152,12 @@ ND4J_LOCAL void lstmCell(sd::LaunchContext * context, const NDArray* xt, const N
     auto zct = z({0,0,  2*nOut,3*nOut});    // z for cell state,  = mmul(Wxc,xt) + mmul(Whc,ht_1) + bc    = [bS x nOut]
     auto zot = z({0,0,  3*nOut,4*nOut});    // z for output gate, = mmul(Wxo,xt) + mmul(Who,ht_1) + bo    = [bS x nOut]
 
-    if(peephole) {                                  // add peephole connections: z  +  ct_1*Wc
-        zit += (*ct_1) * (*Wc)({0,    nOut});       // add peephole connections to input gate
-        zft += (*ct_1) * (*Wc)({nOut, 2*nOut});     // add peephole connections to forget gate
-    }
-
-    // current sell state = ft*ct_1 + it*tanh(mmul(Wxc,xt) + mmul(Whc,ht_1) + bc
-    ct->assign( sigmoid(zft + forgetBias) * (*ct_1) + sigmoid(zit) * tanh(zct) );
-
-    // if clipping value is provided then cell state is clipped by this value prior to the cell output activation
-    if(clippingCellValue > 0.0)
-        ct->applyScalar(scalar::LstmClip, clippingCellValue, *ct);
-
-    if(peephole)
-        zot += (*ct) * (*Wc)({{2*nOut, 3*nOut}});            // add peephole connections to output gate zot + ct*Wc
-
+    // peephole connections: zit + ct_1*Wci, zft + ct_1*Wcf and zot + ct*Wco
+    // current cell state = ft*ct_1 + it*tanh(mmul(Wxc,xt) + mmul(Whc,ht_1) + bc)
     // current cell output = ot*tanh(ct)
-    auto htNoPeepHole = sigmoid(zot) * tanh(*ct);      // = [bS x nOut]
+    // without projection cell output goes straight to ht
+    NDArray htNoPeepHole = projection ? ct->ulike() : NDArray();      // = [bS x nOut]
+    BUILD_SINGLE_SELECTOR(z.dataType(), lstmCellGates_, (zit, zft, zct, zot, ct_1, Wc, peephole, forgetBias, clippingCellValue, ct, projection ? &htNoPeepHole : ht), FLOAT_TYPES);
 
     // apply projection
     if(projection) {
@@ -105,8 +166,6 @@ ND4J_LOCAL void lstmCell(sd::LaunchContext * context, const NDArray* xt, const N
         if(clippingProjValue != 0.)
             ht->applyScalar(scalar::LstmClip, clippingProjValue, *ht);
     }
-    else
-        ht->assign(&htNoPeepHole);
 }
 
 template <typename T>
@@ -0,0 +1,481 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Fused CPU normalization kernels: statistics of every TAD are evaluated in one pass over memory (blocked Welford),
+// then normalized output, optionally scaled and shifted, or gradient is written in second streaming pass
+//
+
+#include <ops/declarable/helpers/normalization.h>
+#include <helpers/ConstantTadHelper.h>
+#include <execution/Threads.h>
+#include <algorithm>
+#include <vector>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// TAD elements are consumed in blocks small enough to stay in L1: block mean and sum of squared deviations are evaluated
+// by two tight loops, then block is merged into running statistics of TAD by Chan's parallel variance formula
+static const Nd4jLong NORM_BLOCK = 256;
+
+//////////////////////////////////////////////////////////////////////////
+// running mean and sum of squared deviations of one TAD
+struct WelfordState {
+    double n = 0.;
+    double mean = 0.;
+    double m2 = 0.;
+
+    FORCEINLINE void merge(const double bN, const double bMean, const double bM2) {
+        const double total = n + bN;
+        const double delta = bMean - mean;
+        mean += delta * bN / total;
+        m2   += bM2 + delta * delta * n * bN / total;
+        n     = total;
+    }
+
+    FORCEINLINE double stdev() const {
+        return n > 0. ? sd::math::nd4j_sqrt<double, double>(m2 / n) : 0.;
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// TADs of array along axis; strided TADs are gathered into contiguous per-thread buffers, so kernels only deal with linear memory
+class TadAccess {
+public:
+    TadPack pack;
+    Nd4jLong tadLength;
+    std::vector<Nd4jLong> offsets;      // offsets of TAD elements in logical order, empty if TAD is linear
+
+    TadAccess(const NDArray& array, const std::vector<int>& axis) : pack(ConstantTadHelper::getInstance().tadForDimensions(array.shapeInfo(), axis)) {
+        auto tadShapeInfo = pack.primaryShapeInfo();
+        tadLength = shape::length(tadShapeInfo);
+
+        if (shape::elementWiseStride(tadShapeInfo) != 1 || (shape::order(tadShapeInfo) != 'c' && shape::rank(tadShapeInfo) > 1)) {
+            offsets.resize(tadLength);
+            for (Nd4jLong e = 0; e < tadLength; e++)
+                offsets[e] = shape::getIndexOffset(e, tadShapeInfo);
+        }
+    }
+
+    FORCEINLINE bool isLinear() const { return offsets.empty(); }
+
+    FORCEINLINE Nd4jLong numTads() const { return pack.numberOfTads(); }
+
+    // returns pointer to contiguous TAD data, either TAD itself or its copy within buffer
+    template <typename X>
+    FORCEINLINE const X* read(const X* array, const Nd4jLong t, X* buffer) const {
+        auto tad = array + pack.primaryOffsets()[t];
+        if (isLinear())
+            return tad;
+
+        for (Nd4jLong e = 0; e < tadLength; e++)
+            buffer[e] = tad[offsets[e]];
+
+        return buffer;
+    }
+
+    // returns pointer kernel should write TAD data to
+    template <typename X>
+    FORCEINLINE X* target(X* array, const Nd4jLong t, X* buffer) const {
+        return isLinear() ? array + pack.primaryOffsets()[t] : buffer;
+    }
+
+    // moves data written to buffer into TAD, if TAD isn't linear
+    template <typename X>
+    FORCEINLINE void write(X* array, const Nd4jLong t, const X* buffer) const {
+        if (isLinear())
+            return;
+
+        auto tad = array + pack.primaryOffsets()[t];
+        for (Nd4jLong e = 0; e < tadLength; e++)
+            tad[offsets[e]] = buffer[e];
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// channel along dimC of element is (index / inner) % numChannels, where index is logical index within TAD if dimC belongs to axis,
+// or index of TAD otherwise
+static Nd4jLong channelsInner(const NDArray& input, const std::vector<int>& axis, const int dimC, bool& inTad) {
+    inTad = std::find(axis.begin(), axis.end(), dimC) != axis.end();
+
+    Nd4jLong inner = 1;
+    for (int d = dimC + 1; d < input.rankOf(); d++)
+        if (inTad == (std::find(axis.begin(), axis.end(), d) != axis.end()))
+            inner *= input.sizeAt(d);
+
+    return inner;
+}
+
+template <typename X>
+static std::vector<X> channelsVector(const NDArray* array, const Nd4jLong numChannels) {
+    std::vector<X> result(numChannels, static_cast<X>(0));
+    if (array != nullptr)
+        for (Nd4jLong c = 0; c < numChannels; c++)
+            result[c] = array->t<X>(c);
+
+    return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X>
+static FORCEINLINE WelfordState tadMoments(const X* x, const Nd4jLong length) {
+    WelfordState state;
+
+    for (Nd4jLong b = 0; b < length; b += NORM_BLOCK) {
+        const Nd4jLong n = sd::math::nd4j_min<Nd4jLong>(NORM_BLOCK, length - b);
+        const X* block = x + b;
+
+        double sum = 0.;
+        PRAGMA_OMP_SIMD_SUM(sum)
+        for (Nd4jLong e = 0; e < n; e++)
+            sum += static_cast<double>(block[e]);
+
+        const double bMean = sum / n;
+
+        double m2 = 0.;
+        PRAGMA_OMP_SIMD_SUM(m2)
+        for (Nd4jLong e = 0; e < n; e++) {
+            const double d = static_cast<double>(block[e]) - bMean;
+            m2 += d * d;
+        }
+
+        state.merge(n, bMean, m2);
+    }
+
+    return state;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X>
+static void standardize_(const NDArray& input, const std::vector<int>& axis, const NDArray* gain, const NDArray* bias, const int dimC, NDArray& output) {
+    const TadAccess xTads(input, axis);
+    const TadAccess zTads(output, axis);
+    const Nd4jLong length = xTads.tadLength;
+
+    auto x = input.bufferAsT<X>();
+    auto z = output.bufferAsT<X>();
+
+    bool inTad = false;
+    const Nd4jLong inner = gain != nullptr ? channelsInner(input, axis, dimC, inTad) : 1;
+    const Nd4jLong numChannels = gain != nullptr ? input.sizeAt(dimC) : 1;
+    const auto g = channelsVector<X>(gain, numChannels);
+    const auto b = channelsVector<X>(bias, numChannels);
+
+    // if channel is within TAD, gain and bias are expanded to TAD length once, so output pass is a plain fma over contiguous arrays
+    std::vector<X> gTad, bTad;
+    if (gain != nullptr && inTad) {
+        gTad.resize(length);
+        bTad.resize(length);
+        for (Nd4jLong e = 0; e < length; e++) {
+            gTad[e] = g[(e / inner) % numChannels];
+            bTad[e] = b[(e / inner) % numChannels];
+        }
+    }
+
+    auto func = PRAGMA_THREADS_FOR {
+        std::vector<X> xBuffer(xTads.isLinear() ? 0 : length);
+        std::vector<X> zBuffer(zTads.isLinear() ? 0 : length);
+
+        for (auto t = start; t < stop; t++) {
+            auto xT = xTads.read(x, t, xBuffer.data());
+            auto zT = zTads.target(z, t, zBuffer.data());
+
+            const auto state = tadMoments(xT, length);
+            const double stdev = state.stdev();
+
+            // constant TADs give zeros, just like NaNs produced by 0/0 are replaced with zeros
+            const X mean = static_cast<X>(state.mean);
+            const X invStd = static_cast<X>(stdev > 0. ? 1. / stdev : 0.);
+
+            if (gain == nullptr) {
+                for (Nd4jLong e = 0; e < length; e++) {
+                    const X y = (xT[e] - mean) * invStd;
+                    zT[e] = sd::math::nd4j_isnan(y) ? static_cast<X>(0) : y;
+                }
+            } else if (inTad) {
+                auto gT = gTad.data();
+                auto bT = bTad.data();
+                for (Nd4jLong e = 0; e < length; e++) {
+                    const X y = (xT[e] - mean) * invStd;
+                    zT[e] = (sd::math::nd4j_isnan(y) ? static_cast<X>(0) : y) * gT[e] + bT[e];
+                }
+            } else {
+                const auto c = (t / inner) % numChannels;
+                const X gC = g[c];
+                const X bC = b[c];
+                for (Nd4jLong e = 0; e < length; e++) {
+                    const X y = (xT[e] - mean) * invStd;
+                    zT[e] = (sd::math::nd4j_isnan(y) ? static_cast<X>(0) : y) * gC + bC;
+                }
+            }
+
+            zTads.write(z, t, zT);
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, xTads.numTads());
+}
+
+//////////////////////////////////////////////////////////////////////////
+// y = (x - mean) / stdev, g = gradO * gain
+// gradI = (g - mean(g) - y * mean(g * y)) / stdev
+// gradG = sum(gradO * y), gradB = sum(gradO) over everything but dimC
+template <typename X>
+static void standardizeBp_(const NDArray& input, const NDArray& gradO, const std::vector<int>& axis, const NDArray* gain, const int dimC,
+                           NDArray& gradI, NDArray* gradG, NDArray* gradB) {
+    const TadAccess xTads(input, axis);
+    const TadAccess eTads(gradO, axis);
+    const TadAccess zTads(gradI, axis);
+    const Nd4jLong length = xTads.tadLength;
+    const Nd4jLong numTads = xTads.numTads();
+
+    auto x = input.bufferAsT<X>();
+    auto eps = gradO.bufferAsT<X>();
+    auto z = gradI.bufferAsT<X>();
+
+    bool inTad = false;
+    const Nd4jLong inner = gain != nullptr ? channelsInner(input, axis, dimC, inTad) : 1;
+    const Nd4jLong numChannels = gain != nullptr ? input.sizeAt(dimC) : 1;
+    const auto g = channelsVector<X>(gain, numChannels);
+
+    std::vector<X> gTad;
+    if (gain != nullptr && inTad) {
+        gTad.resize(length);
+        for (Nd4jLong e = 0; e < length; e++)
+            gTad[e] = g[(e / inner) % numChannels];
+    }
+
+    // gain and bias gradients are accumulated per thread: per element of TAD if channel is within TAD, per channel otherwise
+    const bool gainGrads = gain != nullptr && (gradG != nullptr || gradB != nullptr);
+    const int maxThreads = sd::Environment::getInstance().maxMasterThreads();
+    const Nd4jLong partialLength = inTad ? length : numChannels;
+    std::vector<double> partialG(gainGrads ? maxThreads * partialLength : 0, 0.);
+    std::vector<double> partialB(gainGrads ? maxThreads * partialLength : 0, 0.);
+
+    auto func = PRAGMA_THREADS_FOR {
+        std::vector<X> xBuffer(xTads.isLinear() ? 0 : length);
+        std::vector<X> eBuffer(eTads.isLinear() ? 0 : length);
+        std::vector<X> zBuffer(zTads.isLinear() ? 0 : length);
+        std::vector<X> gBuffer(length);
+
+        auto pG = gainGrads ? partialG.data() + thread_id * partialLength : nullptr;
+        auto pB = gainGrads ? partialB.data() + thread_id * partialLength : nullptr;
+
+        for (auto t = start; t < stop; t++) {
+            auto xT = xTads.read(x, t, xBuffer.data());
+            auto eT = eTads.read(eps, t, eBuffer.data());
+            auto zT = zTads.target(z, t, zBuffer.data());
+            auto gT = gBuffer.data();
+
+            const Nd4jLong c = inTad ? 0 : (t / inner) % numChannels;
+
+            // gradient coming to standardized values
+            if (gain == nullptr) {
+                std::copy(eT, eT + length, gT);
+            } else if (inTad) {
+                for (Nd4jLong e = 0; e < length; e++)
+                    gT[e] = eT[e] * gTad[e];
+            } else {
+                const X gC = g[c];
+                for (Nd4jLong e = 0; e < length; e++)
+                    gT[e] = eT[e] * gC;
+            }
+
+            // first pass: statistics of x, sum(g) and sum(g * (x - mean)). The latter is accumulated against block means
+            // and corrected at the end: sum(g * (x - mean)) = sum_b(sum(g * (x - mean_b))) + sum_b(mean_b * sum_b(g)) - mean * sum(g)
+            WelfordState state;
+            double sumG = 0., sumGXc = 0., sumMG = 0.;
+            for (Nd4jLong b = 0; b < length; b += NORM_BLOCK) {
+                const Nd4jLong n = sd::math::nd4j_min<Nd4jLong>(NORM_BLOCK, length - b);
+                const X* xB = xT + b;
+                const X* gB = gT + b;
+
+                double sum = 0., bSumG = 0.;
+                PRAGMA_OMP_SIMD_SUM(sum)
+                for (Nd4jLong e = 0; e < n; e++)
+                    sum += static_cast<double>(xB[e]);
+
+                for (Nd4jLong e = 0; e < n; e++)
+                    bSumG += static_cast<double>(gB[e]);
+
+                const double bMean = sum / n;
+
+                double m2 = 0., bSumGXc = 0.;
+                for (Nd4jLong e = 0; e < n; e++) {
+                    const double d = static_cast<double>(xB[e]) - bMean;
+                    m2 += d * d;
+                    bSumGXc += static_cast<double>(gB[e]) * d;
+                }
+
+                state.merge(n, bMean, m2);
+                sumG += bSumG;
+                sumGXc += bSumGXc;
+                sumMG += bMean * bSumG;
+            }
+
+            const double stdev = state.stdev();
+            const double invStd = stdev > 0. ? 1. / stdev : 0.;
+            const double sumGY = (sumGXc + sumMG - state.mean * sumG) * invStd;
+
+            const X mean = static_cast<X>(state.mean);
+            const X xInvStd = static_cast<X>(invStd);
+            const X meanG = static_cast<X>(sumG / length);
+            const X meanGY = static_cast<X>(sumGY / length);
+
+            // second pass: gradient of input
+            for (Nd4jLong e = 0; e < length; e++) {
+                const X y = (xT[e] - mean) * xInvStd;
+                const X d = (gT[e] - meanG - y * meanGY) * xInvStd;
+                zT[e] = sd::math::nd4j_isnan(d) ? static_cast<X>(0) : d;
+            }
+
+            if (gainGrads) {
+                if (inTad) {
+                    for (Nd4jLong e = 0; e < length; e++) {
+                        const X y = (xT[e] - mean) * xInvStd;
+                        pG[e] += static_cast<double>(eT[e] * y);
+                        pB[e] += static_cast<double>(eT[e]);
+                    }
+                } else {
+                    double sG = 0., sB = 0.;
+                    for (Nd4jLong e = 0; e < length; e++) {
+                        const X y = (xT[e] - mean) * xInvStd;
+                        sG += static_cast<double>(eT[e] * y);
+                        sB += static_cast<double>(eT[e]);
+                    }
+
+                    pG[c] += sG;
+                    pB[c] += sB;
+                }
+            }
+
+            zTads.write(z, t, zT);
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, numTads, 1, maxThreads);
+
+    if (!gainGrads)
+        return;
+
+    std::vector<double> sumG(numChannels, 0.), sumB(numChannels, 0.);
+    for (int th = 0; th < maxThreads; th++) {
+        for (Nd4jLong e = 0; e < partialLength; e++) {
+            const auto c = inTad ? (e / inner) % numChannels : e;
+            sumG[c] += partialG[th * partialLength + e];
+            sumB[c] += partialB[th * partialLength + e];
+        }
+    }
+
+    for (Nd4jLong c = 0; c < numChannels; c++) {
+        if (gradG != nullptr)
+            gradG->r<X>(c) = static_cast<X>(sumG[c]);
+
+        if (gradB != nullptr)
+            gradB->r<X>(c) = static_cast<X>(sumB[c]);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X>
+static void moments_(const NDArray& input, const std::vector<int>& axis, NDArray& mean, NDArray& variance) {
+    const TadAccess xTads(input, axis);
+    const Nd4jLong length = xTads.tadLength;
+
+    auto x = input.bufferAsT<X>();
+    auto m = mean.bufferAsT<X>();
+    auto v = variance.bufferAsT<X>();
+
+    auto func = PRAGMA_THREADS_FOR {
+        std::vector<X> xBuffer(xTads.isLinear() ? 0 : length);
+
+        for (auto t = start; t < stop; t++) {
+            const auto state = tadMoments(xTads.read(x, t, xBuffer.data()), length);
+
+            m[shape::getIndexOffset(t, mean.shapeInfo())] = static_cast<X>(state.mean);
+            v[shape::getIndexOffset(t, variance.shapeInfo())] = static_cast<X>(state.m2 / state.n);
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, xTads.numTads());
+}
+
+//////////////////////////////////////////////////////////////////////////
+static bool sameFloatTypes(const std::vector<const NDArray*>& arrays) {
+    for (auto array : arrays)
+        if (array != nullptr && (array->dataType() != arrays[0]->dataType() || !array->isR() || array->isEmpty()))
+            return false;
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool standardizeFused(const NDArray& input, const std::vector<int>& axis, const NDArray* gain, const NDArray* bias, const int dimC, NDArray& output) {
+    if (!sameFloatTypes({&input, &output, gain, bias}))
+        return false;
+
+    auto dims = axis;
+    shape::checkDimensions(input.rankOf(), dims);
+
+    NDArray::preparePrimaryUse({&output}, {&input, gain, bias});
+    BUILD_SINGLE_SELECTOR(input.dataType(), standardize_, (input, dims, gain, bias, dimC, output), FLOAT_TYPES);
+    NDArray::registerPrimaryUse({&output}, {&input, gain, bias});
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool standardizeBpFused(const NDArray& input, const NDArray& gradO, const std::vector<int>& axis, const NDArray* gain, const int dimC,
+                        NDArray& gradI, NDArray* gradG, NDArray* gradB) {
+    if (!sameFloatTypes({&input, &gradO, &gradI, gain, gradG, gradB}))
+        return false;
+
+    auto dims = axis;
+    shape::checkDimensions(input.rankOf(), dims);
+
+    NDArray::preparePrimaryUse({&gradI, gradG, gradB}, {&input, &gradO, gain});
+    BUILD_SINGLE_SELECTOR(input.dataType(), standardizeBp_, (input, gradO, dims, gain, dimC, gradI, gradG, gradB), FLOAT_TYPES);
+    NDArray::registerPrimaryUse({&gradI, gradG, gradB}, {&input, &gradO, gain});
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool momentsFused(const NDArray& input, const std::vector<int>& axis, NDArray& mean, NDArray& variance) {
+    if (!sameFloatTypes({&input, &mean, &variance}))
+        return false;
+
+    std::vector<int> dims = axis;
+    if (dims.empty())
+        for (int d = 0; d < input.rankOf(); d++)
+            dims.emplace_back(d);
+
+    shape::checkDimensions(input.rankOf(), dims);
+
+    NDArray::preparePrimaryUse({&mean, &variance}, {&input});
+    BUILD_SINGLE_SELECTOR(input.dataType(), moments_, (input, dims, mean, variance), FLOAT_TYPES);
+    NDArray::registerPrimaryUse({&mean, &variance}, {&input});
+
+    return true;
+}
+
+}
+}
+}
@@ -23,99 +23,100 @@
 #include <ops/ops.h>
 #include <helpers/shape.h>
 #include <helpers/TAD.h>
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/PrefixScan.h>
+#include <execution/Threads.h>
 #include <ops/declarable/helpers/prefix.h>
 
 namespace sd {
     namespace ops {
         namespace helpers {
+            // stride of element within linear index space, or 0 if elements can't be addressed that way
+            static FORCEINLINE Nd4jLong linearStride(Nd4jLong const* shapeInfo) {
+                if (shape::rank(shapeInfo) <= 1 || shape::order(shapeInfo) == 'c')
+                    return shape::elementWiseStride(shapeInfo);
+
+                return 0;
+            }
+
             template <typename T>
-            static void prefix_(scalar::Ops op, const void* vx, Nd4jLong const* xShapeInfo, void* vz, Nd4jLong const* zShapeInfo, bool exclusive, bool reverse) {
+            static void prefix_(scalar::Ops op, const void* vx, Nd4jLong const* xShapeInfo, void* vz, Nd4jLong const* zShapeInfo, bool exclusive, bool reverse, bool parallel) {
                 const auto x = reinterpret_cast<const T *>(vx);
                       auto z = reinterpret_cast<T *>(vz);
                 auto length = shape::length(xShapeInfo);
 
+                const auto xStride = linearStride(xShapeInfo);
+                const auto zStride = linearStride(zShapeInfo);
+
+                if (xStride > 0 && zStride > 0) {
+                    if (op == scalar::Add)
+                        PrefixScan::exec<T, simdOps::Add<T, T, T>>(x, xStride, z, zStride, length, (T) 0, exclusive, reverse, parallel);
+                    else
+                        PrefixScan::exec<T, simdOps::Multiply<T, T, T>>(x, xStride, z, zStride, length, (T) 1, exclusive, reverse, parallel);
+
+                    return;
+                }
+
                 T prevSum = op == scalar::Add ? (T) 0 : (T) 1;
                 T sum = prevSum;
 
                 if (reverse) {
-                    if (shape::elementWiseStride(xShapeInfo) == 1 && shape::elementWiseStride(zShapeInfo) == 1 &&
-                        shape::order(xShapeInfo) == 'c' && shape::order(zShapeInfo) == 'c') {
-
-                        for (Nd4jLong e = length - 1; e >= 0; --e) {
-                            sum = op == scalar::Add ? simdOps::Add<T, T, T>::op(sum, x[e]) : simdOps::Multiply<T, T, T>::op(sum, x[e]);
-                            if (!exclusive)
-                                prevSum = sum;
+                    for (Nd4jLong e = length - 1; e >= 0; --e) {
 
-                            z[e] = prevSum;
+                        auto xOffset = shape::getIndexOffset(e, xShapeInfo);
+                        auto zOffset = shape::getIndexOffset(e, zShapeInfo);
+                        sum = op == scalar::Add ? simdOps::Add<T, T, T>::op(sum, x[xOffset]) : simdOps::Multiply<T, T, T>::op(sum, x[xOffset]);
 
+                        if (!exclusive)
                             prevSum = sum;
-                        }
-                    }
-                    else {
-
-                        for (Nd4jLong e = length - 1; e >= 0; --e) {
-
-                            auto xOffset = shape::getIndexOffset(e, xShapeInfo);
-                            auto zOffset = shape::getIndexOffset(e, zShapeInfo);
-                            sum = op == scalar::Add ? simdOps::Add<T, T, T>::op(sum, x[xOffset]) : simdOps::Multiply<T, T, T>::op(sum, x[xOffset]);
-
-                            if (!exclusive)
-                                prevSum = sum;
 
-                            z[zOffset] = prevSum;
-                            prevSum = sum;
-                        }
+                        z[zOffset] = prevSum;
+                        prevSum = sum;
                     }
                 } else {
-                    if (shape::elementWiseStride(xShapeInfo) == 1 && shape::elementWiseStride(zShapeInfo) == 1 &&
-                        shape::order(xShapeInfo) == 'c' && shape::order(zShapeInfo) == 'c') {
-
-                        for (Nd4jLong e = 0; e < length; e++) {
-                            sum = op == scalar::Add ? simdOps::Add<T, T, T>::op(sum, x[e]) : simdOps::Multiply<T, T, T>::op(sum, x[e]);
-
-                            if (!exclusive)
-                                prevSum = sum;
+                    for (Nd4jLong e = 0; e < length; e++) {
 
-                            z[e] = prevSum;
+                        auto xOffset = shape::getIndexOffset(e, xShapeInfo);
+                        auto zOffset = shape::getIndexOffset(e, zShapeInfo);
+                        sum = op == scalar::Add ? simdOps::Add<T, T, T>::op(sum, x[xOffset]) : simdOps::Multiply<T, T, T>::op(sum, x[xOffset]);
 
+                        if (!exclusive)
                             prevSum = sum;
-                        }
-                    }
-                    else {
-
-                        for (Nd4jLong e = 0; e < length; e++) {
-
-                            auto xOffset = shape::getIndexOffset(e, xShapeInfo);
-                            auto zOffset = shape::getIndexOffset(e, zShapeInfo);
-                            sum = op == scalar::Add ? simdOps::Add<T, T, T>::op(sum, x[xOffset]) : simdOps::Multiply<T, T, T>::op(sum, x[xOffset]);
 
-                            if (!exclusive)
-                                prevSum = sum;
-
-                            z[zOffset] = prevSum;
-                            prevSum = sum;
-                        }
+                        z[zOffset] = prevSum;
+                        prevSum = sum;
                     }
                 }
             };
 
             template <typename T>
             static void prefix_(scalar::Ops op, const NDArray* x, NDArray* z, const std::vector<int>& dims, bool exclusive, bool reverse) {
-                auto xTads = x->allTensorsAlongDimension(dims);
-                auto zTads = z->allTensorsAlongDimension(dims);
-                auto t = xTads.size();
+                auto packX = ConstantTadHelper::getInstance().tadForDimensions(x->shapeInfo(), dims);
+                auto packZ = ConstantTadHelper::getInstance().tadForDimensions(z->shapeInfo(), dims);
+
+                const auto numTads = packX.numberOfTads();
+                const auto tadLength = shape::length(packX.primaryShapeInfo());
 
-                for (int e = 0; e < t; e++) {
-                    auto tx = xTads.at(e);
-                    auto tz = zTads.at(e);
+                auto xBuffer = x->bufferAsT<T>();
+                auto zBuffer = z->bufferAsT<T>();
 
-                    prefix_<T>(op, tx->buffer(), tx->shapeInfo(), tz->buffer(), tz->shapeInfo(), exclusive, reverse);
+                // many short TADs are split between threads, while few long ones are scanned in parallel one by one
+                if (numTads >= sd::Environment::getInstance().maxMasterThreads() || PrefixScan::numberOfChunks(tadLength) == 1) {
+                    auto func = PRAGMA_THREADS_FOR {
+                        for (auto e = start; e < stop; e++)
+                            prefix_<T>(op, xBuffer + packX.primaryOffsets()[e], packX.primaryShapeInfo(), zBuffer + packZ.primaryOffsets()[e], packZ.primaryShapeInfo(), exclusive, reverse, false);
+                    };
+
+                    samediff::Threads::parallel_tad(func, 0, numTads);
+                } else {
+                    for (Nd4jLong e = 0; e < numTads; e++)
+                        prefix_<T>(op, xBuffer + packX.primaryOffsets()[e], packX.primaryShapeInfo(), zBuffer + packZ.primaryOffsets()[e], packZ.primaryShapeInfo(), exclusive, reverse, true);
                 }
             };
 
             template <typename T>
             static void prefix_(scalar::Ops op, const NDArray* x, NDArray* z, bool exclusive, bool reverse) {
-                    prefix_<T>(op, x->buffer(), x->shapeInfo(), z->buffer(), z->shapeInfo(), exclusive, reverse);
+                    prefix_<T>(op, x->buffer(), x->shapeInfo(), z->buffer(), z->shapeInfo(), exclusive, reverse, true);
             };
 
             ND4J_LOCAL void prefix(sd::LaunchContext * context, scalar::Ops op, const NDArray* x, NDArray* z, bool exclusive, bool reverse) {
@@ -126,7 +127,7 @@ namespace sd {
                 BUILD_SINGLE_SELECTOR(x->dataType(), prefix_, (op, x, z, dims, exclusive, reverse), LIBND4J_TYPES);
             }
 
-            BUILD_SINGLE_TEMPLATE(template ND4J_LOCAL void prefix_, (scalar::Ops op, const void* vx, Nd4jLong const* xShapeInfo, void* vz, Nd4jLong const* zShapeInfo, bool exclusive, bool reverse), LIBND4J_TYPES);
+            BUILD_SINGLE_TEMPLATE(template ND4J_LOCAL void prefix_, (scalar::Ops op, const void* vx, Nd4jLong const* xShapeInfo, void* vz, Nd4jLong const* zShapeInfo, bool exclusive, bool reverse, bool parallel), LIBND4J_TYPES);
             BUILD_SINGLE_TEMPLATE(template ND4J_LOCAL void prefix_, (scalar::Ops op, const NDArray* x, NDArray* z, const std::vector<int>& dims, bool exclusive, bool reverse), LIBND4J_TYPES);
             BUILD_SINGLE_TEMPLATE(template ND4J_LOCAL void prefix_, (scalar::Ops op, const NDArray* x, NDArray* z, bool exclusive, bool reverse), LIBND4J_TYPES);
 
@@ -0,0 +1,440 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Fused CPU time loops for lstmLayer, gru and sru:
+// input projections of all time steps are computed by one GEMM before the loop, per-step buffers are allocated once,
+// and gates activations together with state update are evaluated in a single pass over each batch row
+//
+
+#include <ops/declarable/helpers/lstmLayer.h>
+#include <ops/declarable/helpers/gru.h>
+#include <ops/declarable/helpers/sru.h>
+#include <helpers/MmulHelper.h>
+#include <execution/Threads.h>
+#include <type_traits>
+#include <vector>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// channels of one sru task, sru has no recurrent GEMM, so work is split over batch and channels
+static const Nd4jLong SRU_CHANNELS_BLOCK = 64;
+
+//////////////////////////////////////////////////////////////////////////
+// same ids and formulas as applyActivation in lstmLayer: 0=tanh, 1=relu, 2=sigmoid, 3=affine, 4=leaky relu, 5=thresholded relu,
+// 6=scaled tanh, 7=hard sigmoid, 8=ELU, 9=softsign, 10=softplus
+template <typename A>
+static void activateRow(const int opId, const A alpha, const A beta, A* z, const Nd4jLong n) {
+
+    switch (opId) {
+        case 0:
+            for (Nd4jLong e = 0; e < n; e++)
+                z[e] = sd::math::nd4j_tanh<A, A>(z[e]);
+            break;
+        case 1:
+            for (Nd4jLong e = 0; e < n; e++)
+                z[e] = z[e] < static_cast<A>(0) ? static_cast<A>(0) : z[e];
+            break;
+        case 2:
+            for (Nd4jLong e = 0; e < n; e++)
+                z[e] = sd::math::nd4j_sigmoid<A, A>(z[e]);
+            break;
+        case 3:
+            for (Nd4jLong e = 0; e < n; e++)
+                z[e] = alpha * z[e] + beta;
+            break;
+        case 4:
+            for (Nd4jLong e = 0; e < n; e++)
+                z[e] = z[e] < static_cast<A>(0) ? alpha * z[e] : z[e];
+            break;
+        case 5:
+            for (Nd4jLong e = 0; e < n; e++)
+                z[e] = z[e] > alpha ? z[e] : static_cast<A>(0);
+            break;
+        case 6:
+            for (Nd4jLong e = 0; e < n; e++)
+                z[e] = alpha * sd::math::nd4j_tanh<A, A>(beta * z[e]);
+            break;
+        case 7:
+            for (Nd4jLong e = 0; e < n; e++)
+                z[e] = sd::math::nd4j_min<A>(static_cast<A>(1), sd::math::nd4j_max<A>(static_cast<A>(0), static_cast<A>(0.2f) * z[e] + static_cast<A>(0.5f)));
+            break;
+        case 8:
+            for (Nd4jLong e = 0; e < n; e++)
+                z[e] = sd::math::nd4j_elu<A, A>(z[e], alpha);
+            break;
+        case 9:
+            for (Nd4jLong e = 0; e < n; e++)
+                z[e] = sd::math::nd4j_softsign<A, A>(z[e]);
+            break;
+        case 10:
+            for (Nd4jLong e = 0; e < n; e++)
+                z[e] = sd::math::nd4j_softplus<A, A>(z[e]);
+            break;
+        default:
+            throw std::invalid_argument("LSTM_LAYER operation: wrong id number of activation !");
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename A>
+static std::vector<A> vectorOf(const NDArray* arr, const Nd4jLong length) {
+    std::vector<A> result(length, static_cast<A>(0));
+    if (arr != nullptr)
+        for (Nd4jLong e = 0; e < length; e++)
+            result[e] = arr->e<A>(e);
+    return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void lstmLayerTimeLoopFused_(const NDArray* x, const NDArray* Wx, const NDArray* Wr,
+                                    const NDArray* b, const NDArray* seqLen, const NDArray* hI, const NDArray* cI, const NDArray* Wp,
+                                    const std::vector<float>& params, const bool forward,
+                                    NDArray* h, NDArray* hL, NDArray* cL) {
+    typedef typename std::conditional<std::is_same<T, double>::value, double, float>::type A;
+
+    const int dataFormat    = params[0];
+    const int directionMode = params[1];
+    const A cellClip        = params[2];
+
+    const int gateAct = params[3], cellAct = params[6], outAct = params[9];
+    const A gateAlpha = params[4], gateBeta = params[5];
+    const A cellAlpha = params[7], cellBeta = params[8];
+    const A outAlpha  = params[10], outBeta = params[11];
+
+    const Nd4jLong sL   = dataFormat == 3 ?  x->sizeAt(0) : x->sizeAt(dataFormat);
+    const Nd4jLong bS   = dataFormat == 1 || dataFormat == 2 ? x->sizeAt(0) : x->sizeAt(1);
+    const Nd4jLong nIn  = Wx->sizeAt(0);
+    const Nd4jLong nOut = Wx->sizeAt(-1) / 4;
+
+    auto context = x->getContext();
+    const auto type = x->dataType();
+
+    // x × Wx for all time steps at once, rows are ordered as [sL, bS]
+    const std::vector<int> toTimeMajor = dataFormat == 1 ? std::vector<int>({1, 0, 2}) : (dataFormat == 2 ? std::vector<int>({2, 0, 1}) : std::vector<int>({0, 1, 2}));
+    NDArray xFlat = x->permute(toTimeMajor).reshape('c', {sL * bS, nIn});
+    NDArray zx('c', {sL * bS, 4 * nOut}, type, context);
+    MmulHelper::mmul(&xFlat, Wx, &zx);                          // [sL*bS, nIn] × [nIn, 4*nOut] = [sL*bS, 4*nOut]
+
+    // state and per-step buffers, reused by all time steps
+    NDArray ht('c', {bS, nOut}, type, context);
+    NDArray ct('c', {bS, nOut}, type, context);
+    NDArray zr('c', {bS, 4 * nOut}, type, context);
+    std::vector<A> gates(bS * 4 * nOut);
+
+    if (hI)
+        ht.assign(hI);
+    else
+        ht.nullify();
+
+    if (cI)
+        ct.assign(cI);
+    else
+        ct.nullify();
+
+    const auto bias = vectorOf<A>(b, 4 * nOut);
+    const auto peep = vectorOf<A>(Wp, 3 * nOut);
+
+    std::vector<Nd4jLong> limits(bS, sL);
+    Nd4jLong maxLimit = seqLen ? 0 : sL;
+    if (seqLen)
+        for (Nd4jLong e = 0; e < bS; e++) {
+            limits[e] = sd::math::nd4j_max<Nd4jLong>(0, sd::math::nd4j_min<Nd4jLong>(sL, seqLen->e<Nd4jLong>(e)));
+            maxLimit = sd::math::nd4j_max<Nd4jLong>(maxLimit, limits[e]);
+        }
+
+    // [time, batch, nOut] strides of output
+    Nd4jLong hT(0), hB(0), hJ(0);
+    if (h) {
+        if (dataFormat == 1) {
+            hT = h->strideAt(1); hB = h->strideAt(0); hJ = h->strideAt(2);
+        }
+        else if (dataFormat == 2) {
+            hT = h->strideAt(2); hB = h->strideAt(0); hJ = h->strideAt(1);
+        }
+        else {
+            hT = h->strideAt(0); hB = h->strideAt(1); hJ = h->strideAt(2);
+        }
+
+        // time steps beyond sequence lengths stay zero
+        if (seqLen)
+            h->nullify();
+    }
+
+    auto pZx = zx.bufferAsT<T>();
+    auto pZr = zr.bufferAsT<T>();
+    auto pHt = ht.bufferAsT<T>();
+    auto pCt = ct.bufferAsT<T>();
+    auto pH  = h ? h->bufferAsT<T>() : nullptr;
+
+    for (Nd4jLong s = 0; s < maxLimit; s++) {
+
+        MmulHelper::mmul(&ht, Wr, &zr);                         // [bS, nOut] × [nOut, 4*nOut] = [bS, 4*nOut]
+
+        auto func = PRAGMA_THREADS_FOR {
+            for (auto e = start; e < stop; e++) {
+                if (s >= limits[e])
+                    continue;
+
+                // backward pass goes from the end of sequence, which is limit-1 only for backward half of bidirectional mode
+                Nd4jLong t = s;
+                if (!forward)
+                    t = (!seqLen || directionMode == 1) ? sL - 1 - s : limits[e] - 1 - s;
+
+                const T* zxRow = pZx + (t * bS + e) * 4 * nOut;
+                const T* zrRow = pZr + e * 4 * nOut;
+                T* hRow = pHt + e * nOut;
+                T* cRow = pCt + e * nOut;
+
+                // i, f, g, o
+                A* zi = gates.data() + e * 4 * nOut;
+                A* zf = zi + nOut;
+                A* zg = zf + nOut;
+                A* zo = zg + nOut;
+
+                for (Nd4jLong j = 0; j < 4 * nOut; j++)
+                    zi[j] = static_cast<A>(zxRow[j]) + static_cast<A>(zrRow[j]) + bias[j];
+
+                if (Wp)
+                    for (Nd4jLong j = 0; j < nOut; j++) {
+                        zi[j] += static_cast<A>(cRow[j]) * peep[j];
+                        zf[j] += static_cast<A>(cRow[j]) * peep[nOut + j];
+                    }
+
+                activateRow<A>(gateAct, gateAlpha, gateBeta, zi, 2 * nOut);
+                activateRow<A>(cellAct, cellAlpha, cellBeta, zg, nOut);
+
+                // new cell state replaces cell gate
+                for (Nd4jLong j = 0; j < nOut; j++) {
+                    A c = zf[j] * static_cast<A>(cRow[j]) + zi[j] * zg[j];
+                    if (cellClip != static_cast<A>(0))
+                        c = c > cellClip ? cellClip : (c < -cellClip ? -cellClip : c);
+                    zg[j] = c;
+                }
+
+                if (Wp)
+                    for (Nd4jLong j = 0; j < nOut; j++)
+                        zo[j] += zg[j] * peep[2 * nOut + j];
+
+                activateRow<A>(gateAct, gateAlpha, gateBeta, zo, nOut);
+
+                // output activation of cell state replaces forget gate
+                for (Nd4jLong j = 0; j < nOut; j++)
+                    zf[j] = zg[j];
+                activateRow<A>(outAct, outAlpha, outBeta, zf, nOut);
+
+                for (Nd4jLong j = 0; j < nOut; j++) {
+                    cRow[j] = static_cast<T>(zg[j]);
+                    hRow[j] = static_cast<T>(zo[j] * zf[j]);
+                }
+
+                if (pH) {
+                    T* hOut = pH + t * hT + e * hB;
+                    for (Nd4jLong j = 0; j < nOut; j++)
+                        hOut[j * hJ] = hRow[j];
+                }
+            }
+        };
+
+        samediff::Threads::parallel_tad(func, 0, bS);
+    }
+
+    // empty sequences produce zero states
+    for (Nd4jLong e = 0; e < bS; e++)
+        if (limits[e] == 0) {
+            std::fill(pHt + e * nOut, pHt + (e + 1) * nOut, static_cast<T>(0));
+            std::fill(pCt + e * nOut, pCt + (e + 1) * nOut, static_cast<T>(0));
+        }
+
+    if (hL)
+        hL->assign(ht);
+    if (cL)
+        cL->assign(ct);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void gruTimeLoopFused_(const NDArray* x, const NDArray* hI, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h) {
+    typedef typename std::conditional<std::is_same<T, double>::value, double, float>::type A;
+
+    const Nd4jLong sL   = x->sizeAt(0);
+    const Nd4jLong bS   = x->sizeAt(1);
+    const Nd4jLong nIn  = x->sizeAt(2);
+    const Nd4jLong nOut = hI->sizeAt(1);
+
+    auto context = x->getContext();
+    const auto type = x->dataType();
+
+    // x × Wx for all time steps at once, [sL*bS, 3*nOut]
+    NDArray xFlat = x->reshape('c', {sL * bS, nIn});
+    NDArray zx('c', {sL * bS, 3 * nOut}, type, context);
+    MmulHelper::mmul(&xFlat, Wx, &zx);
+
+    NDArray ht('c', {bS, nOut}, type, context);
+    NDArray zh('c', {bS, 3 * nOut}, type, context);
+    ht.assign(hI);
+
+    const auto bias = vectorOf<A>(b, 3 * nOut);
+
+    const Nd4jLong hT = h->strideAt(0), hB = h->strideAt(1), hJ = h->strideAt(2);
+    auto pZx = zx.bufferAsT<T>();
+    auto pZh = zh.bufferAsT<T>();
+    auto pHt = ht.bufferAsT<T>();
+    auto pH  = h->bufferAsT<T>();
+
+    for (Nd4jLong t = 0; t < sL; t++) {
+
+        MmulHelper::mmul(&ht, Wh, &zh);                         // [bS, nOut] × [nOut, 3*nOut] = [bS, 3*nOut]
+
+        auto func = PRAGMA_THREADS_FOR {
+            for (auto e = start; e < stop; e++) {
+                // reset, update, cell
+                const T* zxRow = pZx + (t * bS + e) * 3 * nOut;
+                const T* zhRow = pZh + e * 3 * nOut;
+                T* hRow = pHt + e * nOut;
+                T* hOut = pH + t * hT + e * hB;
+
+                for (Nd4jLong j = 0; j < nOut; j++) {
+                    const A r = sd::math::nd4j_sigmoid<A, A>(static_cast<A>(zxRow[j]) + static_cast<A>(zhRow[j]) + bias[j]);
+                    const A u = sd::math::nd4j_sigmoid<A, A>(static_cast<A>(zxRow[nOut + j]) + static_cast<A>(zhRow[nOut + j]) + bias[nOut + j]);
+                    const A c = sd::math::nd4j_tanh<A, A>(static_cast<A>(zhRow[2 * nOut + j]) * r + static_cast<A>(zxRow[2 * nOut + j]) + bias[2 * nOut + j]);
+
+                    hRow[j] = static_cast<T>(u * static_cast<A>(hRow[j]) + (static_cast<A>(1) - u) * c);
+                    hOut[j * hJ] = hRow[j];
+                }
+            }
+        };
+
+        samediff::Threads::parallel_tad(func, 0, bS);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void sruTimeLoopFused_(const NDArray* x, const NDArray* c0, const NDArray* w, const NDArray* b, NDArray* h, NDArray* c) {
+    typedef typename std::conditional<std::is_same<T, double>::value, double, float>::type A;
+
+    const Nd4jLong bS   = x->sizeAt(0);
+    const Nd4jLong K    = x->sizeAt(1);
+    const Nd4jLong time = x->sizeAt(2);
+
+    // x × wT for all time steps at once, rows are ordered as [time, bS]
+    auto wT = w->transpose();                                   // [3*K x K] -> [K x 3*K]
+    NDArray xFlat = x->permute({2, 0, 1}).reshape('c', {time * bS, K});
+    NDArray z('c', {time * bS, 3 * K}, x->dataType(), x->getContext());
+    MmulHelper::mmul(&xFlat, &wT, &z);
+
+    const auto bias = vectorOf<A>(b, 2 * K);
+
+    auto pZ = z.bufferAsT<T>();
+    auto pX = x->bufferAsT<T>();
+    auto pC0 = c0->bufferAsT<T>();
+    auto pH = h->bufferAsT<T>();
+    auto pC = c->bufferAsT<T>();
+
+    const Nd4jLong c0B = c0->strideAt(0), c0K = c0->strideAt(1);
+    const Nd4jLong xB = x->strideAt(0), xK = x->strideAt(1), xT = x->strideAt(2);
+    const Nd4jLong hB = h->strideAt(0), hK = h->strideAt(1), hT = h->strideAt(2);
+    const Nd4jLong cB = c->strideAt(0), cK = c->strideAt(1), cT = c->strideAt(2);
+
+    const Nd4jLong numBlocks = (K + SRU_CHANNELS_BLOCK - 1) / SRU_CHANNELS_BLOCK;
+
+    // there's no recurrent GEMM, so every channel is an independent chain over time
+    auto func = PRAGMA_THREADS_FOR {
+        A cPrev[SRU_CHANNELS_BLOCK];
+
+        for (auto task = start; task < stop; task++) {
+            const Nd4jLong e  = task / numBlocks;
+            const Nd4jLong k0 = (task % numBlocks) * SRU_CHANNELS_BLOCK;
+            const Nd4jLong nK = sd::math::nd4j_min<Nd4jLong>(SRU_CHANNELS_BLOCK, K - k0);
+
+            for (Nd4jLong k = 0; k < nK; k++)
+                cPrev[k] = static_cast<A>(pC0[e * c0B + (k0 + k) * c0K]);
+
+            for (Nd4jLong t = 0; t < time; t++) {
+                const T* zRow = pZ + (t * bS + e) * 3 * K;
+
+                for (Nd4jLong k = 0; k < nK; k++) {
+                    const auto kk = k0 + k;
+                    const A f = sd::math::nd4j_sigmoid<A, A>(static_cast<A>(zRow[K + kk]) + bias[kk]);
+                    const A r = sd::math::nd4j_sigmoid<A, A>(static_cast<A>(zRow[2 * K + kk]) + bias[K + kk]);
+                    const A ct = f * cPrev[k] + (static_cast<A>(1) - f) * static_cast<A>(zRow[kk]);
+                    const A xt = static_cast<A>(pX[e * xB + kk * xK + t * xT]);
+
+                    pC[e * cB + kk * cK + t * cT] = static_cast<T>(ct);
+                    pH[e * hB + kk * hK + t * hT] = static_cast<T>(r * sd::math::nd4j_tanh<A, A>(ct) + (static_cast<A>(1) - r) * xt);
+                    cPrev[k] = ct;
+                }
+            }
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, bS * numBlocks);
+}
+
+//////////////////////////////////////////////////////////////////////////
+static bool sameFloatTypes(const sd::DataType type, const std::vector<const NDArray*>& arrays) {
+    if (!DataTypeUtils::isR(type))
+        return false;
+
+    for (auto arr : arrays)
+        if (arr != nullptr && arr->dataType() != type)
+            return false;
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+ND4J_LOCAL bool lstmLayerTimeLoopFused(const NDArray* x, const NDArray* Wx, const NDArray* Wr,
+                                       const NDArray* b, const NDArray* seqLen, const NDArray* hI, const NDArray* cI, const NDArray* Wp,
+                                       const std::vector<float>& params, const bool forward,
+                                       NDArray* h, NDArray* hL, NDArray* cL) {
+
+    if (!sameFloatTypes(x->dataType(), {Wx, Wr, b, hI, cI, Wp, h, hL, cL}))
+        return false;
+
+    BUILD_SINGLE_SELECTOR(x->dataType(), lstmLayerTimeLoopFused_, (x, Wx, Wr, b, seqLen, hI, cI, Wp, params, forward, h, hL, cL), FLOAT_TYPES);
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+ND4J_LOCAL bool gruTimeLoopFused(sd::LaunchContext * context, const NDArray* x, const NDArray* hI, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h) {
+
+    if (!sameFloatTypes(x->dataType(), {hI, Wx, Wh, b, h}))
+        return false;
+
+    BUILD_SINGLE_SELECTOR(x->dataType(), gruTimeLoopFused_, (x, hI, Wx, Wh, b, h), FLOAT_TYPES);
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+ND4J_LOCAL bool sruTimeLoopFused(sd::LaunchContext * context, const NDArray* x, const NDArray* c0, const NDArray* w, const NDArray* b, NDArray* h, NDArray* c) {
+
+    if (!sameFloatTypes(x->dataType(), {c0, w, b, h, c}))
+        return false;
+
+    BUILD_SINGLE_SELECTOR(x->dataType(), sruTimeLoopFused_, (x, c0, w, b, h, c), FLOAT_TYPES);
+    return true;
+}
+
+}
+}
+}
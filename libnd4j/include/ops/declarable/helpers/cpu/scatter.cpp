@@ -22,6 +22,7 @@
 
 #include <ops/declarable/helpers/scatter.h>
 #include <numeric>
+#include <algorithm>
 #include <helpers/ShapeUtils.h>
 #include <execution/Threads.h>
 
@@ -72,6 +73,52 @@ ND4J_LOCAL Nd4jLong checkIndices(sd::LaunchContext *context, const NDArray& indi
 }
 
 ///////////////////////////////////////////////////////////////////
+// Groups updates by destination: order gets update numbers sorted by key, in original order within the same key,
+// groups gets offsets of first update of every group within order, plus order size at the end.
+// Every group is applied by single thread, so duplicated indices are accumulated without locks, and in the same order as serial loop does
+static void groupByDestination(const std::vector<Nd4jLong>& keys, const Nd4jLong numKeys, std::vector<Nd4jLong>& order, std::vector<Nd4jLong>& groups) {
+
+    const Nd4jLong numUpd = keys.size();
+    order.resize(numUpd);
+    groups.clear();
+
+    bool inRange = true;
+    for (const auto key : keys)
+        inRange &= key >= 0 && key < numKeys;
+
+    if (inRange && numKeys <= 2 * numUpd + 1024) {
+        // counting sort: bucket offsets are exclusive scan of bucket sizes
+        std::vector<Nd4jLong> offsets(numKeys, 0);
+        for (const auto key : keys)
+            offsets[key]++;
+
+        for (Nd4jLong k = 0, pos = 0; k < numKeys; k++) {
+            if (offsets[k] > 0)
+                groups.emplace_back(pos);
+
+            const auto cnt = offsets[k];
+            offsets[k] = pos;
+            pos += cnt;
+        }
+
+        for (Nd4jLong i = 0; i < numUpd; i++)
+            order[offsets[keys[i]]++] = i;
+    }
+    else {
+        // few updates into large output, or invalid indices which are reported by sub-array creation later
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&keys](Nd4jLong a, Nd4jLong b) { return keys[a] < keys[b]; });
+
+        for (Nd4jLong i = 0; i < numUpd; i++)
+            if (i == 0 || keys[order[i]] != keys[order[i - 1]])
+                groups.emplace_back(i);
+    }
+
+    groups.emplace_back(numUpd);
+}
+
+///////////////////////////////////////////////////////////////////
+// lock isn't needed anymore: threads never share output rows, so results are the same for both values
 ND4J_LOCAL void scatter(sd::LaunchContext  *context, pairwise::Ops op, const NDArray& indices, const NDArray& updates, NDArray& output, const bool lock) {
 
     const int outRank = output.rankOf();
@@ -79,17 +126,30 @@ ND4J_LOCAL void scatter(sd::LaunchContext  *context, pairwise::Ops op, const NDA
     const int updRank = updates.rankOf();
     const Nd4jLong indLen = indices.lengthOf();
 
+    std::vector<Nd4jLong> keys(indLen);
+    auto funcKeys = PRAGMA_THREADS_FOR {
+        for (auto i = start; i < stop; i++)
+            keys[i] = indices.e<Nd4jLong>(i);
+    };
+
+    samediff::Threads::parallel_for(funcKeys, 0, indLen);
+
+    std::vector<Nd4jLong> order, groups;
+    groupByDestination(keys, output.sizeAt(0), order, groups);
+    const Nd4jLong numGroups = groups.size() - 1;
+
     if(outRank == 1) {
         auto func = PRAGMA_THREADS_FOR {
-            for (auto i = start; i < stop; i++) {
-                Nd4jLong idx = indices.e<Nd4jLong>(i);
+            for (auto g = start; g < stop; g++) {
+                Nd4jLong idx = keys[order[groups[g]]];
                 NDArray out = output({idx, idx + 1});
 
-                out.applyPairwiseTransform(op, updates.e(i));
+                for (auto u = groups[g]; u < groups[g + 1]; u++)
+                    out.applyPairwiseTransform(op, updates.e(order[u]));
             }
         };
 
-        samediff::Threads::parallel_tad(func, 0, indLen, 1, lock ? 1 : sd::Environment::getInstance().maxThreads());
+        samediff::Threads::parallel_tad(func, 0, numGroups);
     }
     else {      // outRank > 1
 
@@ -101,15 +161,17 @@ ND4J_LOCAL void scatter(sd::LaunchContext  *context, pairwise::Ops op, const NDA
         std::iota(dimsToExcludeUpd.begin(), dimsToExcludeUpd.end(), 0);
 
         auto func = PRAGMA_THREADS_FOR {
-            for (auto i = start; i < stop; i++) {
-                NDArray outSubArr = output(indices.e<Nd4jLong>(i), std::vector<int>({0}));
-                NDArray updSubArr = updates(i, dimsToExcludeUpd);
+            for (auto g = start; g < stop; g++) {
+                NDArray outSubArr = output(keys[order[groups[g]]], std::vector<int>({0}));
 
-                outSubArr.applyPairwiseTransform(op, updSubArr);
+                for (auto u = groups[g]; u < groups[g + 1]; u++) {
+                    NDArray updSubArr = updates(order[u], dimsToExcludeUpd);
+                    outSubArr.applyPairwiseTransform(op, updSubArr);
+                }
             }
         };
 
-        samediff::Threads::parallel_tad(func, 0, indLen, 1, lock ? 1 : sd::Environment::getInstance().maxThreads());
+        samediff::Threads::parallel_tad(func, 0, numGroups);
     }
 }
 
@@ -120,18 +182,45 @@ ND4J_LOCAL void scatterND(sd::LaunchContext  *context, pairwise::Ops op, const N
     const int outRank = output.rankOf();
     const int indRank = indices.rankOf();
     const Nd4jLong indLastDim = indices.sizeAt(-1);
+    const Nd4jLong numUpd = indLen / indLastDim;
+
+    // destination key is c-order index of sub-array within first indLastDim dimensions of output
+    Nd4jLong numKeys = 1;
+    for (int j = 0; j < indLastDim; j++)
+        numKeys *= output.sizeAt(j);
+
+    std::vector<Nd4jLong> keys(numUpd);
+    auto funcKeys = PRAGMA_THREADS_FOR {
+        for (auto i = start; i < stop; i++) {
+            Nd4jLong key = 0;
+            for (Nd4jLong j = 0; j < indLastDim && key >= 0; j++) {
+                const auto idx = indices.e<Nd4jLong>(i * indLastDim + j);
+                // update with invalid coordinates gets group of its own
+                key = idx < 0 || idx >= output.sizeAt(j) ? -(i + 1) : key * output.sizeAt(j) + idx;
+            }
+
+            keys[i] = key;
+        }
+    };
+
+    samediff::Threads::parallel_for(funcKeys, 0, numUpd);
+
+    std::vector<Nd4jLong> order, groups;
+    groupByDestination(keys, numKeys, order, groups);
+    const Nd4jLong numGroups = groups.size() - 1;
 
     if(outRank == 1) {
         auto func = PRAGMA_THREADS_FOR {
-            for (auto i = start; i < stop; i++) {
-                Nd4jLong idx = indices.e<Nd4jLong>(i);
+            for (auto g = start; g < stop; g++) {
+                Nd4jLong idx = indices.e<Nd4jLong>(order[groups[g]]);
                 NDArray out = output({idx, idx + 1});
 
-                out.applyPairwiseTransform(op, updates.e(i), nullptr);
+                for (auto u = groups[g]; u < groups[g + 1]; u++)
+                    out.applyPairwiseTransform(op, updates.e(order[u]), nullptr);
             }
         };
 
-        samediff::Threads::parallel_tad(func, 0, indLen, 1, lock ? 1 : sd::Environment::getInstance().maxThreads());
+        samediff::Threads::parallel_tad(func, 0, numGroups);
     }
     else {
         std::vector<int> dimsToExcludeInd = ShapeUtils::evalDimsToExclude(indRank, {indRank-1});
@@ -141,8 +230,8 @@ ND4J_LOCAL void scatterND(sd::LaunchContext  *context, pairwise::Ops op, const N
         auto func = PRAGMA_THREADS_FOR {
             std::vector<Nd4jLong> idxRangeOut(2*outRank, 0);
 
-            for (auto i = start; i < stop; i++) {
-                NDArray indSubArr = indices(i, dimsToExcludeInd);
+            for (auto g = start; g < stop; g++) {
+                NDArray indSubArr = indices(order[groups[g]], dimsToExcludeInd);
 
                 for (Nd4jLong j = 0; j < indLastDim; ++j) {
                     idxRangeOut[2 * j] = indSubArr.e<Nd4jLong>(j);
@@ -150,13 +239,15 @@ ND4J_LOCAL void scatterND(sd::LaunchContext  *context, pairwise::Ops op, const N
                 }
 
                 NDArray outSubArr = output(idxRangeOut);
-                NDArray updSubArr = updates(i, dimsToExcludeUpd);
 
-                outSubArr.applyPairwiseTransform(op, updSubArr);
+                for (auto u = groups[g]; u < groups[g + 1]; u++) {
+                    NDArray updSubArr = updates(order[u], dimsToExcludeUpd);
+                    outSubArr.applyPairwiseTransform(op, updSubArr);
+                }
             }
         };
 
-        samediff::Threads::parallel_tad(func, 0, indLen / indLastDim, 1, lock ? 1 : sd::Environment::getInstance().maxThreads());
+        samediff::Threads::parallel_tad(func, 0, numGroups);
     }
 }
 
@@ -25,6 +25,7 @@
 #include <ops/declarable/helpers/segment.h>
 #include <helpers/ShapeUtils.h>
 #include <execution/Threads.h>
+#include <helpers/OpenHashTable.h>
 #include <unordered_map>
 
 namespace sd {
@@ -348,29 +349,61 @@ namespace sd {
                 return true;
             }
 
+            // elements of every segment, gathered without per-element allocations:
+            // elements of segment classes[g] are positions[offsets[g]] ... positions[offsets[g + 1] - 1], in ascending order
+            struct SegmentGroups {
+                std::vector<Nd4jLong> classes;
+                std::vector<Nd4jLong> offsets;
+                std::vector<Nd4jLong> positions;
+
+                Nd4jLong numGroups() const { return classes.size(); }
+                Nd4jLong size(Nd4jLong g) const { return offsets[g + 1] - offsets[g]; }
+                Nd4jLong at(Nd4jLong g, Nd4jLong i) const { return positions[offsets[g] + i]; }
+            };
+
+            static SegmentGroups groupSegments(NDArray* indices) {
+                SegmentGroups result;
+                std::vector<Nd4jLong> counts;
+                std::vector<Nd4jLong> groups(indices->lengthOf());
+
+                groupByKey<Nd4jLong>(indices->lengthOf(), [&](Nd4jLong e) -> Nd4jLong {
+                    return indices->e<Nd4jLong>(e);
+                }, result.classes, groups.data(), counts);
+
+                result.offsets.resize(counts.size() + 1);
+                result.offsets[0] = 0;
+                for (size_t g = 0; g < counts.size(); g++)
+                    result.offsets[g + 1] = result.offsets[g] + counts[g];
+
+                std::vector<Nd4jLong> next(result.offsets.begin(), result.offsets.end() - 1);
+                result.positions.resize(indices->lengthOf());
+                for (Nd4jLong e = 0; e < indices->lengthOf(); e++)
+                    result.positions[next[groups[e]]++] = e;
+
+                return result;
+            }
+
             template <typename T>
             static void unsortedSegmentMaxFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
 
-                // if input is a vector: (as if in doc sample)
-                //int idx = static_cast<int>((*indices)(0.));
-                MAP_IMPL<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-                for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-                    idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-
-                //std::sort(idxs.begin(), idxs.end());
+                // every segment is reduced by single thread
+                auto idxs = groupSegments(indices);
 
                 if (input->isVector() || input->isScalar()) { // 1D case
                     T maxVal = DataTypeUtils::max<T>();
                     output->assign(-maxVal);
 
-                    for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                        T val = input->e<T>(fi->second.at(0));
-                        for (Nd4jLong idx = 1; idx < static_cast<Nd4jLong>(fi->second.size()); ++idx) {
-                            val = sd::math::nd4j_max(val, input->e<T>(fi->second.at(idx)));
+                    auto func = PRAGMA_THREADS_FOR {
+                        for (auto g = start; g < stop; g++) {
+                            T val = input->e<T>(idxs.at(g, 0));
+                            for (Nd4jLong idx = 1; idx < idxs.size(g); ++idx) {
+                                val = sd::math::nd4j_max(val, input->e<T>(idxs.at(g, idx)));
+                            }
+                            output->p(idxs.classes[g], val);
                         }
-                        output->p(fi->first, val);
-                    }
+                    };
+
+                    samediff::Threads::parallel_tad(func, 0, idxs.numGroups());
                 }
                 else {
                     auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
@@ -381,26 +414,22 @@ namespace sd {
                     T maxVal = DataTypeUtils::max<T>();
                     output->assign(-maxVal);
 
-                    for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                        auto outputT = listOfOutTensors.at(fi->first);
-                        outputT->assign(listOfTensors.at(fi->second.at(0)));
-                        for (Nd4jLong idx = 0; idx < listOfTensors.size(); ++idx) {
-                               if(idx >= fi->second.size() ||  fi->second.size() < 2 ||  fi->second.at(idx) >= listOfTensors.size()) {
-                                   continue;
-                            }
-
-                            auto maxT = listOfTensors.at(fi->second.at(idx));
-                            for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                                T val = sd::math::nd4j_max(maxT->e<T>(e), outputT->e<T>(e));
-
-                                outputT->p(e, val);
+                    auto func = PRAGMA_THREADS_FOR {
+                        for (auto g = start; g < stop; g++) {
+                            auto outputT = listOfOutTensors.at(idxs.classes[g]);
+                            outputT->assign(listOfTensors.at(idxs.at(g, 0)));
+                            for (Nd4jLong idx = 1; idx < idxs.size(g); ++idx) {
+                                auto maxT = listOfTensors.at(idxs.at(g, idx));
+                                for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
+                                    T val = sd::math::nd4j_max(maxT->e<T>(e), outputT->e<T>(e));
+
+                                    outputT->p(e, val);
+                                }
                             }
                         }
+                    };
 
-
-                    }
-
-
+                    samediff::Threads::parallel_tad(func, 0, idxs.numGroups());
                 }
             }
             ND4J_LOCAL void unsortedSegmentMaxFunctor(sd::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
@@ -410,27 +439,24 @@ namespace sd {
 
             template <typename T>
             static void unsortedSegmentMinFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-                // if input is a vector: (as if in doc sample)
-                //int idx = static_cast<int>((*indices)(0.));
-                MAP_IMPL<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-
-                for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-                    idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-                //std::sort(idxs.begin(), idxs.end());
+                auto idxs = groupSegments(indices);
 
                 if (input->isVector() || input->isScalar()) { // 1D case
                     T maxVal = DataTypeUtils::max<T>();
                     output->assign(maxVal);
 
-                    for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                        T val = input->t<T>(fi->second.at(0));
+                    auto func = PRAGMA_THREADS_FOR {
+                        for (auto g = start; g < stop; g++) {
+                            T val = input->t<T>(idxs.at(g, 0));
 
-                        for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                            val = sd::math::nd4j_min(val, input->t<T>(fi->second.at(idx)));
+                            for (Nd4jLong idx = 1; idx < idxs.size(g); ++idx) {
+                                val = sd::math::nd4j_min(val, input->t<T>(idxs.at(g, idx)));
+                            }
+                            output->r<T>(idxs.classes[g]) = val;
                         }
-                        output->r<T>(fi->first) = val;
-                    }
+                    };
+
+                    samediff::Threads::parallel_tad(func, 0, idxs.numGroups());
                 }
                 else {
                     auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
@@ -441,18 +467,21 @@ namespace sd {
                     T maxVal = DataTypeUtils::max<T>();
                     output->assign(maxVal);
 
-                    for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                        auto outputT = listOfOutTensors.at(fi->first);
-                        outputT->assign(listOfTensors.at(fi->second.at(0)));
-                        for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                            auto minT = listOfTensors.at(fi->second.at(idx));
-
-                            for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                                outputT->r<T>(e) = sd::math::nd4j_min(minT->t<T>(e), outputT->t<T>(e));
+                    auto func = PRAGMA_THREADS_FOR {
+                        for (auto g = start; g < stop; g++) {
+                            auto outputT = listOfOutTensors.at(idxs.classes[g]);
+                            outputT->assign(listOfTensors.at(idxs.at(g, 0)));
+                            for (Nd4jLong idx = 1; idx < idxs.size(g); ++idx) {
+                                auto minT = listOfTensors.at(idxs.at(g, idx));
+
+                                for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
+                                    outputT->r<T>(e) = sd::math::nd4j_min(minT->t<T>(e), outputT->t<T>(e));
+                                }
                             }
                         }
-                        //outputT->assign(maxT);
-                    }
+                    };
+
+                    samediff::Threads::parallel_tad(func, 0, idxs.numGroups());
                 }
 
             }
@@ -464,25 +493,22 @@ namespace sd {
             BUILD_SINGLE_TEMPLATE(template ND4J_LOCAL void unsortedSegmentMinFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
             ND4J_LOCAL void unsortedSegmentMeanFunctor(sd::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-                MAP_IMPL<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-                for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-                    idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-                //std::sort(idxs.begin(), idxs.end());
+                auto idxs = groupSegments(indices);
 
                 if (input->isVector() || input->isScalar()) { // 1D case
 
-                    for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                        double sumValue = input->e<double>(fi->second.at(0));
-                        int loop_size = fi->second.size();
+                    auto func = PRAGMA_THREADS_FOR {
+                        for (auto g = start; g < stop; g++) {
+                            double sumValue = input->e<double>(idxs.at(g, 0));
+                            for (Nd4jLong idx = 1; idx < idxs.size(g); ++idx) {
+                                sumValue += input->e<double>(idxs.at(g, idx));
+                            }
 
-                        // FIXME: parallelism here?
-                        for (size_t idx = 1; idx < loop_size; ++idx) {
-                            sumValue += input->e<double>(fi->second.at(idx));
+                            output->p(idxs.classes[g], sumValue / idxs.size(g));
                         }
+                    };
 
-                        output->p(fi->first, sumValue / fi->second.size());
-                    }
+                    samediff::Threads::parallel_tad(func, 0, idxs.numGroups());
                 }
                 else {
                     auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
@@ -490,38 +516,39 @@ namespace sd {
                     ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
                     ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
 
-                    // FIXME: parallelism here?
-                    for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                        auto outputT = listOfOutTensors.at(fi->first);
-                        outputT->assign(listOfTensors.at(fi->second.at(0)));
-                        Nd4jLong loopSize = fi->second.size();
+                    auto func = PRAGMA_THREADS_FOR {
+                        for (auto g = start; g < stop; g++) {
+                            auto outputT = listOfOutTensors.at(idxs.classes[g]);
+                            outputT->assign(listOfTensors.at(idxs.at(g, 0)));
 
-                        for (Nd4jLong idx = 1; idx < loopSize; ++idx) {
-                            auto current = listOfTensors.at(fi->second.at(idx));
-                            *outputT += *current;
+                            for (Nd4jLong idx = 1; idx < idxs.size(g); ++idx) {
+                                auto current = listOfTensors.at(idxs.at(g, idx));
+                                *outputT += *current;
+                            }
+                            (*outputT) /= double(idxs.size(g));
                         }
-                        (*outputT) /= double(fi->second.size());
-                    }
+                    };
+
+                    samediff::Threads::parallel_tad(func, 0, idxs.numGroups());
                 }
             }
 
             ND4J_LOCAL void unsortedSegmentSumFunctor(sd::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-                MAP_IMPL<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-                for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-                    idxs[indices->e<Nd4jLong>(e)].push_back(e);
+                auto idxs = groupSegments(indices);
 
                 if (input->isVector() || input->isScalar()) { // 1D case
 
-                    for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                        double sumValue = input->e<double>(fi->second.at(0));
-                        Nd4jLong loop_size = fi->second.size();
-
-                        // FIXME: parallelism here?
-                        for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                            sumValue += input->e<double>(fi->second.at(idx));
+                    auto func = PRAGMA_THREADS_FOR {
+                        for (auto g = start; g < stop; g++) {
+                            double sumValue = input->e<double>(idxs.at(g, 0));
+                            for (Nd4jLong idx = 1; idx < idxs.size(g); ++idx) {
+                                sumValue += input->e<double>(idxs.at(g, idx));
+                            }
+                            output->p(idxs.classes[g], sumValue);
                         }
-                        output->p(fi->first, sumValue);
-                    }
+                    };
+
+                    samediff::Threads::parallel_tad(func, 0, idxs.numGroups());
                 }
                 else {
                     auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
@@ -529,39 +556,40 @@ namespace sd {
                     ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
                     ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
 
-                    for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                        auto outputT = listOfOutTensors.at(fi->first);
-                        outputT->assign(listOfTensors.at(fi->second.at(0)));
-                        Nd4jLong loop_size = fi->second.size();
+                    auto func = PRAGMA_THREADS_FOR {
+                        for (auto g = start; g < stop; g++) {
+                            auto outputT = listOfOutTensors.at(idxs.classes[g]);
+                            outputT->assign(listOfTensors.at(idxs.at(g, 0)));
 
-                        // FIXME: parallelism here?
-                        for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                            auto current = listOfTensors.at(fi->second.at(idx));
-                            *(outputT) += *current;
+                            for (Nd4jLong idx = 1; idx < idxs.size(g); ++idx) {
+                                auto current = listOfTensors.at(idxs.at(g, idx));
+                                *(outputT) += *current;
+                            }
                         }
-                        //outputT->assign(maxT);
-                    }
+                    };
+
+                    samediff::Threads::parallel_tad(func, 0, idxs.numGroups());
                 }
             }
 
             template <typename T>
             ND4J_LOCAL void unsortedSegmentProdFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-                MAP_IMPL<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-                for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-                    idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-                //std::sort(idxs.begin(), idxs.end());
+                auto idxs = groupSegments(indices);
 
                 output->assign(1.f);
 
                 if (input->isVector() || input->isScalar()) { // 1D case
-                    for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                        T prodValue = input->e<T>(fi->second.at(0));
-                        for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                            prodValue *= input->e<T>(fi->second.at(idx));
+                    auto func = PRAGMA_THREADS_FOR {
+                        for (auto g = start; g < stop; g++) {
+                            T prodValue = input->e<T>(idxs.at(g, 0));
+                            for (Nd4jLong idx = 1; idx < idxs.size(g); ++idx) {
+                                prodValue *= input->e<T>(idxs.at(g, idx));
+                            }
+                            output->p(idxs.classes[g], prodValue);
                         }
-                        output->p(fi->first, prodValue);
-                    }
+                    };
+
+                    samediff::Threads::parallel_tad(func, 0, idxs.numGroups());
                 }
                 else {
                     auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
@@ -569,15 +597,19 @@ namespace sd {
                     ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
                     ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
 
-                    for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                        auto outputT = listOfOutTensors.at(fi->first);
-                        outputT->assign(listOfTensors.at(fi->second.at(0)));
-                        for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                            auto current = listOfTensors.at(fi->second.at(idx));
+                    auto func = PRAGMA_THREADS_FOR {
+                        for (auto g = start; g < stop; g++) {
+                            auto outputT = listOfOutTensors.at(idxs.classes[g]);
+                            outputT->assign(listOfTensors.at(idxs.at(g, 0)));
+                            for (Nd4jLong idx = 1; idx < idxs.size(g); ++idx) {
+                                auto current = listOfTensors.at(idxs.at(g, idx));
 
-                            *outputT *= *current;
+                                *outputT *= *current;
+                            }
                         }
-                    }
+                    };
+
+                    samediff::Threads::parallel_tad(func, 0, idxs.numGroups());
                 }
             }
 
@@ -587,20 +619,20 @@ namespace sd {
             BUILD_SINGLE_TEMPLATE(template ND4J_LOCAL void unsortedSegmentProdFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
             ND4J_LOCAL void unsortedSegmentSqrtNFunctor(sd::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-                MAP_IMPL<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-                for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-                    idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-                //std::sort(idxs.begin(), idxs.end());
+                auto idxs = groupSegments(indices);
 
                 if (input->isVector() || input->isScalar()) { // 1D case
-                    for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                        double sumValue = input->e<double>(fi->second.at(0));
-                        for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                            sumValue += input->e<double>(fi->second.at(idx));
+                    auto func = PRAGMA_THREADS_FOR {
+                        for (auto g = start; g < stop; g++) {
+                            double sumValue = input->e<double>(idxs.at(g, 0));
+                            for (Nd4jLong idx = 1; idx < idxs.size(g); ++idx) {
+                                sumValue += input->e<double>(idxs.at(g, idx));
+                            }
+                            output->p(idxs.classes[g], sumValue / sd::math::nd4j_sqrt<Nd4jLong, double>(idxs.size(g)));
                         }
-                        output->p(fi->first, sumValue / sd::math::nd4j_sqrt<Nd4jLong, double>(fi->second.size()));
-                    }
+                    };
+
+                    samediff::Threads::parallel_tad(func, 0, idxs.numGroups());
                 }
                 else {
                     auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
@@ -608,16 +640,19 @@ namespace sd {
                     ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
                     ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
 
-                    for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                        auto outputT = listOfOutTensors.at(fi->first);
-                        outputT->assign(listOfTensors.at(fi->second.at(0)));
-                        for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                            auto current = listOfTensors.at(fi->second.at(idx));
-                            *outputT += *current;
+                    auto func = PRAGMA_THREADS_FOR {
+                        for (auto g = start; g < stop; g++) {
+                            auto outputT = listOfOutTensors.at(idxs.classes[g]);
+                            outputT->assign(listOfTensors.at(idxs.at(g, 0)));
+                            for (Nd4jLong idx = 1; idx < idxs.size(g); ++idx) {
+                                auto current = listOfTensors.at(idxs.at(g, idx));
+                                *outputT += *current;
+                            }
+                            (*outputT) /= sd::math::nd4j_sqrt<Nd4jLong, double>(idxs.size(g));
                         }
-                        //outputT->assign(maxT);
-                        (*outputT) /= sd::math::nd4j_sqrt<size_t, double>(fi->second.size());
-                    }
+                    };
+
+                    samediff::Threads::parallel_tad(func, 0, idxs.numGroups());
                 }
             }
 
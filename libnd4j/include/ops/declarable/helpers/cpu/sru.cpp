@@ -90,6 +90,9 @@ ND4J_LOCAL void sruTimeLoop(sd::LaunchContext * context, const NDArray* x, const
     // h   cell outputs [bS x inSize x time]
     // c   cell states  [bS x inSize x time]
 
+    if(sruTimeLoopFused(context, x, c0, w, b, h, c))
+        return;
+
     auto wT = w->transpose();                             // [3*inSize x inSize] -> [inSize x 3*inSize]
 
     const int time  = x->sizeAt(2);
@@ -23,118 +23,173 @@
 #include <ops/declarable/helpers/top_k.h>
 #include <ops/declarable/headers/parity_ops.h>
 #include <array/NDArrayFactory.h>
+#include <helpers/ConstantTadHelper.h>
 #include <execution/Threads.h>
+#include <algorithm>
 
 namespace sd {
 namespace ops {
 namespace helpers {
 
+    // rows at least that wide are split between threads, if there are not enough rows to keep all threads busy
+    static const Nd4jLong TOP_K_WIDE_ROW = 65536;
+
+    // contiguous rows are scanned by blocks, and block is skipped at once if nothing in it beats current k-th value
+    static const Nd4jLong TOP_K_FILTER_BLOCK = 64;
+
+    // ordering of top_k output: greater values go first, equal values are ordered by their indices
     template <typename T>
-    static int topKFunctor_(const NDArray* input, NDArray* values, NDArray* indices, const uint k, bool needSort) {
-        Nd4jLong width = input->sizeAt(-1);
-        int lastDim = input->rankOf() - 1;
-// ----------------------------------------------------------------------------------------------- //
-// this assumption is right:
-//        if (values->lengthOf() != k * lastDimList->size()) {
-//            nd4j_printf("top_k: something is wrong. %i expected, but %i given.\n",
-//                values->lengthOf(), k * lastDimList->size());
-//        }
-// ----------------------------------------------------------------------------------------------- //
-        std::vector<int> dimsToExclude(input->rankOf() - 1);
-        for (size_t d = 0; d < dimsToExclude.size(); ++d)
-            dimsToExclude[d] = d;
-
-        const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(input->shapeInfo(), dimsToExclude);
-
-            if (k == 1) {
-                for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
-                    auto trial = (*input)(e, dimsToExclude);
-                    //int maxPos = //lastDimList->at(e)->argMax();
-                    Nd4jLong maxPos = 0;
-                    //trial.printIndexedBuffer("TRIAL:");
-                    T maxVal = trial.e<T>(0);
-                    for (Nd4jLong pos = 1; pos < trial.lengthOf(); pos++)
-                        if (maxVal < trial.e<T>(pos)) {
-                            maxPos = pos;
-                            maxVal = trial.e<T>(pos);
-                        }
-                    if (indices)
-                        indices->p(e, maxPos); //topIndex;
-                    if (values)
-                        values->p(e, maxVal);
-                }
+    static FORCEINLINE bool topKBefore(const std::pair<T, Nd4jLong>& a, const std::pair<T, Nd4jLong>& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    }
+
+    // collects top k elements of x[start, stop) into heap, the weakest candidate is kept at the heap front
+    template <typename T>
+    static void topKScan(const T* x, const Nd4jLong xEws, const Nd4jLong start, const Nd4jLong stop, const uint k, std::vector<std::pair<T, Nd4jLong>>& heap) {
+        heap.clear();
+
+        auto i = start;
+        for (; i < stop && heap.size() < k; i++)
+            heap.emplace_back(x[i * xEws], i);
+
+        std::make_heap(heap.begin(), heap.end(), topKBefore<T>);
+
+        if (heap.empty())
+            return;
+
+        // indices grow along the scan, so candidate has to be strictly greater than the weakest one
+        auto threshold = heap.front().first;
+        auto replace = [&](const Nd4jLong j, const T value) {
+            std::pop_heap(heap.begin(), heap.end(), topKBefore<T>);
+            heap.back() = std::make_pair(value, j);
+            std::push_heap(heap.begin(), heap.end(), topKBefore<T>);
+            threshold = heap.front().first;
+        };
+
+        if (xEws == 1) {
+            for (; i < stop; i += TOP_K_FILTER_BLOCK) {
+                const auto end = sd::math::nd4j_min<Nd4jLong>(i + TOP_K_FILTER_BLOCK, stop);
+
+                int hits = 0;
+                PRAGMA_OMP_SIMD
+                for (auto j = i; j < end; j++)
+                    hits += x[j] > threshold ? 1 : 0;
+
+                if (hits == 0)
+                    continue;
+
+                for (auto j = i; j < end; j++)
+                    if (x[j] > threshold)
+                        replace(j, x[j]);
             }
-            else {
-                int nextPos = 0;
-
-                for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
-                    auto trial = (*input)(e, dimsToExclude);
-
-                    // fill up the first k elements
-                    NDArray topValues = NDArrayFactory::create<T>('c', {k}, input->getContext());
-                    NDArray sortedVals = NDArrayFactory::create<T>('c', {k}, input->getContext());
-                    NDArray topIndices = NDArrayFactory::create<Nd4jLong>('c', {k}, input->getContext());
-                    for (uint pos = 0; pos < k; ++pos) {
-                        topIndices.r<Nd4jLong>(pos) = pos;
-                        topValues.r<T>(pos) = trial.t<T>(pos);
-                    }
-                    //std::vector<T> sortedVals(topValues);
-                    sortedVals.assign(topValues);// = NDArrayFactory::create<T>('c', {k});
-                    //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-                    SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
-                    for (Nd4jLong i = static_cast<Nd4jLong>(k); i < width; ++i) {
-                        T val = trial.e<T>(i);
-                        T minTopVal = sortedVals.t<T>(0);
-                        if (minTopVal < val) { // value should be inserted to top k
-                            // only if it is not contained in
-                            T* begin = reinterpret_cast<T*>(sortedVals.buffer());
-                            T* end = begin + k;
-                            bool exists = std::binary_search(begin, end, val);
-                            if (!exists) {
-                                //exchangePos - a distance between begin and minimal existed to be suppressed by val
-                                T* topBegin = reinterpret_cast<T*>(topValues.buffer());
-                                T* topEnd = topBegin + k;
-                                auto exchangePos = std::distance(topBegin, std::find(topBegin, topEnd, sortedVals.t<T>(0)));
-                                topValues.r<T>(exchangePos) = val; //*exchangeIt = val;
-                                topIndices.r<Nd4jLong>(exchangePos) = i;
-                                sortedVals.r<T>(0) = val; // suppress in sorted
-                                //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-                                SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
-                            }
-                        }
-                    }
-                    if (needSort) {
-                        SpecialMethods<T>::sortGeneric(topValues.buffer(), topValues.shapeInfo(), true);
+        }
+        else {
+            for (; i < stop; i++) {
+                const T value = x[i * xEws];
+                if (value > threshold)
+                    replace(i, value);
+            }
+        }
+    }
 
-                        for (Nd4jLong j = 0; j < width; j++)
-                            for (uint pos = 0; pos < k; ++pos)
-                                if (topValues.t<T>(pos) == trial.t<T>(j))
-                                    topIndices.r<Nd4jLong>(pos) = j;
-                    }
-                    else { // else sort by indices
-                        std::map<Nd4jLong, T> sortValsMap;
-                        //std::vector<std::pair<int, T>> data(topValues.lengthOf());
-                        for (Nd4jLong e = 0; e < topValues.lengthOf(); ++e) {
-                            sortValsMap[topIndices.t<Nd4jLong>(e)] = topValues.t<T>(e);
-                        }
+    template <typename T, typename I>
+    static void topKStore(std::vector<std::pair<T, Nd4jLong>>& top, const bool needSort, T* z, const Nd4jLong zEws, I* zI, const Nd4jLong iEws) {
+        if (needSort)
+            std::sort(top.begin(), top.end(), topKBefore<T>);
+        else
+            std::sort(top.begin(), top.end(), [](const std::pair<T, Nd4jLong>& a, const std::pair<T, Nd4jLong>& b) { return a.second < b.second; });
+
+        for (size_t pos = 0; pos < top.size(); ++pos) {
+            if (z != nullptr)
+                z[pos * zEws] = top[pos].first;
+            if (zI != nullptr)
+                zI[pos * iEws] = static_cast<I>(top[pos].second);
+        }
+    }
 
-                        //std::sort(data.begin(), data.end(), [](std::pair<int, T> const& a, std::pair<int, T> const& b) {
-                        //    return a.first < b.first;
-                        //});
-                        Nd4jLong e = 0;
-                        for (auto it = sortValsMap.begin(); it != sortValsMap.end(); ++it, e++) {
-                            topIndices.r<Nd4jLong>(e) = it->first;
-                            topValues.r<T>(e) = it->second;
-                        }
+    template <typename T>
+    static int topKFunctor_(const NDArray* input, NDArray* values, NDArray* indices, const uint k, bool needSort) {
+        const Nd4jLong width = input->sizeAt(-1);
+        const int lastDim = input->rankOf() - 1;
+
+        auto packX = ConstantTadHelper::getInstance().tadForDimensions(input->shapeInfo(), lastDim);
+        const Nd4jLong numOfSubArrs = packX.numberOfTads();
+
+        const auto x = input->bufferAsT<T>();
+        const auto xEws = input->strideAt(lastDim);
+
+        TadPack packZ, packI;
+        T* z = nullptr;
+        Nd4jLong zEws = 0, iEws = 0;
+        if (values != nullptr) {
+            packZ = ConstantTadHelper::getInstance().tadForDimensions(values->shapeInfo(), lastDim);
+            z = values->bufferAsT<T>();
+            zEws = values->strideAt(lastDim);
+        }
 
-                    }
-                    if (values)
-                    (*values)(e, dimsToExclude).assign(topValues);
-                    if (indices)
-                    (*indices)(e, dimsToExclude).assign(topIndices);
-                }
-                //indices->printIndexedBuffer("Indices as is");
+        // indices are either INT32 or INT64
+        int* zI32 = nullptr;
+        Nd4jLong* zI64 = nullptr;
+        if (indices != nullptr) {
+            packI = ConstantTadHelper::getInstance().tadForDimensions(indices->shapeInfo(), lastDim);
+            if (indices->dataType() == sd::DataType::INT32)
+                zI32 = indices->bufferAsT<int>();
+            else
+                zI64 = indices->bufferAsT<Nd4jLong>();
+            iEws = indices->strideAt(lastDim);
+        }
+
+        auto store = [&](const Nd4jLong e, std::vector<std::pair<T, Nd4jLong>>& top) {
+            auto zRow = z != nullptr ? z + packZ.primaryOffsets()[e] : nullptr;
+            if (zI32 != nullptr)
+                topKStore<T, int>(top, needSort, zRow, zEws, zI32 + packI.primaryOffsets()[e], iEws);
+            else
+                topKStore<T, Nd4jLong>(top, needSort, zRow, zEws, zI64 != nullptr ? zI64 + packI.primaryOffsets()[e] : nullptr, iEws);
+        };
+
+        // few very wide rows: every thread collects partial top k of its own part of the row, and partial results are merged
+        const Nd4jLong numThreads = sd::Environment::getInstance().maxMasterThreads();
+        const Nd4jLong numChunks = sd::math::nd4j_min<Nd4jLong>(numThreads, width / sd::math::nd4j_max<Nd4jLong>(TOP_K_WIDE_ROW / 4, 8 * k));
+
+        if (numOfSubArrs < numThreads && width >= TOP_K_WIDE_ROW && numChunks > 1) {
+            std::vector<std::vector<std::pair<T, Nd4jLong>>> partial(numChunks);
+            std::vector<std::pair<T, Nd4jLong>> top;
+
+            for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
+                const auto xRow = x + packX.primaryOffsets()[e];
+
+                auto func = PRAGMA_THREADS_FOR {
+                    for (auto c = start; c < stop; c++)
+                        topKScan<T>(xRow, xEws, c * width / numChunks, (c + 1) * width / numChunks, k, partial[c]);
+                };
+
+                samediff::Threads::parallel_for(func, 0, numChunks);
+
+                top.clear();
+                for (const auto& p : partial)
+                    top.insert(top.end(), p.begin(), p.end());
+
+                std::nth_element(top.begin(), top.begin() + (k - 1), top.end(), topKBefore<T>);
+                top.resize(k);
+
+                store(e, top);
+            }
+
+            return Status::OK();
         }
+
+        auto func = PRAGMA_THREADS_FOR {
+            std::vector<std::pair<T, Nd4jLong>> top;
+            top.reserve(k);
+
+            for (auto e = start; e < stop; e++) {
+                topKScan<T>(x + packX.primaryOffsets()[e], xEws, 0, width, k, top);
+                store(e, top);
+            }
+        };
+
+        samediff::Threads::parallel_tad(func, 0, numOfSubArrs);
+
         return Status::OK();
     }
 // ----------------------------------------------------------------------------------------------- //
@@ -132,6 +132,8 @@ namespace sd {
                     std::vector<const Nd4jLong *> tadShapes(outSize);
                     std::vector<const Nd4jLong *> tadOffsets(outSize);
                     std::vector<Nd4jLong> numTads(outSize);
+                    // packs are kept alive till kernel is done with their pointers
+                    std::vector<TadPack> packsZ(outSize);
                     // fill up dimensions array for before kernel
                     for (unsigned int i = 0; i < outSize; i++) {
                         outputs[i].first = outputList[i];
@@ -142,11 +144,11 @@ namespace sd {
                         for (int k = 1; k < r; k++)
                             outDims[k - 1] = k;
 
-                        auto packZ = ConstantTadHelper::getInstance().tadForDimensions(outputList.at(i)->shapeInfo(), outDims);
+                        packsZ[i] = ConstantTadHelper::getInstance().tadForDimensions(outputList.at(i)->shapeInfo(), outDims);
 
                         outBuffers[i] = outputList.at(i)->specialBuffer();
-                        tadShapes[i] = packZ.platformShapeInfo();
-                        tadOffsets[i] = packZ.platformOffsets();
+                        tadShapes[i] = packsZ[i].platformShapeInfo();
+                        tadOffsets[i] = packsZ[i].platformOffsets();
                     }
 
                     // we copy pointers to device
@@ -269,6 +271,8 @@ namespace sd {
                     std::vector<const void *> inputBuffers(inputSize);
                     std::vector<const Nd4jLong *> inputTadShapes(inputSize);
                     std::vector<const Nd4jLong *> inputTadOffsets(inputSize);
+                    // packs are kept alive till kernel is done with their pointers
+                    std::vector<TadPack> packsX(inputSize);
 
                     std::vector<const void *> indicesBuffers(inputSize);
                     std::vector<const Nd4jLong *> indicesShapes(inputSize);
@@ -278,14 +282,14 @@ namespace sd {
                         for (int i = sourceDims.size(); i > 0;  i--)
                             sourceDims[sourceDims.size() - i] = inputs[e]->rankOf() - i;
 
-                        auto packX = ConstantTadHelper::getInstance().tadForDimensions(inputs[e]->shapeInfo(), sourceDims);
+                        packsX[e] = ConstantTadHelper::getInstance().tadForDimensions(inputs[e]->shapeInfo(), sourceDims);
 
                         indicesBuffers[e] = indices[e]->specialBuffer();
                         indicesShapes[e] = indices[e]->specialShapeInfo();
 
                         inputBuffers[e] = inputs[e]->specialBuffer();
-                        inputTadShapes[e] = packX.platformShapeInfo();
-                        inputTadOffsets[e] = packX.platformOffsets();
+                        inputTadShapes[e] = packsX[e].platformShapeInfo();
+                        inputTadOffsets[e] = packsX[e].platformOffsets();
                     }
 
                     // copying pointers to buffers to device
@@ -98,6 +98,8 @@ namespace helpers {
         std::vector<const Nd4jLong *> hOutTadOffsets(rank);
 
         std::vector<Nd4jLong> hNumTads(rank);
+        // packs are kept alive till kernel is done with their pointers
+        std::vector<TadPack> packs(rank);
 
         for(int i = 0; i < rank; ++i) {
             hInBuffers[i] = inArrs[i]->specialBuffer();
@@ -106,10 +108,10 @@ namespace helpers {
             hOutBuffers[i] = outArrs[i]->specialBuffer();
 
 
-            auto pack = ConstantTadHelper::getInstance().tadForDimensions(outArrs[i]->shapeInfo(), {inIndices[i]});
-            hOutTadShapes[i] = pack.specialShapeInfo();
-            hOutTadOffsets[i] = pack.specialOffsets();
-            hNumTads[i] = pack.numberOfTads();
+            packs[i] = ConstantTadHelper::getInstance().tadForDimensions(outArrs[i]->shapeInfo(), {inIndices[i]});
+            hOutTadShapes[i] = packs[i].specialShapeInfo();
+            hOutTadOffsets[i] = packs[i].specialOffsets();
+            hNumTads[i] = packs[i].numberOfTads();
 
 
             //auto list = outArrs[i]->allTensorsAlongDimension({inIndices[i]});
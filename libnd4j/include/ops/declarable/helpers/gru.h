@@ -38,6 +38,9 @@ namespace helpers {
 
 	void gruTimeLoop(sd::LaunchContext * context, const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h);
 
+	// CPU only: fused version of gruTimeLoop, returns false for mixed data types
+	bool gruTimeLoopFused(sd::LaunchContext * context, const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h);
+
 	void gruCellBp(sd::LaunchContext* context,
               		const NDArray* x,    const NDArray* hLast,
               		const NDArray* W,    const NDArray* Wc,        const NDArray* b,    const NDArray* bc,
@@ -161,6 +161,11 @@ ND4J_LOCAL void gruTimeLoop(sd::LaunchContext * context, const NDArray* x, const
 
     // h  cell outputs at each time step [sL, bS, nOut]
 
+#ifndef __CUDABLAS__
+    if(gruTimeLoopFused(context, x, hI, Wx, Wh, b, h))
+        return;
+#endif
+
     const int sL   = x->sizeAt(0);
     const int bS   = x->sizeAt(1);
     const int nOut = hI->sizeAt(1);
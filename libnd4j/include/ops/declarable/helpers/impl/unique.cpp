@@ -24,25 +24,33 @@
 #include <graph/Status.h>
 #include <execution/Threads.h>
 #include <graph/Variable.h>
+#include <helpers/OpenHashTable.h>
 
 namespace sd {
 namespace ops {
 namespace helpers {
 
+    // groups elements of input by value, distinct values are ordered by their first appearance
     template <typename T>
-    static Nd4jLong uniqueCount_(NDArray* input) {
-        Nd4jLong count = 0;
+    static void uniqueGroups_(NDArray* input, std::vector<T>& values, Nd4jLong* groups, std::vector<Nd4jLong>& counts) {
+        const auto x = input->bufferAsT<T>();
+        const auto xShapeInfo = input->shapeInfo();
+        const bool linear = input->ordering() == 'c' && input->ews() == 1;
+
+        groupByKey<T>(input->lengthOf(), [&](Nd4jLong e) -> T {
+            return x[linear ? e : shape::getIndexOffset(e, xShapeInfo)];
+        }, values, groups, counts);
+    }
 
+    template <typename T>
+    static Nd4jLong uniqueCount_(NDArray* input) {
         std::vector<T> values;
+        std::vector<Nd4jLong> counts;
+        std::vector<Nd4jLong> groups(input->lengthOf());
 
-        for (Nd4jLong e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(values.begin(), values.end(), v) == values.end()) {
-                values.push_back(v);
-                count++;
-            }
-        }
-        return count;
+        uniqueGroups_<T>(input, values, groups.data(), counts);
+
+        return values.size();
     }
 
     ND4J_LOCAL Nd4jLong uniqueCount(sd::LaunchContext * context, NDArray* input) {
@@ -53,37 +61,27 @@ namespace helpers {
 
     template <typename T>
     static Nd4jStatus uniqueFunctor_(NDArray* input, NDArray* values, NDArray* indices, NDArray* counts) {
-    
+
         std::vector<T> valuesVector;
-        MAP_IMPL<T, int> indicesMap;
-        MAP_IMPL<T, int> countsMap;
-
-        for (Nd4jLong e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(valuesVector.begin(), valuesVector.end(), v) == valuesVector.end()) {
-                valuesVector.push_back(v);
-                indicesMap[v] = e;
-                countsMap[v] = 1;
-            }
-            else {
-                countsMap[v]++;
-            }
-        }
+        std::vector<Nd4jLong> countsVector;
+        std::vector<Nd4jLong> groups(input->lengthOf());
+
+        uniqueGroups_<T>(input, valuesVector, groups.data(), countsVector);
 
         auto func = PRAGMA_THREADS_FOR {
             for (auto e = start; e < stop; e++) {
                 values->p(e, static_cast<T>(valuesVector[e]));
                 if (counts != nullptr)
-                    counts->p(e, countsMap[valuesVector[e]]);
+                    counts->p(e, countsVector[e]);
             }
         };
         samediff::Threads::parallel_for(func, 0, values->lengthOf());
 
-        for (Nd4jLong e = 0; e < indices->lengthOf(); e++) {
-            auto posI = std::find(valuesVector.begin(), valuesVector.end(), input->e<T>(e));
-            auto dist = std::distance(valuesVector.begin(), posI);
-            indices->p(e, Nd4jLong(dist));//indicesMap[(*input)(e)];
-        }
+        auto funcIndices = PRAGMA_THREADS_FOR {
+            for (auto e = start; e < stop; e++)
+                indices->p(e, groups[e]);
+        };
+        samediff::Threads::parallel_for(funcIndices, 0, indices->lengthOf());
 
         return Status::OK();
     }
@@ -21,36 +21,28 @@
 //
 
 #include <ops/declarable/helpers/where.h>
-#include <array/NDArrayList.h>
+#include <helpers/PrefixScan.h>
 
 namespace sd {
     namespace ops {
         namespace helpers {
             template <typename T>
             static void __where(NDArray &condition, NDArray& output, memory::Workspace *workspace) {
-                NDArrayList list(0, true);
-                int cnt = 0;
-
-                int idx[MAX_RANK];
-
-                for (Nd4jLong e = 0; e < condition.lengthOf(); e++) {
-
+                const int rank = condition.rankOf();
+                auto z = output.bufferAsT<T>();
+                const auto zRowStride = output.rankOf() == 2 ? output.strideAt(0) : 0;
+                const auto zColStride = output.rankOf() == 2 ? output.strideAt(1) : 0;
+
+                // coordinates of true elements are written straight into their rows of output
+                PrefixScan::compact(condition.lengthOf(), [&](Nd4jLong e) -> bool {
+                    return condition.e<bool>(e);
+                }, [&](Nd4jLong row, Nd4jLong e) {
+                    int idx[MAX_RANK];
                     shape::index2coordsCPU(0, e, condition.shapeInfo(), idx);
 
-                    auto offset = shape::getOffset(condition.shapeInfo(), idx);
-
-                    if (condition.e<bool>(offset)) {
-                        auto array = NDArrayFactory::create_('c', {1, condition.rankOf()}, output.dataType(), output.getContext());
-                        for (int f = 0; f < condition.rankOf(); f++)
-                            array->p(f, (T) idx[f]);
-
-                        list.write(cnt++, array);
-                    }
-                }
-
-                auto s = list.stack();
-                output.assign(s);
-                delete s;
+                    for (int f = 0; f < rank; f++)
+                        z[row * zRowStride + f * zColStride] = (T) idx[f];
+                });
             }
             BUILD_SINGLE_TEMPLATE(template ND4J_LOCAL void __where,(NDArray &condition, NDArray& output, memory::Workspace *workspace), LIBND4J_TYPES);
 
@@ -56,6 +56,15 @@ void ND4J_EXPORT lstmLayerTimeLoop(const NDArray* x, const NDArray* Wx, const ND
                         const bool forward,
                         NDArray* h, NDArray* hL, NDArray* cL);
 
+//////////////////////////////////////////////////////////////////////////
+// CPU only: same as lstmLayerTimeLoop, but x × Wx is computed for all time steps by one GEMM, per-step buffers are allocated once,
+// and gates with cell update are evaluated in one pass. Returns false, without computing anything, for mixed data types
+bool lstmLayerTimeLoopFused(const NDArray* x, const NDArray* Wx, const NDArray* Wr,
+                        const NDArray* b, const NDArray* seqLen, const NDArray* hI, const NDArray* cI, const NDArray* Wp,
+                        const std::vector<float>& params,
+                        const bool forward,
+                        NDArray* h, NDArray* hL, NDArray* cL);
+
 //////////////////////////////////////////////////////////////////////////
 void ND4J_EXPORT lstmLayerTimeLoopBp(const NDArray* x, const NDArray* Wx, const NDArray* Wr,
                         const NDArray* b, const NDArray* seqLen, NDArray* hI, NDArray* cI, const NDArray* Wp,
@@ -0,0 +1,47 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_NORMALIZATION_H
+#define LIBND4J_NORMALIZATION_H
+
+#include <ops/declarable/helpers/helpers.h>
+
+namespace sd    {
+namespace ops     {
+namespace helpers {
+
+//////////////////////////////////////////////////////////////////////////
+// CPU only: standardization along axis with optional gain and bias given along dimension dimC:
+// output = (input - mean) / stdev * gain + bias. Statistics of every TAD are evaluated in one pass, output is written in second one.
+// Returns false, without computing anything, for mixed data types
+bool ND4J_EXPORT standardizeFused(const NDArray& input, const std::vector<int>& axis, const NDArray* gain, const NDArray* bias, const int dimC, NDArray& output);
+
+//////////////////////////////////////////////////////////////////////////
+// CPU only: backprop of standardizeFused, gradG and gradB are optional and only evaluated if gain is given
+bool ND4J_EXPORT standardizeBpFused(const NDArray& input, const NDArray& gradO, const std::vector<int>& axis, const NDArray* gain, const int dimC,
+                                    NDArray& gradI, NDArray* gradG, NDArray* gradB);
+
+//////////////////////////////////////////////////////////////////////////
+// CPU only: mean and population variance along axis in one pass over input
+bool ND4J_EXPORT momentsFused(const NDArray& input, const std::vector<int>& axis, NDArray& mean, NDArray& variance);
+
+}
+}
+}
+
+#endif //LIBND4J_NORMALIZATION_H
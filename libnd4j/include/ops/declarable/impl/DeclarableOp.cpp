@@ -86,6 +86,10 @@ namespace sd {
                 delete _scalar;
         }
 
+        ShapeFunctionCache& DeclarableOp::shapeFunctionCache() {
+            return _shapeFunctionCache;
+        }
+
         OpDescriptor* DeclarableOp::getOpDescriptor() {
             return _descriptor;
         }
@@ -233,6 +237,8 @@ namespace sd {
                     inputStart = std::chrono::system_clock::now();
 
                 int cntIn = 0;
+                // shapes of list inputs aren't known, so such calls can't be cached
+                bool onlyArrays = true;
                 // we build list of input shapes
                 if (fp) {
                     for (const auto p:ctx.fastpath_in()) {
@@ -254,6 +260,7 @@ namespace sd {
                                 ctx.setInputArray(arrCnt++, array);
                         } else {
                             canUseFastPath = false;
+                            onlyArrays = false;
                         }
                         cntIn++;
                     }
@@ -277,7 +284,31 @@ namespace sd {
                     shapeStart = std::chrono::system_clock::now();
                 }
 
-                auto outSha = this->calculateOutputShape(&inSha, ctx);
+                // repeated executions with the same input shapes and arguments take output shapes from cache
+                const bool cacheable = onlyArrays && _shapeFunctionCache.isApplicable();
+                std::shared_ptr<ShapeFunctionCache::Entry> cached;
+                ShapeFunctionCache::Key key;
+                if (cacheable) {
+                    key = ShapeFunctionCache::key(inSha, ctx);
+                    cached = _shapeFunctionCache.get(key);
+                }
+
+                ShapeList *outSha = nullptr;
+                if (cached != nullptr) {
+                    outSha = cached->shapeList();
+                } else {
+                    DataBuffer::resetAccessed();
+                    outSha = this->calculateOutputShape(&inSha, ctx);
+
+                    // shape function that reads values of input arrays (not only their shapes or dtypes) is never cached
+                    if (cacheable) {
+                        if (DataBuffer::wasAccessed())
+                            _shapeFunctionCache.markDataDependent();
+                        else
+                            _shapeFunctionCache.put(key, *outSha);
+                    }
+                }
+
                 results = outSha->size();
 
                 // optionally saving shapeTime
@@ -285,6 +316,8 @@ namespace sd {
                     shapeEnd = std::chrono::system_clock::now();
                     auto prepTime = std::chrono::duration_cast<std::chrono::nanoseconds>(shapeEnd - shapeStart).count();
                     node->setShapeFunctionTime(prepTime);
+                    if (cacheable)
+                        node->addShapeCacheLookup(cached != nullptr);
 
                     // saving output shapes in profile
                     for (int e = 0; e < outSha->size(); e++)
@@ -316,6 +349,18 @@ namespace sd {
                             auto var = ctx.variable(pair);
                             auto shape = var->getNDArray()->shapeInfo();
 
+                            // arena view was planned for another shape (i.e. data-dependent output), so we fall back to dynamic allocation
+                            if (var->isPlanned() && (!shape::equalsSoft(out, shape) || shape::isEmpty(out) != shape::isEmpty(shape) || ArrayOptions::dataType(out) != ArrayOptions::dataType(shape))) {
+                                auto outArr = new NDArray(out, true, ctx.launchContext(), false);
+
+                                delete var->getNDArray();
+                                var->setNDArray(outArr);
+                                var->markRemovable(true);
+                                var->markPlanned(false);
+
+                                shape = outArr->shapeInfo();
+                            }
+
                             if (canUseFastPath)
                                 ctx.setOutputArray(pair.second, var->getNDArray());
 
@@ -0,0 +1,154 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/FusedElementwiseOp.h>
+#include <array/NDArrayFactory.h>
+#include <helpers/ShapeUtils.h>
+#include <legacy/NativeOpExecutioner.h>
+#include <helpers/PointersManager.h>
+
+namespace sd {
+    namespace ops {
+        FusedElementwiseOp::FusedElementwiseOp(const std::vector<FusedStep> &program) : DeclarableOp::DeclarableOp(-1, 1, "fused_elementwise", false, -1, 0) {
+            _program = program;
+        }
+
+        FusedElementwiseOp* FusedElementwiseOp::build(const std::vector<FusedStep> &program) {
+            static std::map<std::string, FusedElementwiseOp*> ops;
+            static std::mutex lock;
+
+            std::string key;
+            for (const auto &step : program)
+                key += std::to_string((int) step.kind) + ":" + std::to_string(step.opNum) + ";";
+
+            std::lock_guard<std::mutex> guard(lock);
+
+            auto it = ops.find(key);
+            if (it != ops.end())
+                return it->second;
+
+            auto op = new FusedElementwiseOp(program);
+            ops[key] = op;
+
+            return op;
+        }
+
+        const std::vector<FusedStep>& FusedElementwiseOp::program() const {
+            return _program;
+        }
+
+        Nd4jStatus FusedElementwiseOp::validateAndExecute(Context &block) {
+            auto x = INPUT_VARIABLE(0);
+            auto z = OUTPUT_VARIABLE(0);
+
+            int numPairwise = 0;
+            int numScalars = 0;
+            for (const auto &step : _program) {
+                if (step.kind == FusedStep::PAIRWISE)
+                    numPairwise++;
+                else if (step.kind == FusedStep::SCALAR)
+                    numScalars++;
+            }
+
+            REQUIRE_TRUE((int) block.width() == numPairwise + 1, 0, "Node_%i: fused_elementwise expects %i inputs, but got %i", block.getNodeId(), numPairwise + 1, (int) block.width());
+            REQUIRE_TRUE((int) block.getTArguments()->size() == numScalars, 0, "Node_%i: fused_elementwise expects %i scalars, but got %i", block.getNodeId(), numScalars, (int) block.getTArguments()->size());
+
+            std::vector<FusedStep> program(_program);
+            std::vector<const NDArray*> inputs({x});
+
+            // binding operands
+            bool sameTypes = x->dataType() == z->dataType() && z->isR();
+            int p = 1, s = 0;
+            for (auto &step : program) {
+                if (step.kind == FusedStep::PAIRWISE) {
+                    auto y = INPUT_VARIABLE(p++);
+                    REQUIRE_TRUE(x->isSameShape(y) || y->isScalar(), 0, "Node_%i: For Pairwise transforms shapes of both operands should be equal but got %s vs %s", block.getNodeId(), ShapeUtils::shapeAsString(x).c_str(), ShapeUtils::shapeAsString(y).c_str());
+
+                    step.y = y->buffer();
+                    step.yShapeInfo = y->shapeInfo();
+
+                    // operand sharing memory with z would be overwritten before it's read
+                    sameTypes &= y->dataType() == z->dataType() && (y->isScalar() || y->buffer() != z->buffer());
+                    inputs.emplace_back(y);
+                } else if (step.kind == FusedStep::SCALAR) {
+                    step.scalar = T_ARG(s++);
+                }
+            }
+
+            if (z->isEmpty())
+                return Status::OK();
+
+#ifndef __CUDABLAS__
+            if (sameTypes) {
+                BUILD_SINGLE_SELECTOR(z->dataType(), FusedLoops, ::execProgram(program, x->buffer(), x->shapeInfo(), z->buffer(), z->shapeInfo()), FLOAT_TYPES);
+
+                STORE_RESULT(*z);
+                return Status::OK();
+            }
+#endif
+
+            // generic path: ops are applied one by one, z holds intermediate results
+            NDArray::prepareSpecialUse({z}, inputs);
+            PointersManager manager(block.launchContext(), "FusedElementwiseOp");
+
+            int pairwise = 1;
+            for (int e = 0; e < (int) program.size(); e++) {
+                const auto &step = program[e];
+                auto src = e == 0 ? x : z;
+
+                switch (step.kind) {
+                    case FusedStep::TRANSFORM_STRICT:
+                        NativeOpExecutioner::execTransformStrict(block.launchContext(), step.opNum, src->buffer(), src->shapeInfo(), src->specialBuffer(), src->specialShapeInfo(),
+                                z->buffer(), z->shapeInfo(), z->specialBuffer(), z->specialShapeInfo(), nullptr, nullptr, nullptr);
+                        break;
+                    case FusedStep::TRANSFORM_SAME:
+                        NativeOpExecutioner::execTransformSame(block.launchContext(), step.opNum, src->buffer(), src->shapeInfo(), src->specialBuffer(), src->specialShapeInfo(),
+                                z->buffer(), z->shapeInfo(), z->specialBuffer(), z->specialShapeInfo(), nullptr, nullptr, nullptr);
+                        break;
+                    case FusedStep::SCALAR: {
+                            auto y = NDArrayFactory::create(z->dataType(), step.scalar, block.launchContext());
+                            src->applyScalarArr(static_cast<sd::scalar::Ops>(step.opNum), y, *z);
+                        }
+                        break;
+                    case FusedStep::PAIRWISE: {
+                            auto y = inputs[pairwise++];
+                            NativeOpExecutioner::execPairwiseTransform(block.launchContext(), step.opNum, src->buffer(), src->shapeInfo(), src->specialBuffer(), src->specialShapeInfo(),
+                                    y->buffer(), y->shapeInfo(), y->specialBuffer(), y->specialShapeInfo(),
+                                    z->buffer(), z->shapeInfo(), z->specialBuffer(), z->specialShapeInfo(), nullptr);
+                        }
+                        break;
+                }
+            }
+
+            manager.synchronize();
+            NDArray::registerSpecialUse({z}, inputs);
+            STORE_RESULT(*z);
+
+            return Status::OK();
+        }
+
+        ShapeList *FusedElementwiseOp::calculateOutputShape(ShapeList *inputShape, sd::graph::Context &block) {
+            auto inShape = inputShape->at(0);
+
+            Nd4jLong *newShape;
+            COPY_SHAPE(inShape, newShape);
+
+            return SHAPELIST(CONSTANT(newShape));
+        }
+    }
+}
@@ -0,0 +1,153 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/ShapeFunctionCache.h>
+#include <system/Environment.h>
+#include <helpers/shape.h>
+#include <cstring>
+
+namespace sd {
+    namespace ops {
+
+        // every op has its own cache, and lookups are lock-free anyway, so few shards are enough for concurrent puts
+        ShapeFunctionCache::ShapeFunctionCache() : _entries(8) {
+            //
+        }
+
+        ShapeFunctionCache::Entry::Entry(ShapeList &shapes) {
+            for (int e = 0; e < shapes.size(); e++) {
+                auto shapeInfo = shapes.at(e);
+                if (shapeInfo == nullptr)
+                    _shapes.emplace_back();
+                else
+                    _shapes.emplace_back(shapeInfo, shapeInfo + shape::shapeInfoLength(shapeInfo));
+            }
+        }
+
+        ShapeList* ShapeFunctionCache::Entry::shapeList() const {
+            std::vector<const Nd4jLong*> shapes;
+            for (const auto &v : _shapes)
+                shapes.emplace_back(v.empty() ? nullptr : v.data());
+
+            return new ShapeList(shapes);
+        }
+
+        size_t ShapeFunctionCache::KeyHash::operator()(const Key &key) const {
+            // FNV-1a over 64-bit words
+            uint64_t hash = 14695981039346656037ULL;
+            for (auto v : key) {
+                hash ^= static_cast<uint64_t>(v);
+                hash *= 1099511628211ULL;
+            }
+
+            return static_cast<size_t>(hash ^ (hash >> 32));
+        }
+
+        ShapeFunctionCache::Key ShapeFunctionCache::key(ShapeList &inputShapes, sd::graph::Context &ctx) {
+            Key key;
+
+            // default types are used by some shape functions for outputs
+            key.emplace_back(static_cast<Nd4jLong>(Environment::getInstance().defaultFloatDataType()));
+            key.emplace_back(static_cast<Nd4jLong>(ctx.dataType()));
+            key.emplace_back(ctx.opNum());
+
+            // every list is prefixed with its length, so different lists never give the same key
+            key.emplace_back(ctx.numI());
+            for (auto v : *ctx.getIArguments())
+                key.emplace_back(v);
+
+            key.emplace_back(ctx.numT());
+            for (auto v : *ctx.getTArguments()) {
+                Nd4jLong bits;
+                memcpy(&bits, &v, sizeof(bits));
+                key.emplace_back(bits);
+            }
+
+            key.emplace_back(ctx.numB());
+            for (auto v : *ctx.getBArguments())
+                key.emplace_back(v ? 1 : 0);
+
+            key.emplace_back(ctx.numD());
+            for (auto v : *ctx.getDArguments())
+                key.emplace_back(static_cast<Nd4jLong>(v));
+
+            key.emplace_back(ctx.getAxis()->size());
+            for (auto v : *ctx.getAxis())
+                key.emplace_back(v);
+
+            key.emplace_back(inputShapes.size());
+            for (int e = 0; e < inputShapes.size(); e++) {
+                auto shapeInfo = inputShapes.at(e);
+                if (shapeInfo == nullptr) {
+                    key.emplace_back(-1);
+                    continue;
+                }
+
+                // shapeInfo starts with rank, so its length is known from the key itself
+                key.insert(key.end(), shapeInfo, shapeInfo + shape::shapeInfoLength(shapeInfo));
+            }
+
+            return key;
+        }
+
+        bool ShapeFunctionCache::isApplicable() const {
+            return !_dataDependent.load(std::memory_order_relaxed) && Environment::getInstance().shapeFunctionCacheSize() > 0;
+        }
+
+        std::shared_ptr<ShapeFunctionCache::Entry> ShapeFunctionCache::get(const Key &key) {
+            std::shared_ptr<Entry> entry;
+            if (!_entries.get(key, entry))
+                return nullptr;
+
+            return entry;
+        }
+
+        void ShapeFunctionCache::put(const Key &key, ShapeList &outputShapes) {
+            auto entry = std::make_shared<Entry>(outputShapes);
+
+            // rarely used signatures are evicted once limit is exceeded
+            _entries.put(key, entry, key.size() * sizeof(Nd4jLong), Environment::getInstance().shapeFunctionCacheSize());
+        }
+
+        void ShapeFunctionCache::markDataDependent() {
+            _dataDependent.store(true);
+
+            purge();
+        }
+
+        bool ShapeFunctionCache::isDataDependent() const {
+            return _dataDependent.load(std::memory_order_relaxed);
+        }
+
+        Nd4jLong ShapeFunctionCache::hits() const {
+            return _entries.hits();
+        }
+
+        Nd4jLong ShapeFunctionCache::misses() const {
+            return _entries.misses();
+        }
+
+        int ShapeFunctionCache::size() {
+            return (int) _entries.size();
+        }
+
+        void ShapeFunctionCache::purge() {
+            _entries.clear();
+        }
+    }
+}
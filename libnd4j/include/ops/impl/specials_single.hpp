@@ -31,6 +31,7 @@
 #include <ops/declarable/CustomOperations.h>
 #include <types/types.h>
 #include <helpers/Loops.h>
+#include <helpers/ParallelSort.h>
 
 namespace sd {
 /**
@@ -448,77 +449,6 @@ void SpecialMethods<T>::splitCpuGeneric(const NDArray& input, const std::vector<
             return shape::getIndexOffset(index, xShapeInfo);
     }
 
-    template<typename T>
-    void SpecialMethods<T>::quickSort_parallel_internal(T* array, Nd4jLong const* xShapeInfo, int left, int right, int cutoff, bool descending) {
-
-        int i = left, j = right;
-        T tmp;
-        T pivot = array[getPosition(xShapeInfo, (left + right) / 2)];
-
-
-        {
-            /* PARTITION PART */
-            while (i <= j) {
-                if (descending) {
-                    while (array[getPosition(xShapeInfo, i)] > pivot)
-                        i++;
-                    while (array[getPosition(xShapeInfo, j)] < pivot)
-                        j--;
-                    if (i <= j) {
-                        tmp = array[getPosition(xShapeInfo, i)];
-                        array[getPosition(xShapeInfo, i)] = array[getPosition(xShapeInfo, j)];
-                        array[getPosition(xShapeInfo, j)] = tmp;
-                        i++;
-                        j--;
-                    }
-                } else {
-                    while (array[getPosition(xShapeInfo, i)] < pivot)
-                        i++;
-                    while (array[getPosition(xShapeInfo, j)] > pivot)
-                        j--;
-                    if (i <= j) {
-                        tmp = array[getPosition(xShapeInfo, i)];
-                        array[getPosition(xShapeInfo, i)] = array[getPosition(xShapeInfo, j)];
-                        array[getPosition(xShapeInfo, j)] = tmp;
-                        i++;
-                        j--;
-                    }
-                }
-            }
-
-        }
-
-        //
-
-        if ( ((right-left)<cutoff) ){
-            if (left < j){ quickSort_parallel_internal(array, xShapeInfo, left, j, cutoff, descending); }
-            if (i < right){ quickSort_parallel_internal(array, xShapeInfo, i, right, cutoff, descending); }
-
-        }else{
-PRAGMA_OMP_TASK
-            { quickSort_parallel_internal(array, xShapeInfo, left, j, cutoff, descending); }
-PRAGMA_OMP_TASK
-            { quickSort_parallel_internal(array, xShapeInfo, i, right, cutoff, descending); }
-        }
-    }
-
-    template<typename T>
-    void SpecialMethods<T>::quickSort_parallel(void *varray, Nd4jLong const* xShapeInfo, Nd4jLong lenArray, int numThreads, bool descending){
-        auto array = reinterpret_cast<T *>(varray);
-        int cutoff = 1000;
-
-        PRAGMA_OMP_PARALLEL_THREADS(numThreads)
-        {
-PRAGMA_OMP_SINGLE_ARGS(nowait)
-            {
-                quickSort_parallel_internal(array, xShapeInfo, 0, lenArray-1, cutoff, descending);
-            }
-        }
-
-    }
-
-
-
     template <typename T>
     int SpecialMethods<T>::nextPowerOf2(int number) {
         int pos = 0;
@@ -541,30 +471,59 @@ PRAGMA_OMP_SINGLE_ARGS(nowait)
     }
 
 
+    template<typename T>
+    void SpecialMethods<T>::sortVector(T* array, Nd4jLong const* xShapeInfo, Nd4jLong lenArray, int numThreads, bool descending) {
+        if (shape::elementWiseStride(xShapeInfo) == 1) {
+            ParallelSort::sort(array, lenArray, descending, numThreads);
+            return;
+        }
+
+        // strided vectors are sorted within contiguous copy
+        std::unique_ptr<T[]> buffer(new T[lenArray]);
+        for (Nd4jLong e = 0; e < lenArray; e++)
+            buffer[e] = array[getPosition(xShapeInfo, e)];
+
+        ParallelSort::sort(buffer.get(), lenArray, descending, numThreads);
+
+        for (Nd4jLong e = 0; e < lenArray; e++)
+            array[getPosition(xShapeInfo, e)] = buffer[e];
+    }
+
     template<typename T>
     void SpecialMethods<T>::sortGeneric(void *vx, Nd4jLong const* xShapeInfo, bool descending) {
         auto x = reinterpret_cast<T *>(vx);
 
-        quickSort_parallel(x, xShapeInfo, shape::length(xShapeInfo), omp_get_max_threads(), descending);
+        sortVector(x, xShapeInfo, shape::length(xShapeInfo), sd::Environment::getInstance().maxMasterThreads(), descending);
     }
 
     template<typename T>
     void SpecialMethods<T>::sortTadGeneric(void *vx, Nd4jLong const* xShapeInfo, int *dimension, int dimensionLength, Nd4jLong const* tadShapeInfo, Nd4jLong const* tadOffsets, bool descending) {
         auto x = reinterpret_cast<T *>(vx);
 
-        //quickSort_parallel(x, xShapeInfo, shape::length(xShapeInfo), omp_get_max_threads(), descending);
         Nd4jLong xLength = shape::length(xShapeInfo);
         Nd4jLong xTadLength = shape::tadLength(xShapeInfo, dimension, dimensionLength);
         int numTads = xLength / xTadLength;
 
+        const int numThreads = sd::Environment::getInstance().maxMasterThreads();
+
+        // few long TADs are sorted one by one with all threads, otherwise every TAD is sorted by single thread
+        if (numTads < numThreads && ParallelSort::numberOfChunks(xTadLength, numThreads) > 1) {
+            for (int r = 0; r < numTads; r++)
+                sortVector(x + tadOffsets[r], tadShapeInfo, xTadLength, numThreads, descending);
+
+            return;
+        }
+
         auto func = PRAGMA_THREADS_FOR {
             for (auto r = start; r < stop; r++) {
                 T *dx = x + tadOffsets[r];
 
-                quickSort_parallel(dx, tadShapeInfo, xTadLength, 1, descending);
+                sortVector(dx, tadShapeInfo, xTadLength, 1, descending);
             }
         };
-        samediff::Threads::parallel_tad(func, 0, numTads);
+
+        // TADs might take very different time to sort (i.e. presorted ones), so they're scheduled dynamically
+        samediff::Threads::parallel_tad(func, 0, numTads, 1, numThreads, samediff::SCHEDULE_DYNAMIC);
     }
 
 
@@ -32,6 +32,11 @@
 #endif
 #include <types/float16.h>
 #include <types/types.h>
+#include <helpers/ParallelSort.h>
+#include <execution/Threads.h>
+#include <numeric>
+#include <memory>
+#include <vector>
 
 namespace sd {
     namespace sparse {
@@ -120,106 +125,34 @@ namespace sd {
             return mid;
     }
 
-        template<typename T>
-        void SparseUtils<T>::coo_quickSort_parallel_internal(Nd4jLong *indices, T* array, Nd4jLong left, Nd4jLong right, int cutoff, int rank) {
-            Nd4jLong span = right - left;  // elements to be partitioned - 1
-
-            if (span == 1){
-                // only 2 elements to partition. swap if needed and return directly without further sorting.
-                if (ltIndices(indices, rank, right, left)){
-                    swapEverything(indices, array, rank, left, right);
-                }
-                return;
-            }
-
-
-            // find optimal pivot and sort left < right < right
-            Nd4jLong pvt = coo_quickSort_findPivot(indices, array, left, right, rank);
-
-            if (span == 2){
-                // only 3 elements to partition. findPivot has already sorted them. no further sorting is needed.
-                return;
-            }
-
-            // index that is greater than pivot - leftmost element is already partitioned because of findPivot.
-            Nd4jLong i = left + 1;
-
-            // index that is smaller than pivot - rightmost element is already partitioned because of findPivot.
-            Nd4jLong j = right - 1;
-
-
-            {
-                // flag that indicates that pivot index lies between i and j and *could* be swapped.
-                bool checkPivot = true;
-                /* PARTITION PART */
-                while (i <= j) {
-                    while (ltIndices(indices, rank, i, pvt))
-                        i++;
-
-                    while (gtIndices(indices, rank, j, pvt))
-                        j--;
-
-
-                    if (i <= j) {
-                        if(i != j) { // swap can be fairly expensive. don't swap i -> i
-                            swapEverything(indices, array, rank, i, j);
-                        }
-
-                        // only check pivot if it hasn't already been swapped.
-                        if (checkPivot) {
-                            // check if we moved the pivot, if so, change pivot index accordingly
-                            if (pvt == j) {
-                                pvt = i;
-                                checkPivot = false;
-                            } else if (pvt == i) {
-                                pvt = j;
-                                checkPivot = false;
-                            }
-                        }
+        template <typename T>
+        void SparseUtils<T>::sortCooIndicesGeneric(Nd4jLong *indices, void *vx, Nd4jLong length, int rank) {
+            auto values = reinterpret_cast<T *>(vx);
 
-                        i++;
-                        j--;
-                    }
-                }
+            // permutation is merge-sorted by index tuples, and then applied to indices and values
+            std::vector<Nd4jLong> order(length);
+            std::iota(order.begin(), order.end(), 0);
 
-            }
+            ParallelSort::mergeSort(order.data(), length, [&](Nd4jLong x, Nd4jLong y) -> bool {
+                return ltIndices(indices, rank, x, y);
+            });
 
-            if ( (span < cutoff) ){
-                if (left < j){ coo_quickSort_parallel_internal(indices, array, left, j, cutoff, rank); }
-                if (i < right){ coo_quickSort_parallel_internal(indices, array, i, right, cutoff, rank); }
+            std::vector<Nd4jLong> sortedIndices(length * rank);
+            std::unique_ptr<T[]> sortedValues(new T[length]);
 
-            }else{
-PRAGMA_OMP_TASK
-                { coo_quickSort_parallel_internal(indices, array, left, j, cutoff, rank); }
-PRAGMA_OMP_TASK
-                { coo_quickSort_parallel_internal(indices, array, i, right, cutoff, rank); }
-            }
-
-        }
+            auto func = PRAGMA_THREADS_FOR {
+                for (auto e = start; e < stop; e++) {
+                    for (int f = 0; f < rank; f++)
+                        sortedIndices[e * rank + f] = indices[order[e] * rank + f];
 
-        template <typename T>
-        void SparseUtils<T>::coo_quickSort_parallel(Nd4jLong *indices, T* array, Nd4jLong lenArray, int numThreads, int rank){
-
-            int cutoff = 1000;
-
-            PRAGMA_OMP_PARALLEL_THREADS(numThreads)
-            {
-PRAGMA_OMP_SINGLE_ARGS(nowait)
-                {
-                    coo_quickSort_parallel_internal(indices, array, 0, lenArray-1, cutoff, rank);
+                    sortedValues[e] = values[order[e]];
                 }
-            }
+            };
 
-        }
+            samediff::Threads::parallel_for(func, 0, length);
 
-        template <typename T>
-        void SparseUtils<T>::sortCooIndicesGeneric(Nd4jLong *indices, void *vx, Nd4jLong length, int rank) {
-        auto values = reinterpret_cast<T *>(vx);
-#ifdef _OPENMP
-            coo_quickSort_parallel(indices, values, length, omp_get_max_threads(), rank);
-#else
-            coo_quickSort_parallel(indices, values, length, 1, rank);
-#endif
+            std::copy(sortedIndices.begin(), sortedIndices.end(), indices);
+            std::copy(sortedValues.get(), sortedValues.get() + length, values);
         }
 
         BUILD_SINGLE_TEMPLATE(template class ND4J_LOCAL SparseUtils, , LIBND4J_TYPES);
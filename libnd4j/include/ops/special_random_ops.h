@@ -217,6 +217,107 @@ namespace randomOps {
     };
 
 
+//////////////////////////////////////////////////////////////////////
+    /**
+    * Box-Muller transform over block of indices: n0[e] and n1[e] are standard normal values for indices index + e and index + e + middle,
+    * both made of uniform values r0 = U(index + e) and r1 = U(index + e + middle). Every value depends on its index only,
+    * so results don't depend on number of threads. length is at most BLOCK_SIZE
+    */
+    template<typename T>
+    class NormalBlock {
+    public:
+        static const int BLOCK_SIZE = 256;
+
+        static inline void generate(sd::graph::RandomGenerator *rng, Nd4jLong index, Nd4jLong middle, Nd4jLong length, T epsilon, T *n0, T *n1) {
+            const T two_pi = static_cast<T>(2.0f) * static_cast<T>(3.14159265358979323846);
+            T r0[BLOCK_SIZE];
+            T r1[BLOCK_SIZE];
+
+            rng->relativeBlock<T>(index, length, r0, epsilon, static_cast<T>(1.0f));
+            rng->relativeBlock<T>(index + middle, length, r1, epsilon, static_cast<T>(1.0f));
+
+            for (Nd4jLong e = 0; e < length; e++) {
+                auto radius = sd::math::nd4j_sqrt<T, T>(static_cast<T>(-2.0f) * sd::math::nd4j_log<T, T>(r0[e]));
+                n0[e] = radius * sd::math::nd4j_cos<T, T>(two_pi * r1[e]);
+                n1[e] = radius * sd::math::nd4j_sin<T, T>(two_pi * r1[e]);
+            }
+        }
+    };
+
+    /**
+    * Floats use branchless polynomial log and sincos (Cephes coefficients, within 2 ulp of libm), so whole block is vectorized.
+    * Uniform values here are within [epsilon, 1), so special cases of log and range reduction of sincos aren't needed
+    */
+    template<>
+    class NormalBlock<float> {
+    public:
+        static const int BLOCK_SIZE = 256;
+
+        static inline void generate(sd::graph::RandomGenerator *rng, Nd4jLong index, Nd4jLong middle, Nd4jLong length, float epsilon, float *n0, float *n1) {
+            float r0[BLOCK_SIZE];
+            float r1[BLOCK_SIZE];
+
+            rng->relativeBlock<float>(index, length, r0, epsilon, 1.0f);
+            rng->relativeBlock<float>(index + middle, length, r1, epsilon, 1.0f);
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong e = 0; e < length; e++) {
+                // log(r0): r0 = m * 2^k, with m within [sqrt(0.5), sqrt(2))
+                sd::u32 u;
+                u._f32 = r0[e];
+                int k = static_cast<int>((u._u32 >> 23) & 0xff) - 126;
+                u._u32 = (u._u32 & 0x807fffffu) | 0x3f000000u;
+
+                // m - 1 + m is exact here, and unlike two alternatives it doesn't keep branch in loop
+                const bool small = u._f32 < 0.707106781186547524f;
+                k = small ? k - 1 : k;
+                const float m = (u._f32 - 1.0f) + (small ? u._f32 : 0.0f);
+
+                const float fk = static_cast<float>(k);
+                const float mm = m * m;
+                float y = 7.0376836292E-2f;
+                y = y * m - 1.1514610310E-1f;
+                y = y * m + 1.1676998740E-1f;
+                y = y * m - 1.2420140846E-1f;
+                y = y * m + 1.4249322787E-1f;
+                y = y * m - 1.6668057665E-1f;
+                y = y * m + 2.0000714765E-1f;
+                y = y * m - 2.4999993993E-1f;
+                y = y * m + 3.3333331174E-1f;
+                y = y * m * mm;
+                y += -2.12194440E-4f * fk;
+                y += -0.5f * mm;
+                const float logR0 = m + y + 0.693359375f * fk;
+
+                // sqrt goes to separate loop, since its errno handling prevents vectorization
+                r0[e] = sd::math::nd4j_max<float>(0.0f, -2.0f * logR0);
+
+                // sincos(2 * pi * r1): octant reduction to [-pi/4, pi/4]
+                const float x = 6.28318530717958647692f * r1[e];
+                const int j = (static_cast<int>(x * 1.27323954473516f) + 1) & ~1;
+                const float fj = static_cast<float>(j);
+                const float r = ((x - fj * 0.78515625f) - fj * 2.4187564849853515625e-4f) - fj * 3.77489497744594108e-8f;
+                const float z = r * r;
+
+                const float c = ((2.443315711809948E-005f * z - 1.388731625493765E-003f) * z + 4.166664568298827E-002f) * z * z - 0.5f * z + 1.0f;
+                const float s = ((-1.9515295891E-4f * z + 8.3321608736E-3f) * z - 1.6666654611E-1f) * z * r + r;
+
+                const int q = (j >> 1) & 3;
+                const float cosine = q == 0 ? c : q == 1 ? -s : q == 2 ? -c : s;
+                const float sine = q == 0 ? s : q == 1 ? c : q == 2 ? -s : -c;
+
+                n0[e] = cosine;
+                n1[e] = sine;
+            }
+
+            for (Nd4jLong e = 0; e < length; e++) {
+                const float radius = sd::math::nd4j_sqrt<float, float>(r0[e]);
+                n0[e] *= radius;
+                n1[e] *= radius;
+            }
+        }
+    };
+
 //////////////////////////////////////////////////////////////////////
     /**
     * This Op produces random values within specified boundaries. Distribuion is Gaussian
@@ -307,8 +408,6 @@ namespace randomOps {
 
         static inline void
         specialOp(Nd4jPointer state, const T *x, const Nd4jLong *xShapeBuffer, const T *y, const Nd4jLong *yShapeBuffer, T *z, const Nd4jLong *zShapeBuffer, T *extraArguments) {
-            const T two_pi = static_cast<T>(2.0f) * static_cast<T>(3.14159265358979323846);
-
             auto zLength = shape::length(zShapeBuffer);
             auto yEWS = shape::elementWiseStride(yShapeBuffer);
             auto zEWS = shape::elementWiseStride(zShapeBuffer);
@@ -332,24 +431,24 @@ namespace randomOps {
             const T epsilon = static_cast<T>(1e-5);
 
             auto func = PRAGMA_THREADS_FOR {
-                for (auto e = start; e < stop; e++) {
-                    auto epm = e + middle;
+                T n0[NormalBlock<T>::BLOCK_SIZE];
+                T n1[NormalBlock<T>::BLOCK_SIZE];
 
-                    // we need to get random values
-                    T r0 = rng->relativeT<T>(e, epsilon, static_cast<T>(1.0f));
-                    T r1 = rng->relativeT<T>(epm, epsilon, static_cast<T>(1.0f));
+                for (auto b = start; b < stop; b += NormalBlock<T>::BLOCK_SIZE) {
+                    const auto blockLength = sd::math::nd4j_min<Nd4jLong>(NormalBlock<T>::BLOCK_SIZE, stop - b);
+                    NormalBlock<T>::generate(rng, b, middle, blockLength, epsilon, n0, n1);
 
-                    T realMean0 = y == z ? mean : y[e * yEWS];
+                    for (Nd4jLong i = 0; i < blockLength; i++) {
+                        auto e = b + i;
+                        auto epm = e + middle;
 
-                    auto z0 = (sd::math::nd4j_sqrt<T, T>(static_cast<T>(-2.0f) * sd::math::nd4j_log<T, T>(r0)) *
-                               sd::math::nd4j_cos<T, T>(two_pi * r1)) * stddev + realMean0;
-                    z[e * zEWS] = z0;
+                        T realMean0 = y == z ? mean : y[e * yEWS];
+                        z[e * zEWS] = n0[i] * stddev + realMean0;
 
-                    if (epm < zLength) {
-                        T realMean1 = y == z ? mean : y[epm * yEWS];
-                        auto z1 = (sd::math::nd4j_sqrt<T, T>(static_cast<T>(-2.0f) * sd::math::nd4j_log<T, T>(r0)) *
-                                   sd::math::nd4j_sin<T, T>(two_pi * r1)) * stddev + realMean1;
-                        z[epm * zEWS] = z1;
+                        if (epm < zLength) {
+                            T realMean1 = y == z ? mean : y[epm * yEWS];
+                            z[epm * zEWS] = n1[i] * stddev + realMean1;
+                        }
                     }
                 }
             };
@@ -793,8 +892,6 @@ namespace randomOps {
 
         static inline void
         specialOp(Nd4jPointer state, const T *x, const Nd4jLong *xShapeBuffer, const T *y, const Nd4jLong *yShapeBuffer, T *z, const Nd4jLong *zShapeBuffer, T *extraArguments) {
-            const T two_pi = static_cast<T>(2.0f) * static_cast<T>(3.14159265358979323846);
-
             Nd4jLong zLength = shape::length(zShapeBuffer);
             auto yEWS = shape::elementWiseStride(yShapeBuffer);
             auto zEWS = shape::elementWiseStride(zShapeBuffer);
@@ -817,21 +914,24 @@ namespace randomOps {
             const T epsilon = static_cast<T>(1e-5);
 
             auto func = PRAGMA_THREADS_FOR {
-                PRAGMA_OMP_SIMD
-                for (auto e = start; e < stop; e++) {
-                    auto epm = e + middle;
+                T n0[NormalBlock<T>::BLOCK_SIZE];
+                T n1[NormalBlock<T>::BLOCK_SIZE];
 
-                    // we need to get random values
-                    T r0 = rng->relativeT<T>(e, epsilon, static_cast<T>(1.0f));
-                    T r1 = rng->relativeT<T>(epm, epsilon, static_cast<T>(1.0f));
+                for (auto b = start; b < stop; b += NormalBlock<T>::BLOCK_SIZE) {
+                    const auto blockLength = sd::math::nd4j_min<Nd4jLong>(NormalBlock<T>::BLOCK_SIZE, stop - b);
+                    NormalBlock<T>::generate(rng, b, middle, blockLength, epsilon, n0, n1);
 
-                    T realMean = y == z ? mean : y[e * yEWS];
+                    for (Nd4jLong i = 0; i < blockLength; i++) {
+                        auto e = b + i;
+                        auto epm = e + middle;
 
-                    z[e * zEWS] =  sd::math::nd4j_exp<T,T>((sd::math::nd4j_sqrt<T,T>(static_cast<T>(-2.0f) * sd::math::nd4j_log<T,T>(r0)) * sd::math::nd4j_cos<T,T>(two_pi * r1)) * stddev + realMean);
+                        T realMean = y == z ? mean : y[e * yEWS];
+                        z[e * zEWS] = sd::math::nd4j_exp<T, T>(n0[i] * stddev + realMean);
 
-                    if (epm < zLength) {
-                        realMean = y == z ? mean : y[epm * yEWS];
-                        z[epm * zEWS] =  sd::math::nd4j_exp<T,T>((sd::math::nd4j_sqrt<T,T>(static_cast<T>(-2.0f) * sd::math::nd4j_log<T,T>(r0)) * sd::math::nd4j_sin<T,T>(two_pi * r1)) * stddev + realMean);
+                        if (epm < zLength) {
+                            realMean = y == z ? mean : y[epm * yEWS];
+                            z[epm * zEWS] = sd::math::nd4j_exp<T, T>(n1[i] * stddev + realMean);
+                        }
                     }
                 }
             };
@@ -0,0 +1,103 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_SYSTEM_CPUDISPATCH_H
+#define SD_SYSTEM_CPUDISPATCH_H
+
+#include <atomic>
+#include <system/dll.h>
+#include <system/op_boilerplate.h>
+
+/**
+ * Loop kernels are compiled for several ISA levels within the same binary (via target attributes),
+ * and the best variant supported by current CPU is picked at runtime.
+ * Only available with GCC/Clang on x86_64 builds that have cpu_features, and pointless for avx512 builds.
+ */
+#if defined(CPU_FEATURES) && defined(__GNUC__) && defined(__x86_64__) && !defined(__CUDACC__) && !defined(F_AVX512)
+#define SD_CPU_DISPATCH
+#define SD_TARGET_AVX2 __attribute__((target("avx,avx2,fma,f16c")))
+#define SD_TARGET_AVX512 __attribute__((target("avx,avx2,fma,f16c,avx512f,avx512vl,avx512bw,avx512dq,avx512cd")))
+#endif
+
+namespace sd {
+    class ND4J_EXPORT CpuDispatch {
+    private:
+        static std::atomic<int> _level;
+        static int _detectedLevel;
+
+    public:
+        // levels match binaryLevel()/optimalLevel() values, 0 means unknown/non-x86 CPU
+        static const int GENERIC = 1;
+        static const int AVX2 = 2;
+        static const int AVX512 = 3;
+
+        /**
+         * This method returns highest ISA level supported by current CPU
+         */
+        static int detectedLevel();
+
+        /**
+         * This method returns ISA level used by loop kernels
+         */
+        static FORCEINLINE int level() {
+            return _level.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * This method allows to limit ISA level used by loop kernels. It can't be set above detected level.
+         * Also can be defined via SD_MAX_CPU_LEVEL env var
+         */
+        static void setLevel(int level);
+    };
+
+#ifdef SD_CPU_DISPATCH
+    template <typename Kernel, typename... Args>
+    SD_TARGET_AVX512 void cpuDispatchAvx512(Args... args) {
+        Kernel::run(args...);
+    }
+
+    template <typename Kernel, typename... Args>
+    SD_TARGET_AVX2 void cpuDispatchAvx2(Args... args) {
+        Kernel::run(args...);
+    }
+#endif
+
+    /**
+     * This function calls Kernel::run(args...) compiled for the best ISA level available.
+     * Kernel::run must be FORCEINLINE, so whole loop gets inlined into target-specific wrapper.
+     */
+    template <typename Kernel, typename... Args>
+    FORCEINLINE void cpuDispatch(Args... args) {
+#ifdef SD_CPU_DISPATCH
+        auto level = CpuDispatch::level();
+        if (level >= CpuDispatch::AVX512) {
+            cpuDispatchAvx512<Kernel>(args...);
+            return;
+        }
+#ifndef F_AVX2
+        if (level >= CpuDispatch::AVX2) {
+            cpuDispatchAvx2<Kernel>(args...);
+            return;
+        }
+#endif
+#endif
+        Kernel::run(args...);
+    }
+}
+
+#endif //SD_SYSTEM_CPUDISPATCH_H
@@ -44,6 +44,7 @@ namespace sd{
         std::atomic<bool> _precBoost;
         std::atomic<bool> _useONEDNN{true};
         std::atomic<bool> _allowHelpers{true};
+        std::atomic<bool> _allowDynamicScheduling{true};
 
         std::atomic<int> _maxThreads;
         std::atomic<int> _maxMasterThreads;
@@ -53,6 +54,36 @@ namespace sd{
         std::atomic<int64_t> _maxTotalSpecialMemory{-1};
         std::atomic<int64_t> _maxDeviceMemory{-1};
 
+        // TAD cache limits, 0 means no limit
+        std::atomic<int64_t> _tadCacheLimit{0};
+        std::atomic<int64_t> _tadCacheBytesLimit{0};
+
+        // number of slots in per-thread shape front cache, 0 disables it
+        std::atomic<int> _shapeFrontCacheSlots{64};
+
+        // number of input signatures every op keeps output shapes for, 0 disables shape function caching
+        std::atomic<int> _shapeFunctionCacheSize{64};
+
+        // NUMA-aware mode, and min size of buffers that get first-touched by threads of owning nodes
+        std::atomic<bool> _numaAware{false};
+        std::atomic<int64_t> _numaFirstTouchThreshold{4 * 1024 * 1024};
+
+        // conv2d algorithm, see sd::ops::Conv2dAlgorithm, 0 means heuristic choice
+        std::atomic<int> _conv2dAlgorithm{0};
+
+        // number of nodes GraphExecutioner runs concurrently, 1 means sequential execution
+        std::atomic<int> _interOpThreads{1};
+
+        // static memory planning of graph intermediates, see sd::graph::MemoryPlanner
+        std::atomic<bool> _memoryPlanning{false};
+
+        // fusion of legacy elementwise op chains, see sd::graph::ElementwiseFusion
+        std::atomic<bool> _elementwiseFusion{false};
+
+        // pooled host allocations outside of workspaces, and huge pages for big pooled blocks, see sd::memory::PooledAllocator
+        std::atomic<bool> _pooledAllocation{false};
+        std::atomic<bool> _pooledHugePages{false};
+
         bool _blasFallback = false;
 
 #ifdef __ND4J_EXPERIMENTAL__
@@ -88,6 +119,12 @@ namespace sd{
         bool helpersAllowed();
         void allowHelpers(bool reallyAllow);
 
+        /**
+         * If dynamic scheduling isn't allowed, loops requesting SCHEDULE_DYNAMIC use static split instead
+         */
+        bool dynamicSchedulingAllowed();
+        void allowDynamicScheduling(bool reallyAllow);
+
         bool blasFallback();
         
         int tadThreshold();
@@ -102,6 +139,12 @@ namespace sd{
         int maxMasterThreads();
         void setMaxMasterThreads(int max);
 
+        /**
+         * This method limits maxMasterThreads() for calling thread only, i.e. for inter-op workers of GraphExecutioner.
+         * 0 removes the limit
+         */
+        void setThreadMaxMasterThreads(int max);
+
         /*
          * Legacy memory limits API, still used in new API as simplified version
          */
@@ -126,6 +169,82 @@ namespace sd{
         Nd4jLong  getDeviceCounter(int deviceId);
         ////////////////////////
 
+        /*
+         * TAD cache limits. TAD packs are evicted with CLOCK (second chance) policy once any of limits is exceeded, 0 means no limit
+         * PLEASE NOTE: pointers taken from TadPack are valid only while that TadPack (or its copy) is alive
+         */
+        Nd4jLong tadCacheLimit();
+        void setTadCacheLimit(Nd4jLong numEntries);
+
+        Nd4jLong tadCacheBytesLimit();
+        void setTadCacheBytesLimit(Nd4jLong numBytes);
+        ////////////////////////
+
+        /**
+         * Number of slots in per-thread front cache of ConstantShapeHelper, 0 disables front caches.
+         * PLEASE NOTE: this doesn't bound memory of interned shapes, shared table is never evicted since its shapeInfo pointers are used as raw pointers
+         */
+        int shapeFrontCacheSlots();
+        void setShapeFrontCacheSlots(int numSlots);
+
+        /**
+         * Number of input signatures (shapes, data types and op arguments) every op remembers output shapes for,
+         * so repeated executions skip shape function. 0 disables caching, see sd::ops::ShapeFunctionCache
+         */
+        int shapeFunctionCacheSize();
+        void setShapeFunctionCacheSize(int numEntries);
+
+        /**
+         * In NUMA-aware mode ThreadPool spreads its threads over NUMA nodes, and big host buffers are first-touched by threads of the nodes that will process them.
+         * PLEASE NOTE: thread placement is decided once, when ThreadPool is created
+         */
+        bool isNumaAware();
+        void setNumaAware(bool reallyNuma);
+
+        Nd4jLong numaFirstTouchThreshold();
+        void setNumaFirstTouchThreshold(Nd4jLong numBytes);
+
+        /**
+         * Algorithm used by CPU conv2d, one of sd::ops::Conv2dAlgorithm values.
+         * Algorithms that don't support given layer (i.e. Winograd for 5x5 kernels) fall back to heuristic choice
+         */
+        int conv2dAlgorithm();
+        void setConv2dAlgorithm(int algorithm);
+
+        /**
+         * Number of independent graph nodes GraphExecutioner runs concurrently.
+         * maxMasterThreads are split evenly between them, so every node gets maxMasterThreads / interOpThreads threads for its own loops
+         */
+        int interOpThreads();
+        void setInterOpThreads(int numThreads);
+
+        /**
+         * If enabled, GraphExecutioner places intermediate arrays of sequentially executed graphs into a single arena,
+         * reusing memory of arrays that aren't needed anymore. Intermediate arrays can't be inspected after execution then
+         */
+        bool isMemoryPlanning();
+        void setMemoryPlanning(bool reallyPlan);
+
+        /**
+         * If enabled, GraphExecutioner replaces chains of legacy elementwise ops with single fused op,
+         * so intermediate results of chain aren't available after execution
+         */
+        bool isElementwiseFusion();
+        void setElementwiseFusion(bool reallyFuse);
+
+        /**
+         * If enabled, host buffers allocated without workspace are taken from PooledAllocator instead of system allocator.
+         * Buffers allocated before switching keep their allocator. Cached blocks are released with PooledAllocator::purge()
+         */
+        bool isPooledAllocation();
+        void setPooledAllocation(bool reallyPool);
+
+        /**
+         * If enabled, PooledAllocator asks for huge pages for blocks of 2MB and bigger, Linux only
+         */
+        bool isPooledHugePages();
+        void setPooledHugePages(bool reallyHuge);
+
         bool isUseONEDNN() { return _useONEDNN.load(); }
         void setUseONEDNN(bool useMKLDNN) { _useONEDNN.store(useMKLDNN); }
 
@@ -220,3 +220,73 @@ TEST_F(AttentionTests, basic_multi_head_dot_product_bp_attention_with_mask) {
     delete result;
 }
  */
+
+TEST_F(AttentionTests, fused_dot_product_attention_1) {
+    // lengths aren't multiples of tile sizes, and some keys are masked out
+    auto queries = NDArrayFactory::create<float>('c', {2, 3, 8, 45});
+    auto keys = NDArrayFactory::create<float>('c', {2, 3, 8, 300});
+    auto values = NDArrayFactory::create<float>('c', {2, 3, 6, 300});
+    auto mask = NDArrayFactory::create<float>('c', {2, 300});
+    queries.linspace(-1.0, 0.001);
+    keys.linspace(1.0, -0.0005);
+    values.linspace(-2.0, 0.0003);
+    mask.assign(1.);
+    mask({0,1, 100,200}).assign(0.);
+
+    sd::ops::dot_product_attention op;
+    for (int normalization : {0, 1}) {
+        for (auto m : std::vector<NDArray*>{nullptr, &mask}) {
+            // weights output goes through non-fused path
+            auto fused = op.evaluate({&queries, &keys, &values, m}, {normalization, 0});
+            auto reference = op.evaluate({&queries, &keys, &values, m}, {normalization, 1});
+            ASSERT_EQ(Status::OK(), fused.status());
+            ASSERT_EQ(Status::OK(), reference.status());
+
+            ASSERT_TRUE(reference.at(0)->isSameShape(fused.at(0)));
+            ASSERT_TRUE(reference.at(0)->equalsTo(fused.at(0), 1e-4));
+        }
+    }
+}
+
+TEST_F(AttentionTests, fused_dot_product_attention_2) {
+    // permuted inputs, like projections in multi_head_dot_product_attention
+    auto q = NDArrayFactory::create<double>('c', {3, 5, 4});
+    auto k = NDArrayFactory::create<double>('c', {3, 7, 4});
+    auto v = NDArrayFactory::create<double>('c', {3, 7, 2});
+    q.linspace(-0.5, 0.02);
+    k.linspace(0.3, -0.01);
+    v.linspace(-1.0, 0.05);
+
+    auto queries = q.permute({0, 2, 1});
+    auto keys = k.permute({0, 2, 1});
+    auto values = v.permute({0, 2, 1});
+
+    sd::ops::dot_product_attention op;
+    auto fused = op.evaluate({&queries, &keys, &values}, {1, 0});
+    auto reference = op.evaluate({&queries, &keys, &values}, {1, 1});
+    ASSERT_EQ(Status::OK(), fused.status());
+
+    ASSERT_TRUE(reference.at(0)->equalsTo(fused.at(0)));
+}
+
+TEST_F(AttentionTests, fused_dot_product_attention_bp_1) {
+    auto queries = NDArrayFactory::create<double>('c', {2, 2, 3, 4});
+    auto keys = NDArrayFactory::create<double>('c', {2, 2, 3, 5});
+    auto values = NDArrayFactory::create<double>('c', {2, 2, 2, 5});
+    auto eps = NDArrayFactory::create<double>('c', {2, 2, 2, 4});
+    auto mask = NDArrayFactory::create<double>('c', {2, 5}, {1., 1., 0., 1., 1., 0., 1., 1., 1., 1.});
+    queries.linspace(-0.5, 0.05);
+    keys.linspace(0.7, -0.03);
+    values.linspace(-1.0, 0.1);
+
+    sd::ops::dot_product_attention opFF;
+    sd::ops::dot_product_attention_bp opBP;
+
+    for (int normalization : {0, 1}) {
+        const OpArgsHolder argsHolderFF({&queries, &keys, &values, &mask}, {}, {normalization, 0});
+        const OpArgsHolder argsHolderBP({&queries, &keys, &values, &eps, &mask}, {}, {normalization});
+
+        const bool isGradCorrect = GradCheck::checkGrad(opFF, opBP, argsHolderFF, argsHolderBP, {1, 1, 1});
+        ASSERT_TRUE(isGradCorrect);
+    }
+}
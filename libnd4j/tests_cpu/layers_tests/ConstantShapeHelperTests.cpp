@@ -26,6 +26,7 @@
 #include <array/ShapeDescriptor.h>
 #include <array/ConstantDataBuffer.h>
 #include <helpers/PointersManager.h>
+#include <thread>
 
 using namespace sd;
 using namespace sd::ops;
@@ -77,6 +78,82 @@ TEST_F(ConstantTadHelperTests, test_cachedAmount_1) {
     ASSERT_EQ(ttlMiddle, ttlAfter);
 }
 
+TEST_F(ConstantTadHelperTests, test_cache_stats_1) {
+    auto arrayA = NDArrayFactory::create<float>('c', {3, 5, 7, 11});
+    auto hitsBefore = ConstantTadHelper::getInstance().cacheHits();
+
+    auto packA = ConstantTadHelper::getInstance().tadForDimensions(arrayA.shapeInfo(), {1, 3});
+    auto packB = ConstantTadHelper::getInstance().tadForDimensions(arrayA.shapeInfo(), {1, 3});
+
+    ASSERT_TRUE(ConstantTadHelper::getInstance().cacheHits() > hitsBefore);
+    ASSERT_TRUE(ConstantTadHelper::getInstance().cachedBytes() > 0);
+    ASSERT_EQ(packA.primaryOffsets(), packB.primaryOffsets());
+}
+
+TEST_F(ConstantTadHelperTests, test_cache_eviction_1) {
+    auto &env = Environment::getInstance();
+    auto limitBefore = env.tadCacheLimit();
+    env.setTadCacheLimit(1);
+
+    auto evictionsBefore = ConstantTadHelper::getInstance().cacheEvictions();
+    std::vector<TadPack> packs;
+    for (int e = 1; e < 200; e++) {
+        auto array = NDArrayFactory::create<float>('c', {e, 3});
+        packs.emplace_back(ConstantTadHelper::getInstance().tadForDimensions(array.shapeInfo(), {1}));
+    }
+
+    env.setTadCacheLimit(limitBefore);
+
+    ASSERT_TRUE(ConstantTadHelper::getInstance().cacheEvictions() > evictionsBefore);
+
+    // evicted packs must stay valid
+    for (int e = 0; e < (int) packs.size(); e++) {
+        ASSERT_EQ(e + 1, packs[e].numberOfTads());
+        ASSERT_EQ(3, shape::length(packs[e].primaryShapeInfo()));
+    }
+}
+
+TEST_F(ConstantShapeHelperTests, concurrent_test_1) {
+    std::vector<const Nd4jLong*> results(8 * 64);
+    std::vector<std::thread> threads(8);
+    for (int t = 0; t < (int) threads.size(); t++) {
+        threads[t] = std::thread([&results, t] () {
+            for (int e = 0; e < 64; e++)
+                results[t * 64 + e] = ConstantShapeHelper::getInstance().createShapeInfo(sd::DataType::FLOAT32, 'c', {e + 1, 5, 3});
+        });
+    }
+
+    for (auto &t : threads)
+        t.join();
+
+    // all threads must get the same interned shapeInfo for the same shape
+    for (int t = 1; t < (int) threads.size(); t++)
+        for (int e = 0; e < 64; e++)
+            ASSERT_EQ(results[e], results[t * 64 + e]);
+
+    for (int e = 0; e < 64; e++)
+        ASSERT_EQ(e + 1, shape::sizeAt(results[e], 0));
+}
+
+TEST_F(ConstantShapeHelperTests, front_cache_test_1) {
+    auto &env = Environment::getInstance();
+    auto slotsBefore = env.shapeFrontCacheSlots();
+
+    env.setShapeFrontCacheSlots(0);
+    auto ptrA = ConstantShapeHelper::getInstance().createShapeInfo(sd::DataType::FLOAT32, 'c', {17, 19, 23});
+
+    env.setShapeFrontCacheSlots(4);
+    auto ptrB = ConstantShapeHelper::getInstance().createShapeInfo(sd::DataType::FLOAT32, 'c', {17, 19, 23});
+    auto ptrC = ConstantShapeHelper::getInstance().createShapeInfo(sd::DataType::FLOAT32, 'c', {17, 19, 23});
+    auto ptrD = ConstantShapeHelper::getInstance().createShapeInfo(sd::DataType::FLOAT32, 'c', {17, 19, 29});
+
+    env.setShapeFrontCacheSlots(slotsBefore);
+
+    ASSERT_EQ(ptrA, ptrB);
+    ASSERT_EQ(ptrA, ptrC);
+    ASSERT_NE(ptrA, ptrD);
+}
+
 TEST_F(ConstantShapeHelperTests, basic_test_1) {
     auto ptr = ShapeBuilders::createShapeInfo(sd::DataType::BFLOAT16, 'f', {5, 10, 15});
     ShapeDescriptor descriptor(ptr);
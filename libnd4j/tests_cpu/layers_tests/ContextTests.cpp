@@ -355,4 +355,116 @@ TEST_F(ContextTests, test_short_context_3) {
     auto z = ctx.fastpath_out()[0];
 
     ASSERT_EQ(exp, *z);
-}
\ No newline at end of file
+}
+
+TEST_F(ContextTests, test_shape_function_cache_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4});
+    auto y = NDArrayFactory::create<float>('c', {4, 5});
+    auto w = NDArrayFactory::create<float>('c', {4, 6});
+    x.linspace(1.f);
+    y.linspace(1.f);
+    w.linspace(1.f);
+
+    sd::ops::matmul op;
+    ASSERT_EQ(0, op.shapeFunctionCache().size());
+
+    for (int e = 0; e < 3; e++) {
+        auto result = op.evaluate({&x, &y});
+        ASSERT_EQ(Status::OK(), result.status());
+
+        auto z = result.at(0);
+        ASSERT_EQ(std::vector<Nd4jLong>({3, 5}), z->getShapeAsVector());
+        ASSERT_NEAR(110.f, z->e<float>(0), 1e-5f);
+    }
+
+    ASSERT_EQ(1, op.shapeFunctionCache().misses());
+    ASSERT_EQ(2, op.shapeFunctionCache().hits());
+    ASSERT_FALSE(op.shapeFunctionCache().isDataDependent());
+
+    // different input shape
+    auto result = op.evaluate({&x, &w});
+    ASSERT_EQ(Status::OK(), result.status());
+    ASSERT_EQ(std::vector<Nd4jLong>({3, 6}), result.at(0)->getShapeAsVector());
+
+    // different arguments, y is transposed
+    auto result2 = op.evaluate({&x, &x}, {}, {0, 1});
+    ASSERT_EQ(Status::OK(), result2.status());
+    ASSERT_EQ(std::vector<Nd4jLong>({3, 3}), result2.at(0)->getShapeAsVector());
+
+    ASSERT_EQ(3, op.shapeFunctionCache().misses());
+    ASSERT_EQ(3, op.shapeFunctionCache().size());
+}
+
+TEST_F(ContextTests, test_shape_function_cache_2) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4});
+    auto s0 = NDArrayFactory::create<Nd4jLong>('c', {2}, {2, 6});
+    auto s1 = NDArrayFactory::create<Nd4jLong>('c', {2}, {6, 2});
+    x.linspace(1.f);
+
+    // shape is given as input array, so output shape depends on input values
+    sd::ops::reshape op;
+    auto result0 = op.evaluate({&x, &s0});
+    ASSERT_EQ(Status::OK(), result0.status());
+    ASSERT_EQ(std::vector<Nd4jLong>({2, 6}), result0.at(0)->getShapeAsVector());
+
+    auto result1 = op.evaluate({&x, &s1});
+    ASSERT_EQ(Status::OK(), result1.status());
+    ASSERT_EQ(std::vector<Nd4jLong>({6, 2}), result1.at(0)->getShapeAsVector());
+
+    ASSERT_TRUE(op.shapeFunctionCache().isDataDependent());
+    ASSERT_EQ(0, op.shapeFunctionCache().hits());
+    ASSERT_EQ(0, op.shapeFunctionCache().size());
+}
+
+TEST_F(ContextTests, test_shape_function_cache_3) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4});
+    auto y = NDArrayFactory::create<float>('c', {4, 5});
+
+    auto original = Environment::getInstance().shapeFunctionCacheSize();
+    Environment::getInstance().setShapeFunctionCacheSize(0);
+
+    sd::ops::matmul op;
+    for (int e = 0; e < 2; e++) {
+        auto result = op.evaluate({&x, &y});
+        ASSERT_EQ(Status::OK(), result.status());
+        ASSERT_EQ(std::vector<Nd4jLong>({3, 5}), result.at(0)->getShapeAsVector());
+    }
+
+    Environment::getInstance().setShapeFunctionCacheSize(original);
+
+    ASSERT_EQ(0, op.shapeFunctionCache().hits());
+    ASSERT_EQ(0, op.shapeFunctionCache().misses());
+}
+
+TEST_F(ContextTests, test_shape_function_cache_4) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3});
+    auto y = NDArrayFactory::create<float>('c', {2, 3});
+    x.linspace(1.f);
+    y.linspace(7.f);
+
+    // these shape functions fetch input arrays, but look only at their shapes, data types and emptiness
+    sd::ops::concat concat;
+    sd::ops::permute permute;
+    sd::ops::expand_dims expand;
+
+    for (int e = 0; e < 2; e++) {
+        auto result0 = concat.evaluate({&x, &y}, {}, {0});
+        ASSERT_EQ(Status::OK(), result0.status());
+        ASSERT_EQ(std::vector<Nd4jLong>({4, 3}), result0.at(0)->getShapeAsVector());
+        ASSERT_NEAR(12.f, result0.at(0)->e<float>(11), 1e-5f);
+
+        auto result1 = permute.evaluate({&x}, {}, {1, 0});
+        ASSERT_EQ(Status::OK(), result1.status());
+        ASSERT_EQ(std::vector<Nd4jLong>({3, 2}), result1.at(0)->getShapeAsVector());
+
+        auto result2 = expand.evaluate({&x}, {}, {1});
+        ASSERT_EQ(Status::OK(), result2.status());
+        ASSERT_EQ(std::vector<Nd4jLong>({2, 1, 3}), result2.at(0)->getShapeAsVector());
+    }
+
+    for (auto cache : {&concat.shapeFunctionCache(), &permute.shapeFunctionCache(), &expand.shapeFunctionCache()}) {
+        ASSERT_FALSE(cache->isDataDependent());
+        ASSERT_EQ(1, cache->misses());
+        ASSERT_EQ(1, cache->hits());
+    }
+}
@@ -273,6 +273,86 @@ TYPED_TEST(TypedConvolutionTests1, conv2d_7) {
 
 }
 
+//////////////////////////////////////////////////////////////////////
+TYPED_TEST(TypedConvolutionTests1, conv2d_algorithms_1) {
+
+    int bS=2, iH=13,iW=10,  iC=17,oC=20,  kH=3,kW=3,  sH=1,sW=1,  pH=0,pW=0,  dH=1,dW=1;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+    int dataFormat  = 0;             // 1-NHWC, 0-NCHW
+    int wFormat     = 1;             // 0-[kH, kW, iC, oC], 1-[oC, iC, kH, kW], 2-[oC, kH, kW, iC]
+
+    auto input   = NDArrayFactory::create<TypeParam>('c', {bS, iC, iH, iW});
+    auto weights = NDArrayFactory::create<TypeParam>('c', {oC, iC, kH, kW});
+    auto bias    = NDArrayFactory::create<TypeParam>('c', {oC});
+
+    input.linspace(1.);
+    input.applyTransform(transform::Cosine, input);
+    weights.linspace(0.3, 0.7);
+    weights.applyTransform(transform::Cosine, weights);
+    bias.linspace(-1., 0.1);
+
+    auto &env = sd::Environment::getInstance();
+    const auto algorithm = env.conv2dAlgorithm();
+    const auto helpers = env.helpersAllowed();
+    env.allowHelpers(false);
+
+    sd::ops::conv2d op;
+    env.setConv2dAlgorithm(sd::ops::CONV2D_IM2COL);
+    auto expected = op.evaluate({&input, &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat, wFormat});
+    ASSERT_EQ(Status::OK(), expected.status());
+
+    // autotune is run twice: first call tunes the layer, second one uses cached choice
+    for (int algo : {sd::ops::CONV2D_DIRECT, sd::ops::CONV2D_WINOGRAD_2X2, sd::ops::CONV2D_WINOGRAD_4X4, sd::ops::CONV2D_AUTO, sd::ops::CONV2D_AUTOTUNE, sd::ops::CONV2D_AUTOTUNE}) {
+        env.setConv2dAlgorithm(algo);
+        auto results = op.evaluate({&input, &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat, wFormat});
+        ASSERT_EQ(Status::OK(), results.status());
+        ASSERT_TRUE(expected.at(0)->isSameShape(results.at(0)));
+        ASSERT_TRUE(expected.at(0)->equalsTo(results.at(0), 1e-4));
+    }
+
+    env.setConv2dAlgorithm(algorithm);
+    env.allowHelpers(helpers);
+}
+
+//////////////////////////////////////////////////////////////////////
+TYPED_TEST(TypedConvolutionTests1, conv2d_algorithms_2) {
+
+    // Winograd isn't applicable to strided/dilated kernels, so it falls back to heuristic choice
+    int bS=2, iH=15,iW=12,  iC=5,oC=70,  kH=5,kW=3,  sH=2,sW=1,  pH=1,pW=2,  dH=1,dW=2;
+    int paddingMode = 0;             // 1-SAME, 0-VALID;
+    int dataFormat  = 1;             // 1-NHWC, 0-NCHW
+    int wFormat     = 2;             // 0-[kH, kW, iC, oC], 1-[oC, iC, kH, kW], 2-[oC, kH, kW, iC]
+
+    auto input   = NDArrayFactory::create<TypeParam>('c', {bS, iH, iW, iC});
+    auto weights = NDArrayFactory::create<TypeParam>('c', {oC, kH, kW, iC});
+
+    input.linspace(1.);
+    input.applyTransform(transform::Cosine, input);
+    weights.linspace(0.3, 0.7);
+    weights.applyTransform(transform::Cosine, weights);
+
+    auto &env = sd::Environment::getInstance();
+    const auto algorithm = env.conv2dAlgorithm();
+    const auto helpers = env.helpersAllowed();
+    env.allowHelpers(false);
+
+    sd::ops::conv2d op;
+    env.setConv2dAlgorithm(sd::ops::CONV2D_IM2COL);
+    auto expected = op.evaluate({&input, &weights}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat, wFormat});
+    ASSERT_EQ(Status::OK(), expected.status());
+
+    for (int algo : {sd::ops::CONV2D_DIRECT, sd::ops::CONV2D_WINOGRAD_4X4, sd::ops::CONV2D_AUTOTUNE}) {
+        env.setConv2dAlgorithm(algo);
+        auto results = op.evaluate({&input, &weights}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat, wFormat});
+        ASSERT_EQ(Status::OK(), results.status());
+        ASSERT_TRUE(expected.at(0)->isSameShape(results.at(0)));
+        ASSERT_TRUE(expected.at(0)->equalsTo(results.at(0), 1e-4));
+    }
+
+    env.setConv2dAlgorithm(algorithm);
+    env.allowHelpers(helpers);
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(ConvolutionTests1, conv2d_8) {
 
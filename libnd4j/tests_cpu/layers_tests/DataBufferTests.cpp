@@ -30,6 +30,7 @@
 #include <ops/declarable/helpers/convolutions.h>
 #include <ops/declarable/helpers/col2im.h>
 #include <helpers/RandomLauncher.h>
+#include <memory/PooledAllocator.h>
 
 using namespace sd;
 using namespace sd::graph;
@@ -77,4 +78,87 @@ TEST_F(DataBufferTests, test_alloc_limit_1) {
     // restore original limits, so subsequent tests do not fail
     MemoryCounter::getInstance().setDeviceLimit(deviceId, odLimit);
     MemoryCounter::getInstance().setGroupLimit(MemoryType::HOST, odLimit);
-}
\ No newline at end of file
+}
+
+TEST_F(DataBufferTests, test_pooled_alloc_1) {
+    if (!Environment::getInstance().isCPU())
+        return;
+
+    const bool pooled = Environment::getInstance().isPooledAllocation();
+    Environment::getInstance().setPooledAllocation(true);
+
+    auto ogUse = MemoryCounter::getInstance().allocatedGroup(MemoryType::HOST);
+    auto before = MemoryCounter::getInstance().pooledStatistics();
+
+    void *address = nullptr;
+    {
+        DataBuffer buffer(1000, DataType::INT8);
+        ASSERT_EQ(ogUse + 1000, MemoryCounter::getInstance().allocatedGroup(MemoryType::HOST));
+        ASSERT_EQ(0, reinterpret_cast<uintptr_t>(buffer.primary()) % PooledAllocator::ALIGNMENT);
+
+        address = buffer.primary();
+        std::memset(address, 1, 1000);
+    }
+
+    ASSERT_EQ(ogUse, MemoryCounter::getInstance().allocatedGroup(MemoryType::HOST));
+
+    // released block comes back to the same thread, zeroed
+    DataBuffer buffer(1000, DataType::INT8);
+    ASSERT_EQ(address, buffer.primary());
+    for (int e = 0; e < 1000; e++)
+        ASSERT_EQ(0, buffer.primaryAsT<int8_t>()[e]);
+
+    auto after = MemoryCounter::getInstance().pooledStatistics();
+    ASSERT_LT(before.hits, after.hits);
+
+    // buffer expanded after switching pool off is released to system allocator
+    Environment::getInstance().setPooledAllocation(false);
+    buffer.expand(5000);
+    ASSERT_EQ(0, buffer.primaryAsT<int8_t>()[4999]);
+
+    Environment::getInstance().setPooledAllocation(pooled);
+    PooledAllocator::getInstance().purge();
+}
+
+TEST_F(DataBufferTests, test_pooled_alloc_2) {
+    ASSERT_EQ(0, PooledAllocator::sizeClass(1));
+    ASSERT_EQ(0, PooledAllocator::sizeClass(64));
+    ASSERT_EQ(1, PooledAllocator::sizeClass(65));
+    ASSERT_EQ(-1, PooledAllocator::sizeClass(PooledAllocator::MAX_POOLED_SIZE + 1));
+    ASSERT_EQ(PooledAllocator::MAX_POOLED_SIZE, PooledAllocator::classSize(PooledAllocator::NUM_CLASSES - 1));
+
+    for (size_t bytes = 1; bytes <= PooledAllocator::MAX_POOLED_SIZE; bytes = bytes * 3 / 2 + 1) {
+        auto c = PooledAllocator::sizeClass(bytes);
+        ASSERT_LE(bytes, PooledAllocator::classSize(c));
+        ASSERT_EQ(0, PooledAllocator::classSize(c) % PooledAllocator::ALIGNMENT);
+
+        // request doesn't fit into previous class, so no smaller block would do
+        if (c > 0) {
+            ASSERT_LT(PooledAllocator::classSize(c - 1), bytes);
+        }
+    }
+}
+
+TEST_F(DataBufferTests, test_pooled_alloc_3) {
+    if (!Environment::getInstance().isCPU())
+        return;
+
+    const bool pooled = Environment::getInstance().isPooledAllocation();
+    Environment::getInstance().setPooledAllocation(true);
+
+    void *address = nullptr;
+    {
+        DataBuffer buffer(1000, DataType::INT8);
+        address = buffer.primary();
+
+        // length changes while pooled primary buffer is still owned
+        buffer.setSpecialBuffer(nullptr, 100000);
+    }
+
+    // block is released to the size class it was allocated from
+    DataBuffer buffer(1000, DataType::INT8);
+    ASSERT_EQ(address, buffer.primary());
+
+    Environment::getInstance().setPooledAllocation(pooled);
+    PooledAllocator::getInstance().purge();
+}
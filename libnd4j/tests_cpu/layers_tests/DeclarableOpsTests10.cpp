@@ -210,6 +210,34 @@ TEST_F(DeclarableOpsTests10, Where_SGO_Test_02) {
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, Where_SGO_Test_03) {
+    // long enough to be compacted in parallel chunks
+    const Nd4jLong rows = 400, cols = 300;
+    NDArray input('c', {rows, cols}, sd::DataType::BOOL);
+    Nd4jLong numTrue = 0;
+    for (Nd4jLong r = 0; r < rows; r++)
+        for (Nd4jLong c = 0; c < cols; c++) {
+            input.r<bool>(r, c) = (r * cols + c) % 3 == 0;
+            numTrue += (r * cols + c) % 3 == 0 ? 1 : 0;
+        }
+
+    NDArray exp('c', {numTrue, 2}, sd::DataType::INT64);
+    Nd4jLong row = 0;
+    for (Nd4jLong e = 0; e < rows * cols; e += 3) {
+        exp.r<Nd4jLong>(row, 0) = e / cols;
+        exp.r<Nd4jLong>(row, 1) = e % cols;
+        row++;
+    }
+
+    sd::ops::Where op;
+    auto res = op.evaluate({&input}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, res.status());
+
+    ASSERT_TRUE(exp.isSameShape(res.at(0)));
+    ASSERT_TRUE(exp.equalsTo(res.at(0)));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests10, WhereNP_SGO_Test_1) {
     auto cond3d = NDArrayFactory::create<bool>('c', {2, 2, 2}, {true, false, false, true, true, true, true, false});
@@ -26,6 +26,9 @@
 #include <array/NDArray.h>
 #include <ops/ops.h>
 #include <helpers/GradCheck.h>
+#include <ops/declarable/helpers/gru.h>
+#include <ops/declarable/helpers/lstmLayer.h>
+#include <ops/declarable/helpers/sru.h>
 #include <array>
 
 
@@ -674,6 +677,65 @@ TEST_F(DeclarableOpsTests15, Test_layer_norm_bp_2) {
     ASSERT_EQ(Status::OK(), status);
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests15, Test_layer_norm_2) {
+    // channels dimension belongs to normalized axes in first case, and doesn't in second one
+    NDArray x('c', {2, 3, 5}, sd::DataType::DOUBLE);
+    NDArray gain('c', {3}, {0.5, -1.5, 2.}, sd::DataType::DOUBLE);
+    NDArray bias('c', {3}, {0.1, 0.2, -0.3}, sd::DataType::DOUBLE);
+    x.linspace(-3., 0.37);
+    x.applyTransform(transform::Sin, x);
+
+    for (const auto &axis : std::vector<std::vector<int>>({{1, 2}, {2}})) {
+        NDArray exp('c', {2, 3, 5}, sd::DataType::DOUBLE);
+        const int tads = axis.size() == 2 ? 2 : 6;
+        const int tadLength = 30 / tads;
+        for (int t = 0; t < tads; t++) {
+            double mean = 0., var = 0.;
+            for (int e = 0; e < tadLength; e++)
+                mean += x.e<double>(t * tadLength + e) / tadLength;
+            for (int e = 0; e < tadLength; e++)
+                var += (x.e<double>(t * tadLength + e) - mean) * (x.e<double>(t * tadLength + e) - mean) / tadLength;
+
+            for (int e = 0; e < tadLength; e++) {
+                const int i = t * tadLength + e;
+                const int c = (i / 5) % 3;
+                exp.p(i, (x.e<double>(i) - mean) / sd::math::nd4j_sqrt<double, double>(var) * gain.e<double>(c) + bias.e<double>(c));
+            }
+        }
+
+        // f-ordered copy goes through strided TADs
+        auto xF = x.dup('f');
+        sd::ops::layer_norm op;
+        for (auto input : {&x, &xF}) {
+            auto result = op.evaluate({input, &gain, &bias}, {}, std::vector<Nd4jLong>(axis.begin(), axis.end()), {true});
+            ASSERT_EQ(Status::OK(), result.status());
+            ASSERT_TRUE(exp.equalsTo(result.at(0)));
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests15, Test_layer_norm_bp_3) {
+    NDArray x('c', {2, 3, 4}, sd::DataType::DOUBLE);
+    NDArray gain('c', {3}, {0.5, -1.5, 2.}, sd::DataType::DOUBLE);
+    NDArray bias('c', {3}, {0.1, 0.2, -0.3}, sd::DataType::DOUBLE);
+    NDArray gradO('c', {2, 3, 4}, sd::DataType::DOUBLE);
+    x.linspace(-3., 0.37);
+    x.applyTransform(transform::Sin, x);
+
+    sd::ops::layer_norm op;
+    sd::ops::layer_norm_bp op_bp;
+
+    for (const auto &axis : std::vector<std::vector<Nd4jLong>>({{1, 2}, {2}})) {
+        const OpArgsHolder argsHolderFF({&x, &gain, &bias}, {}, axis, {true});
+        const OpArgsHolder argsHolderBP({&x, &gain, &bias, &gradO}, {}, axis, {true});
+
+        const bool isGradCorrect = GradCheck::checkGrad(op, op_bp, argsHolderFF, argsHolderBP, {1, 1, 1});
+        ASSERT_TRUE(isGradCorrect);
+    }
+}
+
 TEST_F(DeclarableOpsTests15, test_hashCode_1) {
     auto x = NDArrayFactory::create<int>('c', {10});
     auto y = NDArrayFactory::create<int>('c', {10});
@@ -2079,6 +2141,181 @@ TEST_F(DeclarableOpsTests15, gru_1) {
     ASSERT_TRUE(expH.equalsTo(h));
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests15, gru_2) {
+
+    const int sL = 5;
+    const int bS = 3;
+    const int nIn = 4;
+    const int nOut = 6;
+
+    NDArray x('c', {sL, bS, nIn}, sd::DataType::DOUBLE);
+    NDArray hI('c', {bS, nOut}, sd::DataType::DOUBLE);
+    NDArray Wx('c', {nIn, 3*nOut}, sd::DataType::DOUBLE);
+    NDArray Wh('c', {nOut, 3*nOut}, sd::DataType::DOUBLE);
+    NDArray b('c', {3*nOut}, sd::DataType::DOUBLE);
+
+    x.linspace(-1., 0.03);
+    hI.linspace(-0.5, 0.05);
+    Wx.linspace(0.2, -0.01);
+    Wh.linspace(-0.3, 0.01);
+    b.linspace(-0.1, 0.02);
+
+    // step-by-step reference
+    NDArray expH('c', {sL, bS, nOut}, sd::DataType::DOUBLE);
+    NDArray gates('c', {bS, 3*nOut}, sd::DataType::DOUBLE);
+    for (int t = 0; t < sL; ++t) {
+        auto xt = x(t, {0});
+        auto hPrev = t == 0 ? hI : expH(t-1, {0});
+        auto ht = expH(t, {0});
+        sd::ops::helpers::gruCell(x.getContext(), &xt, &hPrev, &Wx, &Wh, &b, &gates, &ht);
+    }
+
+    sd::ops::gru op;
+    auto results = op.evaluate({&x, &hI, &Wx, &Wh, &b}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results.status());
+
+    auto* h = results.at(0);
+
+    ASSERT_TRUE(expH.isSameShape(h));
+    ASSERT_TRUE(expH.equalsTo(h, 1e-10));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests15, lstmLayer_fused_1) {
+
+    const int sL = 5;
+    const int bS = 3;
+    const int nIn = 4;
+    const int nOut = 6;
+
+    NDArray x('c', {sL, bS, nIn}, sd::DataType::DOUBLE);
+    NDArray Wx('c', {nIn, 4*nOut}, sd::DataType::DOUBLE);
+    NDArray Wr('c', {nOut, 4*nOut}, sd::DataType::DOUBLE);
+    NDArray b('c', {4*nOut}, sd::DataType::DOUBLE);
+    NDArray hI('c', {bS, nOut}, sd::DataType::DOUBLE);
+    NDArray cI('c', {bS, nOut}, sd::DataType::DOUBLE);
+    NDArray Wp('c', {3*nOut}, sd::DataType::DOUBLE);
+
+    x.linspace(-1., 0.03);
+    Wx.linspace(0.2, -0.01);
+    Wr.linspace(-0.3, 0.01);
+    b.linspace(-0.1, 0.02);
+    hI.linspace(-0.5, 0.05);
+    cI.linspace(0.7, -0.07);
+    Wp.linspace(-0.2, 0.03);
+
+    // {dataFormat, directionMode, cellClip, gateAct, gateAlpha, gateBeta, cellAct, cellAlpha, cellBeta, outAct, outAlpha, outBeta}
+    const std::vector<float> params = {0, 0, 0.9f, 2, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    // step-by-step reference
+    NDArray expH('c', {sL, bS, nOut}, sd::DataType::DOUBLE);
+    NDArray expC('c', {sL, bS, nOut}, sd::DataType::DOUBLE);
+    for (int t = 0; t < sL; ++t) {
+        auto xt = x(t, {0});
+        auto hPrev = t == 0 ? hI : expH(t-1, {0});
+        auto cPrev = t == 0 ? cI : expC(t-1, {0});
+        auto ht = expH(t, {0});
+        auto ct = expC(t, {0});
+        sd::ops::helpers::lstmLayerCell(&xt, &Wx, &Wr, &b, &hPrev, &cPrev, &Wp, params, &ht, &ct);
+    }
+
+    NDArray h('c', {sL, bS, nOut}, sd::DataType::DOUBLE);
+    NDArray hL('c', {bS, nOut}, sd::DataType::DOUBLE);
+    NDArray cL('c', {bS, nOut}, sd::DataType::DOUBLE);
+
+    sd::ops::helpers::lstmLayerTimeLoop(&x, &Wx, &Wr, &b, nullptr, &hI, &cI, &Wp, params, true, &h, &hL, &cL);
+
+    ASSERT_TRUE(expH.equalsTo(h, 1e-10));
+    ASSERT_TRUE(expH(sL-1, {0}).equalsTo(hL, 1e-10));
+    ASSERT_TRUE(expC(sL-1, {0}).equalsTo(cL, 1e-10));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests15, lstmLayer_fused_2) {
+
+    const int sL = 4;
+    const int bS = 2;
+    const int nIn = 3;
+    const int nOut = 5;
+
+    // [bS, sL, nIn], backward direction
+    NDArray x('c', {bS, sL, nIn}, sd::DataType::FLOAT32);
+    NDArray Wx('c', {nIn, 4*nOut}, sd::DataType::FLOAT32);
+    NDArray Wr('c', {nOut, 4*nOut}, sd::DataType::FLOAT32);
+    NDArray b('c', {4*nOut}, sd::DataType::FLOAT32);
+
+    x.linspace(0.5, -0.04);
+    Wx.linspace(-0.15, 0.01);
+    Wr.linspace(0.1, -0.01);
+    b.linspace(0.05, -0.01);
+
+    const std::vector<float> params = {1, 1, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    NDArray expH('c', {bS, sL, nOut}, sd::DataType::FLOAT32);
+    NDArray hPrev('c', {bS, nOut}, sd::DataType::FLOAT32);
+    NDArray cPrev('c', {bS, nOut}, sd::DataType::FLOAT32);
+    NDArray ct('c', {bS, nOut}, sd::DataType::FLOAT32);
+    hPrev.nullify();
+    cPrev.nullify();
+    for (int t = sL - 1; t >= 0; --t) {
+        auto xt = x(t, {1});
+        auto ht = expH(t, {1});
+        sd::ops::helpers::lstmLayerCell(&xt, &Wx, &Wr, &b, &hPrev, &cPrev, nullptr, params, &ht, &ct);
+        hPrev.assign(ht);
+        cPrev.assign(ct);
+    }
+
+    NDArray h('c', {bS, sL, nOut}, sd::DataType::FLOAT32);
+    NDArray hL('c', {bS, nOut}, sd::DataType::FLOAT32);
+
+    sd::ops::helpers::lstmLayerTimeLoop(&x, &Wx, &Wr, &b, nullptr, nullptr, nullptr, nullptr, params, false, &h, &hL, nullptr);
+
+    ASSERT_TRUE(expH.equalsTo(h, 1e-5));
+    ASSERT_TRUE(hPrev.equalsTo(hL, 1e-5));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests15, sru_fused_1) {
+
+    const int bS = 3;
+    const int inSize = 4;
+    const int time = 5;
+
+    NDArray x('c', {bS, inSize, time}, sd::DataType::DOUBLE);
+    NDArray w('c', {3*inSize, inSize}, sd::DataType::DOUBLE);
+    NDArray b('c', {2*inSize}, sd::DataType::DOUBLE);
+    NDArray c0('c', {bS, inSize}, sd::DataType::DOUBLE);
+
+    x.linspace(-0.7, 0.02);
+    w.linspace(0.3, -0.01);
+    b.linspace(-0.2, 0.05);
+    c0.linspace(0.4, -0.06);
+
+    // step-by-step reference
+    auto wT = w.transpose();
+    NDArray expH('c', {bS, inSize, time}, sd::DataType::DOUBLE);
+    NDArray expC('c', {bS, inSize, time}, sd::DataType::DOUBLE);
+    NDArray ct_1(c0);
+    for (int t = 0; t < time; ++t) {
+        auto xt = x(t, {2});
+        auto ht = expH(t, {2});
+        auto ct = expC(t, {2});
+        sd::ops::helpers::sruCell(x.getContext(), &xt, &ct_1, &wT, &b, &ht, &ct);
+        ct_1.assign(ct);
+    }
+
+    sd::ops::sru op;
+    auto results = op.evaluate({&x, &w, &b, &c0}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results.status());
+
+    ASSERT_TRUE(expH.isSameShape(results.at(0)));
+    ASSERT_TRUE(expH.equalsTo(results.at(0), 1e-10));
+    ASSERT_TRUE(expC.equalsTo(results.at(1), 1e-10));
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests15, sqrtm_1) {
 
@@ -161,6 +161,41 @@ TEST_F(DeclarableOpsTests3, Test_Unique_2) {
     ASSERT_TRUE(expC.equalsTo(c));
 }
 
+TEST_F(DeclarableOpsTests3, Test_Unique_3) {
+    // long enough to be grouped by several threads, values are sparse ids
+    const Nd4jLong length = 300000, numIds = 1000;
+    NDArray x('c', {length}, sd::DataType::INT64);
+    for (Nd4jLong e = 0; e < length; e++)
+        x.r<Nd4jLong>(e) = ((e * 7919) % numIds) * 1000000007LL;
+
+    // first appearances are 0 ... numIds - 1, since 7919 and numIds are coprime
+    NDArray expV('c', {numIds}, sd::DataType::INT64);
+    NDArray expI('c', {length}, sd::DataType::INT64);
+    NDArray expC('c', {numIds}, sd::DataType::INT64);
+    for (Nd4jLong e = 0; e < numIds; e++) {
+        expV.r<Nd4jLong>(e) = x.e<Nd4jLong>(e);
+        expC.r<Nd4jLong>(e) = length / numIds;
+    }
+
+    for (Nd4jLong e = 0; e < length; e++)
+        expI.r<Nd4jLong>(e) = e % numIds;
+
+    sd::ops::unique_with_counts op;
+    auto result = op.evaluate({&x}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result.status());
+    ASSERT_EQ(3, result.size());
+
+    ASSERT_TRUE(expV.isSameShape(result.at(0)));
+    ASSERT_TRUE(expV.equalsTo(result.at(0)));
+
+    ASSERT_TRUE(expI.isSameShape(result.at(1)));
+    ASSERT_TRUE(expI.equalsTo(result.at(1)));
+
+    ASSERT_TRUE(expC.isSameShape(result.at(2)));
+    ASSERT_TRUE(expC.equalsTo(result.at(2)));
+}
+
 TEST_F(DeclarableOpsTests3, Test_Rint_1) {
     auto x= NDArrayFactory::create<float>('c', {1, 7}, {-1.7f, -1.5f, -0.2f, 0.2f, 1.5f, 1.7f, 2.0f});
     auto exp= NDArrayFactory::create<float>('c', {1, 7}, {-2.f, -2.f, -0.f, 0.f, 2.f, 2.f, 2.f});
@@ -1406,6 +1406,58 @@ TEST_F(DeclarableOpsTests5, Test_TopK_5) {
 
 }
 
+///////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, Test_TopK_6) {
+    // equal values are ordered by their indices
+    auto x = NDArrayFactory::create<float>('c', {2, 6}, {1.f, 5.f, 5.f, 5.f, 2.f, 7.f, 3.f, 3.f, 3.f, 3.f, 3.f, 3.f});
+    auto expV = NDArrayFactory::create<float>('c', {2, 3}, {7.f, 5.f, 5.f, 3.f, 3.f, 3.f});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {2, 3}, {5, 1, 2, 0, 1, 2});
+
+    sd::ops::top_k op;
+    auto result = op.evaluate({&x}, {}, {3}, {true});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result.status());
+
+    auto v = result.at(0);
+    auto i = result.at(1);
+
+    ASSERT_TRUE(expV.isSameShape(v));
+    ASSERT_TRUE(expV.equalsTo(v));
+
+    ASSERT_TRUE(expI.isSameShape(i));
+    ASSERT_TRUE(expI.equalsTo(i));
+}
+
+///////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, Test_TopK_7) {
+    // rows wide enough to be split between threads
+    const Nd4jLong width = 300000;
+    auto x = NDArrayFactory::create<float>('c', {2, width});
+    x.linspace(0.f);
+    x.p(17, 1.e7f);
+    x.p(width + 5, 1.e7f);
+
+    auto expV = NDArrayFactory::create<float>('c', {2, 3}, {1.e7f, (float) width - 1, (float) width - 2, 1.e7f, (float) 2 * width - 1, (float) 2 * width - 2});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {2, 3}, {17, width - 1, width - 2, 5, width - 1, width - 2});
+
+    sd::ops::top_k op;
+    auto result = op.evaluate({&x}, {}, {3}, {true});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result.status());
+
+    auto v = result.at(0);
+    auto i = result.at(1);
+
+    ASSERT_TRUE(expV.equalsTo(v));
+    ASSERT_TRUE(expI.equalsTo(i));
+
+    result = op.evaluate({&x}, {}, {3}, {false});
+    ASSERT_EQ(ND4J_STATUS_OK, result.status());
+
+    auto expUnsorted = NDArrayFactory::create<Nd4jLong>('c', {2, 3}, {17, width - 2, width - 1, 5, width - 2, width - 1});
+    ASSERT_TRUE(expUnsorted.equalsTo(result.at(1)));
+}
+
 ///////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests5, Test_Moments_1) {
     auto x = NDArrayFactory::create<double>('c', {2, 3, 4}, {11.0, 3.0, 14.0, 5.0,
@@ -2137,6 +2189,93 @@ TEST_F(DeclarableOpsTests5, DynamicStitch_2) {
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(DeclarableOpsTests5, DynamicPartition_large_1) {
+    const int numRows = 50000;
+    const int numPartition = 300;
+
+    // f-ordered input, so rows aren't contiguous
+    auto x = NDArrayFactory::create<float>('f', {numRows, 3});
+    x.linspace(1.f);
+    auto y = NDArrayFactory::create<int>('c', {numRows});
+    for (int e = 0; e < numRows; e++)
+        y.p(e, (e * 7919) % numPartition);
+
+    sd::ops::dynamic_partition op;
+    auto result = op.evaluate({&x, &y}, {}, {numPartition});
+    ASSERT_EQ(ND4J_STATUS_OK, result.status());
+    ASSERT_EQ(numPartition, result.size());
+
+    std::vector<int> positions(numPartition, 0);
+    for (int e = 0; e < numRows; e++) {
+        auto p = y.e<int>(e);
+        auto z = result.at(p);
+        auto r = positions[p]++;
+
+        for (int k = 0; k < 3; k++)
+            ASSERT_EQ(x.e<float>(e, k), z->e<float>(r, k));
+    }
+
+    for (int p = 0; p < numPartition; p++)
+        ASSERT_EQ(positions[p], result.at(p)->sizeAt(0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(DeclarableOpsTests5, DynamicStitch_duplicates_1) {
+    auto x1 = NDArrayFactory::create<int>({1, 0, 1});
+    auto x2 = NDArrayFactory::create<int>({0, 2});
+    auto y1 = NDArrayFactory::create<double>('c', {3, 2}, {1., 2., 3., 4., 5., 6.});
+    auto y2 = NDArrayFactory::create<double>('c', {2, 2}, {7., 8., 9., 10.});
+
+    // the last occurrence of every index wins
+    auto exp = NDArrayFactory::create<double>('c', {3, 2}, {7., 8., 5., 6., 9., 10.});
+
+    sd::ops::dynamic_stitch op;
+    auto result = op.evaluate({&x1, &x2, &y1, &y2}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result.status());
+
+    auto output = result.at(0);
+    ASSERT_TRUE(exp.isSameShape(output));
+    ASSERT_TRUE(exp.equalsTo(output));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(DeclarableOpsTests5, DynamicStitch_large_1) {
+    const int numRows = 40000;
+    const int numPartition = 17;
+
+    auto x = NDArrayFactory::create<double>('c', {numRows, 4});
+    x.linspace(1.);
+    auto positions = NDArrayFactory::create<int>('c', {numRows});
+    positions.linspace(0);
+    auto y = NDArrayFactory::create<int>('c', {numRows});
+    for (int e = 0; e < numRows; e++)
+        y.p(e, (e / 3) % numPartition);
+
+    // partitioning of positions gives stitch indices, which restore original order
+    sd::ops::dynamic_partition partition;
+    auto data = partition.evaluate({&x, &y}, {}, {numPartition});
+    auto indices = partition.evaluate({&positions, &y}, {}, {numPartition});
+    ASSERT_EQ(ND4J_STATUS_OK, data.status());
+    ASSERT_EQ(ND4J_STATUS_OK, indices.status());
+
+    std::vector<NDArray*> inputs;
+    for (int p = 0; p < numPartition; p++)
+        inputs.emplace_back(indices.at(p));
+    for (int p = 0; p < numPartition; p++)
+        inputs.emplace_back(data.at(p));
+
+    sd::ops::dynamic_stitch op;
+    auto result = op.evaluate(inputs, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result.status());
+
+    ASSERT_TRUE(x.isSameShape(result.at(0)));
+    ASSERT_TRUE(x.equalsTo(result.at(0)));
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests5, fusedBatchNorm_test1) {
 
@@ -769,6 +769,77 @@ TEST_F(DeclarableOpsTests6, cumSum_20) {
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, cumSum_21) {
+
+    // long enough to be scanned in parallel chunks
+    const Nd4jLong length = 200000;
+    NDArray x('c', {length}, sd::DataType::DOUBLE);
+    for (Nd4jLong e = 0; e < length; e++)
+        x.r<double>(e) = (double) (e % 7);
+
+    sd::ops::cumsum op;
+    for (int exclusive = 0; exclusive < 2; exclusive++) {
+        for (int reverse = 0; reverse < 2; reverse++) {
+            NDArray exp('c', {length}, sd::DataType::DOUBLE);
+            double sum = 0.;
+            for (Nd4jLong i = 0; i < length; i++) {
+                const auto e = reverse ? length - 1 - i : i;
+                if (!exclusive)
+                    sum += x.e<double>(e);
+
+                exp.r<double>(e) = sum;
+
+                if (exclusive)
+                    sum += x.e<double>(e);
+            }
+
+            auto result = op.evaluate({&x}, {}, {exclusive, reverse});
+            ASSERT_EQ(Status::OK(), result.status());
+            ASSERT_TRUE(exp.equalsTo(result.at(0)));
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, cumSum_22) {
+
+    const Nd4jLong rows = 3, cols = 60000;
+    NDArray x('c', {rows, cols}, sd::DataType::DOUBLE);
+    for (Nd4jLong r = 0; r < rows; r++)
+        for (Nd4jLong c = 0; c < cols; c++)
+            x.r<double>(r, c) = (double) ((r + c) % 5);
+
+    // few long TADs along last axis, exclusive and reverse
+    NDArray exp1('c', {rows, cols}, sd::DataType::DOUBLE);
+    for (Nd4jLong r = 0; r < rows; r++) {
+        double sum = 0.;
+        for (Nd4jLong c = cols - 1; c >= 0; c--) {
+            exp1.r<double>(r, c) = sum;
+            sum += x.e<double>(r, c);
+        }
+    }
+
+    // many short strided TADs along first axis
+    NDArray exp0('c', {rows, cols}, sd::DataType::DOUBLE);
+    for (Nd4jLong c = 0; c < cols; c++) {
+        double sum = 0.;
+        for (Nd4jLong r = 0; r < rows; r++) {
+            sum += x.e<double>(r, c);
+            exp0.r<double>(r, c) = sum;
+        }
+    }
+
+    sd::ops::cumsum op;
+    auto result1 = op.evaluate({&x}, {}, {1, 1, 1});
+    ASSERT_EQ(Status::OK(), result1.status());
+    ASSERT_TRUE(exp1.equalsTo(result1.at(0)));
+
+    auto result0 = op.evaluate({&x}, {}, {0, 0, 0});
+    ASSERT_EQ(Status::OK(), result0.status());
+    ASSERT_TRUE(exp0.equalsTo(result0.at(0)));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests6, TestMergeMaxIndex_1) {
 
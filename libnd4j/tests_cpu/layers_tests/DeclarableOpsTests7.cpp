@@ -2108,6 +2108,30 @@ TEST_F(DeclarableOpsTests7, TestUnsortedSegmentSum_3) {
     
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, TestUnsortedSegmentSum_Large_1) {
+    // long enough to be grouped by several threads
+    const Nd4jLong length = 200000, numClasses = 37;
+    NDArray x('c', {length, 2}, sd::DataType::DOUBLE);
+    NDArray idx('c', {length}, sd::DataType::INT32);
+    NDArray exp('c', {numClasses, 2}, sd::DataType::DOUBLE);
+
+    for (Nd4jLong e = 0; e < length; e++) {
+        const int c = (int) ((e * 13) % numClasses);
+        idx.r<int>(e) = c;
+        x.r<double>(e, 0) = (double) (e % 10);
+        x.r<double>(e, 1) = 1.;
+        exp.r<double>(c, 0) += (double) (e % 10);
+        exp.r<double>(c, 1) += 1.;
+    }
+
+    sd::ops::unsorted_segment_sum op;
+
+    auto result = op.evaluate({&x, &idx}, {}, {numClasses});
+    ASSERT_EQ(result.status(), Status::OK());
+    ASSERT_TRUE(exp.equalsTo(result.at(0)));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests7, TestUnsortedSegmentSum_4) {
     auto x = NDArrayFactory::create<double>('c', {4, 4, 4}, {91. ,  82. ,  37. ,  64. ,55.1,  46.4,  73. ,  28. ,119.1,  12.1, 112.7,  13.1,14. , 114.2,  16.2, 117. ,51. ,  42. ,  67. ,   24.,15.1,  56.4,  93. ,   28.,
@@ -30,6 +30,10 @@
 #include <array/NDArray.h>
 #include <ops/declarable/DeclarableOp.h>
 #include <ops/declarable/generic/parity_ops.cpp>
+#include <ops/declarable/CustomOperations.h>
+#include <graph/execution/MemoryPlanner.h>
+#include <graph/execution/ElementwiseFusion.h>
+#include <chrono>
 
 using namespace sd;
 using namespace sd::graph;
@@ -1638,3 +1642,259 @@ TEST_F(GraphTests, Test_Minifier_3) {
     //ASSERT_EQ(0, unlink("libnd4j_mini3.hpp"));
 
 }
+
+TEST_F(GraphTests, Test_Inter_Op_Parallelism_1) {
+    // Inception-like block: 4 independent branches of matmuls, joined by adds
+    sd::ops::matmul mmul;
+    sd::ops::add add;
+
+    auto buildGraph = [&] () -> Graph* {
+        auto graph = new Graph();
+
+        auto x = NDArrayFactory::create_<float>('c', {256, 256});
+        auto w = NDArrayFactory::create_<float>('c', {256, 256});
+        x->linspace(0.001f, 0.0001f);
+        w->linspace(-0.003f, 0.00001f);
+
+        graph->getVariableSpace()->putVariable(-1, x);
+        graph->getVariableSpace()->putVariable(-2, w);
+
+        for (int b = 0; b < 4; b++) {
+            graph->addNode(new Node(&mmul, 10 * (b + 1) + 1, {-1, -2}));
+            graph->addNode(new Node(&mmul, 10 * (b + 1) + 2, {10 * (b + 1) + 1, -2}));
+            graph->addNode(new Node(&mmul, 10 * (b + 1) + 3, {10 * (b + 1) + 2, -2}));
+        }
+
+        graph->addNode(new Node(&add, 100, {13, 23}));
+        graph->addNode(new Node(&add, 101, {33, 43}));
+        graph->addNode(new Node(&add, 102, {100, 101}));
+
+        return graph;
+    };
+
+    auto &env = sd::Environment::getInstance();
+    const auto interOpThreads = env.interOpThreads();
+    const int iterations = 10;
+
+    std::vector<Nd4jLong> times[2];
+    NDArray results[2];
+    for (int e = 0; e < 2; e++) {
+        env.setInterOpThreads(e == 0 ? 1 : 4);
+
+        for (int i = 0; i < iterations; i++) {
+            auto graph = buildGraph();
+
+            auto timeStart = std::chrono::system_clock::now();
+            ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+            auto timeEnd = std::chrono::system_clock::now();
+            times[e].emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+
+            ASSERT_TRUE(graph->getVariableSpace()->hasVariable(102));
+            results[e] = graph->getVariableSpace()->getVariable(102)->getNDArray()->dup();
+
+            delete graph;
+        }
+
+        std::sort(times[e].begin(), times[e].end());
+    }
+
+    env.setInterOpThreads(interOpThreads);
+
+    ASSERT_TRUE(results[0].equalsTo(results[1]));
+
+    nd4j_printf("Branched graph: sequential %lld us; 4 inter-op threads %lld us; speedup %.2fx\n", times[0][iterations / 2], times[1][iterations / 2], (double) times[0][iterations / 2] / times[1][iterations / 2]);
+}
+
+TEST_F(GraphTests, Test_Inter_Op_Switch_Merge_1) {
+    // Switch picks one of two branches, Merge takes output of the active one. independent node keeps graph wide
+    sd::ops::eq_scalar eqOp;
+    sd::ops::Switch switchOp;
+
+    auto buildGraph = [&] (float condition) -> Graph* {
+        auto graph = new Graph();
+        auto variableSpace = graph->getVariableSpace();
+
+        auto input = NDArrayFactory::create_<float>('c', {32, 100});
+        input->assign(-119.0f);
+
+        auto conditionX = NDArrayFactory::create_<float>('c', {1, 1});
+        conditionX->p(0, condition);
+        auto conditionY = NDArrayFactory::create_<float>('c', {1, 1});
+        conditionY->p(0, 0.0f);
+
+        variableSpace->putVariable(-1, input);
+        variableSpace->putVariable(-2, conditionX);
+        variableSpace->putVariable(-3, conditionY);
+
+        auto nodeZ0 = new Node(OpType_TRANSFORM_SAME, transform::Abs, 4, {}, {});
+        nodeZ0->pickInput(3, 0);
+        auto nodeZ1 = new Node(OpType_TRANSFORM_SAME, transform::OneMinus, 5, {}, {});
+        nodeZ1->pickInput(3, 1);
+
+        graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2}));
+        graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 2, {1}, {3}));
+        graph->addNode(new Node(&eqOp, 119, {-2, -3}));
+        graph->addNode(new Node(&switchOp, 3, {2, 119}, {4, 5}));
+        graph->addNode(nodeZ0);
+        graph->addNode(nodeZ1);
+        graph->addNode(new Node(OpType_LOGIC, logic::Merge, 6, {4, 5}));
+        graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Neg, 7, {-1}));
+
+        return graph;
+    };
+
+    auto &env = sd::Environment::getInstance();
+    const auto interOpThreads = env.interOpThreads();
+
+    for (int t : {1, 4}) {
+        env.setInterOpThreads(t);
+
+        for (float condition : {0.0f, 1.0f}) {
+            auto graph = buildGraph(condition);
+            FlowPath flowPath;
+            graph->getVariableSpace()->setFlowPath(&flowPath);
+
+            ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+
+            // condition is TRUE for 0.0, so :1 branch is active, and :0 otherwise
+            const bool isTrue = condition == 0.0f;
+            ASSERT_EQ(!isTrue, flowPath.isNodeActive(4));
+            ASSERT_EQ(isTrue, flowPath.isNodeActive(5));
+
+            ASSERT_TRUE(graph->getVariableSpace()->hasVariable(6));
+            auto z = graph->getVariableSpace()->getVariable(6)->getNDArray();
+            ASSERT_NEAR(isTrue ? -118.f : 119.f, z->e<float>(0), 1e-5f);
+
+            ASSERT_NEAR(119.f, graph->getVariableSpace()->getVariable(7)->getNDArray()->e<float>(0), 1e-5f);
+
+            delete graph;
+        }
+    }
+
+    env.setInterOpThreads(interOpThreads);
+}
+
+TEST_F(GraphTests, Test_Memory_Planner_1) {
+    // chain of matmuls: every intermediate is consumed by the next node only
+    sd::ops::matmul mmul;
+    sd::ops::add add;
+
+    auto buildGraph = [&] (Nd4jLong rows) -> Graph* {
+        auto graph = new Graph();
+
+        auto x = NDArrayFactory::create_<float>('c', {rows, 64});
+        auto w = NDArrayFactory::create_<float>('c', {64, 64});
+        x->linspace(0.001f, 0.0001f);
+        w->linspace(-0.003f, 0.0001f);
+
+        graph->getVariableSpace()->putVariable(-1, x);
+        graph->getVariableSpace()->putVariable(-2, w);
+
+        graph->addNode(new Node(&mmul, 1, {-1, -2}));
+        for (int e = 2; e <= 6; e++)
+            graph->addNode(new Node(&mmul, e, {e - 1, -2}));
+
+        graph->addNode(new Node(&add, 7, {6, 1}));
+
+        return graph;
+    };
+
+    auto &env = sd::Environment::getInstance();
+    const auto memoryPlanning = env.isMemoryPlanning();
+    auto &planner = MemoryPlanner::getInstance();
+    planner.purge();
+
+    env.setMemoryPlanning(false);
+    auto graph = buildGraph(32);
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+    auto exp = graph->getVariableSpace()->getVariable(7)->getNDArray()->dup();
+    delete graph;
+
+    env.setMemoryPlanning(true);
+    for (int i = 0; i < 3; i++) {
+        graph = buildGraph(32);
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+
+        // first run builds plan, next ones use it
+        ASSERT_EQ(1, planner.numberOfPlans());
+        ASSERT_EQ(i > 0, graph->getVariableSpace()->getVariable(3)->isPlanned());
+        ASSERT_FALSE(graph->getVariableSpace()->getVariable(7)->isPlanned());
+        ASSERT_TRUE(exp.equalsTo(graph->getVariableSpace()->getVariable(7)->getNDArray()));
+
+        delete graph;
+    }
+
+    graph = buildGraph(32);
+    graph->buildGraph();
+    auto signature = MemoryPlanner::signature(graph, graph->getVariableSpace());
+    delete graph;
+
+    auto plan = planner.plan(signature);
+    ASSERT_TRUE(plan != nullptr);
+    ASSERT_EQ(6, (int) plan->tensors().size());
+
+    // output of node 1 lives till the end, so only 3 arrays are alive at once
+    ASSERT_EQ(6 * 32 * 64 * sizeof(float), plan->totalSize());
+    ASSERT_EQ(3 * 32 * 64 * sizeof(float), plan->arenaSize());
+
+    // other input shapes get their own plan
+    graph = buildGraph(16);
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+    ASSERT_EQ(2, planner.numberOfPlans());
+    delete graph;
+
+    env.setMemoryPlanning(memoryPlanning);
+    planner.purge();
+}
+
+TEST_F(GraphTests, Test_Elementwise_Fusion_1) {
+    // abs(x) is consumed by the last node only, so everything but it ends up in node 6
+    auto buildGraph = [] () -> Graph* {
+        auto graph = new Graph();
+
+        auto x = NDArrayFactory::create_<float>('c', {17, 129});
+        auto y = NDArrayFactory::create_<float>('c', {17, 129});
+        x->linspace(-1.f, 0.001f);
+        y->linspace(0.5f, -0.0003f);
+
+        graph->getVariableSpace()->putVariable(-1, x);
+        graph->getVariableSpace()->putVariable(-2, y);
+
+        graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Neg, 1, {-1}));
+        graph->addNode(new Node(OpType_SCALAR, scalar::Multiply, 2, {1}, {}, {}, 2.0f));
+        graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Tanh, 3, {2}));
+        graph->addNode(new Node(OpType_PAIRWISE, pairwise::Add, 4, {3, -2}));
+        graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 5, {-1}));
+        graph->addNode(new Node(OpType_PAIRWISE, pairwise::Multiply, 6, {4, 5}));
+
+        return graph;
+    };
+
+    auto &env = sd::Environment::getInstance();
+    const auto elementwiseFusion = env.isElementwiseFusion();
+
+    env.setElementwiseFusion(false);
+    auto graph = buildGraph();
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+    ASSERT_EQ(6, graph->totalNodes());
+    auto exp = graph->getVariableSpace()->getVariable(6)->getNDArray()->dup();
+    delete graph;
+
+    env.setElementwiseFusion(true);
+    graph = buildGraph();
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+    ASSERT_EQ(2, graph->totalNodes());
+    ASSERT_TRUE(exp.equalsTo(graph->getVariableSpace()->getVariable(6)->getNDArray()));
+
+    auto node = graph->getMapped()->at(6);
+    ASSERT_EQ(OpType_CUSTOM, node->opType());
+    ASSERT_EQ(3, (int) node->input()->size());
+
+    // second run reuses fused graph as is
+    ASSERT_EQ(0, ElementwiseFusion::apply(graph));
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+    ASSERT_TRUE(exp.equalsTo(graph->getVariableSpace()->getVariable(6)->getNDArray()));
+    delete graph;
+
+    env.setElementwiseFusion(elementwiseFusion);
+}
@@ -1544,6 +1544,95 @@ TEST_F(HelpersTests1, mmulHelper_test_7) {
 
 }
 
+////////////////////////////////////////////////////////////////////
+static void fillSmallIntegers(NDArray &array, int range) {
+    for (Nd4jLong e = 0; e < array.lengthOf(); e++)
+        array.p(e, (float) ((e * 7 + 3) % (2 * range + 1) - range));
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulHelper_test_8) {
+
+    NDArray x('c', {37, 53}, sd::DataType::FLOAT32);
+    NDArray y('f', {53, 29}, sd::DataType::FLOAT32);
+    NDArray z('c', {37, 29}, sd::DataType::FLOAT32);
+    fillSmallIntegers(x, 3);
+    fillSmallIntegers(y, 3);
+
+    MmulHelper::mmul(&x, &y, &z, 1., 0.);
+
+    // packed gemm accumulates in fp32, so integer products are exact before final rounding
+    auto xb = x.cast(sd::DataType::BFLOAT16);
+    auto yb = y.cast(sd::DataType::BFLOAT16);
+    NDArray zb('f', {37, 29}, sd::DataType::BFLOAT16);
+
+    MmulHelper::mmul(&xb, &yb, &zb, 1., 0.);
+
+    ASSERT_TRUE(z.cast(sd::DataType::BFLOAT16).equalsTo(&zb));
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulHelper_test_9) {
+
+    NDArray x('f', {19, 40}, sd::DataType::FLOAT32);
+    NDArray y('c', {40, 67}, sd::DataType::FLOAT32);
+    NDArray z('c', {19, 67}, sd::DataType::FLOAT32);
+    fillSmallIntegers(x, 1);
+    fillSmallIntegers(y, 1);
+
+    MmulHelper::mmul(&x, &y, &z, 1., 0.);
+
+    auto xi = x.cast(sd::DataType::INT8);
+    auto yi = y.cast(sd::DataType::INT8);
+    NDArray zi('c', {19, 67}, sd::DataType::INT8);
+
+    MmulHelper::mmul(&xi, &yi, &zi, 1., 0.);
+
+    ASSERT_TRUE(z.cast(sd::DataType::INT8).equalsTo(&zi));
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulHelper_test_10) {
+
+    NDArray x('c', {3, 17, 9}, sd::DataType::FLOAT32);
+    NDArray y('c', {3, 9, 11}, sd::DataType::FLOAT32);
+    NDArray z('c', {3, 17, 11}, sd::DataType::FLOAT32);
+    fillSmallIntegers(x, 5);
+    fillSmallIntegers(y, 5);
+
+    MmulHelper::mmul(&x, &y, &z, 1., 0.);
+
+    auto xi = x.cast(sd::DataType::INT32);
+    auto yi = y.cast(sd::DataType::INT32);
+    NDArray zi('c', {3, 17, 11}, sd::DataType::INT32);
+
+    MmulHelper::mmul(&xi, &yi, &zi, 1., 0.);
+
+    ASSERT_TRUE(z.cast(sd::DataType::INT32).equalsTo(&zi));
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulHelper_test_11) {
+
+    NDArray x('c', {8, 12}, sd::DataType::FLOAT32);
+    NDArray y('c', {12, 70}, sd::DataType::FLOAT32);
+    NDArray z('c', {8, 70}, sd::DataType::FLOAT32);
+    fillSmallIntegers(x, 2);
+    fillSmallIntegers(y, 2);
+    z.assign(1.f);
+
+    MmulHelper::mmul(&x, &y, &z, 2., 3.);
+
+    auto xh = x.cast(sd::DataType::HALF);
+    auto yh = y.cast(sd::DataType::HALF);
+    NDArray zh('c', {8, 70}, sd::DataType::HALF);
+    zh.assign(1.f);
+
+    MmulHelper::mmul(&xh, &yh, &zh, 2., 3.);
+
+    ASSERT_TRUE(z.cast(sd::DataType::HALF).equalsTo(&zh));
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(HelpersTests1, tensordot_test_1) {
 
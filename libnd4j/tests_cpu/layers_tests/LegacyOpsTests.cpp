@@ -33,6 +33,7 @@
 #include <ops/declarable/LegacyBroadcastOp.h>
 #include <helpers/TAD.h>
 #include <helpers/ConstantTadHelper.h>
+#include <system/CpuDispatch.h>
 
 using namespace sd;
 using namespace sd::ops;
@@ -768,3 +769,58 @@ TEST_F(LegacyOpsTests, test_legacy_transform_float_1) {
 
     NativeOpExecutioner::execTransformFloat(LaunchContext::defaultContext(), transform::FloatOps::RSqrt, x.buffer(), x.shapeInfo(), x.specialBuffer(), x.specialShapeInfo(), x.buffer(), x.shapeInfo(), x.specialBuffer(), x.specialShapeInfo(), nullptr, nullptr, nullptr);
 }
+
+TEST_F(LegacyOpsTests, test_cpu_dispatch_levels_1) {
+    if (!Environment::getInstance().isCPU())
+        return;
+
+    auto x = NDArrayFactory::create<float>('c', {37, 129});
+    auto y = NDArrayFactory::create<float>('c', {37, 129});
+    auto row = NDArrayFactory::create<float>('c', {129});
+    auto h = NDArrayFactory::create<float16>('c', {37, 129});
+    x.linspace(-3.0, 0.01);
+    y.linspace(2.0, 0.003);
+    row.linspace(1.0, 0.5);
+    h.linspace(-1.0, 0.01);
+
+    // strided views go through EWSNONZERO paths
+    auto xs = x({0,0,1, 0,128,2}, true, true);
+    auto ys = y({0,0,1, 1,129,2}, true, true);
+
+    auto run = [&] () {
+        std::vector<NDArray> r;
+        r.emplace_back(x + y);
+        r.emplace_back(xs * ys);
+        r.emplace_back(x * 1.5f);
+        r.emplace_back(h - float16(0.25f));
+        r.emplace_back(x + row);
+        r.emplace_back(x.transform(transform::Tanh));
+        r.emplace_back(x.transform(transform::Sqrt));
+        r.emplace_back(xs.transform(transform::Sigmoid));
+        r.emplace_back(x.reduceNumber(reduce::Mean));
+        r.emplace_back(xs.reduceNumber(reduce::Norm2));
+        return r;
+    };
+
+    auto detected = CpuDispatch::detectedLevel();
+    auto level = CpuDispatch::level();
+
+    CpuDispatch::setLevel(CpuDispatch::GENERIC);
+    ASSERT_TRUE(CpuDispatch::level() <= CpuDispatch::GENERIC);
+    auto expected = run();
+
+    for (int l = CpuDispatch::AVX2; l <= detected; l++) {
+        CpuDispatch::setLevel(l);
+        ASSERT_EQ(l, CpuDispatch::level());
+
+        auto result = run();
+        for (int e = 0; e < (int) result.size(); e++)
+            ASSERT_TRUE(expected[e].equalsTo(result[e], 1e-5)) << "level: " << l << "; case: " << e;
+    }
+
+    // level can't go above what CPU supports
+    CpuDispatch::setLevel(CpuDispatch::AVX512 + 1);
+    ASSERT_EQ(detected, CpuDispatch::level());
+
+    CpuDispatch::setLevel(level);
+}
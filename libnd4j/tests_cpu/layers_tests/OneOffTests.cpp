@@ -29,6 +29,8 @@
 #include <memory/MemoryReport.h>
 #include <memory/MemoryUtils.h>
 #include <helpers/MmulHelper.h>
+#include <helpers/MappedFile.h>
+#include <helpers/BitwiseUtils.h>
 
 using namespace sd;
 using namespace sd::ops;
@@ -115,6 +117,70 @@ TEST_F(OneOffTests, test_pad_1D_1) {
     ASSERT_EQ(e, *z);
     delete graph;
 }
+
+// every array of actual graph must be equal to the one of expected graph. If mappedFile is given, arrays must be its views
+static void assertSameArrays(Graph *expected, Graph *actual, const MappedFile *mappedFile = nullptr) {
+    for (auto v : expected->getVariableSpace()->getVariables()) {
+        if (!v->hasNDArray())
+            continue;
+
+        ASSERT_TRUE(actual->getVariableSpace()->hasVariable(v->id(), v->index()));
+        auto m = actual->getVariableSpace()->getVariable(v->id(), v->index());
+        ASSERT_TRUE(m->hasNDArray());
+        ASSERT_EQ(*v->getNDArray(), *m->getNDArray());
+
+        if (mappedFile != nullptr)
+            ASSERT_TRUE(mappedFile->contains(m->getNDArray()->buffer(), m->getNDArray()->lengthOf() * m->getNDArray()->sizeOfT()));
+    }
+}
+
+TEST_F(OneOffTests, test_pad_1D_mapped_1) {
+    // pad_1D.fb holds arrays in BE order, so on LE hosts they're converted into own buffers
+    auto e = NDArrayFactory::create<float>('c', {7}, {10.f,0.778786f, 0.801198f, 0.724375f, 0.230894f, 0.727141f,10.f});
+    auto graph = GraphExecutioner::importFromMappedFlatBuffers("./resources/pad_1D.fb");
+    auto copied = GraphExecutioner::importFromFlatBuffers("./resources/pad_1D.fb");
+
+    ASSERT_TRUE(graph != nullptr);
+    ASSERT_TRUE(copied != nullptr);
+
+    assertSameArrays(copied, graph);
+    delete copied;
+
+    Nd4jStatus status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    auto z = graph->getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_TRUE(z != nullptr);
+    ASSERT_EQ(e, *z);
+
+    delete graph;
+}
+
+TEST_F(OneOffTests, test_pad_1D_mapped_2) {
+    // same graph as pad_1D.fb, but with arrays stored in LE order, so on LE hosts they're used from the mapped file as is
+    auto e = NDArrayFactory::create<float>('c', {7}, {10.f,0.778786f, 0.801198f, 0.724375f, 0.230894f, 0.727141f,10.f});
+    auto mappedFile = std::make_shared<MappedFile>("./resources/pad_1D_le.fb");
+    auto graph = new Graph(GetFlatGraph(mappedFile->data()), nullptr, mappedFile);
+    auto copied = GraphExecutioner::importFromFlatBuffers("./resources/pad_1D.fb");
+
+    ASSERT_TRUE(copied != nullptr);
+
+    assertSameArrays(copied, graph, BitwiseUtils::isBE() ? nullptr : mappedFile.get());
+    delete copied;
+
+    // arrays keep the file mapped on their own
+    mappedFile.reset();
+
+    Nd4jStatus status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    auto z = graph->getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_TRUE(z != nullptr);
+    ASSERT_EQ(e, *z);
+
+    delete graph;
+}
+
 /*
 TEST_F(OneOffTests, test_scatter_nd_update_1) {
 
@@ -705,6 +705,75 @@ TEST_F(ParityOpsTests, Test_Scatter_Add_1) {
 
 }
 
+TEST_F(ParityOpsTests, Test_Scatter_Add_Duplicates_1) {
+    // many updates of few rows, with lock and without it
+    const Nd4jLong rows = 7, cols = 5, numUpd = 5000;
+    NDArray matrix('c', {rows, cols}, sd::DataType::FLOAT32);
+    NDArray idc('c', {numUpd}, sd::DataType::INT64);
+    NDArray updates('c', {numUpd, cols}, sd::DataType::FLOAT32);
+    NDArray exp('c', {rows, cols}, sd::DataType::FLOAT32);
+
+    for (Nd4jLong i = 0; i < numUpd; i++) {
+        idc.r<Nd4jLong>(i) = (i * 31) % rows;
+        for (Nd4jLong j = 0; j < cols; j++) {
+            updates.r<float>(i, j) = (float) ((i + j) % 9);
+            exp.r<float>((i * 31) % rows, j) += (float) ((i + j) % 9);
+        }
+    }
+
+    sd::ops::scatter_add op;
+    for (bool lock : {false, true}) {
+        auto result = op.evaluate({&matrix, &idc, &updates}, {}, {}, {lock});
+        ASSERT_EQ(ND4J_STATUS_OK, result.status());
+        ASSERT_TRUE(exp.equalsTo(result.at(0)));
+    }
+}
+
+TEST_F(ParityOpsTests, Test_Scatter_Max_Duplicates_1) {
+    const Nd4jLong length = 11, numUpd = 3000;
+    NDArray vec('c', {length}, sd::DataType::FLOAT32);
+    NDArray idc('c', {numUpd}, sd::DataType::INT32);
+    NDArray updates('c', {numUpd}, sd::DataType::FLOAT32);
+    NDArray exp('c', {length}, sd::DataType::FLOAT32);
+
+    vec.assign(-1.f);
+    exp.assign(-1.f);
+    for (Nd4jLong i = 0; i < numUpd; i++) {
+        const int idx = (int) ((i * 7) % length);
+        idc.r<int>(i) = idx;
+        updates.r<float>(i) = (float) ((i * 13) % 101);
+        exp.r<float>(idx) = sd::math::nd4j_max<float>(exp.e<float>(idx), updates.e<float>(i));
+    }
+
+    sd::ops::scatter_max op;
+    auto result = op.evaluate({&vec, &idc, &updates}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result.status());
+    ASSERT_TRUE(exp.equalsTo(result.at(0)));
+}
+
+TEST_F(ParityOpsTests, Test_Scatter_ND_Add_Duplicates_1) {
+    const Nd4jLong numUpd = 4000;
+    NDArray input('c', {3, 4, 6}, sd::DataType::FLOAT32);
+    NDArray indices('c', {numUpd, 2}, sd::DataType::INT32);
+    NDArray updates('c', {numUpd, 6}, sd::DataType::FLOAT32);
+    NDArray exp('c', {3, 4, 6}, sd::DataType::FLOAT32);
+
+    for (Nd4jLong i = 0; i < numUpd; i++) {
+        const int r0 = (int) (i % 3), r1 = (int) ((i / 3) % 4);
+        indices.r<int>(i, 0) = r0;
+        indices.r<int>(i, 1) = r1;
+        for (Nd4jLong j = 0; j < 6; j++) {
+            updates.r<float>(i, j) = (float) ((i + j) % 5);
+            exp.r<float>(r0, r1, j) += (float) ((i + j) % 5);
+        }
+    }
+
+    sd::ops::scatter_nd_add op;
+    auto result = op.evaluate({&input, &indices, &updates}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result.status());
+    ASSERT_TRUE(exp.equalsTo(result.at(0)));
+}
+
 TEST_F(ParityOpsTests, Test_Scatter_Add_2) {
 
     auto vec = NDArrayFactory::create<float>('c', {4}, {1, 2, 3, 4});
@@ -38,13 +38,18 @@
 
 #include <helpers/BenchmarkHelper.h>
 #include <ops/declarable/helpers/scatter.h>
+#include <ops/declarable/helpers/convolutions.h>
 #include <helpers/ConstantShapeHelper.h>
 #include <helpers/ConstantTadHelper.h>
 #include <array>
+#include <thread>
 
 
 #include <ops/declarable/helpers/legacy_helpers.h>
 #include <execution/ThreadPool.h>
+#include <system/CpuDispatch.h>
+#include <memory/MemoryCounter.h>
+#include <memory/PooledAllocator.h>
 
 using namespace sd;
 using namespace sd::graph;
@@ -142,4 +147,389 @@ TEST_F(PerformanceTests, test_maxpooling2d_1) {
     nd4j_printf("Execution time: %lld; Min: %lld; Max: %lld;\n", valuesX[valuesX.size() / 2], valuesX[0], valuesX[valuesX.size() - 1]);
 }
 
-#endif
\ No newline at end of file
+TEST_F(PerformanceTests, test_gemm_data_types_1) {
+    BenchmarkHelper helper(3, 10);
+
+    helper.benchmarkGEMM('c', {1024, 1024}, 'c', {1024, 1024}, 'c', {1024, 1024});
+    helper.benchmarkGEMM('c', {64, 1024}, 'f', {1024, 4096}, 'c', {64, 4096});
+    helper.benchmarkGEMM('c', {16, 128, 64}, 'c', {16, 64, 128}, 'c', {16, 128, 128});
+}
+
+TEST_F(PerformanceTests, test_cpu_dispatch_levels_1) {
+    // arrays fit into L2, so loops are compute-bound
+    const int iterations = 1000;
+    auto level = CpuDispatch::level();
+
+    for (auto dataType : {sd::DataType::FLOAT32, sd::DataType::HALF, sd::DataType::BFLOAT16, sd::DataType::INT32}) {
+        NDArray x('c', {64, 1024}, dataType);
+        NDArray y('c', {64, 1024}, dataType);
+        NDArray row('c', {1024}, dataType);
+        NDArray z('c', {64, 1024}, dataType);
+        x.linspace(1.0, 0.001);
+        y.linspace(2.0, 0.001);
+        row.linspace(1.0, 0.01);
+
+        for (int l = CpuDispatch::GENERIC; l <= CpuDispatch::detectedLevel(); l++) {
+            CpuDispatch::setLevel(l);
+
+            std::vector<Nd4jLong> pairwise, scalar, broadcast;
+            for (int e = 0; e < iterations; e++) {
+                auto timeStart = std::chrono::system_clock::now();
+                x.applyPairwiseTransform(pairwise::Add, y, z);
+                auto timeMid = std::chrono::system_clock::now();
+                x.applyScalar(scalar::Multiply, 1.5f, z);
+                auto timeMid2 = std::chrono::system_clock::now();
+                x.applyBroadcast(broadcast::Multiply, {1}, row, z);
+                auto timeEnd = std::chrono::system_clock::now();
+
+                pairwise.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeMid - timeStart).count());
+                scalar.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeMid2 - timeMid).count());
+                broadcast.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeMid2).count());
+            }
+
+            std::sort(pairwise.begin(), pairwise.end());
+            std::sort(scalar.begin(), scalar.end());
+            std::sort(broadcast.begin(), broadcast.end());
+
+            nd4j_printf("%s; level %i; pairwise: %lld ns; scalar: %lld ns; broadcast: %lld ns\n", DataTypeUtils::asString(dataType).c_str(), l, pairwise[iterations / 2], scalar[iterations / 2], broadcast[iterations / 2]);
+        }
+    }
+
+    CpuDispatch::setLevel(level);
+}
+
+TEST_F(PerformanceTests, test_conv2d_algorithms_1) {
+    // {iC, iH, oC, k, s}: ResNet-50 stem and 3x3/1x1 layers of all stages, MobileNet first layer and pointwise layers
+    std::vector<std::array<int, 5>> layers = {{3, 224, 64, 7, 2},
+                                              {64, 56, 64, 3, 1}, {128, 28, 128, 3, 1}, {256, 14, 256, 3, 1}, {512, 7, 512, 3, 1},
+                                              {64, 56, 256, 1, 1}, {256, 56, 64, 1, 1},
+                                              {3, 224, 32, 3, 2}, {32, 112, 64, 1, 1}, {128, 56, 128, 1, 1}, {512, 14, 512, 1, 1}};
+    const int bS = 8;
+    const int iterations = 10;
+
+    auto &env = sd::Environment::getInstance();
+    const auto algorithm = env.conv2dAlgorithm();
+    const auto helpers = env.helpersAllowed();
+    env.allowHelpers(false);
+
+    sd::ops::conv2d op;
+
+    for (const auto &l : layers) {
+        const int iC = l[0], iH = l[1], oC = l[2], k = l[3], s = l[4];
+        const int oH = (iH + s - 1) / s;
+        auto input = NDArrayFactory::create<float>('c', {bS, iH, iH, iC});
+        auto weights = NDArrayFactory::create<float>('c', {k, k, iC, oC});
+        auto output = NDArrayFactory::create<float>('c', {bS, oH, oH, oC});
+        input.linspace(1.0, 0.0001);
+        weights.linspace(1.0, 0.0001);
+
+        Nd4jLong iArgs[] {k,k, s,s, 0,0, 1,1, 1, 1, 0};
+        Context ctx(1);
+        ctx.setInputArray(0, &input);
+        ctx.setInputArray(1, &weights);
+        ctx.setOutputArray(0, &output);
+        ctx.setIArguments(iArgs, 11);
+
+        for (int algo : {sd::ops::CONV2D_AUTO, sd::ops::CONV2D_IM2COL, sd::ops::CONV2D_DIRECT, sd::ops::CONV2D_WINOGRAD_2X2, sd::ops::CONV2D_WINOGRAD_4X4}) {
+            if ((algo == sd::ops::CONV2D_WINOGRAD_2X2 || algo == sd::ops::CONV2D_WINOGRAD_4X4) && (k != 3 || s != 1))
+                continue;
+
+            env.setConv2dAlgorithm(algo);
+            op.execute(&ctx);
+
+            std::vector<Nd4jLong> values;
+            for (int e = 0; e < iterations; e++) {
+                auto timeStart = std::chrono::system_clock::now();
+                op.execute(&ctx);
+                auto timeEnd = std::chrono::system_clock::now();
+                values.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+            }
+
+            std::sort(values.begin(), values.end());
+            nd4j_printf("conv2d [%i, %i, %i, %i] k%i s%i -> %i; algorithm %i: %lld us\n", bS, iH, iH, iC, k, s, oC, algo, values[iterations / 2]);
+        }
+    }
+
+    env.setConv2dAlgorithm(algorithm);
+    env.allowHelpers(helpers);
+}
+
+TEST_F(PerformanceTests, test_top_k_1) {
+    // {batch, width}: recommender-like few wide rows, and classifier-like many short rows
+    std::vector<std::array<Nd4jLong, 2>> shapes = {{1, 1000000}, {8, 1000000}, {64, 100000}, {1024, 1000}, {4096, 128}};
+    const int iterations = 10;
+
+    sd::ops::top_k op;
+
+    for (const auto &s : shapes) {
+        auto x = NDArrayFactory::create<float>('c', {s[0], s[1]});
+        RandomGenerator rng(119, 5);
+        RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, &x, -1.0, 1.0);
+
+        for (Nd4jLong k : {1, 10, 100, 500}) {
+            if (k > s[1])
+                continue;
+
+            auto values = NDArrayFactory::create<float>('c', {s[0], k});
+            auto indices = NDArrayFactory::create<Nd4jLong>('c', {s[0], k});
+
+            Context ctx(1);
+            ctx.setInputArray(0, &x);
+            ctx.setOutputArray(0, &values);
+            ctx.setOutputArray(1, &indices);
+            ctx.setIArguments({k});
+            ctx.setBArguments({true});
+
+            op.execute(&ctx);
+
+            std::vector<Nd4jLong> times;
+            for (int e = 0; e < iterations; e++) {
+                auto timeStart = std::chrono::system_clock::now();
+                op.execute(&ctx);
+                auto timeEnd = std::chrono::system_clock::now();
+                times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+            }
+
+            std::sort(times.begin(), times.end());
+            nd4j_printf("top_k [%lld, %lld], k %lld: %lld us\n", s[0], s[1], k, times[iterations / 2]);
+        }
+    }
+}
+
+TEST_F(PerformanceTests, test_scatter_add_duplicates_1) {
+    // embedding gradient update: numUpd rows scattered into vocabulary, with decreasing number of distinct rows
+    const Nd4jLong vocab = 100000, width = 128, numUpd = 65536;
+    const int iterations = 10;
+
+    auto output = NDArrayFactory::create<float>('c', {vocab, width});
+    auto updates = NDArrayFactory::create<float>('c', {numUpd, width});
+    updates.linspace(1.f, 1e-6f);
+
+    for (Nd4jLong distinct : {65536, 4096, 256, 16, 1}) {
+        auto indices = NDArrayFactory::create<Nd4jLong>('c', {numUpd});
+        for (Nd4jLong e = 0; e < numUpd; e++)
+            indices.r<Nd4jLong>(e) = ((e * 7919) % distinct) * (vocab / distinct);
+
+        sd::ops::helpers::scatter(LaunchContext::defaultContext(), pairwise::Add, indices, updates, output, false);
+
+        std::vector<Nd4jLong> times;
+        for (int e = 0; e < iterations; e++) {
+            auto timeStart = std::chrono::system_clock::now();
+            sd::ops::helpers::scatter(LaunchContext::defaultContext(), pairwise::Add, indices, updates, output, false);
+            auto timeEnd = std::chrono::system_clock::now();
+            times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+        }
+
+        std::sort(times.begin(), times.end());
+        nd4j_printf("scatter_add [%lld x %lld], distinct rows %lld: %lld us; %.2f rows/us\n", numUpd, width, distinct, times[iterations / 2], (double) numUpd / times[iterations / 2]);
+    }
+}
+
+TEST_F(PerformanceTests, test_shape_interning_scaling_1) {
+    // small set of shapes, looked up over and over again, like output shapes of ops during inference
+    std::vector<ShapeDescriptor> descriptors;
+    for (int e = 1; e <= 128; e++)
+        descriptors.emplace_back(sd::DataType::FLOAT32, 'c', std::vector<Nd4jLong>({e, 3, 7}));
+
+    const int iterations = 1000000;
+    for (int numThreads : {1, 2, 4, 8, 16, 32, 64}) {
+        std::vector<std::thread> threads(numThreads);
+
+        auto timeStart = std::chrono::system_clock::now();
+        for (int t = 0; t < numThreads; t++) {
+            threads[t] = std::thread([&descriptors, t] () {
+                for (int i = 0; i < iterations; i++)
+                    ConstantShapeHelper::getInstance().bufferForShapeInfo(descriptors[(i + t) % descriptors.size()]);
+            });
+        }
+
+        for (auto &t : threads)
+            t.join();
+
+        auto timeEnd = std::chrono::system_clock::now();
+        auto outerTime = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count();
+        nd4j_printf("Threads: %i; lookups/us: %.2f\n", numThreads, (double) numThreads * iterations / outerTime);
+    }
+}
+
+TEST_F(PerformanceTests, test_pooled_allocation_1) {
+    // small temporaries allocated and released over and over again, like in op-by-op inference
+    const int iterations = 1000000;
+    const bool pooled = Environment::getInstance().isPooledAllocation();
+
+    for (int numThreads : {1, 4, 16}) {
+        for (bool pool : {false, true}) {
+            Environment::getInstance().setPooledAllocation(pool);
+            std::vector<std::thread> threads(numThreads);
+
+            auto timeStart = std::chrono::system_clock::now();
+            for (int t = 0; t < numThreads; t++) {
+                threads[t] = std::thread([t] () {
+                    for (int i = 0; i < iterations; i++) {
+                        DataBuffer buffer(((i + t) % 256 + 1) * 16, sd::DataType::INT8);
+                    }
+                });
+            }
+
+            for (auto &t : threads)
+                t.join();
+
+            auto timeEnd = std::chrono::system_clock::now();
+            auto outerTime = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count();
+            nd4j_printf("Threads: %i; pooled: %i; allocations/us: %.2f\n", numThreads, (int) pool, (double) numThreads * iterations / outerTime);
+        }
+    }
+
+    auto stats = sd::memory::MemoryCounter::getInstance().pooledStatistics();
+    nd4j_printf("Pool hits: %lld; misses: %lld; cached bytes: %lld\n", stats.hits, stats.misses, stats.cachedBytes);
+
+    Environment::getInstance().setPooledAllocation(pooled);
+    sd::memory::PooledAllocator::getInstance().purge();
+}
+
+TEST_F(PerformanceTests, test_float_conversions_1) {
+    const Nd4jLong length = 16 * 1024 * 1024;
+    const int iterations = 10;
+
+    std::vector<std::pair<sd::DataType, sd::DataType>> pairs = {{sd::DataType::FLOAT32, sd::DataType::HALF}, {sd::DataType::HALF, sd::DataType::FLOAT32},
+                                                                {sd::DataType::FLOAT32, sd::DataType::BFLOAT16}, {sd::DataType::BFLOAT16, sd::DataType::FLOAT32},
+                                                                {sd::DataType::DOUBLE, sd::DataType::FLOAT32}, {sd::DataType::FLOAT32, sd::DataType::DOUBLE},
+                                                                {sd::DataType::HALF, sd::DataType::BFLOAT16}};
+
+    for (const auto &p : pairs) {
+        NDArray x('c', {length}, p.first);
+        NDArray z('c', {length}, p.second);
+        x.linspace(-1.0, 1e-7);
+
+        std::vector<Nd4jLong> vectorized, legacy;
+        for (int e = 0; e < iterations; e++) {
+            auto timeStart = std::chrono::system_clock::now();
+            z.assign(x);
+            auto timeMid = std::chrono::system_clock::now();
+            NativeOpExecutioner::execTransformAny(LaunchContext::defaultContext(), transform::Assign, x.buffer(), x.shapeInfo(), x.specialBuffer(), x.specialShapeInfo(), z.buffer(), z.shapeInfo(), z.specialBuffer(), z.specialShapeInfo(), nullptr, nullptr, nullptr);
+            auto timeEnd = std::chrono::system_clock::now();
+
+            vectorized.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeMid - timeStart).count());
+            legacy.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeMid).count());
+        }
+
+        std::sort(vectorized.begin(), vectorized.end());
+        std::sort(legacy.begin(), legacy.end());
+
+        auto bytes = (double) length * (x.sizeOfT() + z.sizeOfT());
+        nd4j_printf("%s -> %s: vectorized %lld us (%.2f GB/s); legacy %lld us (%.2f GB/s)\n", DataTypeUtils::asString(p.first).c_str(), DataTypeUtils::asString(p.second).c_str(),
+                    vectorized[iterations / 2], bytes / vectorized[iterations / 2] / 1000., legacy[iterations / 2], bytes / legacy[iterations / 2] / 1000.);
+    }
+}
+
+TEST_F(PerformanceTests, test_dynamic_partition_1) {
+    const int numRows = 1000000;
+    const int numPartition = 300;
+    const int iterations = 10;
+
+    auto x = NDArrayFactory::create<float>('c', {numRows, 16});
+    x.linspace(1.f);
+    auto y = NDArrayFactory::create<int>('c', {numRows});
+    for (int e = 0; e < numRows; e++)
+        y.p(e, (e * 7919) % numPartition);
+
+    sd::ops::dynamic_partition partition;
+    std::vector<Nd4jLong> partitionTimes;
+    for (int e = 0; e < iterations; e++) {
+        auto timeStart = std::chrono::system_clock::now();
+        auto result = partition.evaluate({&x, &y}, {}, {numPartition});
+        auto timeEnd = std::chrono::system_clock::now();
+        ASSERT_EQ(Status::OK(), result.status());
+
+        partitionTimes.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+    }
+
+    auto data = partition.evaluate({&x, &y}, {}, {numPartition});
+    auto positions = NDArrayFactory::create<int>('c', {numRows});
+    positions.linspace(0);
+    auto indices = partition.evaluate({&positions, &y}, {}, {numPartition});
+
+    std::vector<NDArray*> inputs;
+    for (int p = 0; p < numPartition; p++)
+        inputs.emplace_back(indices.at(p));
+    for (int p = 0; p < numPartition; p++)
+        inputs.emplace_back(data.at(p));
+
+    sd::ops::dynamic_stitch stitch;
+    std::vector<Nd4jLong> stitchTimes;
+    for (int e = 0; e < iterations; e++) {
+        auto timeStart = std::chrono::system_clock::now();
+        auto result = stitch.evaluate(inputs, {}, {});
+        auto timeEnd = std::chrono::system_clock::now();
+        ASSERT_EQ(Status::OK(), result.status());
+
+        stitchTimes.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+    }
+
+    std::sort(partitionTimes.begin(), partitionTimes.end());
+    std::sort(stitchTimes.begin(), stitchTimes.end());
+
+    nd4j_printf("dynamic_partition: %lld us; dynamic_stitch: %lld us\n", partitionTimes[iterations / 2], stitchTimes[iterations / 2]);
+}
+
+TEST_F(PerformanceTests, test_gaussian_1) {
+    const int iterations = 10;
+    sd::graph::RandomGenerator rng(119, 5);
+
+    for (auto dataType : {sd::DataType::FLOAT32, sd::DataType::DOUBLE}) {
+        NDArray x('c', {4096, 4096}, dataType);
+
+        std::vector<Nd4jLong> gaussian, logNormal, truncated;
+        for (int e = 0; e < iterations; e++) {
+            auto timeStart = std::chrono::system_clock::now();
+            RandomLauncher::fillGaussian(LaunchContext::defaultContext(), rng, &x, 0.0, 1.0);
+            auto timeGaussian = std::chrono::system_clock::now();
+            RandomLauncher::fillLogNormal(LaunchContext::defaultContext(), rng, &x, 0.0, 1.0);
+            auto timeLogNormal = std::chrono::system_clock::now();
+            RandomLauncher::fillTruncatedNormal(LaunchContext::defaultContext(), rng, &x, 0.0, 1.0);
+            auto timeEnd = std::chrono::system_clock::now();
+
+            gaussian.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeGaussian - timeStart).count());
+            logNormal.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeLogNormal - timeGaussian).count());
+            truncated.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeLogNormal).count());
+        }
+
+        std::sort(gaussian.begin(), gaussian.end());
+        std::sort(logNormal.begin(), logNormal.end());
+        std::sort(truncated.begin(), truncated.end());
+
+        nd4j_printf("%s: gaussian %lld us; log-normal %lld us; truncated normal %lld us\n", DataTypeUtils::asString(dataType).c_str(), gaussian[iterations / 2], logNormal[iterations / 2], truncated[iterations / 2]);
+    }
+}
+
+TEST_F(PerformanceTests, test_shape_function_cache_1) {
+    const int iterations = 100000;
+
+    auto x = NDArrayFactory::create<float>('c', {8, 16});
+    auto y = NDArrayFactory::create<float>('c', {16, 8});
+
+    auto original = Environment::getInstance().shapeFunctionCacheSize();
+
+    for (auto cacheSize : {0, original}) {
+        Environment::getInstance().setShapeFunctionCacheSize(cacheSize);
+
+        // outputs aren't provided, so shape function is called on every execution
+        sd::ops::matmul op;
+        std::vector<Nd4jLong> values;
+        for (int e = 0; e < iterations; e++) {
+            auto timeStart = std::chrono::system_clock::now();
+            auto result = op.evaluate({&x, &y});
+            auto timeEnd = std::chrono::system_clock::now();
+
+            values.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count());
+        }
+
+        std::sort(values.begin(), values.end());
+
+        nd4j_printf("Cache size %i: matmul %lld ns; cache hits: %lld\n", cacheSize, values[values.size() / 2], op.shapeFunctionCache().hits());
+    }
+
+    Environment::getInstance().setShapeFunctionCacheSize(original);
+}
+
+#endif
@@ -1297,3 +1297,52 @@ TEST_F(RNGTests, test_multinomial_6) {
     ASSERT_NEAR(1.2175, deviation.e<double>(0), 5e-3); // 1000000 3e-3);
     ASSERT_NEAR(2.906, mean.e<double>(0), 5e-3); // 1000000 3e-3);
 }
+
+TEST_F(RNGTests, Test_RelativeBlock_1) {
+    const int length = 1003;
+    std::vector<uint32_t> bits(length);
+    std::vector<float> floats(length);
+    std::vector<double> doubles(length);
+
+    for (Nd4jLong first : {0LL, 17LL, 4294967290LL}) {
+        _rngA.xoroshiro32Block(first, length, bits.data());
+        _rngA.relativeBlock<float>(first, length, floats.data(), 1e-5f, 1.0f);
+        _rngA.relativeBlock<double>(first, length, doubles.data(), -3.0, 2.0);
+
+        for (int e = 0; e < length; e++) {
+            ASSERT_EQ(_rngB.xoroshiro32(first + e), bits[e]);
+            ASSERT_EQ(_rngB.relativeT<float>(first + e, 1e-5f, 1.0f), floats[e]);
+            ASSERT_EQ(_rngB.relativeT<double>(first + e, -3.0, 2.0), doubles[e]);
+        }
+    }
+}
+
+TEST_F(RNGTests, Test_Gaussian_Threads_1) {
+    auto x0 = NDArrayFactory::create<float>('c', {1000, 301});
+    auto x1 = NDArrayFactory::create<float>('c', {1000, 301});
+    auto x2 = NDArrayFactory::create<double>('c', {1000, 301});
+    auto x3 = NDArrayFactory::create<double>('c', {1000, 301});
+
+    RandomLauncher::fillGaussian(LaunchContext::defaultContext(), _rngA, &x0, 1.0f, 2.0f);
+    RandomLauncher::fillLogNormal(LaunchContext::defaultContext(), _rngA, &x2, 1.0f, 2.0f);
+
+    // values depend on indices only, so single thread must give the same results
+    auto maxThreads = Environment::getInstance().maxThreads();
+    auto maxMasterThreads = Environment::getInstance().maxMasterThreads();
+    Environment::getInstance().setMaxThreads(1);
+    Environment::getInstance().setMaxMasterThreads(1);
+
+    RandomLauncher::fillGaussian(LaunchContext::defaultContext(), _rngB, &x1, 1.0f, 2.0f);
+    RandomLauncher::fillLogNormal(LaunchContext::defaultContext(), _rngB, &x3, 1.0f, 2.0f);
+
+    Environment::getInstance().setMaxThreads(maxThreads);
+    Environment::getInstance().setMaxMasterThreads(maxMasterThreads);
+
+    ASSERT_TRUE(x0.equalsTo(&x1, 0.0));
+    ASSERT_TRUE(x2.equalsTo(&x3, 0.0));
+
+    auto mean = x0.meanNumber();
+    auto stdev = x0.varianceNumber(sd::variance::SummaryStatsStandardDeviation, false);
+    ASSERT_NEAR(1.0f, mean.e<float>(0), 2e-2f);
+    ASSERT_NEAR(2.0f, stdev.e<float>(0), 2e-2f);
+}
@@ -24,6 +24,7 @@
 #include <graph/GraphExecutioner.h>
 #include <graph/GraphHolder.h>
 #include <graph/InferenceRequest.h>
+#include <thread>
 
 using namespace sd;
 using namespace sd::graph;
@@ -187,4 +188,99 @@ TEST_F(ServerRelatedTests, BasicExecutionTests_3) {
 
     GraphHolder::getInstance().dropGraphAny(11903L);
 }
+
+TEST_F(ServerRelatedTests, BasicExecutionTests_4) {
+    Environment::getInstance().setDebug(false);
+    Environment::getInstance().setVerbose(false);
+
+    auto oGraph = GraphExecutioner::importFromFlatBuffers("./resources/reduce_dim_false.fb");
+    GraphHolder::getInstance().registerGraph(11904L, oGraph);
+
+    // every request gets its own input, so results of concurrent requests must not mix up
+    auto runRequest = [] (float value) -> bool {
+        flatbuffers::FlatBufferBuilder builder(4096);
+        flatbuffers::FlatBufferBuilder otherBuilder(4096);
+
+        auto input0 = NDArrayFactory::create<float>('c', {3, 3});
+        input0.assign(value);
+        auto exp = NDArrayFactory::create<float>('c', {3});
+        exp.assign(3 * value);
+
+        InferenceRequest ir(11904L);
+        ir.appendVariable(1, 0, &input0);
+
+        auto af = ir.asFlatInferenceRequest(otherBuilder);
+        otherBuilder.Finish(af);
+        auto fir = GetFlatInferenceRequest(otherBuilder.GetBufferPointer());
+
+        auto flatResult = GraphHolder::getInstance().execute(fir->id(), builder, fir);
+        builder.Finish(flatResult);
+
+        ExecutionResult restored(GetFlatResult(builder.GetBufferPointer()));
+        return restored.size() == 1 && exp == *restored.at(0)->getNDArray();
+    };
+
+    // sequential requests reuse single session
+    for (int e = 0; e < 3; e++)
+        ASSERT_TRUE(runRequest(e + 1.f));
+
+    ASSERT_EQ(1, GraphHolder::getInstance().numberOfSessions(11904L));
+
+    std::atomic<int> failures(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&, t] () {
+            for (int e = 0; e < 50; e++)
+                if (!runRequest(t * 100 + e))
+                    failures++;
+        });
+    }
+
+    for (auto &t : threads)
+        t.join();
+
+    ASSERT_EQ(0, failures.load());
+    ASSERT_GE(4, GraphHolder::getInstance().numberOfSessions(11904L));
+
+    GraphHolder::getInstance().dropGraphAny(11904L);
+    ASSERT_EQ(0, GraphHolder::getInstance().numberOfSessions(11904L));
+}
+
+TEST_F(ServerRelatedTests, BasicExecutionTests_5) {
+    Environment::getInstance().setDebug(false);
+    Environment::getInstance().setVerbose(false);
+
+    auto oGraph = GraphExecutioner::importFromFlatBuffers("./resources/reduce_dim_false.fb");
+    GraphHolder::getInstance().registerGraph(11905L, oGraph);
+
+    // the same pooled session gets requests with different batch sizes, so outputs of previous request can't be reused
+    for (int size: {3, 5, 2}) {
+        flatbuffers::FlatBufferBuilder builder(4096);
+        flatbuffers::FlatBufferBuilder otherBuilder(4096);
+
+        auto input0 = NDArrayFactory::create<float>('c', {size, size});
+        input0.assign(2.f);
+        auto exp = NDArrayFactory::create<float>('c', {size});
+        exp.assign(2.f * size);
+
+        InferenceRequest ir(11905L);
+        ir.appendVariable(1, 0, &input0);
+
+        auto af = ir.asFlatInferenceRequest(otherBuilder);
+        otherBuilder.Finish(af);
+        auto fir = GetFlatInferenceRequest(otherBuilder.GetBufferPointer());
+
+        auto flatResult = GraphHolder::getInstance().execute(fir->id(), builder, fir);
+        builder.Finish(flatResult);
+
+        ExecutionResult restored(GetFlatResult(builder.GetBufferPointer()));
+        ASSERT_EQ(1, restored.size());
+        ASSERT_EQ(exp, *restored.at(0)->getNDArray());
+
+        ASSERT_EQ(1, GraphHolder::getInstance().numberOfSessions(11905L));
+    }
+
+    GraphHolder::getInstance().dropGraphAny(11905L);
+    ASSERT_EQ(0, GraphHolder::getInstance().numberOfSessions(11905L));
+}
 #endif
@@ -25,6 +25,10 @@
 #include <array/NDArray.h>
 #include <legacy/NativeOps.h>
 #include <helpers/BitwiseUtils.h>
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/RandomLauncher.h>
+#include <array>
+#include <chrono>
 
 using namespace sd;
 using namespace sd::graph;
@@ -104,3 +108,157 @@ TEST_F(SortCpuTests, test_tad_sort_by_val_1) {
     ASSERT_EQ(ek, k);
     ASSERT_EQ(ev, v);
 }
+
+TEST_F(SortCpuTests, test_linear_sort_large_1) {
+    if (!Environment::getInstance().isCPU())
+        return;
+
+    // long enough to be radix-sorted by several threads
+    const Nd4jLong length = 300000;
+    auto x = NDArrayFactory::create<float>('c', {length});
+    for (Nd4jLong e = 0; e < length; e++)
+        x.r<float>(e) = (float) ((e * 7919) % 100003) - 50000.f;
+
+    for (bool descending : {false, true}) {
+        sort(nullptr, x.buffer(), x.shapeInfo(), x.specialBuffer(), x.specialShapeInfo(), descending);
+
+        for (Nd4jLong e = 1; e < length; e++) {
+            if (descending) {
+                ASSERT_GE(x.e<float>(e - 1), x.e<float>(e));
+            } else {
+                ASSERT_LE(x.e<float>(e - 1), x.e<float>(e));
+            }
+        }
+    }
+}
+
+TEST_F(SortCpuTests, test_linear_sort_by_key_stable_1) {
+    if (!Environment::getInstance().isCPU())
+        return;
+
+    // many duplicated keys, values are original positions
+    const Nd4jLong length = 200000;
+    auto k = NDArrayFactory::create<Nd4jLong>('c', {length});
+    auto v = NDArrayFactory::create<int>('c', {length});
+    for (Nd4jLong e = 0; e < length; e++) {
+        k.r<Nd4jLong>(e) = ((e * 31) % 97) - 48;
+        v.r<int>(e) = (int) e;
+    }
+
+    sortByKey(nullptr, k.buffer(), k.shapeInfo(), k.specialBuffer(), k.specialShapeInfo(), v.buffer(), v.shapeInfo(), v.specialBuffer(), v.specialShapeInfo(), false);
+
+    for (Nd4jLong e = 1; e < length; e++) {
+        ASSERT_LE(k.e<Nd4jLong>(e - 1), k.e<Nd4jLong>(e));
+        if (k.e<Nd4jLong>(e - 1) == k.e<Nd4jLong>(e)) {
+            ASSERT_LT(v.e<int>(e - 1), v.e<int>(e));
+        }
+    }
+}
+
+TEST_F(SortCpuTests, test_tad_sort_large_1) {
+    if (!Environment::getInstance().isCPU())
+        return;
+
+    // few long TADs are sorted with all threads one by one
+    const Nd4jLong rows = 2, cols = 200000;
+    auto x = NDArrayFactory::create<double>('c', {rows, cols});
+    for (Nd4jLong r = 0; r < rows; r++)
+        for (Nd4jLong c = 0; c < cols; c++)
+            x.r<double>(r, c) = (double) ((c * 7919 + r) % 100003);
+
+    int axis = 1;
+    auto pack = ConstantTadHelper::getInstance().tadForDimensions(x.shapeInfo(), axis);
+    sortTad(nullptr, x.buffer(), x.shapeInfo(), x.specialBuffer(), x.specialShapeInfo(), &axis, 1, pack.primaryShapeInfo(), pack.primaryOffsets(), true);
+
+    for (Nd4jLong r = 0; r < rows; r++)
+        for (Nd4jLong c = 1; c < cols; c++)
+            ASSERT_GE(x.e<double>(r, c - 1), x.e<double>(r, c));
+}
+
+#ifdef RELEASE_BUILD
+TEST_F(SortCpuTests, test_sort_benchmark_1) {
+    if (!Environment::getInstance().isCPU())
+        return;
+
+    const int iterations = 5;
+
+    for (auto dtype : {sd::DataType::FLOAT32, sd::DataType::DOUBLE, sd::DataType::INT32, sd::DataType::INT64, sd::DataType::HALF}) {
+        NDArray source('c', {10000000}, dtype);
+        RandomGenerator rng(119, 5);
+        RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, &source, -1000000.0, 1000000.0);
+
+        std::vector<Nd4jLong> times;
+        for (int e = 0; e < iterations; e++) {
+            auto x = source.dup();
+
+            auto timeStart = std::chrono::system_clock::now();
+            sort(nullptr, x.buffer(), x.shapeInfo(), x.specialBuffer(), x.specialShapeInfo(), false);
+            auto timeEnd = std::chrono::system_clock::now();
+            times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+        }
+
+        std::sort(times.begin(), times.end());
+        nd4j_printf("sort %s [%lld]: %lld us\n", DataTypeUtils::asString(dtype).c_str(), source.lengthOf(), times[iterations / 2]);
+    }
+}
+
+TEST_F(SortCpuTests, test_sort_tad_benchmark_1) {
+    if (!Environment::getInstance().isCPU())
+        return;
+
+    // {numTads, tadLength}: few long TADs are sorted within TAD, many short ones across TADs
+    std::vector<std::array<Nd4jLong, 2>> shapes = {{1, 10000000}, {4, 2500000}, {1000, 10000}, {100000, 100}};
+    const int iterations = 5;
+
+    for (const auto &s : shapes) {
+        auto source = NDArrayFactory::create<float>('c', {s[0], s[1]});
+        RandomGenerator rng(119, 5);
+        RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, &source, -1.0, 1.0);
+
+        int axis = 1;
+        auto pack = ConstantTadHelper::getInstance().tadForDimensions(source.shapeInfo(), axis);
+
+        std::vector<Nd4jLong> times;
+        for (int e = 0; e < iterations; e++) {
+            auto x = source.dup();
+
+            auto timeStart = std::chrono::system_clock::now();
+            sortTad(nullptr, x.buffer(), x.shapeInfo(), x.specialBuffer(), x.specialShapeInfo(), &axis, 1, pack.primaryShapeInfo(), pack.primaryOffsets(), false);
+            auto timeEnd = std::chrono::system_clock::now();
+            times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+        }
+
+        std::sort(times.begin(), times.end());
+        nd4j_printf("sortTad [%lld, %lld]: %lld us\n", s[0], s[1], times[iterations / 2]);
+    }
+}
+
+TEST_F(SortCpuTests, test_sort_by_key_benchmark_1) {
+    if (!Environment::getInstance().isCPU())
+        return;
+
+    const Nd4jLong length = 10000000;
+    const int iterations = 5;
+
+    auto keys = NDArrayFactory::create<Nd4jLong>('c', {length});
+    auto values = NDArrayFactory::create<float>('c', {length});
+    RandomGenerator rng(119, 5);
+    RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, &values, -1.0, 1.0);
+    for (Nd4jLong e = 0; e < length; e++)
+        keys.r<Nd4jLong>(e) = (e * 2654435761LL) % 1000003;
+
+    std::vector<Nd4jLong> times;
+    for (int e = 0; e < iterations; e++) {
+        auto k = keys.dup();
+        auto v = values.dup();
+
+        auto timeStart = std::chrono::system_clock::now();
+        sortByKey(nullptr, k.buffer(), k.shapeInfo(), k.specialBuffer(), k.specialShapeInfo(), v.buffer(), v.shapeInfo(), v.specialBuffer(), v.specialShapeInfo(), false);
+        auto timeEnd = std::chrono::system_clock::now();
+        times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+    }
+
+    std::sort(times.begin(), times.end());
+    nd4j_printf("sortByKey [%lld]: %lld us\n", length, times[iterations / 2]);
+}
+#endif
@@ -25,7 +25,9 @@
 #include <loops/type_conversions.h>
 #include <execution/Threads.h>
 #include <chrono>
+#include <atomic>
 #include <execution/ThreadPool.h>
+#include <execution/NumaTopology.h>
 
 using namespace samediff;
 using namespace sd;
@@ -232,6 +234,144 @@ TEST_F(ThreadsTests, crash_test_1) {
   }
 }
 
+TEST_F(ThreadsTests, dynamic_schedule_coverage_1) {
+    std::vector<std::atomic<int>> hits(1013);
+    for (auto &h:hits)
+        h = 0;
+
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto e = start; e < stop; e += increment)
+            hits[e]++;
+    };
+
+    samediff::Threads::parallel_for(func, 0, hits.size(), 1, 8, samediff::SCHEDULE_DYNAMIC);
+
+    for (int e = 0; e < (int) hits.size(); e++)
+        ASSERT_EQ(1, hits[e].load());
+}
+
+TEST_F(ThreadsTests, dynamic_schedule_nested_1) {
+    std::atomic<int64_t> sum(0);
+
+    auto outer = PRAGMA_THREADS_FOR {
+        for (auto e = start; e < stop; e++) {
+            auto inner = PRAGMA_THREADS_FOR {
+                int64_t local = 0;
+                for (auto i = start; i < stop; i++)
+                    local += i;
+
+                sum += local;
+            };
+
+            samediff::Threads::parallel_for(inner, 0, 1000, 1, 4, samediff::SCHEDULE_DYNAMIC);
+        }
+    };
+
+    samediff::Threads::parallel_tad(outer, 0, 100, 1, 4, samediff::SCHEDULE_DYNAMIC);
+
+    ASSERT_EQ(100 * 499500, sum.load());
+}
+
+TEST_F(ThreadsTests, dynamic_schedule_exception_1) {
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto e = start; e < stop; e++)
+            if (e == 77)
+                throw std::runtime_error("failed iteration");
+    };
+
+    ASSERT_ANY_THROW(samediff::Threads::parallel_for(func, 0, 128, 1, 4, samediff::SCHEDULE_DYNAMIC));
+}
+
+TEST_F(ThreadsTests, dynamic_schedule_exception_2) {
+    // first chunk is taken by calling thread, and queued lanes must be finished before exception leaves parallel_for
+    auto func = PRAGMA_THREADS_FOR {
+        if (start == 0)
+            throw std::runtime_error("failed chunk");
+    };
+
+    std::vector<std::atomic<int>> hits(1013);
+    auto count = PRAGMA_THREADS_FOR {
+        for (auto e = start; e < stop; e++)
+            hits[e]++;
+    };
+
+    for (int r = 0; r < 10; r++) {
+        ASSERT_ANY_THROW(samediff::Threads::parallel_for(func, 0, 128, 1, 4, samediff::SCHEDULE_DYNAMIC));
+
+        for (auto &h:hits)
+            h = 0;
+
+        samediff::Threads::parallel_for(count, 0, hits.size(), 1, 4, samediff::SCHEDULE_DYNAMIC);
+
+        for (int e = 0; e < (int) hits.size(); e++)
+            ASSERT_EQ(1, hits[e].load());
+    }
+}
+
+TEST_F(ThreadsTests, numa_topology_1) {
+    auto cpus = samediff::NumaTopology::parseCpuList("0-3,8,10-11\n");
+    ASSERT_EQ(std::vector<int>({0, 1, 2, 3, 8, 10, 11}), cpus);
+
+    auto &topology = samediff::NumaTopology::getInstance();
+    ASSERT_LE(1, topology.numberOfNodes());
+    for (int e = 0; e < topology.numberOfNodes(); e++) {
+        ASSERT_FALSE(topology.cpusOfNode(e).empty());
+        ASSERT_EQ(e, topology.nodeOfCpu(topology.cpusOfNode(e)[0]));
+    }
+
+    // contiguous slots are mapped to nodes proportionally
+    std::vector<int> nodes;
+    for (int e = 0; e < 6; e++)
+        nodes.emplace_back(samediff::ThreadPool::nodeForSlot(e, 6, 2));
+
+    ASSERT_EQ(std::vector<int>({0, 0, 0, 1, 1, 1}), nodes);
+    ASSERT_EQ(0, samediff::ThreadPool::nodeForSlot(3, 4, 1));
+}
+
+TEST_F(ThreadsTests, numa_first_touch_1) {
+    if (!Environment::getInstance().isCPU())
+        return;
+
+    auto numa = Environment::getInstance().isNumaAware();
+    auto threshold = Environment::getInstance().numaFirstTouchThreshold();
+    Environment::getInstance().setNumaAware(true);
+    Environment::getInstance().setNumaFirstTouchThreshold(1024);
+
+    auto x = NDArrayFactory::create<float>('c', {1024, 64});
+    x.assign(2.0f);
+    ASSERT_EQ(2.0f * x.lengthOf(), x.sumNumber().e<float>(0));
+
+    Environment::getInstance().setNumaAware(numa);
+    Environment::getInstance().setNumaFirstTouchThreshold(threshold);
+}
+
+#ifdef RELEASE_BUILD
+TEST_F(ThreadsTests, dynamic_schedule_imbalanced_1) {
+    // triangular workload: last iterations are way heavier than first ones, so static chunks are imbalanced
+    const int numTads = 512;
+    std::vector<double> results(numTads);
+
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto e = start; e < stop; e++) {
+            double r = 0.0;
+            for (int i = 0; i < e * 2000; i++)
+                r += sqrt((double) i);
+
+            results[e] = r;
+        }
+    };
+
+    for (auto schedule : {samediff::SCHEDULE_STATIC, samediff::SCHEDULE_DYNAMIC}) {
+        auto timeStart = std::chrono::system_clock::now();
+        samediff::Threads::parallel_tad(func, 0, numTads, 1, sd::Environment::getInstance().maxMasterThreads(), schedule);
+        auto timeEnd = std::chrono::system_clock::now();
+
+        auto outerTime = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count();
+        nd4j_printf("%s schedule: %lld us\n", schedule == samediff::SCHEDULE_STATIC ? "Static" : "Dynamic", outerTime);
+    }
+}
+#endif
+
 /*
 TEST_F(ThreadsTests, basic_test_1) {
     if (!Environment::getInstance().isCPU())
@@ -72,3 +72,58 @@ TEST_F(TypeCastTests, Test_ConvertDtype_1) {
 
     #endif
 }
+
+TEST_F(TypeCastTests, Test_Cast_Half_1) {
+#ifndef __CUDABLAS__
+    // odd length, so vectorized loops have tails
+    const int limit = 1003;
+    std::vector<float> src(limit);
+    std::vector<float16> z(limit);
+    std::vector<float> back(limit);
+
+    for (int e = 0; e < limit; e++)
+        src[e] = (e - 500) * 131.7f / (e % 7 + 1);
+
+    src[1] = 1e-7f;
+    src[2] = 70000.f;
+    src[3] = -0.f;
+
+    TypeCast::convertGeneric<float, float16>(nullptr, src.data(), limit, z.data());
+    TypeCast::convertGeneric<float16, float>(nullptr, z.data(), limit, back.data());
+
+    for (int e = 0; e < limit; e++) {
+        auto exp = static_cast<float16>(src[e]);
+        ASSERT_EQ(static_cast<float>(exp), static_cast<float>(z[e]));
+        ASSERT_EQ(static_cast<float>(exp), back[e]);
+    }
+#endif
+}
+
+TEST_F(TypeCastTests, Test_Cast_Bfloat16_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 341});
+    x.linspace(-100.f, 0.37f);
+
+    auto z = x.cast(sd::DataType::BFLOAT16);
+    auto d = z.cast(sd::DataType::DOUBLE);
+
+    for (Nd4jLong e = 0; e < x.lengthOf(); e++) {
+        auto exp = static_cast<float>(static_cast<bfloat16>(x.e<float>(e)));
+        ASSERT_EQ(exp, z.e<float>(e));
+        ASSERT_EQ((double) exp, d.e<double>(e));
+    }
+}
+
+TEST_F(TypeCastTests, Test_Cast_Op_Half_1) {
+    auto x = NDArrayFactory::create<double>('c', {37});
+    x.linspace(-3.0, 0.123);
+
+    sd::ops::cast op;
+    auto result = op.evaluate({&x}, {}, {(Nd4jLong) sd::DataType::HALF});
+    ASSERT_EQ(Status::OK(), result.status());
+
+    auto z = result.at(0);
+    ASSERT_EQ(sd::DataType::HALF, z->dataType());
+
+    for (Nd4jLong e = 0; e < x.lengthOf(); e++)
+        ASSERT_EQ(static_cast<float>(static_cast<float16>(static_cast<float>(x.e<double>(e)))), z->e<float>(e));
+}
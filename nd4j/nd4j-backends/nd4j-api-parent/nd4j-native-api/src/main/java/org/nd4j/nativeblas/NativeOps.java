@@ -1200,6 +1200,20 @@ public interface NativeOps {
 
     long getCachedMemory(int deviceId);
 
+    long getTadCacheHits();
+    long getTadCacheMisses();
+    long getTadCacheEvictions();
+    long getTadCacheEntries();
+    long getTadCacheBytes();
+
+    /**
+     * This method sets TAD cache limits. Least recently used entries are evicted once any limit is exceeded.
+     *
+     * @param maxEntries max number of cached TAD packs, 0 means no limit
+     * @param maxBytes max amount of memory used by cached TAD packs, 0 means no limit
+     */
+    void setTadCacheLimits(@Cast("Nd4jLong") long maxEntries, @Cast("Nd4jLong") long maxBytes);
+
     OpaqueLaunchContext defaultLaunchContext();
 
     Pointer lcScalarPointer(OpaqueLaunchContext lc);